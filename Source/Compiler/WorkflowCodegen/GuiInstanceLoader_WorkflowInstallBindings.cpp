@@ -237,28 +237,12 @@ Workflow_InstallBindProperty
 				auto funcExpr = MakePtr<WfFunctionExpression>();
 				funcExpr->function = callback;
 
-				auto refBind = MakePtr<WfReferenceExpression>();
-				refBind->name.value = L"<created-subscription>";
-
-				auto refEvent = MakePtr<WfMemberExpression>();
-				refEvent->parent = refBind;
-				refEvent->name.value = L"ValueChanged";
-
-				auto attachExpr = MakePtr<WfAttachEventExpression>();
-				attachExpr->event = refEvent;
-				attachExpr->function = funcExpr;
-
-				auto stat = MakePtr<WfExpressionStatement>();
-				stat->expression = attachExpr;
-				subBlock->statements.Add(stat);
-			}
-			{
 				auto refThis = MakePtr<WfReferenceExpression>();
 				refThis->name.value = L"<this>";
 
 				auto member = MakePtr<WfMemberExpression>();
 				member->parent = refThis;
-				member->name.value = L"AddSubscription";
+				member->name.value = L"AddPropertyBinding";
 
 				auto refBind = MakePtr<WfReferenceExpression>();
 				refBind->name.value = L"<created-subscription>";
@@ -266,6 +250,7 @@ Workflow_InstallBindProperty
 				auto call = MakePtr<WfCallExpression>();
 				call->function = member;
 				call->arguments.Add(refBind);
+				call->arguments.Add(funcExpr);
 
 				auto stat = MakePtr<WfExpressionStatement>();
 				stat->expression = call;
@@ -14,6 +14,162 @@ namespace vl
 			using namespace theme;
 			using namespace description;
 
+/***********************************************************************
+GuiFrameScheduler
+***********************************************************************/
+
+			void GuiFrameScheduler::GlobalTimer()
+			{
+				ProcessFrame();
+			}
+
+			void GuiFrameScheduler::ScheduleCaretDeadline()
+			{
+				// a caret only changes when it blinks, so a one-shot delayed task requests the frame at the earliest deadline
+				bool pending = false;
+				vuint64_t deadline = 0;
+				FOREACH(GuiGraphicsHost*, host, hosts)
+				{
+					vuint64_t hostDeadline = 0;
+					if (host->GetCaretDeadline(hostDeadline) && (!pending || hostDeadline < deadline))
+					{
+						pending = true;
+						deadline = hostDeadline;
+					}
+				}
+
+				if (caretDelay && caretDelay->GetStatus() == INativeDelay::Pending)
+				{
+					if (pending && deadline == caretDeadline) return;
+					caretDelay->Cancel();
+				}
+				caretDelay = nullptr;
+
+				if (pending)
+				{
+					vuint64_t now = GetClockTime();
+					caretDeadline = deadline;
+					caretDelay = GetCurrentController()->AsyncService()->DelayExecuteInMainThread([]()
+					{
+						if (auto application = GetApplication())
+						{
+							application->GetFrameScheduler()->RequestFrame();
+						}
+					}, (deadline > now ? (vint)(deadline - now) : 0));
+				}
+			}
+
+			GuiFrameScheduler::GuiFrameScheduler()
+			{
+				GetCurrentController()->CallbackService()->InstallListener(this);
+			}
+
+			GuiFrameScheduler::~GuiFrameScheduler()
+			{
+				GetCurrentController()->CallbackService()->UninstallListener(this);
+				GetCurrentController()->InputService()->StopTimer();
+				if (caretDelay)
+				{
+					caretDelay->Cancel();
+				}
+			}
+
+			void GuiFrameScheduler::RegisterHost(compositions::GuiGraphicsHost* host)
+			{
+				if (!hosts.Contains(host))
+				{
+					hosts.Add(host);
+					RequestFrame();
+				}
+			}
+
+			void GuiFrameScheduler::UnregisterHost(compositions::GuiGraphicsHost* host)
+			{
+				hosts.Remove(host);
+			}
+
+			vuint64_t GuiFrameScheduler::GetClockTime()
+			{
+				return clock ? clock() : DateTime::UtcTime().totalMilliseconds;
+			}
+
+			void GuiFrameScheduler::SetClock(const Func<vuint64_t()>& value)
+			{
+				clock = value;
+			}
+
+			vint GuiFrameScheduler::GetFrameCount()
+			{
+				return frameCount;
+			}
+
+			bool GuiFrameScheduler::IsFrameScheduled()
+			{
+				return GetCurrentController()->InputService()->IsTimerEnabled();
+			}
+
+			bool GuiFrameScheduler::IsFrameRequired()
+			{
+				FOREACH(GuiGraphicsHost*, host, hosts)
+				{
+					if (host->IsFrameRequired())
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			void GuiFrameScheduler::RequestFrame()
+			{
+				// the timer belongs to the main thread, and the scheduler could be gone when the request arrives
+				auto asyncService = GetCurrentController()->AsyncService();
+				if (!asyncService->IsInMainThread())
+				{
+					asyncService->InvokeInMainThread(nullptr, []()
+					{
+						if (auto application = GetApplication())
+						{
+							application->GetFrameScheduler()->RequestFrame();
+						}
+					});
+					return;
+				}
+
+				// the timer is checked after the current frame
+				if (!processingFrame)
+				{
+					GetCurrentController()->InputService()->StartTimer();
+				}
+			}
+
+			void GuiFrameScheduler::ProcessFrame()
+			{
+				// a host could run a nested message loop in a frame, which processes frames again
+				bool nested = processingFrame;
+				processingFrame = true;
+				vuint64_t now = GetClockTime();
+				for (vint i = 0; i < hosts.Count(); i++)
+				{
+					hosts[i]->ProcessFrame(now);
+				}
+				frameCount++;
+				processingFrame = nested;
+
+				if (!nested)
+				{
+					if (IsFrameRequired())
+					{
+						GetCurrentController()->InputService()->StartTimer();
+					}
+					else
+					{
+						GetCurrentController()->InputService()->StopTimer();
+						ScheduleCaretDeadline();
+					}
+				}
+			}
+
 /***********************************************************************
 GuiApplication
 ***********************************************************************/
@@ -163,6 +319,11 @@ GuiApplication
 				}
 			}
 
+			GuiFrameScheduler* GuiApplication::GetFrameScheduler()
+			{
+				return &frameScheduler;
+			}
+
 			GuiWindow* GuiApplication::GetMainWindow()
 			{
 				return mainWindow;
@@ -497,7 +658,6 @@ GuiApplicationMain
 
 			void GuiApplicationInitialize()
 			{
-				GetCurrentController()->InputService()->StartTimer();
 				theme::InitializeTheme();
 
 #ifndef VCZH_DEBUG_NO_REFLECTION
@@ -18,6 +18,60 @@ namespace vl
 		namespace controls
 		{
 
+/***********************************************************************
+Frame Scheduler
+***********************************************************************/
+
+			/// <summary>
+			/// Drives all <see cref="compositions::GuiGraphicsHost"/> instances in a single frame callback from the global timer.
+			/// The global timer only runs when any host requires the next frame, that is, a rendering is pending or an animation is running.
+			/// A visible caret and delayed tasks are woken by <see cref="INativeAsyncService"/> at their deadlines, they do not keep the global timer running.
+			/// </summary>
+			class GuiFrameScheduler : public Object, private INativeControllerListener
+			{
+			protected:
+				collections::List<compositions::GuiGraphicsHost*>	hosts;
+				Func<vuint64_t()>								clock;
+				bool											processingFrame = false;
+				vint											frameCount = 0;
+				Ptr<INativeDelay>								caretDelay;
+				vuint64_t										caretDeadline = 0;
+
+				void											GlobalTimer()override;
+				void											ScheduleCaretDeadline();
+			public:
+				GuiFrameScheduler();
+				~GuiFrameScheduler();
+
+				/// <summary>Add a host to be driven by frames.</summary>
+				/// <param name="host">The host.</param>
+				void											RegisterHost(compositions::GuiGraphicsHost* host);
+				/// <summary>Remove a host from frames.</summary>
+				/// <param name="host">The host.</param>
+				void											UnregisterHost(compositions::GuiGraphicsHost* host);
+
+				/// <summary>Get the current time in milliseconds from the clock.</summary>
+				/// <returns>The current time.</returns>
+				vuint64_t										GetClockTime();
+				/// <summary>Replace the clock, for example, with a virtual clock in tests.</summary>
+				/// <param name="value">The clock returning the current time in milliseconds. Set to null to use the system time.</param>
+				void											SetClock(const Func<vuint64_t()>& value);
+				/// <summary>Get the number of processed frames.</summary>
+				/// <returns>The number of processed frames.</returns>
+				vint											GetFrameCount();
+
+				/// <summary>Test if the global timer is running to process the next frame.</summary>
+				/// <returns>Returns true if the next frame is scheduled.</returns>
+				bool											IsFrameScheduled();
+				/// <summary>Test if any host requires the next frame.</summary>
+				/// <returns>Returns true if the next frame is required.</returns>
+				bool											IsFrameRequired();
+				/// <summary>Start the global timer if it is not running. This function should be called when a host has something to do in the next frame. A request from other threads is forwarded to the main thread.</summary>
+				void											RequestFrame();
+				/// <summary>Process a frame for all hosts, then keep the global timer running only if any host requires the next frame. Otherwise a frame is only requested again when the earliest visible caret blinks.</summary>
+				void											ProcessFrame();
+			};
+
 /***********************************************************************
 Application
 ***********************************************************************/
@@ -46,6 +100,7 @@ Application
 				bool											sharedTooltipClosing = false;
 				collections::List<GuiWindow*>					windows;
 				collections::SortedList<GuiPopup*>				openingPopups;
+				GuiFrameScheduler								frameScheduler;
 
 				GuiApplication();
 				~GuiApplication();
@@ -72,6 +127,9 @@ Application
 				/// <summary>Run a <see cref="GuiWindow"/> as the main window and show it. This function can only be called once in the entry point. When the main window is closed or hiden, the Run function will finished, and the application should prepare for finalization.</summary>
 				/// <param name="_mainWindow">The main window.</param>
 				void											Run(GuiWindow* _mainWindow);
+				/// <summary>Get the frame scheduler that drives all windows.</summary>
+				/// <returns>The frame scheduler.</returns>
+				GuiFrameScheduler*								GetFrameScheduler();
 				/// <summary>Get the main window.</summary>
 				/// <returns>The main window.</returns>
 				GuiWindow*										GetMainWindow();
@@ -1047,9 +1047,13 @@ GuiPopup
 GuiPopup
 ***********************************************************************/
 
-			void GuiTooltip::GlobalTimer()
+			void GuiTooltip::TooltipContainerBoundsChanged(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments)
 			{
-				SetClientSize(GetClientSize());
+				// the tooltip fits itself to the content only when the content changes its size
+				if (GetNativeWindow() && GetNativeWindow()->IsVisible())
+				{
+					SetClientSize(GetClientSize());
+				}
 			}
 
 			void GuiTooltip::TooltipOpened(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments)
@@ -1067,15 +1071,14 @@ GuiPopup
 			{
 				containerComposition->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
 				containerComposition->SetPreferredMinSize(Size(20, 10));
-				GetCurrentController()->CallbackService()->InstallListener(this);
 
+				containerComposition->BoundsChanged.AttachMethod(this, &GuiTooltip::TooltipContainerBoundsChanged);
 				WindowOpened.AttachMethod(this, &GuiTooltip::TooltipOpened);
 				WindowClosed.AttachMethod(this, &GuiTooltip::TooltipClosed);
 			}
 
 			GuiTooltip::~GuiTooltip()
 			{
-				GetCurrentController()->CallbackService()->UninstallListener(this);
 			}
 
 			vint GuiTooltip::GetPreferredContentWidth()
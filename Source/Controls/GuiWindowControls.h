@@ -388,12 +388,12 @@ Window
 			};
 
 			/// <summary>Represents a tooltip window.</summary>
-			class GuiTooltip : public GuiPopup, private INativeControllerListener, public Description<GuiTooltip>
+			class GuiTooltip : public GuiPopup, public Description<GuiTooltip>
 			{
 			protected:
 				GuiControl*								temporaryContentControl;
 
-				void									GlobalTimer()override;
+				void									TooltipContainerBoundsChanged(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments);
 				void									TooltipOpened(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments);
 				void									TooltipClosed(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments);
 			public:
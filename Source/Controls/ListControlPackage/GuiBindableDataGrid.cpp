@@ -1,5 +1,6 @@
 #include "GuiBindableDataGrid.h"
 #include "GuiBindableListControls.h"
+#include "../GuiApplication.h"
 
 namespace vl
 {
@@ -232,6 +233,13 @@ DataReverseSorter
 					return sorter ? -sorter->Compare(row1, row2) : 0;
 				}
 
+				bool DataReverseSorter::GetSortKey(const description::Value& row, double& key)
+				{
+					if (!sorter || !sorter->GetSortKey(row, key)) return false;
+					key = -key;
+					return true;
+				}
+
 /***********************************************************************
 DataColumn
 ***********************************************************************/
@@ -488,19 +496,50 @@ DataProvider
 
 				void DataProvider::OnProcessorChanged()
 				{
+					// the callback does not tell whether a filter or a sorter is changed, RefilterRows finds out by checking the current order
 					RebuildFilter();
-					ReorderRows(true);
+					if (!RefilterRows())
+					{
+						ReorderRows(true);
+					}
 				}
 
 				void DataProvider::OnItemSourceModified(vint start, vint count, vint newCount)
 				{
-					if (!currentSorter && !currentFilter && count == newCount)
+					if (!currentSorter && !currentFilter)
 					{
+						if (count != newCount)
+						{
+							ReorderRows(false);
+						}
 						InvokeOnItemModified(start, count, newCount);
 					}
-					else
+					else if (reordering || !ReorderModifiedRows(start, count, newCount))
 					{
-						ReorderRows(true);
+						// rows are reordered in background threads, remove modified rows now to keep other rows valid until then
+						if (reordering || GetParallelTaskCount(itemSource ? itemSource->GetCount() : 0) > 1)
+						{
+							vint modifiedStart = -1;
+							vint modifiedEnd = -1;
+							vint modifiedOldCount = 0;
+							RemoveModifiedRows(start, count, newCount, modifiedStart, modifiedEnd, modifiedOldCount);
+							if (modifiedStart != -1)
+							{
+								InvokeOnItemModified(modifiedStart, modifiedOldCount, modifiedEnd - modifiedStart);
+							}
+						}
+
+						if (reordering)
+						{
+							// the running reordering is not replaced, otherwise a steady stream of modifications never lets a result arrive
+							// modified rows are placed when the result arrives
+							SourceModification modification = { start, count, newCount };
+							reorderingModifications.Add(modification);
+						}
+						else
+						{
+							ReorderRows(true);
+						}
 					}
 				}
 
@@ -593,46 +632,614 @@ DataProvider
 					}
 				}
 
+				vint DataProvider::GetParallelTaskCount(vint rowCount)
+				{
+					// rows for each task in parallel processing
+					const vint RowsPerTask = 16384;
+					const vint MaxTaskCount = 16;
+
+					if (!parallelProcessing || (!currentFilter && !currentSorter))
+					{
+						return 0;
+					}
+					vint taskCount = rowCount / RowsPerTask;
+					return taskCount > MaxTaskCount ? MaxTaskCount : taskCount;
+				}
+
 				void DataProvider::ReorderRows(bool invokeCallback)
 				{
+					if (reordering && invokeCallback && GetParallelTaskCount(itemSource ? itemSource->GetCount() : 0) > 1)
+					{
+						// rows are read again only once, when the running reordering finishes
+						reorderingDiscarded = true;
+						reorderingRestarted = true;
+						reorderingModifications.Clear();
+						return;
+					}
+
 					vint oldRowCount = virtualRowToSourceRow.Count();
-					virtualRowToSourceRow.Clear();
 					vint rowCount = itemSource ? itemSource->GetCount() : 0;
 
-					if (currentFilter)
+					if (currentFilter || currentSorter)
 					{
+						// read each row only once, instead of twice for each comparison
+						auto rows = MakePtr<Array<Value>>(rowCount);
 						for (vint i = 0; i < rowCount; i++)
 						{
-							if (currentFilter->Filter(itemSource->Get(i)))
-							{
-								virtualRowToSourceRow.Add(i);
-							}
+							rows->Set(i, itemSource->Get(i));
 						}
+
+						vint taskCount = GetParallelTaskCount(rowCount);
+						if (invokeCallback && taskCount > 1 && GetApplication())
+						{
+							ReorderRowsInParallel(rows, taskCount);
+							return;
+						}
+
+						DiscardReordering();
+						virtualRowToSourceRow.Clear();
+						Array<double> keys;
+						bool useKeys = PrepareSortKeys(currentSorter.Obj(), *rows.Obj(), keys);
+						FilterAndSortRows(currentFilter.Obj(), currentSorter.Obj(), *rows.Obj(), (useKeys ? &keys : nullptr), 0, rowCount, virtualRowToSourceRow);
 					}
 					else
 					{
+						DiscardReordering();
+						virtualRowToSourceRow.Clear();
 						for (vint i = 0; i < rowCount; i++)
 						{
 							virtualRowToSourceRow.Add(i);
 						}
 					}
 
-					if (currentSorter && virtualRowToSourceRow.Count() > 0)
+					if (invokeCallback)
 					{
-						IDataSorter* sorter = currentSorter.Obj();
-						SortLambda(
-							&virtualRowToSourceRow[0],
-							virtualRowToSourceRow.Count(),
-							[=](vint a, vint b)
+						InvokeOnItemModified(0, oldRowCount, virtualRowToSourceRow.Count());
+					}
+				}
+
+				void DataProvider::ReorderingWorker::Run(Ptr<ReorderingWorker> worker)
+				{
+					auto& semaphore = worker->semaphore;
+					auto& lock = worker->lock;
+					auto& cancelled = worker->cancelled;
+					while (true)
+					{
+						semaphore.Wait();
+						Ptr<Array<Value>> currentRows;
+						Ptr<IDataFilter> currentFilter;
+						Ptr<IDataSorter> currentSorter;
+						vint currentTaskCount = 0;
+						SPIN_LOCK(lock)
+						{
+							if (cancelled) return;
+							currentRows = worker->rows;
+							currentFilter = worker->filter;
+							currentSorter = worker->sorter;
+							currentTaskCount = worker->taskCount;
+							worker->rows = nullptr;
+							worker->filter = nullptr;
+							worker->sorter = nullptr;
+						}
+						if (!currentRows) continue;
+
+						auto result = MakePtr<List<vint>>();
+						FilterAndSortRowsInParallel(currentFilter.Obj(), currentSorter.Obj(), *currentRows.Obj(), currentTaskCount, *result.Obj(), &cancelled);
+						if (cancelled) return;
+
+						// the application is disposed after all windows and data providers are deleted
+						auto application = worker->application;
+						if (application && GetApplication() == application)
+						{
+							application->InvokeInMainThread(nullptr, [=]()
 							{
-								return sorter->Compare(itemSource->Get(a), itemSource->Get(b));
+								if (worker->owner)
+								{
+									worker->owner->OnRowsReordered(result);
+								}
 							});
+						}
 					}
+				}
 
-					if (invokeCallback)
+				void DataProvider::ReorderRowsInParallel(Ptr<collections::Array<description::Value>> rows, vint taskCount)
+				{
+					// the UI thread keeps the current rows, the result is swapped in when it is ready
+					// filters and sorters are kept alive by the background thread, it never accesses the data provider
+					if (!reorderingWorker)
+					{
+						reorderingWorker = MakePtr<ReorderingWorker>();
+						reorderingWorker->owner = this;
+						reorderingWorker->application = GetApplication();
+						reorderingWorker->semaphore.Create(0, 2);
+						auto worker = reorderingWorker;
+						reorderingWorker->thread = Thread::CreateAndStart([worker]() { ReorderingWorker::Run(worker); }, false);
+					}
+
+					reordering = true;
+					reorderingDiscarded = false;
+					reorderingRestarted = false;
+					reorderingModifications.Clear();
+					SPIN_LOCK(reorderingWorker->lock)
+					{
+						reorderingWorker->rows = rows;
+						reorderingWorker->filter = currentFilter;
+						reorderingWorker->sorter = currentSorter;
+						reorderingWorker->taskCount = taskCount;
+					}
+					reorderingWorker->semaphore.Release();
+				}
+
+				void DataProvider::DiscardReordering()
+				{
+					// the result of the running reordering is dropped when it arrives
+					if (reordering)
+					{
+						reorderingDiscarded = true;
+						reorderingRestarted = false;
+						reorderingModifications.Clear();
+					}
+				}
+
+				void DataProvider::OnRowsReordered(Ptr<collections::List<vint>> result)
+				{
+					reordering = false;
+					if (reorderingDiscarded)
+					{
+						reorderingDiscarded = false;
+						if (reorderingRestarted)
+						{
+							reorderingRestarted = false;
+							ReorderRows(true);
+						}
+						return;
+					}
+
+					// the result is for rows when the reordering started, modifications since then are applied to it
+					// dirtyRanges are rows in the item source that are modified, in [start, end) form
+					vint oldRowCount = virtualRowToSourceRow.Count();
+					CopyFrom(virtualRowToSourceRow, *result.Obj());
+					List<Pair<vint, vint>> dirtyRanges;
+					for (vint i = 0; i < reorderingModifications.Count(); i++)
+					{
+						auto modification = reorderingModifications[i];
+						vint modifiedStart = -1;
+						vint modifiedEnd = -1;
+						vint modifiedOldCount = 0;
+						RemoveModifiedRows(modification.start, modification.count, modification.newCount, modifiedStart, modifiedEnd, modifiedOldCount);
+
+						vint delta = modification.newCount - modification.count;
+						vint removedEnd = modification.start + modification.count;
+						List<Pair<vint, vint>> ranges;
+						for (vint j = 0; j < dirtyRanges.Count(); j++)
+						{
+							auto range = dirtyRanges[j];
+							if (range.key < modification.start)
+							{
+								ranges.Add(Pair<vint, vint>(range.key, range.value < modification.start ? range.value : modification.start));
+							}
+							if (range.value > removedEnd)
+							{
+								ranges.Add(Pair<vint, vint>((range.key > removedEnd ? range.key : removedEnd) + delta, range.value + delta));
+							}
+						}
+						if (modification.newCount > 0)
+						{
+							ranges.Add(Pair<vint, vint>(modification.start, modification.start + modification.newCount));
+						}
+						CopyFrom(dirtyRanges, ranges);
+					}
+					reorderingModifications.Clear();
+
+					vint dirtyCount = 0;
+					for (vint i = 0; i < dirtyRanges.Count(); i++)
+					{
+						dirtyCount += dirtyRanges[i].value - dirtyRanges[i].key;
+					}
+
+					vint rowCount = itemSource ? itemSource->GetCount() : 0;
+					if (dirtyCount * 8 > rowCount && GetParallelTaskCount(rowCount) > 1)
+					{
+						// too many rows are modified, show the result without them and reorder again
+						InvokeOnItemModified(0, oldRowCount, virtualRowToSourceRow.Count());
+						ReorderRows(true);
+						return;
+					}
+
+					for (vint i = 0; i < dirtyRanges.Count(); i++)
+					{
+						for (vint row = dirtyRanges[i].key; row < dirtyRanges[i].value; row++)
+						{
+							auto value = itemSource->Get(row);
+							if (!currentFilter || currentFilter->Filter(value))
+							{
+								virtualRowToSourceRow.Insert(FindRowPosition(row, value), row);
+							}
+						}
+					}
+					InvokeOnItemModified(0, oldRowCount, virtualRowToSourceRow.Count());
+				}
+
+				bool DataProvider::PrepareSortKeys(IDataSorter* sorter, const collections::Array<description::Value>& rows, collections::Array<double>& keys)
+				{
+					// keys are only used when the sorter provides them, callers fill keys of rows to sort
+					double key = 0;
+					if (!sorter || rows.Count() == 0 || !sorter->GetSortKey(rows[0], key))
+					{
+						return false;
+					}
+					keys.Resize(rows.Count());
+					return true;
+				}
+
+				vint DataProvider::CompareRows(IDataSorter* sorter, const collections::Array<description::Value>& rows, const collections::Array<double>* keys, vint a, vint b)
+				{
+					// equal rows are kept in their original order
+					vint order = 0;
+					if (keys)
+					{
+						double keyA = keys->Get(a);
+						double keyB = keys->Get(b);
+						order = keyA < keyB ? -1 : keyA > keyB ? 1 : 0;
+					}
+					else if (sorter)
+					{
+						order = sorter->Compare(rows[a], rows[b]);
+					}
+					return order != 0 ? order : a - b;
+				}
+
+				void DataProvider::SortRows(IDataSorter* sorter, const collections::Array<description::Value>& rows, const collections::Array<double>* keys, collections::List<vint>& result)
+				{
+					if (!sorter) return;
+
+					// SortLambda takes the first item as the pivot, which is quadratic for rows that are already sorted, so a merge sort is used
+					vint count = result.Count();
+					Array<vint> first(count), second(count);
+					for (vint i = 0; i < count; i++)
+					{
+						first[i] = result[i];
+					}
+					auto source = &first;
+					auto target = &second;
+					for (vint width = 1; width < count; width *= 2)
+					{
+						for (vint start = 0; start < count; start += width * 2)
+						{
+							vint middle = start + width < count ? start + width : count;
+							vint end = middle + width < count ? middle + width : count;
+							vint left = start, right = middle;
+							for (vint i = start; i < end; i++)
+							{
+								if (left < middle && (right == end || CompareRows(sorter, rows, keys, source->Get(left), source->Get(right)) < 0))
+								{
+									target->Set(i, source->Get(left++));
+								}
+								else
+								{
+									target->Set(i, source->Get(right++));
+								}
+							}
+						}
+						auto swap = source;
+						source = target;
+						target = swap;
+					}
+					for (vint i = 0; i < count; i++)
+					{
+						result[i] = source->Get(i);
+					}
+				}
+
+				void DataProvider::FilterAndSortRows(IDataFilter* filter, IDataSorter* sorter, const collections::Array<description::Value>& rows, collections::Array<double>* keys, vint start, vint count, collections::List<vint>& result)
+				{
+					for (vint i = start; i < start + count; i++)
+					{
+						if (!filter || filter->Filter(rows[i]))
+						{
+							result.Add(i);
+							if (keys)
+							{
+								sorter->GetSortKey(rows[i], (*keys)[i]);
+							}
+						}
+					}
+					SortRows(sorter, rows, keys, result);
+				}
+
+				void DataProvider::MergeRows(IDataSorter* sorter, const collections::Array<description::Value>& rows, const collections::Array<double>* keys, const collections::List<vint>& first, const collections::List<vint>& second, collections::List<vint>& result)
+				{
+					vint firstIndex = 0;
+					vint secondIndex = 0;
+					while (firstIndex < first.Count() && secondIndex < second.Count())
+					{
+						vint a = first[firstIndex];
+						vint b = second[secondIndex];
+						if (CompareRows(sorter, rows, keys, a, b) < 0)
+						{
+							result.Add(a);
+							firstIndex++;
+						}
+						else
+						{
+							result.Add(b);
+							secondIndex++;
+						}
+					}
+					while (firstIndex < first.Count())
+					{
+						result.Add(first[firstIndex++]);
+					}
+					while (secondIndex < second.Count())
+					{
+						result.Add(second[secondIndex++]);
+					}
+				}
+
+				void DataProvider::FilterAndSortRowsInParallel(IDataFilter* filter, IDataSorter* sorter, const collections::Array<description::Value>& rows, vint taskCount, collections::List<vint>& result, const volatile bool* cancelled)
+				{
+					// each task filters and sorts a range of rows, and then sorted ranges are merged in pairs until only one is left
+					Array<double> keys;
+					auto sortKeys = PrepareSortKeys(sorter, rows, keys) ? &keys : nullptr;
+					List<Ptr<List<vint>>> results;
+					Semaphore semaphore;
+					semaphore.Create(0, taskCount);
+
+					for (vint i = 0; i < taskCount; i++)
+					{
+						auto taskResult = MakePtr<List<vint>>();
+						results.Add(taskResult);
+
+						vint start = rows.Count() * i / taskCount;
+						vint end = rows.Count() * (i + 1) / taskCount;
+						ThreadPoolLite::QueueLambda([=, &rows, &semaphore]()
+						{
+							FilterAndSortRows(filter, sorter, rows, sortKeys, start, end - start, *taskResult.Obj());
+							semaphore.Release();
+						});
+					}
+					for (vint i = 0; i < taskCount; i++)
+					{
+						semaphore.Wait();
+					}
+
+					while (results.Count() > 1)
+					{
+						if (cancelled && *cancelled) return;
+						List<Ptr<List<vint>>> merged;
+						vint mergeCount = results.Count() / 2;
+						for (vint i = 0; i < mergeCount; i++)
+						{
+							auto first = results[i * 2];
+							auto second = results[i * 2 + 1];
+							auto mergedResult = MakePtr<List<vint>>();
+							merged.Add(mergedResult);
+
+							ThreadPoolLite::QueueLambda([=, &rows, &semaphore]()
+							{
+								MergeRows(sorter, rows, sortKeys, *first.Obj(), *second.Obj(), *mergedResult.Obj());
+								semaphore.Release();
+							});
+						}
+						if (results.Count() % 2 == 1)
+						{
+							merged.Add(results[results.Count() - 1]);
+						}
+						for (vint i = 0; i < mergeCount; i++)
+						{
+							semaphore.Wait();
+						}
+						CopyFrom(results, merged);
+					}
+
+					CopyFrom(result, *results[0].Obj());
+				}
+
+				vint DataProvider::FindRowPosition(vint row, const description::Value& value)
+				{
+					// rows are sorted by the sorter, or by their indices in the item source if there is no sorter
+					// equal rows are kept in their original order
+					vint start = 0;
+					vint end = virtualRowToSourceRow.Count();
+					while (start < end)
+					{
+						vint middle = start + (end - start) / 2;
+						vint middleRow = virtualRowToSourceRow[middle];
+						vint result = currentSorter ? currentSorter->Compare(value, itemSource->Get(middleRow)) : 0;
+						if (result == 0)
+						{
+							result = row - middleRow;
+						}
+
+						if (result < 0)
+						{
+							end = middle;
+						}
+						else
+						{
+							start = middle + 1;
+						}
+					}
+					return start;
+				}
+
+				void DataProvider::RemoveModifiedRows(vint start, vint count, vint newCount, vint& modifiedStart, vint& modifiedEnd, vint& modifiedOldCount)
+				{
+					// [modifiedStart, modifiedEnd) in virtualRowToSourceRow covers all removed rows
+					// it replaces modifiedOldCount rows before the change
+					{
+						vint delta = newCount - count;
+						vint rowIndex = 0;
+						for (vint i = 0; i < virtualRowToSourceRow.Count(); i++)
+						{
+							vint row = virtualRowToSourceRow[i];
+							if (row < start)
+							{
+								virtualRowToSourceRow[rowIndex++] = row;
+							}
+							else if (row >= start + count)
+							{
+								virtualRowToSourceRow[rowIndex++] = row + delta;
+							}
+							else
+							{
+								if (modifiedStart == -1)
+								{
+									modifiedStart = rowIndex;
+								}
+								modifiedOldCount = i - modifiedStart + 1;
+								modifiedEnd = rowIndex;
+							}
+						}
+						if (rowIndex < virtualRowToSourceRow.Count())
+						{
+							virtualRowToSourceRow.RemoveRange(rowIndex, virtualRowToSourceRow.Count() - rowIndex);
+						}
+					}
+				}
+
+				bool DataProvider::ReorderModifiedRows(vint start, vint count, vint newCount)
+				{
+					// when only a few rows are changed, keep the order of other rows and only filter and place changed rows
+					vint rowCount = itemSource ? itemSource->GetCount() : 0;
+					if ((count + newCount) * 8 > rowCount)
+					{
+						return false;
+					}
+
+					// [modifiedStart, modifiedEnd) in virtualRowToSourceRow covers all changed rows
+					// it replaces modifiedOldCount rows before the change
+					vint modifiedStart = -1;
+					vint modifiedEnd = -1;
+					vint modifiedOldCount = 0;
+					RemoveModifiedRows(start, count, newCount, modifiedStart, modifiedEnd, modifiedOldCount);
+
+					for (vint i = 0; i < newCount; i++)
+					{
+						vint row = start + i;
+						auto value = itemSource->Get(row);
+						if (currentFilter && !currentFilter->Filter(value))
+						{
+							continue;
+						}
+
+						vint position = FindRowPosition(row, value);
+						virtualRowToSourceRow.Insert(position, row);
+						if (modifiedStart == -1)
+						{
+							modifiedStart = position;
+							modifiedEnd = position + 1;
+						}
+						else if (position < modifiedStart)
+						{
+							modifiedOldCount += modifiedStart - position;
+							modifiedStart = position;
+							modifiedEnd++;
+						}
+						else if (position > modifiedEnd)
+						{
+							modifiedOldCount += position - modifiedEnd;
+							modifiedEnd = position + 1;
+						}
+						else
+						{
+							modifiedEnd++;
+						}
+					}
+
+					if (modifiedStart != -1)
 					{
-						NotifyAllItemsUpdate();
+						InvokeOnItemModified(modifiedStart, modifiedOldCount, modifiedEnd - modifiedStart);
 					}
+					return true;
+				}
+
+				bool DataProvider::RefilterRows()
+				{
+					// when only filters are changed, visible rows are still in order
+					// rows that are filtered out are removed, and rows that become visible are sorted and merged into them
+					vint rowCount = itemSource ? itemSource->GetCount() : 0;
+					Array<Value> rows(rowCount);
+					for (vint i = 0; i < rowCount; i++)
+					{
+						rows[i] = itemSource->Get(i);
+					}
+
+					Array<double> keys;
+					auto sortKeys = PrepareSortKeys(currentSorter.Obj(), rows, keys) ? &keys : nullptr;
+					if (sortKeys)
+					{
+						for (vint i = 0; i < rowCount; i++)
+						{
+							currentSorter->GetSortKey(rows[i], keys[i]);
+						}
+					}
+
+					// a changed sorter usually breaks the order, all rows need to be sorted again
+					if (currentSorter)
+					{
+						for (vint i = 1; i < virtualRowToSourceRow.Count(); i++)
+						{
+							if (CompareRows(currentSorter.Obj(), rows, sortKeys, virtualRowToSourceRow[i - 1], virtualRowToSourceRow[i]) > 0)
+							{
+								return false;
+							}
+						}
+					}
+
+					Array<bool> visibleRows(rowCount);
+					for (vint i = 0; i < rowCount; i++)
+					{
+						visibleRows[i] = false;
+					}
+
+					List<vint> keptRows;
+					for (vint i = 0; i < virtualRowToSourceRow.Count(); i++)
+					{
+						vint row = virtualRowToSourceRow[i];
+						visibleRows[row] = true;
+						if (!currentFilter || currentFilter->Filter(rows[row]))
+						{
+							keptRows.Add(row);
+						}
+					}
+
+					List<vint> addedRows;
+					for (vint i = 0; i < rowCount; i++)
+					{
+						if (!visibleRows[i] && (!currentFilter || currentFilter->Filter(rows[i])))
+						{
+							addedRows.Add(i);
+						}
+					}
+					SortRows(currentSorter.Obj(), rows, sortKeys, addedRows);
+
+					List<vint> newRows;
+					MergeRows(currentSorter.Obj(), rows, sortKeys, keptRows, addedRows, newRows);
+
+					// only report rows between the first and the last different positions
+					vint oldCount = virtualRowToSourceRow.Count();
+					vint newCount = newRows.Count();
+					vint minCount = oldCount < newCount ? oldCount : newCount;
+					vint prefix = 0;
+					while (prefix < minCount && virtualRowToSourceRow[prefix] == newRows[prefix])
+					{
+						prefix++;
+					}
+					vint suffix = 0;
+					while (suffix < minCount - prefix && virtualRowToSourceRow[oldCount - suffix - 1] == newRows[newCount - suffix - 1])
+					{
+						suffix++;
+					}
+
+					// the result includes rows that a running reordering has not swapped in yet
+					DiscardReordering();
+					CopyFrom(virtualRowToSourceRow, newRows);
+					if (prefix + suffix < oldCount || prefix + suffix < newCount)
+					{
+						InvokeOnItemModified(prefix, oldCount - prefix - suffix, newCount - prefix - suffix);
+					}
+					return true;
 				}
 
 				DataProvider::DataProvider()
@@ -645,6 +1252,18 @@ DataProvider
 
 				DataProvider::~DataProvider()
 				{
+					if (reorderingWorker)
+					{
+						reorderingWorker->owner = nullptr;
+						SPIN_LOCK(reorderingWorker->lock)
+						{
+							reorderingWorker->cancelled = true;
+						}
+						reorderingWorker->semaphore.Release();
+						reorderingWorker->thread->Wait();
+						delete reorderingWorker->thread;
+						reorderingWorker->thread = nullptr;
+					}
 				}
 
 				Ptr<IDataFilter> DataProvider::GetAdditionalFilter()
@@ -656,7 +1275,20 @@ DataProvider
 				{
 					additionalFilter = value;
 					RebuildFilter();
-					ReorderRows(true);
+					if (!RefilterRows())
+					{
+						ReorderRows(true);
+					}
+				}
+
+				bool DataProvider::GetParallelProcessing()
+				{
+					return parallelProcessing;
+				}
+
+				void DataProvider::SetParallelProcessing(bool value)
+				{
+					parallelProcessing = value;
 				}
 
 				// ===================== GuiListControl::IItemProvider =====================
@@ -923,6 +1555,16 @@ GuiBindableDataGrid
 				dataProvider->SetAdditionalFilter(value);
 			}
 
+			bool GuiBindableDataGrid::GetParallelProcessing()
+			{
+				return dataProvider->GetParallelProcessing();
+			}
+
+			void GuiBindableDataGrid::SetParallelProcessing(bool value)
+			{
+				dataProvider->SetParallelProcessing(value);
+			}
+
 			ItemProperty<Ptr<GuiImageData>> GuiBindableDataGrid::GetLargeImageProperty()
 			{
 				return dataProvider->largeImageProperty;
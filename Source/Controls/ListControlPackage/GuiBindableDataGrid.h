@@ -17,6 +17,7 @@ namespace vl
 	{
 		namespace controls
 		{
+			class GuiApplication;
 			class GuiBindableDataGrid;
 
 			namespace list
@@ -45,6 +46,11 @@ Interfaces
 				public:
 					virtual void										SetCallback(IDataProcessorCallback* value) = 0;
 					virtual vint										Compare(const description::Value& row1, const description::Value& row2) = 0;
+					/// <summary>Get a number that orders rows in the same way as <see cref="Compare"/>. Keys are extracted once per row and sorted without calling <see cref="Compare"/>.</summary>
+					/// <returns>Returns true if the sorter provides keys, it should return the same for all rows. The default implementation returns false.</returns>
+					/// <param name="row">The row.</param>
+					/// <param name="key">The key of the row.</param>
+					virtual bool										GetSortKey(const description::Value& row, double& key) { return false; }
 				};
 
 /***********************************************************************
@@ -177,6 +183,7 @@ Sorter Extensions
 					bool												SetSubSorter(Ptr<IDataSorter> value);
 					void												SetCallback(IDataProcessorCallback* value)override;
 					vint												Compare(const description::Value& row1, const description::Value& row2)override;
+					bool												GetSortKey(const description::Value& row, double& key)override;
 				};
 
 /***********************************************************************
@@ -335,6 +342,32 @@ DataProvider
 					friend class DataColumns;
 					friend class controls::GuiBindableDataGrid;
 				protected:
+					/// <summary>A background thread that reorders snapshots of rows one at a time, for the data provider until it is deleted.</summary>
+					class ReorderingWorker : public Object
+					{
+					public:
+						DataProvider*										owner = nullptr;
+						GuiApplication*										application = nullptr;
+						Thread*												thread = nullptr;
+						Semaphore											semaphore;
+						SpinLock											lock;
+						Ptr<collections::Array<description::Value>>			rows;
+						Ptr<IDataFilter>									filter;
+						Ptr<IDataSorter>									sorter;
+						vint												taskCount = 0;
+						volatile bool										cancelled = false;
+
+						static void											Run(Ptr<ReorderingWorker> worker);
+					};
+
+					/// <summary>An item source modification that happens when a reordering is running.</summary>
+					struct SourceModification
+					{
+						vint												start;
+						vint												count;
+						vint												newCount;
+					};
+
 					ListViewDataColumns										dataColumns;
 					DataColumns												columns;
 					ListViewColumnItemArranger::IColumnItemViewCallback*	columnItemViewCallback = nullptr;
@@ -344,6 +377,12 @@ DataProvider
 					Ptr<IDataFilter>										additionalFilter;
 					Ptr<IDataFilter>										currentFilter;
 					Ptr<IDataSorter>										currentSorter;
+					bool													parallelProcessing = false;
+					Ptr<ReorderingWorker>									reorderingWorker;
+					bool													reordering = false;
+					bool													reorderingDiscarded = false;
+					bool													reorderingRestarted = false;
+					collections::List<SourceModification>					reorderingModifications;
 					collections::List<vint>									virtualRowToSourceRow;
 
 					void													NotifyAllItemsUpdate()override;
@@ -354,7 +393,21 @@ DataProvider
 					void													OnItemSourceModified(vint start, vint count, vint newCount);
 
 					void													RebuildFilter();
+					vint													GetParallelTaskCount(vint rowCount);
 					void													ReorderRows(bool invokeCallback);
+					void													ReorderRowsInParallel(Ptr<collections::Array<description::Value>> rows, vint taskCount);
+					void													DiscardReordering();
+					void													OnRowsReordered(Ptr<collections::List<vint>> result);
+					static bool												PrepareSortKeys(IDataSorter* sorter, const collections::Array<description::Value>& rows, collections::Array<double>& keys);
+					static vint												CompareRows(IDataSorter* sorter, const collections::Array<description::Value>& rows, const collections::Array<double>* keys, vint a, vint b);
+					static void												SortRows(IDataSorter* sorter, const collections::Array<description::Value>& rows, const collections::Array<double>* keys, collections::List<vint>& result);
+					static void												FilterAndSortRows(IDataFilter* filter, IDataSorter* sorter, const collections::Array<description::Value>& rows, collections::Array<double>* keys, vint start, vint count, collections::List<vint>& result);
+					static void												MergeRows(IDataSorter* sorter, const collections::Array<description::Value>& rows, const collections::Array<double>* keys, const collections::List<vint>& first, const collections::List<vint>& second, collections::List<vint>& result);
+					static void												FilterAndSortRowsInParallel(IDataFilter* filter, IDataSorter* sorter, const collections::Array<description::Value>& rows, vint taskCount, collections::List<vint>& result, const volatile bool* cancelled = nullptr);
+					vint													FindRowPosition(vint row, const description::Value& value);
+					void													RemoveModifiedRows(vint start, vint count, vint newCount, vint& modifiedStart, vint& modifiedEnd, vint& modifiedOldCount);
+					bool													ReorderModifiedRows(vint start, vint count, vint newCount);
+					bool													RefilterRows();
 
 				public:
 					ItemProperty<Ptr<GuiImageData>>							largeImageProperty;
@@ -373,6 +426,8 @@ DataProvider
 					
 					Ptr<IDataFilter>									GetAdditionalFilter();
 					void												SetAdditionalFilter(Ptr<IDataFilter> value);
+					bool												GetParallelProcessing();
+					void												SetParallelProcessing(bool value);
 
 					// ===================== GuiListControl::IItemProvider =====================
 
@@ -453,6 +508,13 @@ GuiBindableDataGrid
 				/// <param name="value">The additional filter.</param>
 				void												SetAdditionalFilter(Ptr<list::IDataFilter> value);
 
+				/// <summary>Test if filters and sorters run in multiple threads when all rows are reordered.</summary>
+				/// <returns>Returns true if filters and sorters run in multiple threads.</returns>
+				bool												GetParallelProcessing();
+				/// <summary>Set if filters and sorters run in multiple threads when all rows are reordered. The UI thread does not wait for the result. Until the result is swapped in, rows keep their previous order, and rows added to the item source are not displayed yet. Only enable it when filters and sorters of all columns do not access any control and are safe to be called from multiple threads.</summary>
+				/// <param name="value">Set to true to run filters and sorters in multiple threads.</param>
+				void												SetParallelProcessing(bool value);
+
 				/// <summary>Large image property name changed event.</summary>
 				compositions::GuiNotifyEvent						LargeImagePropertyChanged;
 				/// <summary>Small image property name changed event.</summary>
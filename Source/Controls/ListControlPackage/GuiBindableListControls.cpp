@@ -606,13 +606,27 @@ GuiBindableTreeView::ItemSourceNode
 							itemChangedEventHandler = ol->ItemChanged.Add([this](vint start, vint oldCount, vint newCount)
 							{
 								callback->OnBeforeItemModified(this, start, oldCount, newCount);
+								for (vint i = 0; i < oldCount; i++)
+								{
+									auto node = children[start + i];
+									node->UnprepareChildren();
+									if (childVisibleNodesBuilt)
+									{
+										childVisibleNodes.Remove(node->visibleNodeHandle);
+									}
+								}
 								children.RemoveRange(start, oldCount);
 								for (vint i = 0; i < newCount; i++)
 								{
 									Value value = childrenVirtualList->Get(start + i);
 									auto node = new ItemSourceNode(value, this);
 									children.Insert(start + i, node);
+									if (childVisibleNodesBuilt)
+									{
+										node->visibleNodeHandle = childVisibleNodes.Insert(start + i, node->CalculateTotalVisibleNodes());
+									}
 								}
+								UpdateTotalVisibleNodes();
 								callback->OnAfterItemModified(this, start, oldCount, newCount);
 							});
 							childrenVirtualList = ol;
@@ -656,6 +670,49 @@ GuiBindableTreeView::ItemSourceNode
 					node->UnprepareChildren();
 				}
 				children.Clear();
+				childVisibleNodes.Clear();
+				childVisibleNodesBuilt = false;
+			}
+
+			void GuiBindableTreeView::ItemSourceNode::EnsureChildVisibleNodes()
+			{
+				PrepareChildren();
+				if (!childVisibleNodesBuilt)
+				{
+					for (vint i = 0; i < children.Count(); i++)
+					{
+						children[i]->visibleNodeHandle = childVisibleNodes.Insert(i, children[i]->CalculateTotalVisibleNodes());
+					}
+					childVisibleNodesBuilt = true;
+				}
+			}
+
+			void GuiBindableTreeView::ItemSourceNode::UpdateTotalVisibleNodes()
+			{
+				// when the cached value is unknown, no parent node has counted this node yet
+				vint oldCount = totalVisibleNodeCount;
+				totalVisibleNodeCount = -1;
+				vint newCount = CalculateTotalVisibleNodes();
+				if (parent && oldCount != -1 && oldCount != newCount)
+				{
+					parent->OnChildTotalVisibleNodesChanged(visibleNodeHandle, newCount - oldCount);
+				}
+			}
+
+			void GuiBindableTreeView::ItemSourceNode::OnChildTotalVisibleNodesChanged(vint handle, vint offset)
+			{
+				if (childVisibleNodesBuilt)
+				{
+					childVisibleNodes.Update(handle, offset);
+				}
+				if (totalVisibleNodeCount != -1 && GetExpanding())
+				{
+					totalVisibleNodeCount += offset;
+					if (parent)
+					{
+						parent->OnChildTotalVisibleNodesChanged(visibleNodeHandle, offset);
+					}
+				}
 			}
 
 			GuiBindableTreeView::ItemSourceNode::ItemSourceNode(const description::Value& _itemSource, ItemSourceNode* _parent)
@@ -687,11 +744,49 @@ GuiBindableTreeView::ItemSourceNode
 				vint oldCount = GetChildCount();
 				UnprepareChildren();
 				itemSource = _itemSource;
+				UpdateTotalVisibleNodes();
 				vint newCount = GetChildCount();
 				callback->OnBeforeItemModified(this, 0, oldCount, newCount);
 				callback->OnAfterItemModified(this, 0, oldCount, newCount);
 			}
 
+			vint GuiBindableTreeView::ItemSourceNode::CalculateVisibleIndex()
+			{
+				if (!parent)
+				{
+					return 0;
+				}
+				if (!parent->GetExpanding())
+				{
+					return -1;
+				}
+
+				vint index = parent->CalculateVisibleIndex();
+				if (index == -1)
+				{
+					return -1;
+				}
+				parent->EnsureChildVisibleNodes();
+				return index + 1 + parent->childVisibleNodes.GetOffset(visibleNodeHandle);
+			}
+
+			GuiBindableTreeView::ItemSourceNode* GuiBindableTreeView::ItemSourceNode::GetVisibleNode(vint offset)
+			{
+				if (offset == 0)
+				{
+					return this;
+				}
+				if (offset < 0 || offset >= CalculateTotalVisibleNodes())
+				{
+					return nullptr;
+				}
+
+				offset -= 1;
+				EnsureChildVisibleNodes();
+				vint index = childVisibleNodes.FindSubNode(offset);
+				return children[index]->GetVisibleNode(offset);
+			}
+
 			bool GuiBindableTreeView::ItemSourceNode::GetExpanding()
 			{
 				return this == rootProvider->rootNode.Obj() ? true : expanding;
@@ -702,6 +797,7 @@ GuiBindableTreeView::ItemSourceNode
 				if (this != rootProvider->rootNode.Obj() && expanding != value)
 				{
 					expanding = value;
+					UpdateTotalVisibleNodes();
 					if (expanding)
 					{
 						callback->OnItemExpanded(this);
@@ -715,18 +811,19 @@ GuiBindableTreeView::ItemSourceNode
 
 			vint GuiBindableTreeView::ItemSourceNode::CalculateTotalVisibleNodes()
 			{
-				if (!GetExpanding())
-				{
-					return 1;
-				}
-
-				PrepareChildren();
-				vint count = 1;
-				FOREACH(Ptr<ItemSourceNode>, child, children)
+				if (totalVisibleNodeCount == -1)
 				{
-					count += child->CalculateTotalVisibleNodes();
+					if (GetExpanding())
+					{
+						EnsureChildVisibleNodes();
+						totalVisibleNodeCount = 1 + childVisibleNodes.GetTotalCount();
+					}
+					else
+					{
+						totalVisibleNodeCount = 1;
+					}
 				}
-				return count;
+				return totalVisibleNodeCount;
 			}
 
 			vint GuiBindableTreeView::ItemSourceNode::GetChildCount()
@@ -787,6 +884,7 @@ GuiBindableTreeView::ItemSource
 				if (updateChildrenProperty)
 				{
 					rootNode->UnprepareChildren();
+					rootNode->UpdateTotalVisibleNodes();
 				}
 				vint newCount = rootNode->GetChildCount();
 				OnBeforeItemModified(rootNode.Obj(), 0, oldCount, newCount);
@@ -800,6 +898,28 @@ GuiBindableTreeView::ItemSource
 				return rootNode.Obj();
 			}
 
+			bool GuiBindableTreeView::ItemSource::CanGetNodeByVisibleIndex()
+			{
+				return true;
+			}
+
+			tree::INodeProvider* GuiBindableTreeView::ItemSource::GetNodeByVisibleIndex(vint index)
+			{
+				return rootNode->GetVisibleNode(index);
+			}
+
+			vint GuiBindableTreeView::ItemSource::GetVisibleIndexByNode(tree::INodeProvider* node)
+			{
+				if (auto itemSourceNode = dynamic_cast<ItemSourceNode*>(node))
+				{
+					if (itemSourceNode->rootProvider == this)
+					{
+						return itemSourceNode->CalculateVisibleIndex();
+					}
+				}
+				return -1;
+			}
+
 			WString GuiBindableTreeView::ItemSource::GetTextValue(tree::INodeProvider* node)
 			{
 				return ReadProperty(GetBindingValue(node), textProperty);
@@ -309,13 +309,20 @@ GuiBindableTreeView
 					ItemSourceNode*									parent;
 					tree::INodeProviderCallback*					callback;
 					bool											expanding = false;
+					vint											totalVisibleNodeCount = -1;
+					vint											visibleNodeHandle = -1;
+					bool											childVisibleNodesBuilt = false;
 
 					Ptr<EventHandler>								itemChangedEventHandler;
 					Ptr<description::IValueReadonlyList>			childrenVirtualList;
 					NodeList										children;
+					tree::VisibleNodeCountTree						childVisibleNodes;
 
 					void											PrepareChildren();
 					void											UnprepareChildren();
+					void											EnsureChildVisibleNodes();
+					void											UpdateTotalVisibleNodes();
+					void											OnChildTotalVisibleNodesChanged(vint handle, vint offset);
 				public:
 					ItemSourceNode(const description::Value& _itemSource, ItemSourceNode* _parent);
 					ItemSourceNode(ItemSource* _rootProvider);
@@ -323,6 +330,8 @@ GuiBindableTreeView
 
 					description::Value								GetItemSource();
 					void											SetItemSource(const description::Value& _itemSource);
+					vint											CalculateVisibleIndex();
+					ItemSourceNode*									GetVisibleNode(vint offset);
 
 					// ===================== tree::INodeProvider =====================
 
@@ -360,6 +369,9 @@ GuiBindableTreeView
 					// ===================== tree::INodeRootProvider =====================
 
 					tree::INodeProvider*							GetRootNode()override;
+					bool											CanGetNodeByVisibleIndex()override;
+					tree::INodeProvider*							GetNodeByVisibleIndex(vint index)override;
+					vint											GetVisibleIndexByNode(tree::INodeProvider* node)override;
 					WString											GetTextValue(tree::INodeProvider* node)override;
 					description::Value								GetBindingValue(tree::INodeProvider* node)override;
 					IDescriptable*									RequestView(const WString& identifier)override;
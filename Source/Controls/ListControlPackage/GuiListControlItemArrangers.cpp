@@ -63,10 +63,11 @@ RangedItemArrangerBase
 					if (backgroundButton)
 					{
 						itemStyle->SetAlignmentToParent(Margin(0, 0, 0, 0));
-						itemStyle->SelectedChanged.AttachLambda([=](GuiGraphicsComposition* sender, GuiEventArgs& arguments)
+						auto handler = itemStyle->SelectedChanged.AttachLambda([=](GuiGraphicsComposition* sender, GuiEventArgs& arguments)
 						{
 							backgroundButton->SetSelected(itemStyle->GetSelected());
 						});
+						selectedChangedHandlers.Add(itemStyle, handler);
 						backgroundButton->GetContainerComposition()->AddChild(itemStyle);
 					}
 					return { itemStyle, backgroundButton };
@@ -74,6 +75,13 @@ RangedItemArrangerBase
 
 				void RangedItemArrangerBase::DeleteStyle(ItemStyleRecord style)
 				{
+					// the item style could be reused after released, so it should not keep referencing the deleted background button
+					vint index = selectedChangedHandlers.Keys().IndexOf(style.key);
+					if (index != -1)
+					{
+						style.key->SelectedChanged.Detach(selectedChangedHandlers.Values()[index]);
+						selectedChangedHandlers.Remove(style.key);
+					}
 					callback->ReleaseItem(style.key);
 					if (style.value)
 					{
@@ -910,6 +918,254 @@ FixedHeightMultiColumnItemArranger
 					}
 					return expectedSize;
 				}
+
+/***********************************************************************
+VariableHeightItemArranger
+***********************************************************************/
+
+				vint VariableHeightItemArranger::GetItemCount()
+				{
+					return itemHeights.Count();
+				}
+
+				vint VariableHeightItemArranger::GetEstimatedHeight()
+				{
+					auto total = itemHeights.GetTotal();
+					return total.measuredCount == 0 ? 1 : (total.height + total.measuredCount / 2) / total.measuredCount;
+				}
+
+				vint VariableHeightItemArranger::GetMeasuredHeight(vint index)
+				{
+					vint handle = itemHeights.GetHandle(index);
+					return handle == -1 ? 0 : itemHeights.Get(handle).height;
+				}
+
+				vint VariableHeightItemArranger::GetItemHeight(vint index)
+				{
+					vint height = GetMeasuredHeight(index);
+					return height == 0 ? GetEstimatedHeight() : height;
+				}
+
+				vint VariableHeightItemArranger::GetItemTop(vint index)
+				{
+					auto sum = itemHeights.GetSum(index);
+					return sum.height + (index - sum.measuredCount) * GetEstimatedHeight();
+				}
+
+				vint VariableHeightItemArranger::GetItemFromPosition(vint position)
+				{
+					vint itemCount = GetItemCount();
+					if (itemCount == 0 || position <= 0) return 0;
+
+					// unmeasured items take the estimated height
+					vint estimatedHeight = GetEstimatedHeight();
+					vint index = 0;
+					ItemHeight before;
+					vint handle = itemHeights.Find([=](vint count, const ItemHeight& sum)
+					{
+						return position < sum.height + (count - sum.measuredCount) * estimatedHeight;
+					}, index, before);
+					return handle == -1 ? itemCount - 1 : index;
+				}
+
+				void VariableHeightItemArranger::SetItemHeight(vint index, vint height)
+				{
+					vint handle = itemHeights.GetHandle(index);
+					if (itemHeights.Get(handle).height != height)
+					{
+						ItemHeight value;
+						value.height = height;
+						value.measuredCount = height == 0 ? 0 : 1;
+						itemHeights.Set(handle, value);
+					}
+				}
+
+				void VariableHeightItemArranger::BeginPlaceItem(bool forMoving, Rect newBounds, vint& newStartIndex)
+				{
+					if (forMoving)
+					{
+						newStartIndex = GetItemFromPosition(newBounds.Top());
+						pim_startTop = GetItemTop(newStartIndex);
+						pim_heightChanged = false;
+					}
+				}
+
+				void VariableHeightItemArranger::PlaceItem(bool forMoving, vint index, ItemStyleRecord style, Rect viewBounds, Rect& bounds, Margin& alignmentToParent)
+				{
+					if (forMoving)
+					{
+						vint styleHeight = callback->GetStylePreferredSize(GetStyleBounds(style)).y;
+						if (styleHeight < 1) styleHeight = 1;
+						if (GetMeasuredHeight(index) != styleHeight)
+						{
+							SetItemHeight(index, styleHeight);
+							pim_heightChanged = true;
+						}
+					}
+					alignmentToParent = Margin(0, -1, 0, -1);
+					bounds = Rect(Point(0, GetItemTop(index)), Size(0, GetItemHeight(index)));
+				}
+
+				bool VariableHeightItemArranger::IsItemOutOfViewBounds(vint index, ItemStyleRecord style, Rect bounds, Rect viewBounds)
+				{
+					return bounds.Top() >= viewBounds.Bottom();
+				}
+
+				bool VariableHeightItemArranger::EndPlaceItem(bool forMoving, Rect newBounds, vint newStartIndex)
+				{
+					if (forMoving)
+					{
+						// changing the estimated height moves all items, keep the first visible item at the same place in the view
+						vint startTop = GetItemTop(newStartIndex);
+						if (startTop != pim_startTop)
+						{
+							callback->SetViewLocation(Point(0, newBounds.Top() + startTop - pim_startTop));
+							return true;
+						}
+						return pim_heightChanged;
+					}
+					return false;
+				}
+
+				void VariableHeightItemArranger::InvalidateItemSizeCache()
+				{
+					vint count = itemHeights.Count();
+					itemHeights.Clear();
+					itemHeights.InsertRange(0, count, {});
+				}
+
+				Size VariableHeightItemArranger::OnCalculateTotalSize()
+				{
+					return Size(0, GetItemTop(GetItemCount()));
+				}
+
+				VariableHeightItemArranger::VariableHeightItemArranger()
+				{
+				}
+
+				VariableHeightItemArranger::~VariableHeightItemArranger()
+				{
+				}
+
+				void VariableHeightItemArranger::OnAttached(GuiListControl::IItemProvider* provider)
+				{
+					itemHeights.Clear();
+					RangedItemArrangerBase::OnAttached(provider);
+				}
+
+				void VariableHeightItemArranger::OnItemModified(vint start, vint count, vint newCount)
+				{
+					if (count == newCount)
+					{
+						for (vint i = 0; i < count; i++)
+						{
+							SetItemHeight(start + i, 0);
+						}
+					}
+					else
+					{
+						// cut out modified items and splice in new unmeasured items, this is O((count + newCount) * log n)
+						itemHeights.RemoveRange(start, count);
+						itemHeights.InsertRange(start, newCount, {});
+					}
+					RangedItemArrangerBase::OnItemModified(start, count, newCount);
+				}
+
+				vint VariableHeightItemArranger::FindItem(vint itemIndex, compositions::KeyDirection key)
+				{
+					vint count = itemProvider->Count();
+					if (count == 0) return -1;
+					switch (key)
+					{
+					case KeyDirection::Up:
+						itemIndex--;
+						break;
+					case KeyDirection::Down:
+						itemIndex++;
+						break;
+					case KeyDirection::Home:
+						itemIndex = 0;
+						break;
+					case KeyDirection::End:
+						itemIndex = count;
+						break;
+					case KeyDirection::PageUp:
+						{
+							vint newIndex = GetItemFromPosition(GetItemTop(itemIndex) - viewBounds.Height());
+							itemIndex = newIndex < itemIndex ? newIndex : itemIndex - 1;
+						}
+						break;
+					case KeyDirection::PageDown:
+						{
+							vint newIndex = GetItemFromPosition(GetItemTop(itemIndex) + viewBounds.Height());
+							itemIndex = newIndex > itemIndex ? newIndex : itemIndex + 1;
+						}
+						break;
+					default:
+						return -1;
+					}
+
+					if (itemIndex < 0) return 0;
+					else if (itemIndex >= count) return count - 1;
+					else return itemIndex;
+				}
+
+				bool VariableHeightItemArranger::EnsureItemVisible(vint itemIndex)
+				{
+					if (callback)
+					{
+						if (itemIndex < 0 || itemIndex >= itemProvider->Count())
+						{
+							return false;
+						}
+						while (true)
+						{
+							vint top = GetItemTop(itemIndex);
+							vint bottom = top + GetItemHeight(itemIndex);
+
+							if (viewBounds.Height() < bottom - top)
+							{
+								if (viewBounds.Top() < bottom && top < viewBounds.Bottom())
+								{
+									break;
+								}
+							}
+
+							Point location = viewBounds.LeftTop();
+							if (top < viewBounds.Top())
+							{
+								location.y = top;
+							}
+							else if (viewBounds.Bottom() < bottom)
+							{
+								location.y = bottom - viewBounds.Height();
+							}
+							else
+							{
+								break;
+							}
+
+							Rect oldBounds = viewBounds;
+							callback->SetViewLocation(location);
+							if (viewBounds == oldBounds)
+							{
+								break;
+							}
+						}
+						return true;
+					}
+					return false;
+				}
+
+				Size VariableHeightItemArranger::GetAdoptedSize(Size expectedSize)
+				{
+					if (itemProvider)
+					{
+						vint count = itemProvider->Count();
+						return Size(expectedSize.x, CalculateAdoptedSize(expectedSize.y, count, GetEstimatedHeight()));
+					}
+					return expectedSize;
+				}
 			}
 		}
 	}
@@ -10,6 +10,7 @@ Interfaces:
 #define VCZH_PRESENTATION_CONTROLS_GUILISTCONTROLITEMARRANGERS
 
 #include "GuiListControls.h"
+#include "../../GuiImplicitTreap.h"
 
 namespace vl
 {
@@ -30,6 +31,7 @@ Predefined ItemArranger
 				protected:
 					using ItemStyleRecord = collections::Pair<GuiListControl::ItemStyle*, GuiSelectableButton*>;
 					typedef collections::List<ItemStyleRecord>	StyleList;
+					typedef collections::Dictionary<GuiListControl::ItemStyle*, Ptr<compositions::IGuiGraphicsEventHandler>>	SelectedChangedHandlerMap;
 
 					GuiListControl*								listControl = nullptr;
 					GuiListControl::IItemArrangerCallback*		callback = nullptr;
@@ -39,6 +41,7 @@ Predefined ItemArranger
 					Rect										viewBounds;
 					vint										startIndex = 0;
 					StyleList									visibleStyles;
+					SelectedChangedHandlerMap					selectedChangedHandlers;
 
 				protected:
 
@@ -159,6 +162,57 @@ Predefined ItemArranger
 					bool										EnsureItemVisible(vint itemIndex)override;
 					Size										GetAdoptedSize(Size expectedSize)override;
 				};
+
+				/// <summary>Variable height item arranger. This arranger lists all items in one column, each item uses its own minimum height. Items are measured when they are displayed, heights of other items are estimated using the average height of all measured items.</summary>
+				class VariableHeightItemArranger : public RangedItemArrangerBase, public Description<VariableHeightItemArranger>
+				{
+				protected:
+					/// <summary>The measured height of an item, or the sum of measured heights of items. An item is not measured when its height is 0.</summary>
+					struct ItemHeight
+					{
+						vint									height = 0;
+						vint									measuredCount = 0;
+
+						ItemHeight operator+(const ItemHeight& value)const
+						{
+							ItemHeight result;
+							result.height = height + value.height;
+							result.measuredCount = measuredCount + value.measuredCount;
+							return result;
+						}
+					};
+				private:
+					vint										pim_startTop = 0;
+					bool										pim_heightChanged = false;
+
+				protected:
+					ImplicitTreap<ItemHeight>					itemHeights;
+
+					vint										GetItemCount();
+					vint										GetEstimatedHeight();
+					vint										GetMeasuredHeight(vint index);
+					vint										GetItemHeight(vint index);
+					vint										GetItemTop(vint index);
+					vint										GetItemFromPosition(vint position);
+					void										SetItemHeight(vint index, vint height);
+
+					void										BeginPlaceItem(bool forMoving, Rect newBounds, vint& newStartIndex)override;
+					void										PlaceItem(bool forMoving, vint index, ItemStyleRecord style, Rect viewBounds, Rect& bounds, Margin& alignmentToParent)override;
+					bool										IsItemOutOfViewBounds(vint index, ItemStyleRecord style, Rect bounds, Rect viewBounds)override;
+					bool										EndPlaceItem(bool forMoving, Rect newBounds, vint newStartIndex)override;
+					void										InvalidateItemSizeCache()override;
+					Size										OnCalculateTotalSize()override;
+				public:
+					/// <summary>Create the arranger.</summary>
+					VariableHeightItemArranger();
+					~VariableHeightItemArranger();
+
+					void										OnAttached(GuiListControl::IItemProvider* provider)override;
+					void										OnItemModified(vint start, vint count, vint newCount)override;
+					vint										FindItem(vint itemIndex, compositions::KeyDirection key)override;
+					bool										EnsureItemVisible(vint itemIndex)override;
+					Size										GetAdoptedSize(Size expectedSize)override;
+				};
 			}
 		}
 	}
@@ -28,7 +28,10 @@ GuiListControl::ItemCallback
 				auto style = installedStyles.Keys()[index];
 				auto handler = installedStyles.Values()[index];
 				listControl->OnStyleUninstalled(style);
-				listControl->GetContainerComposition()->RemoveChild(style);
+				if (auto parent = style->GetParent())
+				{
+					parent->RemoveChild(style);
+				}
 				style->BoundsChanged.Detach(handler);
 				return style;
 			}
@@ -56,6 +59,44 @@ GuiListControl::ItemCallback
 					SafeDeleteComposition(style);
 				}
 				installedStyles.Clear();
+
+				ShrinkCache(0);
+				templateTypes.Clear();
+			}
+
+			void GuiListControl::ItemCallback::ShrinkCache(vint capacity)
+			{
+				while (reusableStyleCount > capacity)
+				{
+					auto& styles = reusableStyles.GetByIndex(reusableStyles.Count() - 1);
+					auto style = styles[styles.Count() - 1];
+					reusableStyles.Remove(reusableStyles.Keys()[reusableStyles.Count() - 1], style);
+					reusableStyleCount--;
+					SafeDeleteComposition(style);
+				}
+			}
+
+			GuiListControl::ItemStyle* GuiListControl::ItemCallback::TakeReusableStyle(const reflection::description::Value& value)
+			{
+#ifdef VCZH_DEBUG_NO_REFLECTION
+				// without type information, the template that the item template property would create cannot be predicted
+				return nullptr;
+#else
+				// an item template property chooses a factory by the type of the item, and all templates from a factory share the same type
+				// so the pool is searched by the template type that the item template property created for this type of item before
+				vint templateIndex = templateTypes.Keys().IndexOf(value.GetTypeDescriptor());
+				if (templateIndex == -1) return nullptr;
+				auto templateType = templateTypes.Values()[templateIndex];
+				if (!templateType) return nullptr;
+
+				vint poolIndex = reusableStyles.Keys().IndexOf(templateType);
+				if (poolIndex == -1) return nullptr;
+				auto& styles = reusableStyles.GetByIndex(poolIndex);
+				auto style = styles[styles.Count() - 1];
+				reusableStyles.Remove(templateType, style);
+				reusableStyleCount--;
+				return style;
+#endif
 			}
 
 			void GuiListControl::ItemCallback::OnAttached(IItemProvider* provider)
@@ -73,7 +114,28 @@ GuiListControl::ItemCallback
 				CHECK_ERROR(0 <= itemIndex && itemIndex < itemProvider->Count(), L"GuiListControl::ItemCallback::RequestItem(vint)#Index out of range.");
 				CHECK_ERROR(listControl->itemStyleProperty, L"GuiListControl::ItemCallback::RequestItem(vint)#SetItemTemplate function should be called before adding items to the list control.");
 
-				auto style = listControl->itemStyleProperty(itemProvider->GetBindingValue(itemIndex));
+				auto value = itemProvider->GetBindingValue(itemIndex);
+				auto style = TakeReusableStyle(value);
+				if (!style)
+				{
+					style = listControl->itemStyleProperty(value);
+#ifndef VCZH_DEBUG_NO_REFLECTION
+					if (auto valueType = value.GetTypeDescriptor())
+					{
+						auto templateType = style->GetTypeDescriptor();
+						vint templateIndex = templateTypes.Keys().IndexOf(valueType);
+						if (templateIndex == -1)
+						{
+							templateTypes.Add(valueType, templateType);
+						}
+						else if (templateTypes.Values()[templateIndex] != templateType)
+						{
+							// the item template property does not choose factories only by the type of the item, so templates are not reused for this type
+							templateTypes.Set(valueType, nullptr);
+						}
+					}
+#endif
+				}
 				auto handler = InstallStyle(style, itemIndex, itemComposition);
 				installedStyles.Add(style, handler);
 				return style;
@@ -86,7 +148,17 @@ GuiListControl::ItemCallback
 				{
 					auto style = UninstallStyle(index);
 					installedStyles.Remove(style);
-					SafeDeleteComposition(style);
+#ifndef VCZH_DEBUG_NO_REFLECTION
+					if (style->GetReusable() && reusableStyleCount < listControl->itemTemplatePoolCapacity)
+					{
+						reusableStyles.Add(style->GetTypeDescriptor(), style);
+						reusableStyleCount++;
+					}
+					else
+#endif
+					{
+						SafeDeleteComposition(style);
+					}
 				}
 			}
 
@@ -503,6 +575,21 @@ GuiListControl
 				}
 			}
 
+			vint GuiListControl::GetItemTemplatePoolCapacity()
+			{
+				return itemTemplatePoolCapacity;
+			}
+
+			void GuiListControl::SetItemTemplatePoolCapacity(vint value)
+			{
+				if (value < 0) value = 0;
+				if (itemTemplatePoolCapacity != value)
+				{
+					itemTemplatePoolCapacity = value;
+					callback->ShrinkCache(value);
+				}
+			}
+
 /***********************************************************************
 GuiSelectableListControl
 ***********************************************************************/
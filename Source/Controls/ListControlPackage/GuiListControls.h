@@ -198,10 +198,18 @@ List Control
 					typedef compositions::IGuiGraphicsEventHandler							BoundsChangedHandler;
 					typedef collections::List<ItemStyle*>									StyleList;
 					typedef collections::Dictionary<ItemStyle*, Ptr<BoundsChangedHandler>>	InstalledStyleMap;
+					typedef reflection::description::ITypeDescriptor						TypeDescriptor;
+					typedef collections::Dictionary<TypeDescriptor*, TypeDescriptor*>		TemplateTypeMap;
+					typedef collections::Group<TypeDescriptor*, ItemStyle*>					StylePool;
 				protected:
 					GuiListControl*								listControl = nullptr;
 					IItemProvider*								itemProvider = nullptr;
 					InstalledStyleMap							installedStyles;
+					StylePool									reusableStyles;
+					vint										reusableStyleCount = 0;
+					TemplateTypeMap								templateTypes;
+
+					ItemStyle*									TakeReusableStyle(const reflection::description::Value& value);
 
 					Ptr<BoundsChangedHandler>					InstallStyle(ItemStyle* style, vint itemIndex, compositions::GuiBoundsComposition* itemComposition);
 					ItemStyle*									UninstallStyle(vint index);
@@ -211,6 +219,7 @@ List Control
 					~ItemCallback();
 
 					void										ClearCache();
+					void										ShrinkCache(vint capacity);
 
 					void										OnAttached(IItemProvider* provider)override;
 					void										OnItemModified(vint start, vint count, vint newCount)override;
@@ -236,6 +245,7 @@ List Control
 				Ptr<compositions::IGuiAxis>						axis;
 				Size											fullSize;
 				bool											displayItemBackground = true;
+				vint											itemTemplatePoolCapacity = 64;
 
 				virtual void									OnItemModified(vint start, vint count, vint newCount);
 				virtual void									OnStyleInstalled(vint itemIndex, ItemStyle* style);
@@ -360,6 +370,12 @@ List Control
 				/// <summary>Set if the list control displays predefined item background.</summary>
 				/// <param name="value">Set to true to display item background.</param>
 				void											SetDisplayItemBackground(bool value);
+				/// <summary>Get the maximum number of released item templates that are kept for new items. Only item templates with the Reusable property set to true are kept.</summary>
+				/// <returns>The maximum number of kept item templates.</returns>
+				vint											GetItemTemplatePoolCapacity();
+				/// <summary>Set the maximum number of released item templates that are kept for new items. Set to 0 to always create new item templates.</summary>
+				/// <param name="value">The maximum number of kept item templates.</param>
+				void											SetItemTemplatePoolCapacity(vint value);
 			};
 
 /***********************************************************************
@@ -123,6 +123,7 @@ DefaultTextListItemTemplate
 
 				DefaultTextListItemTemplate::DefaultTextListItemTemplate()
 				{
+					SetReusable(true);
 				}
 
 				DefaultTextListItemTemplate::~DefaultTextListItemTemplate()
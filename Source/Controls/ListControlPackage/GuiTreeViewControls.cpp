@@ -16,6 +16,50 @@ namespace vl
 			{
 				const wchar_t* const INodeItemView::Identifier = L"vl::presentation::controls::tree::INodeItemView";
 
+/***********************************************************************
+INodeRootProvider
+***********************************************************************/
+
+				vint INodeRootProvider::GetVisibleIndexByNode(INodeProvider* node)
+				{
+					INodeProvider* parent = node->GetParent();
+					if (parent == 0)
+					{
+						return 0;
+					}
+					if (!parent->GetExpanding())
+					{
+						return -1;
+					}
+
+					vint index = GetVisibleIndexByNode(parent);
+					if (index == -1)
+					{
+						return -1;
+					}
+
+					vint count = parent->GetChildCount();
+					for (vint i = 0; i < count; i++)
+					{
+						INodeProvider* child = parent->GetChild(i);
+						bool findResult = child == node;
+						if (findResult)
+						{
+							index++;
+						}
+						else
+						{
+							index += child->CalculateTotalVisibleNodes();
+						}
+						child->Release();
+						if (findResult)
+						{
+							return index;
+						}
+					}
+					return -1;
+				}
+
 /***********************************************************************
 NodeItemProvider
 ***********************************************************************/
@@ -148,6 +192,12 @@ NodeItemProvider
 
 				vint NodeItemProvider::CalculateNodeVisibilityIndexInternal(INodeProvider* node)
 				{
+					if (root->CanGetNodeByVisibleIndex())
+					{
+						vint index = root->GetVisibleIndexByNode(node);
+						return index == -1 ? -2 : index - 1;
+					}
+
 					INodeProvider* parent = node->GetParent();
 					if (parent == 0)
 					{
@@ -267,6 +317,40 @@ NodeItemProvider
 					}
 				}
 
+/***********************************************************************
+VisibleNodeCountTree
+***********************************************************************/
+
+				void VisibleNodeCountTree::Update(vint handle, vint offset)
+				{
+					Set(handle, Get(handle) + offset);
+				}
+
+				vint VisibleNodeCountTree::GetOffset(vint handle)
+				{
+					return GetSum(GetIndex(handle));
+				}
+
+				vint VisibleNodeCountTree::GetTotalCount()
+				{
+					return GetTotal();
+				}
+
+				vint VisibleNodeCountTree::FindSubNode(vint& offset)
+				{
+					vint target = offset;
+					vint index = 0;
+					vint before = 0;
+					if (Find([=](vint, vint sum) { return target < sum; }, index, before) == -1 && index > 0)
+					{
+						// the visible node is after all sub nodes, it is counted from the last sub node
+						index--;
+						before -= Get(GetHandle(index));
+					}
+					offset -= before;
+					return index;
+				}
+
 /***********************************************************************
 MemoryNodeProvider::NodeCollection
 ***********************************************************************/
@@ -326,11 +410,14 @@ MemoryNodeProvider::NodeCollection
 				void MemoryNodeProvider::NodeCollection::BeforeRemove(vint index, Ptr<MemoryNodeProvider> const& child)
 				{
 					OnBeforeChildModified(index, 1, 0);
+					ownerProvider->childVisibleNodes.Remove(child->visibleNodeHandle);
+					child->visibleNodeHandle = -1;
 					child->parent = 0;
 				}
 
 				void MemoryNodeProvider::NodeCollection::AfterInsert(vint index, Ptr<MemoryNodeProvider> const& child)
 				{
+					child->visibleNodeHandle = ownerProvider->childVisibleNodes.Insert(index, child->totalVisibleNodeCount);
 					OnAfterChildModified(index, 0, 1);
 				}
 
@@ -365,7 +452,11 @@ MemoryNodeProvider
 					totalVisibleNodeCount+=offset;
 					if(parent)
 					{
-						parent->OnChildTotalVisibleNodesChanged(offset);
+						parent->childVisibleNodes.Update(visibleNodeHandle, offset);
+						if(parent->expanding)
+						{
+							parent->OnChildTotalVisibleNodesChanged(offset);
+						}
 					}
 				}
 
@@ -409,6 +500,41 @@ MemoryNodeProvider
 					return children;
 				}
 
+				vint MemoryNodeProvider::CalculateVisibleIndex()
+				{
+					if(!parent)
+					{
+						return 0;
+					}
+					if(!parent->expanding)
+					{
+						return -1;
+					}
+
+					vint index=parent->CalculateVisibleIndex();
+					if(index==-1)
+					{
+						return -1;
+					}
+					return index+1+parent->childVisibleNodes.GetOffset(visibleNodeHandle);
+				}
+
+				MemoryNodeProvider* MemoryNodeProvider::GetVisibleNode(vint offset)
+				{
+					if(offset==0)
+					{
+						return this;
+					}
+					if(!expanding || offset<0 || offset>=totalVisibleNodeCount)
+					{
+						return 0;
+					}
+
+					offset-=1;
+					vint index=childVisibleNodes.FindSubNode(offset);
+					return children[index]->GetVisibleNode(offset);
+				}
+
 				bool MemoryNodeProvider::GetExpanding()
 				{
 					return expanding;
@@ -419,11 +545,7 @@ MemoryNodeProvider
 					if(expanding!=value)
 					{
 						expanding=value;
-						vint offset=0;
-						for(vint i=0;i<childCount;i++)
-						{
-							offset+=children[i]->totalVisibleNodeCount;
-						}
+						vint offset=childVisibleNodes.GetTotalCount();
 
 						OnChildTotalVisibleNodesChanged(expanding?offset:-offset);
 						INodeProviderCallback* proxy=GetCallbackProxyInternal();
@@ -591,6 +713,25 @@ MemoryNodeRootProvider
 					return this;
 				}
 
+				bool MemoryNodeRootProvider::CanGetNodeByVisibleIndex()
+				{
+					return true;
+				}
+
+				INodeProvider* MemoryNodeRootProvider::GetNodeByVisibleIndex(vint index)
+				{
+					return GetVisibleNode(index);
+				}
+
+				vint MemoryNodeRootProvider::GetVisibleIndexByNode(INodeProvider* node)
+				{
+					if(auto memoryNode=GetMemoryNode(node))
+					{
+						return memoryNode->CalculateVisibleIndex();
+					}
+					return -1;
+				}
+
 				MemoryNodeProvider* MemoryNodeRootProvider::GetMemoryNode(INodeProvider* node)
 				{
 					return dynamic_cast<MemoryNodeProvider*>(node);
@@ -1135,6 +1276,7 @@ DefaultTreeItemTemplate
 
 				DefaultTreeItemTemplate::DefaultTreeItemTemplate()
 				{
+					SetReusable(true);
 				}
 
 				DefaultTreeItemTemplate::~DefaultTreeItemTemplate()
@@ -10,6 +10,7 @@ Interfaces:
 #define VCZH_PRESENTATION_CONTROLS_GUITREEVIEWCONTROLS
 
 #include "GuiListControls.h"
+#include "../../GuiImplicitTreap.h"
 
 namespace vl
 {
@@ -106,6 +107,10 @@ NodeItemProvider
 					/// <returns>The node for the index in all visible nodes.</returns>
 					/// <param name="index">The index in all visible nodes.</param>
 					virtual INodeProvider*			GetNodeByVisibleIndex(vint index)=0;
+					/// <summary>Get the index in all visible nodes of a node. It is called when [M:vl.presentation.controls.tree.INodeRootProvider.CanGetNodeByVisibleIndex] returns true. The default implementation visits all ancestors and their previous siblings, override it to provide an optimized algorithm.</summary>
+					/// <returns>The index in all visible nodes, the root node is 0. Returns -1 if the node is not visible because any parent node is collapsed.</returns>
+					/// <param name="node">The node.</param>
+					virtual vint					GetVisibleIndexByNode(INodeProvider* node);
 					/// <summary>Attach an node provider callback to this node provider.</summary>
 					/// <returns>Returns true if this operation succeeded.</returns>
 					/// <param name="value">The node provider callback.</param>
@@ -201,6 +206,27 @@ MemoryNodeProvider
 
 			namespace tree
 			{
+				/// <summary>Sums of total visible nodes of sub nodes, to convert between indices in all visible nodes and sub nodes in logarithm time. Values are numbers of total visible nodes of sub nodes ordered by sub node indices, each sub node is identified by a handle which does not change when other sub nodes are inserted or removed.</summary>
+				class VisibleNodeCountTree : public ImplicitTreap<vint>
+				{
+				public:
+					/// <summary>Update the number of total visible nodes of a sub node.</summary>
+					/// <param name="handle">The handle of the sub node.</param>
+					/// <param name="offset">The difference of the number of total visible nodes.</param>
+					void							Update(vint handle, vint offset);
+					/// <summary>Get the number of total visible nodes of all sub nodes before a sub node.</summary>
+					/// <returns>The number of total visible nodes.</returns>
+					/// <param name="handle">The handle of the sub node.</param>
+					vint							GetOffset(vint handle);
+					/// <summary>Get the number of total visible nodes of all sub nodes.</summary>
+					/// <returns>The number of total visible nodes.</returns>
+					vint							GetTotalCount();
+					/// <summary>Find the sub node that contains a visible node.</summary>
+					/// <returns>The index of the sub node.</returns>
+					/// <param name="offset">The index of the visible node in all total visible nodes of all sub nodes. It becomes the index of the visible node in total visible nodes of the found sub node.</param>
+					vint							FindSubNode(vint& offset);
+				};
+
 				/// <summary>An in-memory <see cref="INodeProvider"/> implementation.</summary>
 				class MemoryNodeProvider
 					: public Object
@@ -236,8 +262,10 @@ MemoryNodeProvider
 					bool							expanding = false;
 					vint							childCount = 0;
 					vint							totalVisibleNodeCount = 1;
+					vint							visibleNodeHandle = -1;
 					Ptr<DescriptableObject>			data;
 					NodeCollection					children;
+					VisibleNodeCountTree			childVisibleNodes;
 
 					virtual INodeProviderCallback*	GetCallbackProxyInternal();
 					void							OnChildTotalVisibleNodesChanged(vint offset);
@@ -258,6 +286,13 @@ MemoryNodeProvider
 					/// <summary>Get all sub nodes.</summary>
 					/// <returns>All sub nodes.</returns>
 					NodeCollection&					Children();
+					/// <summary>Get the index of this node in all visible nodes from the root node.</summary>
+					/// <returns>The index of this node, the root node is 0. Returns -1 if any parent node is collapsed.</returns>
+					vint							CalculateVisibleIndex();
+					/// <summary>Get a node in total visible nodes of this node.</summary>
+					/// <returns>The node. Returns null if the offset is out of range.</returns>
+					/// <param name="offset">The index in total visible nodes of this node, this node is 0.</param>
+					MemoryNodeProvider*				GetVisibleNode(vint offset);
 
 					bool							GetExpanding()override;
 					void							SetExpanding(bool value)override;
@@ -306,6 +341,9 @@ MemoryNodeProvider
 					~MemoryNodeRootProvider();
 
 					INodeProvider*					GetRootNode()override;
+					bool							CanGetNodeByVisibleIndex()override;
+					INodeProvider*					GetNodeByVisibleIndex(vint index)override;
+					vint							GetVisibleIndexByNode(INodeProvider* node)override;
 					/// <summary>Get the <see cref="MemoryNodeProvider"/> object from an <see cref="INodeProvider"/> object.</summary>
 					/// <returns>The corresponding <see cref="MemoryNodeProvider"/> object.</returns>
 					/// <param name="node">The node to get the memory node.</param>
@@ -8,6 +8,7 @@ namespace vl
 	{
 		namespace controls
 		{
+			using namespace collections;
 			using namespace reflection::description;
 			using namespace compositions;
 
@@ -71,6 +72,28 @@ GuiInstanceRootObject
 					return alive;
 				}
 			};
+
+			class RootObjectBindingCallback : public Object, public IGuiGraphicsTimerCallback
+			{
+			public:
+				GuiInstanceRootObject*			rootObject;
+				bool							alive = true;
+
+				RootObjectBindingCallback(GuiInstanceRootObject* _rootObject)
+					:rootObject(_rootObject)
+				{
+				}
+
+				bool Play()override
+				{
+					if (alive)
+					{
+						rootObject->bindingCallback = nullptr;
+						rootObject->FlushBindings();
+					}
+					return false;
+				}
+			};
 			
 			void GuiInstanceRootObject::InstallTimerCallback(controls::GuiControlHost* controlHost)
 			{
@@ -125,6 +148,97 @@ GuiInstanceRootObject
 				pendingAnimations.Clear();
 			}
 
+			void GuiInstanceRootObject::UninstallBindingCallback()
+			{
+				if (bindingCallback)
+				{
+					bindingCallback->alive = false;
+					bindingCallback = nullptr;
+				}
+			}
+
+			void GuiInstanceRootObject::SortBindings(BindingList& bindings)
+			{
+				auto before = [](const Ptr<PropertyBinding>& a, const Ptr<PropertyBinding>& b)
+				{
+					return a->rank != b->rank ? a->rank < b->rank : a->order < b->order;
+				};
+
+				vint count = bindings.Count();
+				bool sorted = true;
+				for (vint i = 1; i < count && sorted; i++)
+				{
+					sorted = !before(bindings[i], bindings[i - 1]);
+				}
+				if (sorted) return;
+
+				// SortLambda takes the first item as the pivot, which is quadratic for almost sorted bindings, the usual case here, so a merge sort is used
+				Array<Ptr<PropertyBinding>> first, second;
+				CopyFrom(first, bindings);
+				second.Resize(count);
+				auto source = &first;
+				auto target = &second;
+				for (vint width = 1; width < count; width *= 2)
+				{
+					for (vint start = 0; start < count; start += width * 2)
+					{
+						vint middle = start + width < count ? start + width : count;
+						vint end = middle + width < count ? middle + width : count;
+						vint left = start, right = middle;
+						for (vint i = start; i < end; i++)
+						{
+							if (left < middle && (right == end || !before(source->Get(right), source->Get(left))))
+							{
+								target->Set(i, source->Get(left++));
+							}
+							else
+							{
+								target->Set(i, source->Get(right++));
+							}
+						}
+					}
+					auto swap = source;
+					source = target;
+					target = swap;
+				}
+				CopyFrom(bindings, *source);
+			}
+
+			void GuiInstanceRootObject::OnBindingValueChanged(Ptr<PropertyBinding> binding, const description::Value& value)
+			{
+				if (finalized) return;
+				if (!flushingBindings && bindingBatchCounter == 0 && !batchBindings)
+				{
+					binding->callback(value);
+					return;
+				}
+
+				binding->value = value;
+				if (applyingBinding && binding.Obj() != applyingBinding && binding->rank <= applyingBinding->rank && applyingBinding->rank < bindingCount)
+				{
+					// writing the current binding changes this binding, so this binding depends on it
+					binding->rank = applyingBinding->rank + 1;
+				}
+				if (!binding->dirty)
+				{
+					binding->dirty = true;
+					dirtyBindings.Add(binding);
+				}
+
+				if (!flushingBindings && bindingBatchCounter == 0 && !bindingCallback)
+				{
+					if (auto controlHost = GetControlHostForInstance())
+					{
+						bindingCallback = new RootObjectBindingCallback(this);
+						controlHost->GetTimerManager()->AddCallback(bindingCallback);
+					}
+					else
+					{
+						FlushBindings();
+					}
+				}
+			}
+
 			GuiInstanceRootObject::GuiInstanceRootObject()
 			{
 			}
@@ -132,6 +246,7 @@ GuiInstanceRootObject
 			GuiInstanceRootObject::~GuiInstanceRootObject()
 			{
 				UninstallTimerCallback(nullptr);
+				UninstallBindingCallback();
 			}
 
 			void GuiInstanceRootObject::FinalizeInstance()
@@ -150,6 +265,8 @@ GuiInstanceRootObject
 					}
 
 					subscriptions.Clear();
+					dirtyBindings.Clear();
+					UninstallBindingCallback();
 					for (vint i = 0; i<components.Count(); i++)
 					{
 						delete components[i];
@@ -210,20 +327,26 @@ GuiInstanceRootObject
 				return object;
 			}
 
-			Ptr<description::IValueSubscription> GuiInstanceRootObject::AddSubscription(Ptr<description::IValueSubscription> subscription)
+			bool GuiInstanceRootObject::RegisterSubscription(Ptr<description::IValueSubscription> subscription)
 			{
-				CHECK_ERROR(finalized == false, L"GuiInstanceRootObject::AddSubscription(Ptr<IValueSubscription>)#Cannot add subscription after finalizing.");
 				if (subscriptions.Contains(subscription.Obj()))
 				{
-					return nullptr;
+					return false;
 				}
-				else
+				subscriptions.Add(subscription);
+				return true;
+			}
+
+			Ptr<description::IValueSubscription> GuiInstanceRootObject::AddSubscription(Ptr<description::IValueSubscription> subscription)
+			{
+				CHECK_ERROR(finalized == false, L"GuiInstanceRootObject::AddSubscription(Ptr<IValueSubscription>)#Cannot add subscription after finalizing.");
+				if (!RegisterSubscription(subscription))
 				{
-					subscriptions.Add(subscription);
-					subscription->Open();
-					subscription->Update();
-					return subscription;
+					return nullptr;
 				}
+				subscription->Open();
+				subscription->Update();
+				return subscription;
 			}
 
 			void GuiInstanceRootObject::UpdateSubscriptions()
@@ -234,6 +357,87 @@ GuiInstanceRootObject
 				}
 			}
 
+			Ptr<description::IValueSubscription> GuiInstanceRootObject::AddPropertyBinding(Ptr<description::IValueSubscription> subscription, const Func<void(const description::Value&)>& callback)
+			{
+				CHECK_ERROR(finalized == false, L"GuiInstanceRootObject::AddPropertyBinding(Ptr<IValueSubscription>, const Func<void(const Value&)>&)#Cannot add subscription after finalizing.");
+				if (!RegisterSubscription(subscription))
+				{
+					return nullptr;
+				}
+
+				// the handler is attached only to an accepted subscription, and before opening it to receive the initial value
+				auto binding = MakePtr<PropertyBinding>();
+				binding->callback = callback;
+				binding->order = bindingCount++;
+				subscription->ValueChanged.Add([=](const Value& value)
+				{
+					OnBindingValueChanged(binding, value);
+				});
+				subscription->Open();
+				subscription->Update();
+				return subscription;
+			}
+
+			bool GuiInstanceRootObject::GetBatchBindings()
+			{
+				return batchBindings;
+			}
+
+			void GuiInstanceRootObject::SetBatchBindings(bool value)
+			{
+				if (batchBindings != value)
+				{
+					batchBindings = value;
+					if (!batchBindings && bindingBatchCounter == 0)
+					{
+						FlushBindings();
+					}
+				}
+			}
+
+			void GuiInstanceRootObject::BeginBindingBatch()
+			{
+				bindingBatchCounter++;
+			}
+
+			void GuiInstanceRootObject::EndBindingBatch()
+			{
+				CHECK_ERROR(bindingBatchCounter > 0, L"GuiInstanceRootObject::EndBindingBatch()#BeginBindingBatch is not called.");
+				if (--bindingBatchCounter == 0)
+				{
+					FlushBindings();
+				}
+			}
+
+			void GuiInstanceRootObject::FlushBindings()
+			{
+				if (flushingBindings) return;
+				flushingBindings = true;
+				UninstallBindingCallback();
+
+				while (dirtyBindings.Count() > 0)
+				{
+					// bindings changed by writing other bindings are written in the next round
+					BindingList bindings;
+					CopyFrom(bindings, dirtyBindings);
+					dirtyBindings.Clear();
+					SortBindings(bindings);
+
+					for (vint i = 0; i < bindings.Count() && !finalized; i++)
+					{
+						auto binding = bindings[i];
+						auto value = binding->value;
+						binding->value = Value();
+						binding->dirty = false;
+						applyingBinding = binding.Obj();
+						binding->callback(value);
+					}
+				}
+
+				applyingBinding = nullptr;
+				flushingBindings = false;
+			}
+
 			bool GuiInstanceRootObject::AddComponent(GuiComponent* component)
 			{
 				CHECK_ERROR(finalized == false, L"GuiInstanceRootObject::AddComponent(GuiComponent*)#Cannot add component after finalizing.");
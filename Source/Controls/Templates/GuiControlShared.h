@@ -154,13 +154,26 @@ Root Object
 ***********************************************************************/
 
 			class RootObjectTimerCallback;
+			class RootObjectBindingCallback;
 
 			/// <summary>Represnets a root GUI object.</summary>
 			class GuiInstanceRootObject abstract : public Description<GuiInstanceRootObject>
 			{
 				friend class RootObjectTimerCallback;
+				friend class RootObjectBindingCallback;
 				typedef collections::List<Ptr<description::IValueSubscription>>		SubscriptionList;
 			protected:
+				// a property binding whose new value is waiting to be written in a batch
+				struct PropertyBinding
+				{
+					Func<void(const description::Value&)>		callback;
+					description::Value							value;
+					vint										order = 0;
+					vint										rank = 0;
+					bool										dirty = false;
+				};
+				typedef collections::List<Ptr<PropertyBinding>>						BindingList;
+
 				Ptr<GuiResourcePathResolver>					resourceResolver;
 				SubscriptionList								subscriptions;
 				collections::SortedList<GuiComponent*>			components;
@@ -169,11 +182,23 @@ Root Object
 				collections::SortedList<Ptr<IGuiAnimation>>		pendingAnimations;
 				bool											finalized = false;
 
+				BindingList										dirtyBindings;
+				PropertyBinding*								applyingBinding = nullptr;
+				Ptr<RootObjectBindingCallback>					bindingCallback;
+				vint											bindingCount = 0;
+				vint											bindingBatchCounter = 0;
+				bool											batchBindings = false;
+				bool											flushingBindings = false;
+
 				virtual controls::GuiControlHost*				GetControlHostForInstance() = 0;
 				void											InstallTimerCallback(controls::GuiControlHost* controlHost);
 				bool											UninstallTimerCallback(controls::GuiControlHost* controlHost);
 				void											OnControlHostForInstanceChanged();
 				void											StartPendingAnimations();
+				void											UninstallBindingCallback();
+				bool											RegisterSubscription(Ptr<description::IValueSubscription> subscription);
+				static void										SortBindings(BindingList& bindings);
+				void											OnBindingValueChanged(Ptr<PropertyBinding> binding, const description::Value& value);
 			public:
 				GuiInstanceRootObject();
 				~GuiInstanceRootObject();
@@ -206,6 +231,31 @@ Root Object
 				Ptr<description::IValueSubscription>			AddSubscription(Ptr<description::IValueSubscription> subscription);
 				/// <summary>Clear all subscriptions.</summary>
 				void											UpdateSubscriptions();
+				/// <summary>Add a subscription for a property binding. The callback writes a new value to the property. It is called immediately when the value changes, or later if the new value is batched.</summary>
+				/// <returns>Returns null if this operation failed.</returns>
+				/// <param name="subscription">The subscription to add.</param>
+				/// <param name="callback">The callback to write a new value to the property.</param>
+				Ptr<description::IValueSubscription>			AddPropertyBinding(Ptr<description::IValueSubscription> subscription, const Func<void(const description::Value&)>& callback);
+
+				/// <summary>Test if property bindings are batched until the next frame.</summary>
+				/// <returns>Returns true if property bindings are batched until the next frame.</returns>
+				bool											GetBatchBindings();
+				/// <summary>
+				/// Set to true to batch property bindings until the next frame of the window.
+				/// When the root object is not in a window, property bindings are written immediately.
+				/// </summary>
+				/// <param name="value">Set to true to batch property bindings until the next frame.</param>
+				void											SetBatchBindings(bool value);
+				/// <summary>Begin a batch. Property bindings are not written until the outermost batch ends.</summary>
+				void											BeginBindingBatch();
+				/// <summary>End a batch. When the outermost batch ends, all batched property bindings are written.</summary>
+				void											EndBindingBatch();
+				/// <summary>
+				/// Write all batched property bindings.
+				/// Each property binding is written once with the latest value.
+				/// When writing a property binding changes another one, the other one is written after it, and it will be ordered after it in all following batches.
+				/// </summary>
+				void											FlushBindings();
 
 				/// <summary>Add a component. When this control host is disposing, all attached components will be deleted.</summary>
 				/// <returns>Returns true if this operation succeeded.</returns>
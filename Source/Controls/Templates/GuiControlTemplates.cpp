@@ -71,9 +71,12 @@ Item GuiListItemTemplate
 
 			void GuiListItemTemplate::Initialize(controls::GuiListControl* _listControl)
 			{
-				CHECK_ERROR(listControl == nullptr, L"GuiListItemTemplate::Initialize(GuiListControl*)#This function can only be called once.");
-				listControl = _listControl;
-				OnInitialize();
+				CHECK_ERROR(listControl == nullptr || (GetReusable() && listControl == _listControl), L"GuiListItemTemplate::Initialize(GuiListControl*)#This function can only be called once, unless the template is reused by the same list control.");
+				if (listControl == nullptr)
+				{
+					listControl = _listControl;
+					OnInitialize();
+				}
 			}
 
 /***********************************************************************
@@ -148,6 +148,7 @@ GuiListItemTemplate
 #define GuiListItemTemplate_PROPERTIES(F)\
 				F(GuiListItemTemplate, bool, Selected, false)\
 				F(GuiListItemTemplate, vint, Index, 0)\
+				F(GuiListItemTemplate, bool, Reusable, false)\
 
 				GuiListItemTemplate_PROPERTIES(GUI_TEMPLATE_PROPERTY_DECL)
 
@@ -290,6 +291,7 @@ Item Template
 #define GuiListItemTemplate_PROPERTIES(F)\
 				F(GuiListItemTemplate, bool, Selected, false)\
 				F(GuiListItemTemplate, vint, Index, 0)\
+				F(GuiListItemTemplate, bool, Reusable, false)\
 
 #define GuiTextListItemTemplate_PROPERTIES(F)\
 				F(GuiTextListItemTemplate, Color, TextColor, {})\
@@ -62,16 +62,120 @@ GuiTextBoxAutoCompleteBase::TextListControlProvider
 GuiTextBoxAutoCompleteBase
 ***********************************************************************/
 
-			bool GuiTextBoxAutoCompleteBase::IsPrefix(const WString& prefix, const WString& candidate)
+			vint GuiTextBoxAutoCompleteBase::GetMatchScore(vint candidate, const WString& pattern)
 			{
-				if(candidate.Length()>=prefix.Length())
+				const WString& key = candidateKeys[candidate];
+				if (pattern.Length() == 0) return 0;
+				if (key.Length() < pattern.Length()) return -1;
+
+				// match characters greedily, prefer consecutive characters and characters at word starts
+				const wchar_t* text = candidateItems[candidate].text.Buffer();
+				const wchar_t* reading = key.Buffer();
+				vint score = 0;
+				vint position = 0;
+				vint previous = -2;
+				for (vint i = 0; i < pattern.Length(); i++)
 				{
-					if(INVLOC.Compare(prefix, candidate.Sub(0, prefix.Length()), Locale::IgnoreCase)==0)
+					wchar_t c = pattern[i];
+					while (reading[position] && reading[position] != c) position++;
+					if (!reading[position]) return -1;
+
+					score += 1;
+					if (position == previous + 1) score += 5;
+					if (position == 0)
+					{
+						score += 8;
+					}
+					else
+					{
+						// a character is in upper case if lowering it changes it
+						wchar_t before = reading[position - 1];
+						bool beforeUpper = text[position - 1] != before;
+						bool currentUpper = text[position] != reading[position];
+						bool beforeIdentifier = beforeUpper || (L'a' <= before && before <= L'z') || (L'0' <= before && before <= L'9');
+						bool wordStart = !beforeIdentifier || (!beforeUpper && currentUpper);
+						if (wordStart) score += 4;
+					}
+					vint gap = position - previous - 1;
+					if (previous >= 0 && gap > 0) score -= gap < 3 ? gap : 3;
+
+					previous = position;
+					position++;
+				}
+
+				if (wcsncmp(reading, pattern.Buffer(), pattern.Length()) == 0)
+				{
+					score += 100;
+					if (key.Length() == pattern.Length()) score += 50;
+				}
+				return score;
+			}
+
+			void GuiTextBoxAutoCompleteBase::DisplayMatchedCandidates(MatchedCandidates* matched)
+			{
+				const auto& matchedCandidates = matched->candidates;
+				const auto& matchedScores = matched->scores;
+
+				// keep the best matches in a min-heap, the worst one stays at the top
+				auto worse = [&](vint a, vint b)
+				{
+					if (matchedScores[a] != matchedScores[b]) return matchedScores[a] < matchedScores[b];
+					return matchedCandidates[a] > matchedCandidates[b];
+				};
+
+				Array<vint> heap(matchedCandidates.Count() < MaxListItemCount ? matchedCandidates.Count() : MaxListItemCount);
+				vint heapCount = 0;
+				for (vint i = 0; i < matchedCandidates.Count(); i++)
+				{
+					vint current = -1;
+					if (heapCount < heap.Count())
+					{
+						current = heapCount++;
+						while (current > 0 && worse(i, heap[(current - 1) / 2]))
+						{
+							heap[current] = heap[(current - 1) / 2];
+							current = (current - 1) / 2;
+						}
+					}
+					else if (worse(heap[0], i))
+					{
+						current = 0;
+						while (true)
+						{
+							vint child = current * 2 + 1;
+							if (child >= heapCount) break;
+							if (child + 1 < heapCount && worse(heap[child + 1], heap[child])) child++;
+							if (!worse(heap[child], i)) break;
+							heap[current] = heap[child];
+							current = child;
+						}
+					}
+
+					if (current != -1)
 					{
-						return true;
+						heap[current] = i;
 					}
 				}
-				return false;
+
+				List<vint> bestMatches;
+				for (vint i = 0; i < heapCount; i++)
+				{
+					bestMatches.Add(heap[i]);
+				}
+				if (bestMatches.Count() > 0)
+				{
+					SortLambda(&bestMatches[0], bestMatches.Count(), [&](vint a, vint b)
+					{
+						return worse(a, b) ? 1 : worse(b, a) ? -1 : 0;
+					});
+				}
+
+				List<AutoCompleteItem> items;
+				FOREACH(vint, match, bestMatches)
+				{
+					items.Add(candidateItems[matchedCandidates[match]]);
+				}
+				autoCompleteControlProvider->SetSortedContent(items);
 			}
 
 			GuiTextBoxAutoCompleteBase::GuiTextBoxAutoCompleteBase(Ptr<IAutoCompleteControlProvider> _autoCompleteControlProvider)
@@ -183,9 +287,8 @@ GuiTextBoxAutoCompleteBase
 					CloseList();
 				}
 
-				List<AutoCompleteItem> sortedItems;
 				CopyFrom(
-					sortedItems,
+					candidateItems,
 					From(items)
 						.OrderBy([](const AutoCompleteItem& a, const AutoCompleteItem& b)
 						{
@@ -193,7 +296,18 @@ GuiTextBoxAutoCompleteBase
 						})
 					);
 
-				autoCompleteControlProvider->SetSortedContent(sortedItems);
+				auto matched = MakePtr<MatchedCandidates>();
+				candidateKeys.Resize(candidateItems.Count());
+				for (vint i = 0; i < candidateItems.Count(); i++)
+				{
+					candidateKeys[i] = wlower(candidateItems[i].text);
+					matched->candidates.Add(i);
+					matched->scores.Add(0);
+				}
+				matchedHistory.Clear();
+				matchedHistory.Add(matched);
+
+				DisplayMatchedCandidates(matched.Obj());
 				autoCompleteControlProvider->GetAutoCompleteControl()->GetBoundsComposition()->SetPreferredMinSize(Size(200, 200));
 			}
 
@@ -268,48 +382,60 @@ GuiTextBoxAutoCompleteBase
 			{
 				if(IsListOpening())
 				{
-					vint first=0;
-					vint last = autoCompleteControlProvider->GetItemCount() - 1;
-					vint selected=-1;
+					WString pattern = wlower(editingText);
 
-					while (first <= last)
+					// results of patterns that are not a prefix of the new pattern are dropped, so deleting characters returns to a previous result
+					bool changed = false;
+					while (matchedHistory.Count() > 0)
 					{
-						vint middle = (first + last) / 2;
-						WString text = autoCompleteControlProvider->GetItemText(middle);
-						if (IsPrefix(editingText, text))
-						{
-							selected = middle;
-							break;
-						}
+						const WString& previous = matchedHistory[matchedHistory.Count() - 1]->pattern;
+						if (pattern.Length() >= previous.Length() && pattern.Sub(0, previous.Length()) == previous) break;
+						matchedHistory.RemoveAt(matchedHistory.Count() - 1);
+						changed = true;
+					}
 
-						vint result = INVLOC.Compare(editingText, text, Locale::IgnoreCase);
-						if (result <= 0)
+					if (matchedHistory.Count() == 0 || matchedHistory[matchedHistory.Count() - 1]->pattern != pattern)
+					{
+						// a longer pattern only matches candidates that are matched by its prefix, so only previous matches are checked
+						auto matched = MakePtr<MatchedCandidates>();
+						matched->pattern = pattern;
+						auto check = [&](vint candidate)
 						{
-							last = middle - 1;
+							vint score = GetMatchScore(candidate, pattern);
+							if (score >= 0)
+							{
+								matched->candidates.Add(candidate);
+								matched->scores.Add(score);
+							}
+						};
+
+						if (matchedHistory.Count() > 0)
+						{
+							FOREACH(vint, candidate, matchedHistory[matchedHistory.Count() - 1]->candidates)
+							{
+								check(candidate);
+							}
 						}
 						else
 						{
-							first = middle + 1;
+							for (vint i = 0; i < candidateItems.Count(); i++)
+							{
+								check(i);
+							}
 						}
+						matchedHistory.Add(matched);
+						changed = true;
 					}
 
-					while(selected>0)
+					if (changed)
 					{
-						WString text = autoCompleteControlProvider->GetItemText(selected - 1);
-						if (IsPrefix(editingText, text))
-						{
-							selected--;
-						}
-						else
-						{
-							break;
-						}
+						DisplayMatchedCandidates(matchedHistory[matchedHistory.Count() - 1].Obj());
 					}
 
-					if(selected!=-1)
+					if (autoCompleteControlProvider->GetItemCount() > 0)
 					{
-						autoCompleteControlProvider->GetListControl()->SetSelected(selected, true);
-						autoCompleteControlProvider->GetListControl()->EnsureItemVisible(selected);
+						autoCompleteControlProvider->GetListControl()->SetSelected(0, true);
+						autoCompleteControlProvider->GetListControl()->EnsureItemVisible(0);
 					}
 				}
 			}
@@ -79,6 +79,9 @@ GuiTextBoxAutoCompleteBase
 					WString											GetItemText(vint index)override;
 				};
 
+				/// <summary>The maximum number of matched candidate items to display in the list.</summary>
+				static const vint									MaxListItemCount = 100;
+
 			protected:
 				elements::GuiColorizedTextElement*					element;
 				SpinLock*											elementModifyLock;
@@ -87,7 +90,20 @@ GuiTextBoxAutoCompleteBase
 				Ptr<IAutoCompleteControlProvider>					autoCompleteControlProvider;
 				TextPos												autoCompleteStartPosition;
 
-				bool												IsPrefix(const WString& prefix, const WString& candidate);
+				struct MatchedCandidates
+				{
+					WString											pattern;
+					collections::List<vint>							candidates;
+					collections::List<vint>							scores;
+				};
+
+				collections::List<AutoCompleteItem>					candidateItems;
+				collections::Array<WString>							candidateKeys;
+				// each pattern extends the pattern before it, and only matches candidates that are matched before
+				collections::List<Ptr<MatchedCandidates>>			matchedHistory;
+
+				vint												GetMatchScore(vint candidate, const WString& pattern);
+				void												DisplayMatchedCandidates(MatchedCandidates* matched);
 			public:
 				/// <summary>Create an auto complete.</summary>
 				/// <param name="_autoCompleteControlProvider">A auto complete control provider. Set to null to use a default one.</param>
@@ -127,7 +143,7 @@ GuiTextBoxAutoCompleteBase
 				/// <summary>Get the selected item.</summary>
 				/// <returns>The text of the selected item. Returns empty if there is no selected item.</returns>
 				WString												GetSelectedListItem();
-				/// <summary>Highlight a candidate item in the list.</summary>
+				/// <summary>Filter candidate items by the editing text and highlight the best match. Characters of the editing text should appear in a candidate item in order, case insensitively. Prefix and word start matches are ranked higher.</summary>
 				/// <param name="editingText">The text to match an item.</param>
 				void												HighlightList(const WString& editingText);
 			};
@@ -18,49 +18,133 @@ GuiTextBoxColorizerBase
 				GuiTextBoxColorizerBase* colorizer=(GuiTextBoxColorizerBase*)argument;
 				while(!colorizer->isFinalizing)
 				{
-					vint lineIndex=-1;
-					wchar_t* text=0;
-					vuint32_t* colors=0;
-					vint length=0;
+					vint version=-1;
+					vint firstLine=-1;
+					vint lineCount=0;
+					bool speculative=false;
 					vint lexerState=-1;
 					vint contextState=-1;
 
 					SPIN_LOCK(*colorizer->elementModifyLock)
 					{
-						if(colorizer->colorizedLineCount>=colorizer->element->GetLines().GetCount())
+						TextLines& lines=colorizer->element->GetLines();
+						if(colorizer->colorizedLineCount>=lines.GetCount())
 						{
 							colorizer->isColorizerRunning=false;
 							goto CANCEL_COLORIZING;
 						}
+						version=colorizer->colorizingVersion;
 
-						lineIndex=colorizer->colorizedLineCount++;
-						TextLine& line=colorizer->element->GetLines().GetLine(lineIndex);
-						length=line.dataLength;
-						text=new wchar_t[length+2];
-						colors=new vuint32_t[length+2];
-						memcpy(text, line.text, sizeof(wchar_t)*length);
-						text[length]=L'\r';
-						text[length+1]=L'\n';
-						lexerState=lineIndex==0?colorizer->GetLexerStartState():colorizer->element->GetLines().GetLine(lineIndex-1).lexerFinalState;
-						contextState=lineIndex==0?colorizer->GetContextStartState():colorizer->element->GetLines().GetLine(lineIndex-1).contextFinalState;
+						if(colorizer->visibleLinesChanged)
+						{
+							// visible lines that will not be reached soon are colorized with the state of the previous line, before the colorizer arrives there
+							colorizer->visibleLinesChanged=false;
+							vint start=colorizer->visibleLineStart;
+							vint end=start+colorizer->visibleLineCount;
+							if(end>lines.GetCount()) end=lines.GetCount();
+							if(start<colorizer->dirtyLineEnd && end>colorizer->dirtyLineEnd) end=colorizer->dirtyLineEnd;
+							if(colorizer->dirtyLineEnd<=start && start<colorizer->validLineEnd) end=start;
+							colorizer->speculativeLineStart=start;
+							colorizer->speculativeLineEnd=end;
+						}
+
+						if(colorizer->speculativeLineStart>colorizer->colorizedLineCount && colorizer->speculativeLineStart<colorizer->speculativeLineEnd)
+						{
+							speculative=true;
+							firstLine=colorizer->speculativeLineStart;
+						}
+						else
+						{
+							colorizer->speculativeLineEnd=colorizer->speculativeLineStart;
+							firstLine=colorizer->colorizedLineCount;
+						}
+
+						vint lastLine=speculative?colorizer->speculativeLineEnd:lines.GetCount();
+						if(lastLine-firstLine>BatchLineCount) lastLine=firstLine+BatchLineCount;
+
+						vint charCount=0;
+						for(lineCount=0;firstLine+lineCount<lastLine;lineCount++)
+						{
+							vint length=lines.GetLine(firstLine+lineCount).dataLength+2;
+							if(lineCount>0 && charCount+length>BatchCharCount) break;
+							charCount+=length;
+						}
+						if(colorizer->batchText.Count()<charCount)
+						{
+							colorizer->batchText.Resize(charCount);
+							colorizer->batchColors.Resize(charCount);
+						}
+
+						vint offset=0;
+						for(vint i=0;i<lineCount;i++)
+						{
+							TextLine& line=lines.GetLine(firstLine+i);
+							colorizer->batchOffsets[i]=offset;
+							wchar_t* text=&colorizer->batchText[offset];
+							memcpy(text, line.text, sizeof(wchar_t)*line.dataLength);
+							text[line.dataLength]=L'\r';
+							text[line.dataLength+1]=L'\n';
+							offset+=line.dataLength+2;
+						}
+						colorizer->batchOffsets[lineCount]=offset;
+
+						if(firstLine>0)
+						{
+							TextLine& previous=lines.GetLine(firstLine-1);
+							lexerState=previous.lexerFinalState;
+							contextState=previous.contextFinalState;
+						}
+						if(firstLine==0 || (speculative && lexerState==-1))
+						{
+							lexerState=colorizer->GetLexerStartState();
+							contextState=colorizer->GetContextStartState();
+						}
+
+						if(speculative)
+						{
+							colorizer->speculativeLineStart+=lineCount;
+						}
 					}
 
-					colorizer->ColorizeLineWithCRLF(lineIndex, text, colors, length+2, lexerState, contextState);
+					for(vint i=0;i<lineCount;i++)
+					{
+						vint offset=colorizer->batchOffsets[i];
+						vint length=colorizer->batchOffsets[i+1]-offset;
+						colorizer->ColorizeLineWithCRLF(firstLine+i, &colorizer->batchText[offset], &colorizer->batchColors[offset], length, lexerState, contextState);
+						colorizer->batchLexerStates[i]=lexerState;
+						colorizer->batchContextStates[i]=contextState;
+					}
 
 					SPIN_LOCK(*colorizer->elementModifyLock)
 					{
-						if(lineIndex<colorizer->colorizedLineCount && lineIndex<colorizer->element->GetLines().GetCount())
+						if(version==colorizer->colorizingVersion)
 						{
-							TextLine& line=colorizer->element->GetLines().GetLine(lineIndex);
-							line.lexerFinalState=lexerState;
-							line.contextFinalState=contextState;
-							for(vint i=0;i<length;i++)
+							TextLines& lines=colorizer->element->GetLines();
+							for(vint i=0;i<lineCount;i++)
 							{
-								line.att[i].colorIndex=colors[i];
+								vint lineIndex=firstLine+i;
+								TextLine& line=lines.GetLine(lineIndex);
+								vuint32_t* colors=&colorizer->batchColors[colorizer->batchOffsets[i]];
+								for(vint j=0;j<line.dataLength;j++)
+								{
+									line.att[j].colorIndex=colors[j];
+								}
+								if(speculative) continue;
+
+								// the following lines are not changed since the last time they were colorized, stop if this line ends in the same state
+								bool converged
+									=colorizer->dirtyLineEnd<=lineIndex && lineIndex<colorizer->validLineEnd
+									&& line.lexerFinalState==colorizer->batchLexerStates[i]
+									&& line.contextFinalState==colorizer->batchContextStates[i];
+								line.lexerFinalState=colorizer->batchLexerStates[i];
+								line.contextFinalState=colorizer->batchContextStates[i];
+								colorizer->colorizedLineCount=converged?colorizer->validLineEnd:lineIndex+1;
+								if(converged) break;
 							}
+
+							if(colorizer->dirtyLineEnd<colorizer->colorizedLineCount) colorizer->dirtyLineEnd=colorizer->colorizedLineCount;
+							if(colorizer->validLineEnd<colorizer->dirtyLineEnd) colorizer->validLineEnd=colorizer->dirtyLineEnd;
 						}
-						delete[] text;
-						delete[] colors;
 					}
 				}
 			CANCEL_COLORIZING:
@@ -83,6 +167,9 @@ GuiTextBoxColorizerBase
 				colorizerRunningEvent.Enter();
 				colorizerRunningEvent.Leave();
 				colorizedLineCount=0;
+				dirtyLineEnd=0;
+				validLineEnd=0;
+				colorizingVersion++;
 				if(!forever)
 				{
 					isFinalizing=false;
@@ -94,13 +181,45 @@ GuiTextBoxColorizerBase
 				StopColorizer(true);
 			}
 
+			void GuiTextBoxColorizerBase::UpdateVisibleLines()
+			{
+				if(element && elementModifyLock && ownerComposition)
+				{
+					vint rowHeight=element->GetLines().GetRowHeight();
+					if(rowHeight<1) rowHeight=1;
+					vint start=element->GetViewPosition().y/rowHeight;
+					vint count=ownerComposition->GetBounds().Height()/rowHeight+2;
+					SPIN_LOCK(*elementModifyLock)
+					{
+						if(visibleLineStart!=start || visibleLineCount!=count)
+						{
+							visibleLineStart=start;
+							visibleLineCount=count;
+							visibleLinesChanged=true;
+						}
+					}
+				}
+			}
+
 			GuiTextBoxColorizerBase::GuiTextBoxColorizerBase()
 				:element(0)
 				,elementModifyLock(0)
+				,ownerComposition(0)
 				,colorizedLineCount(0)
+				,dirtyLineEnd(0)
+				,validLineEnd(0)
+				,colorizingVersion(0)
 				,isColorizerRunning(false)
 				,isFinalizing(false)
-			{
+				,visibleLineStart(0)
+				,visibleLineCount(0)
+				,visibleLinesChanged(false)
+				,speculativeLineStart(0)
+				,speculativeLineEnd(0)
+			{
+				batchOffsets.Resize(BatchLineCount+1);
+				batchLexerStates.Resize(BatchLineCount);
+				batchContextStates.Resize(BatchLineCount);
 			}
 
 			GuiTextBoxColorizerBase::~GuiTextBoxColorizerBase()
@@ -116,8 +235,11 @@ GuiTextBoxColorizerBase
 					{
 						element=_element;
 						elementModifyLock=&_elementModifyLock;
+						ownerComposition=_ownerComposition;
+						visibleLinesChanged=true;
 						StartColorizer();
 					}
+					UpdateVisibleLines();
 				}
 			}
 
@@ -130,6 +252,7 @@ GuiTextBoxColorizerBase
 					{
 						element=0;
 						elementModifyLock=0;
+						ownerComposition=0;
 					}
 				}
 			}
@@ -148,17 +271,45 @@ GuiTextBoxColorizerBase
 							=arguments.originalStart.row<arguments.originalEnd.row
 							?arguments.originalStart.row
 							:arguments.originalEnd.row;
+						vint originalEnd=arguments.originalEnd.row;
+						vint inputEnd=arguments.inputEnd.row;
+						vint delta=inputEnd-originalEnd;
+
+						// map a line boundary before the edit to the same boundary after the edit
+						auto map=[=](vint row)
+						{
+							return row>originalEnd?row+delta:row>line?inputEnd+1:row;
+						};
+
+						if(line<colorizedLineCount && colorizedLineCount>originalEnd)
+						{
+							// lines between the edit and the end of the colorized part keep their states
+							validLineEnd=colorizedLineCount+delta;
+							dirtyLineEnd=inputEnd+1;
+						}
+						else
+						{
+							vint newDirtyLineEnd=map(dirtyLineEnd);
+							if(newDirtyLineEnd<inputEnd+1) newDirtyLineEnd=inputEnd+1;
+							validLineEnd=map(validLineEnd);
+							dirtyLineEnd=newDirtyLineEnd;
+						}
+						if(validLineEnd<dirtyLineEnd) validLineEnd=dirtyLineEnd;
 						if(colorizedLineCount>line)
 						{
 							colorizedLineCount=line;
 						}
+						colorizingVersion++;
+						visibleLinesChanged=true;
 						StartColorizer();
 					}
+					UpdateVisibleLines();
 				}
 			}
 
 			void GuiTextBoxColorizerBase::TextCaretChanged(const TextCaretChangedStruct& arguments)
 			{
+				UpdateVisibleLines();
 			}
 
 			void GuiTextBoxColorizerBase::TextEditFinished(vuint editVersion)
@@ -172,6 +323,10 @@ GuiTextBoxColorizerBase
 					SPIN_LOCK(*elementModifyLock)
 					{
 						colorizedLineCount=0;
+						dirtyLineEnd=0;
+						validLineEnd=0;
+						colorizingVersion++;
+						visibleLinesChanged=true;
 						StartColorizer();
 					}
 				}
@@ -27,19 +27,37 @@ GuiTextBoxColorizerBase
 			{
 			public:
 				typedef collections::Array<elements::text::ColorEntry>			ColorArray;
+				static const vint							BatchLineCount=32;
+				static const vint							BatchCharCount=65536;
 			protected:
 				elements::GuiColorizedTextElement*			element;
 				SpinLock*									elementModifyLock;
+				compositions::GuiGraphicsComposition*		ownerComposition;
 				volatile vint								colorizedLineCount;
+				volatile vint								dirtyLineEnd;
+				volatile vint								validLineEnd;
+				volatile vint								colorizingVersion;
 				volatile bool								isColorizerRunning;
 				volatile bool								isFinalizing;
 				SpinLock									colorizerRunningEvent;
 
+				vint										visibleLineStart;
+				vint										visibleLineCount;
+				volatile bool								visibleLinesChanged;
+				vint										speculativeLineStart;
+				vint										speculativeLineEnd;
+				collections::Array<wchar_t>					batchText;
+				collections::Array<vuint32_t>				batchColors;
+				collections::Array<vint>					batchOffsets;
+				collections::Array<vint>					batchLexerStates;
+				collections::Array<vint>					batchContextStates;
+
 				static void									ColorizerThreadProc(void* argument);
 
 				void										StartColorizer();
 				void										StopColorizer(bool forever);
 				void										StopColorizerForever();
+				void										UpdateVisibleLines();
 			public:
 				/// <summary>Create a colorrizer.</summary>
 				GuiTextBoxColorizerBase();
@@ -20,6 +20,9 @@ GuiGeneralUndoRedoProcessor
 				:firstFutureStep(0)
 				,savedStep(0)
 				,performingUndoRedo(false)
+				,memorySize(0)
+				,memoryBudget(-1)
+				,compoundStepLevel(0)
 			{
 			}
 
@@ -29,7 +32,11 @@ GuiGeneralUndoRedoProcessor
 
 			void GuiGeneralUndoRedoProcessor::PushStep(Ptr<IEditStep> step)
 			{
-				if(!performingUndoRedo)
+				if(!performingUndoRedo && compoundStep)
+				{
+					compoundStep->steps.Add(step);
+				}
+				else if(!performingUndoRedo)
 				{
 					if(firstFutureStep<savedStep)
 					{
@@ -39,16 +46,58 @@ GuiGeneralUndoRedoProcessor
 					vint count=steps.Count()-firstFutureStep;
 					if(count>0)
 					{
+						for(vint i=firstFutureStep;i<steps.Count();i++)
+						{
+							memorySize-=steps[i]->GetMemorySize();
+						}
 						steps.RemoveRange(firstFutureStep, count);
 					}
 				
 					steps.Add(step);
+					memorySize+=step->GetMemorySize();
 					firstFutureStep=steps.Count();
+					RemoveOldSteps();
 					UndoRedoChanged();
 					ModifiedChanged();
 				}
 			}
 
+			void GuiGeneralUndoRedoProcessor::RemoveOldSteps()
+			{
+				if(memoryBudget<0) return;
+
+				// the latest step is always kept, even if it alone exceeds the budget
+				vint count=0;
+				while(memorySize>memoryBudget && count<firstFutureStep && count<steps.Count()-1)
+				{
+					memorySize-=steps[count]->GetMemorySize();
+					count++;
+				}
+
+				if(count>0)
+				{
+					steps.RemoveRange(0, count);
+					firstFutureStep-=count;
+					savedStep=savedStep>=count?savedStep-count:-1;
+				}
+			}
+
+			GuiGeneralUndoRedoProcessor::IEditStep* GuiGeneralUndoRedoProcessor::GetMergeableStep()
+			{
+				if(!performingUndoRedo && !compoundStep && firstFutureStep>0 && firstFutureStep==steps.Count() && savedStep!=firstFutureStep)
+				{
+					return steps[firstFutureStep-1].Obj();
+				}
+				return nullptr;
+			}
+
+			void GuiGeneralUndoRedoProcessor::OnMergeableStepChanged(vint oldMemorySize)
+			{
+				memorySize+=steps[firstFutureStep-1]->GetMemorySize()-oldMemorySize;
+				RemoveOldSteps();
+				UndoRedoChanged();
+			}
+
 			bool GuiGeneralUndoRedoProcessor::CanUndo()
 			{
 				return firstFutureStep>0;
@@ -66,6 +115,7 @@ GuiGeneralUndoRedoProcessor
 					steps.Clear();
 					firstFutureStep=0;
 					savedStep=0;
+					memorySize=0;
 				}
 			}
 
@@ -107,6 +157,84 @@ GuiGeneralUndoRedoProcessor
 				return true;
 			}
 
+			vint GuiGeneralUndoRedoProcessor::GetMemorySize()
+			{
+				return memorySize;
+			}
+
+			vint GuiGeneralUndoRedoProcessor::GetMemoryBudget()
+			{
+				return memoryBudget;
+			}
+
+			void GuiGeneralUndoRedoProcessor::SetMemoryBudget(vint value)
+			{
+				if(value<0) value=-1;
+				if(memoryBudget!=value)
+				{
+					memoryBudget=value;
+					if(!performingUndoRedo)
+					{
+						RemoveOldSteps();
+						UndoRedoChanged();
+						ModifiedChanged();
+					}
+				}
+			}
+
+			void GuiGeneralUndoRedoProcessor::BeginCompoundStep()
+			{
+				if(compoundStepLevel++==0)
+				{
+					compoundStep=new CompoundStep;
+				}
+			}
+
+			void GuiGeneralUndoRedoProcessor::EndCompoundStep()
+			{
+				if(compoundStepLevel==0 || --compoundStepLevel>0) return;
+				auto step=compoundStep;
+				compoundStep=nullptr;
+				if(step->steps.Count()==1)
+				{
+					PushStep(step->steps[0]);
+				}
+				else if(step->steps.Count()>1)
+				{
+					PushStep(step);
+				}
+			}
+
+/***********************************************************************
+GuiGeneralUndoRedoProcessor::CompoundStep
+***********************************************************************/
+
+			void GuiGeneralUndoRedoProcessor::CompoundStep::Undo()
+			{
+				for(vint i=steps.Count()-1;i>=0;i--)
+				{
+					steps[i]->Undo();
+				}
+			}
+
+			void GuiGeneralUndoRedoProcessor::CompoundStep::Redo()
+			{
+				for(vint i=0;i<steps.Count();i++)
+				{
+					steps[i]->Redo();
+				}
+			}
+
+			vint GuiGeneralUndoRedoProcessor::CompoundStep::GetMemorySize()
+			{
+				vint size=sizeof(*this);
+				for(vint i=0;i<steps.Count();i++)
+				{
+					size+=steps[i]->GetMemorySize();
+				}
+				return size;
+			}
+
 /***********************************************************************
 GuiTextBoxUndoRedoProcessor::EditStep
 ***********************************************************************/
@@ -133,6 +261,27 @@ GuiTextBoxUndoRedoProcessor::EditStep
 				}
 			}
 
+			vint GuiTextBoxUndoRedoProcessor::EditStep::GetMemorySize()
+			{
+				return sizeof(*this)+(arguments.originalText.Length()+arguments.inputText.Length())*sizeof(wchar_t);
+			}
+
+			bool GuiTextBoxUndoRedoProcessor::EditStep::TryMerge(const TextEditNotifyStruct& nextArguments)
+			{
+				// only continuous typing in the same line is merged
+				if(!arguments.keyInput || !nextArguments.keyInput) return false;
+				if(arguments.inputStart.row!=arguments.inputEnd.row) return false;
+				if(nextArguments.originalStart!=nextArguments.originalEnd) return false;
+				if(nextArguments.originalStart!=arguments.inputEnd) return false;
+				if(nextArguments.inputEnd.row!=nextArguments.inputStart.row) return false;
+				if(arguments.inputText.Length()+nextArguments.inputText.Length()>MaxMergedInputLength) return false;
+
+				arguments.inputText+=nextArguments.inputText;
+				arguments.inputEnd=nextArguments.inputEnd;
+				arguments.editVersion=nextArguments.editVersion;
+				return true;
+			}
+
 /***********************************************************************
 GuiTextBoxUndoRedoProcessor
 ***********************************************************************/
@@ -162,6 +311,16 @@ GuiTextBoxUndoRedoProcessor
 
 			void GuiTextBoxUndoRedoProcessor::TextEditNotify(const TextEditNotifyStruct& arguments)
 			{
+				if(auto lastStep=dynamic_cast<EditStep*>(GetMergeableStep()))
+				{
+					vint oldMemorySize=lastStep->GetMemorySize();
+					if(lastStep->TryMerge(arguments))
+					{
+						OnMergeableStepChanged(oldMemorySize);
+						return;
+					}
+				}
+
 				Ptr<EditStep> step=new EditStep;
 				step->processor=this;
 				step->arguments=arguments;
@@ -180,6 +339,75 @@ GuiTextBoxUndoRedoProcessor
 GuiDocumentUndoRedoProcessor::ReplaceModelStep
 ***********************************************************************/
 
+			class DocumentMemorySizeVisitor : public Object, public DocumentRun::IVisitor
+			{
+			public:
+				vint				size = 0;
+
+				void VisitContainer(DocumentContainerRun* run)
+				{
+					FOREACH(Ptr<DocumentRun>, subRun, run->runs)
+					{
+						subRun->Accept(this);
+					}
+				}
+
+				void Visit(DocumentTextRun* run)override
+				{
+					size+=sizeof(*run)+run->text.Length()*sizeof(wchar_t);
+				}
+
+				void Visit(DocumentStylePropertiesRun* run)override
+				{
+					size+=sizeof(*run)+sizeof(DocumentStyleProperties);
+					VisitContainer(run);
+				}
+
+				void Visit(DocumentStyleApplicationRun* run)override
+				{
+					size+=sizeof(*run)+run->styleName.Length()*sizeof(wchar_t);
+					VisitContainer(run);
+				}
+
+				void Visit(DocumentHyperlinkRun* run)override
+				{
+					size+=sizeof(*run)+(run->styleName.Length()+run->reference.Length())*sizeof(wchar_t);
+					VisitContainer(run);
+				}
+
+				void Visit(DocumentImageRun* run)override
+				{
+					size+=sizeof(*run)+run->source.Length()*sizeof(wchar_t);
+				}
+
+				void Visit(DocumentEmbeddedObjectRun* run)override
+				{
+					size+=sizeof(*run)+run->name.Length()*sizeof(wchar_t);
+				}
+
+				void Visit(DocumentParagraphRun* run)override
+				{
+					size+=sizeof(*run);
+					VisitContainer(run);
+				}
+
+				static vint GetMemorySize(Ptr<DocumentModel> model)
+				{
+					if(!model) return 0;
+					DocumentMemorySizeVisitor visitor;
+					visitor.size=sizeof(DocumentModel);
+					FOREACH(Ptr<DocumentParagraphRun>, paragraph, model->paragraphs)
+					{
+						paragraph->Accept(&visitor);
+					}
+					for(vint i=0;i<model->styles.Count();i++)
+					{
+						visitor.size+=sizeof(DocumentStyle)+sizeof(DocumentStyleProperties)*2+model->styles.Keys()[i].Length()*sizeof(wchar_t);
+					}
+					return visitor.size;
+				}
+			};
+
 			void GuiDocumentUndoRedoProcessor::ReplaceModelStep::Undo()
 			{
 				GuiDocumentCommonInterface* ci=dynamic_cast<GuiDocumentCommonInterface*>(processor->ownerComposition->GetRelatedControl());
@@ -200,6 +428,37 @@ GuiDocumentUndoRedoProcessor::ReplaceModelStep
 				}
 			}
 
+			vint GuiDocumentUndoRedoProcessor::ReplaceModelStep::GetMemorySize()
+			{
+				if(memorySize==-1)
+				{
+					memorySize=sizeof(*this)
+						+DocumentMemorySizeVisitor::GetMemorySize(arguments.originalModel)
+						+DocumentMemorySizeVisitor::GetMemorySize(arguments.inputModel);
+				}
+				return memorySize;
+			}
+
+			bool GuiDocumentUndoRedoProcessor::ReplaceModelStep::TryMerge(const ReplaceModelStruct& nextArguments)
+			{
+				// only continuous insertions by typing in the same paragraph are merged
+				if(!arguments.keyInput || !nextArguments.keyInput) return false;
+				if(arguments.inputStart.row!=arguments.inputEnd.row) return false;
+				if(nextArguments.originalStart!=nextArguments.originalEnd) return false;
+				if(nextArguments.originalStart!=arguments.inputEnd) return false;
+				if(nextArguments.inputStart!=nextArguments.originalStart) return false;
+				if(nextArguments.inputEnd.row!=nextArguments.inputStart.row) return false;
+				if(nextArguments.inputEnd.column-arguments.inputStart.column>MaxMergedInputLength) return false;
+
+				auto inputModel=processor->element->GetDocument()->CopyDocument(arguments.inputStart, nextArguments.inputEnd, true);
+				if(!inputModel) return false;
+
+				arguments.inputEnd=nextArguments.inputEnd;
+				arguments.inputModel=inputModel;
+				memorySize=-1;
+				return true;
+			}
+
 /***********************************************************************
 GuiDocumentUndoRedoProcessor::RenameStyleStep
 ***********************************************************************/
@@ -222,6 +481,11 @@ GuiDocumentUndoRedoProcessor::RenameStyleStep
 				}
 			}
 
+			vint GuiDocumentUndoRedoProcessor::RenameStyleStep::GetMemorySize()
+			{
+				return sizeof(*this)+(arguments.oldStyleName.Length()+arguments.newStyleName.Length())*sizeof(wchar_t);
+			}
+
 /***********************************************************************
 GuiDocumentUndoRedoProcessor::SetAlignmentStep
 ***********************************************************************/
@@ -244,6 +508,11 @@ GuiDocumentUndoRedoProcessor::SetAlignmentStep
 				}
 			}
 
+			vint GuiDocumentUndoRedoProcessor::SetAlignmentStep::GetMemorySize()
+			{
+				return sizeof(*this)+sizeof(SetAlignmentStruct)+(arguments->originalAlignments.Count()+arguments->inputAlignments.Count())*sizeof(Nullable<Alignment>);
+			}
+
 /***********************************************************************
 GuiDocumentUndoRedoProcessor
 ***********************************************************************/
@@ -266,6 +535,16 @@ GuiDocumentUndoRedoProcessor
 
 			void GuiDocumentUndoRedoProcessor::OnReplaceModel(const ReplaceModelStruct& arguments)
 			{
+				if(auto lastStep=dynamic_cast<ReplaceModelStep*>(GetMergeableStep()))
+				{
+					vint oldMemorySize=lastStep->GetMemorySize();
+					if(lastStep->TryMerge(arguments))
+					{
+						OnMergeableStepChanged(oldMemorySize);
+						return;
+					}
+				}
+
 				Ptr<ReplaceModelStep> step=new ReplaceModelStep;
 				step->processor=this;
 				step->arguments=arguments;
@@ -32,17 +32,37 @@ Undo Redo
 				public:
 					virtual void							Undo()=0;
 					virtual void							Redo()=0;
+					virtual vint							GetMemorySize()=0;
 				};
 				friend class collections::ArrayBase<Ptr<IEditStep>>;
 
+				class CompoundStep : public Object, public IEditStep
+				{
+				public:
+					collections::List<Ptr<IEditStep>>		steps;
+
+					void									Undo();
+					void									Redo();
+					vint									GetMemorySize();
+				};
+
 			protected:
 				collections::List<Ptr<IEditStep>>			steps;
+				Ptr<CompoundStep>							compoundStep;
+				vint										compoundStepLevel;
 				vint										firstFutureStep;
 				vint										savedStep;
 				bool										performingUndoRedo;
+				vint										memorySize;
+				vint										memoryBudget;
 
 				void										PushStep(Ptr<IEditStep> step);
+				void										RemoveOldSteps();
+				IEditStep*									GetMergeableStep();
+				void										OnMergeableStepChanged(vint oldMemorySize);
 			public:
+				static const vint							MaxMergedInputLength=256;
+
 				GuiGeneralUndoRedoProcessor();
 				~GuiGeneralUndoRedoProcessor();
 
@@ -56,6 +76,11 @@ Undo Redo
 				void										NotifyModificationSaved();
 				bool										Undo();
 				bool										Redo();
+				vint										GetMemorySize();
+				vint										GetMemoryBudget();
+				void										SetMemoryBudget(vint value);
+				void										BeginCompoundStep();
+				void										EndCompoundStep();
 			};
 
 /***********************************************************************
@@ -73,6 +98,8 @@ Undo Redo (Text)
 					
 					void									Undo();
 					void									Redo();
+					vint									GetMemorySize();
+					bool									TryMerge(const TextEditNotifyStruct& nextArguments);
 				};
 
 				compositions::GuiGraphicsComposition*		ownerComposition;
@@ -103,8 +130,10 @@ Undo Redo (Document)
 					TextPos									inputStart;
 					TextPos									inputEnd;
 					Ptr<DocumentModel>						inputModel;
+					bool									keyInput;
 
 					ReplaceModelStruct()
+						:keyInput(false)
 					{
 					}
 				};
@@ -136,9 +165,12 @@ Undo Redo (Document)
 				public:
 					GuiDocumentUndoRedoProcessor*			processor;
 					ReplaceModelStruct						arguments;
+					vint									memorySize = -1;
 					
 					void									Undo();
 					void									Redo();
+					vint									GetMemorySize();
+					bool									TryMerge(const ReplaceModelStruct& nextArguments);
 				};
 
 				class RenameStyleStep : public Object, public IEditStep
@@ -149,6 +181,7 @@ Undo Redo (Document)
 					
 					void									Undo();
 					void									Redo();
+					vint									GetMemorySize();
 				};
 
 				class SetAlignmentStep : public Object, public IEditStep
@@ -159,6 +192,7 @@ Undo Redo (Document)
 					
 					void									Undo();
 					void									Redo();
+					vint									GetMemorySize();
 				};
 			public:
 
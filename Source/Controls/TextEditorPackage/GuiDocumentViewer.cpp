@@ -166,7 +166,7 @@ GuiDocumentCommonInterface
 							ProcessKey(VKEY_LEFT, true, false);
 						}
 						Array<WString> text;
-						EditText(documentElement->GetCaretBegin(), documentElement->GetCaretEnd(), documentElement->IsCaretEndPreferFrontSide(), text);
+						EditTextAsKeyInput(text);
 						return true;
 					}
 					break;
@@ -178,7 +178,7 @@ GuiDocumentCommonInterface
 							ProcessKey(VKEY_RIGHT, true, false);
 						}
 						Array<WString> text;
-						EditText(documentElement->GetCaretBegin(), documentElement->GetCaretEnd(), documentElement->IsCaretEndPreferFrontSide(), text);
+						EditTextAsKeyInput(text);
 						return true;
 					}
 					break;
@@ -189,12 +189,12 @@ GuiDocumentCommonInterface
 						{
 							Array<WString> text(1);
 							text[0]=L"\r\n";
-							EditText(documentElement->GetCaretBegin(), documentElement->GetCaretEnd(), documentElement->IsCaretEndPreferFrontSide(), text);
+							EditTextAsKeyInput(text);
 						}
 						else
 						{
 							Array<WString> text(2);
-							EditText(documentElement->GetCaretBegin(), documentElement->GetCaretEnd(), documentElement->IsCaretEndPreferFrontSide(), text);
+							EditTextAsKeyInput(text);
 						}
 						return true;
 					}
@@ -277,7 +277,7 @@ GuiDocumentCommonInterface
 				});
 			}
 
-			void GuiDocumentCommonInterface::EditTextInternal(TextPos begin, TextPos end, const Func<void(TextPos, TextPos, vint&, vint&)>& editor)
+			void GuiDocumentCommonInterface::EditTextInternal(TextPos begin, TextPos end, const Func<void(TextPos, TextPos, vint&, vint&)>& editor, bool asKeyInput)
 			{
 				// save run before editing
 				if(begin>end)
@@ -324,10 +324,24 @@ GuiDocumentCommonInterface
 					arguments.inputStart=begin;
 					arguments.inputEnd=caret;
 					arguments.inputModel=inputModel;
+					arguments.keyInput=asKeyInput;
 					undoRedoProcessor->OnReplaceModel(arguments);
 				}
 			}
 
+			void GuiDocumentCommonInterface::EditTextAsKeyInput(const collections::Array<WString>& text)
+			{
+				TextPos begin=documentElement->GetCaretBegin();
+				TextPos end=documentElement->GetCaretEnd();
+				bool frontSide=documentElement->IsCaretEndPreferFrontSide();
+				EditTextInternal(begin, end, [=, &text](TextPos begin, TextPos end, vint& paragraphCount, vint& lastParagraphLength)
+				{
+					documentElement->EditText(begin, end, frontSide, text);
+					paragraphCount=text.Count();
+					lastParagraphLength=paragraphCount==0?0:text[paragraphCount-1].Length();
+				}, true);
+			}
+
 			void GuiDocumentCommonInterface::EditStyleInternal(TextPos begin, TextPos end, const Func<void(TextPos, TextPos)>& editor)
 			{
 				// save run before editing
@@ -427,7 +441,7 @@ GuiDocumentCommonInterface
 					{
 						Array<WString> text(1);
 						text[0]=WString(arguments.code);
-						EditText(documentElement->GetCaretBegin(), documentElement->GetCaretEnd(), documentElement->IsCaretEndPreferFrontSide(), text);
+						EditTextAsKeyInput(text);
 					}
 				}
 			}
@@ -714,7 +728,7 @@ GuiDocumentCommonInterface
 					documentElement->EditRun(begin, end, model, copy);
 					paragraphCount=model->paragraphs.Count();
 					lastParagraphLength=paragraphCount==0?0:model->paragraphs[paragraphCount-1]->GetText(false).Length();
-				});
+				}, false);
 			}
 
 			void GuiDocumentCommonInterface::EditText(TextPos begin, TextPos end, bool frontSide, const collections::Array<WString>& text)
@@ -724,7 +738,7 @@ GuiDocumentCommonInterface
 					documentElement->EditText(begin, end, frontSide, text);
 					paragraphCount=text.Count();
 					lastParagraphLength=paragraphCount==0?0:text[paragraphCount-1].Length();
-				});
+				}, false);
 			}
 
 			void GuiDocumentCommonInterface::EditStyle(TextPos begin, TextPos end, Ptr<DocumentStyleProperties> style)
@@ -742,7 +756,7 @@ GuiDocumentCommonInterface
 					documentElement->EditImage(begin, end, image);
 					paragraphCount=1;
 					lastParagraphLength=wcslen(DocumentImageRun::RepresentationText);
-				});
+				}, false);
 			}
 
 			void GuiDocumentCommonInterface::EditHyperlink(vint paragraphIndex, vint begin, vint end, const WString& reference, const WString& normalStyleName, const WString& activeStyleName)
@@ -1082,6 +1096,16 @@ GuiDocumentCommonInterface
 				undoRedoProcessor->NotifyModificationSaved();
 			}
 
+			vint GuiDocumentCommonInterface::GetUndoMemoryBudget()
+			{
+				return undoRedoProcessor->GetMemoryBudget();
+			}
+
+			void GuiDocumentCommonInterface::SetUndoMemoryBudget(vint value)
+			{
+				undoRedoProcessor->SetMemoryBudget(value);
+			}
+
 			bool GuiDocumentCommonInterface::Undo()
 			{
 				if(CanUndo())
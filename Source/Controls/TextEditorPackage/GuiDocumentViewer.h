@@ -87,7 +87,8 @@ GuiDocumentCommonInterface
 				void										SetActiveHyperlink(Ptr<DocumentHyperlinkRun::Package> package);
 				void										ActivateActiveHyperlink(bool activate);
 				void										AddShortcutCommand(vint key, const Func<void()>& eventHandler);
-				void										EditTextInternal(TextPos begin, TextPos end, const Func<void(TextPos, TextPos, vint&, vint&)>& editor);
+				void										EditTextInternal(TextPos begin, TextPos end, const Func<void(TextPos, TextPos, vint&, vint&)>& editor, bool asKeyInput);
+				void										EditTextAsKeyInput(const collections::Array<WString>& text);
 				void										EditStyleInternal(TextPos begin, TextPos end, const Func<void(TextPos, TextPos)>& editor);
 				
 				void										MergeBaselineAndDefaultFont(Ptr<DocumentModel> document);
@@ -323,6 +324,12 @@ GuiDocumentCommonInterface
 				bool										GetModified();
 				/// <summary>Notify the text box that the current status is considered saved.</summary>
 				void										NotifyModificationSaved();
+				/// <summary>Get the memory budget of undo and redo information in bytes.</summary>
+				/// <returns>The memory budget. -1 means unlimited.</returns>
+				vint										GetUndoMemoryBudget();
+				/// <summary>Set the memory budget of undo and redo information in bytes. Oldest steps are removed when the budget is exceeded.</summary>
+				/// <param name="value">The memory budget. -1 means unlimited.</param>
+				void										SetUndoMemoryBudget(vint value);
 				/// <summary>Perform the undo action.</summary>
 				/// <returns>Returns true if this operation succeeded.</returns>
 				bool										Undo();
@@ -585,6 +585,30 @@ GuiTextBoxCommonInterface
 				}
 			}
 
+			void GuiTextBoxCommonInterface::UnsafeLoadText(stream::IStream& stream)
+			{
+				if(textElement)
+				{
+					// callbacks are attached again to take the loaded text as a new text, without receiving the whole text in a notification
+					for(vint i=0;i<textEditCallbacks.Count();i++)
+					{
+						textEditCallbacks[i]->Detach();
+					}
+					SPIN_LOCK(elementModifyLock)
+					{
+						textElement->GetLines().LoadText(stream);
+					}
+					editVersion++;
+					for(vint i=0;i<textEditCallbacks.Count();i++)
+					{
+						textEditCallbacks[i]->Attach(textElement, elementModifyLock, textComposition, editVersion);
+					}
+
+					Move(TextPos(0, 0), false);
+					textControl->TextChanged.Execute(textControl->GetNotifyEventArguments());
+				}
+			}
+
 			GuiTextBoxCommonInterface::GuiTextBoxCommonInterface()
 				:textElement(0)
 				,textComposition(0)
@@ -771,6 +795,72 @@ GuiTextBoxCommonInterface
 				return c1>c2?c1:c2;
 			}
 
+			//================ searching
+
+			TextPos GuiTextBoxCommonInterface::GetWrapPosition(bool forward)
+			{
+				if(forward)
+				{
+					return TextPos(0, 0);
+				}
+				vint row=textElement->GetLines().GetCount()-1;
+				return TextPos(row, textElement->GetLines().GetLine(row).dataLength);
+			}
+
+			vint GuiTextBoxCommonInterface::ReplaceMatches(const collections::List<TextMatch>& matches, const WString& replacement)
+			{
+				if(readonly || matches.Count()==0) return 0;
+				// matches are replaced from the last one, so that positions of previous matches are not changed
+				// each match is modified separately without copying text between matches, and all replacements are undone in one step
+				undoRedoProcessor->BeginCompoundStep();
+				for(vint i=matches.Count()-1;i>=0;i--)
+				{
+					Modify(matches[i].start, matches[i].end, replacement, false);
+				}
+				undoRedoProcessor->EndCompoundStep();
+				return matches.Count();
+			}
+
+			bool GuiTextBoxCommonInterface::Find(const WString& pattern, bool caseSensitive, bool forward)
+			{
+				TextLines& lines=textElement->GetLines();
+				TextMatch match;
+				if(lines.Find(pattern, caseSensitive, forward, forward?GetCaretLarge():GetCaretSmall(), match)
+					|| lines.Find(pattern, caseSensitive, forward, GetWrapPosition(forward), match))
+				{
+					Select(match.start, match.end);
+					return true;
+				}
+				return false;
+			}
+
+			bool GuiTextBoxCommonInterface::Find(const regex::Regex& pattern, bool forward)
+			{
+				TextLines& lines=textElement->GetLines();
+				TextMatch match;
+				if(lines.Find(pattern, forward, forward?GetCaretLarge():GetCaretSmall(), match)
+					|| lines.Find(pattern, forward, GetWrapPosition(forward), match))
+				{
+					Select(match.start, match.end);
+					return true;
+				}
+				return false;
+			}
+
+			vint GuiTextBoxCommonInterface::ReplaceAll(const WString& pattern, bool caseSensitive, const WString& replacement)
+			{
+				collections::List<TextMatch> matches;
+				textElement->GetLines().FindAll(pattern, caseSensitive, matches);
+				return ReplaceMatches(matches, replacement);
+			}
+
+			vint GuiTextBoxCommonInterface::ReplaceAll(const regex::Regex& pattern, const WString& replacement)
+			{
+				collections::List<TextMatch> matches;
+				textElement->GetLines().FindAll(pattern, matches);
+				return ReplaceMatches(matches, replacement);
+			}
+
 			//================ position query
 				
 			vint GuiTextBoxCommonInterface::GetRowWidth(vint row)
@@ -913,6 +1003,16 @@ GuiTextBoxCommonInterface
 				undoRedoProcessor->NotifyModificationSaved();
 			}
 
+			vint GuiTextBoxCommonInterface::GetUndoMemoryBudget()
+			{
+				return undoRedoProcessor->GetMemoryBudget();
+			}
+
+			void GuiTextBoxCommonInterface::SetUndoMemoryBudget(vint value)
+			{
+				undoRedoProcessor->SetMemoryBudget(value);
+			}
+
 			bool GuiTextBoxCommonInterface::Undo()
 			{
 				if(CanUndo())
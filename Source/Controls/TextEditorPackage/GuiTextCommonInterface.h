@@ -84,6 +84,8 @@ Common Interface
 				void												UpdateCaretPoint();
 				void												Move(TextPos pos, bool shift);
 				void												Modify(TextPos start, TextPos end, const WString& input, bool asKeyInput);
+				TextPos												GetWrapPosition(bool forward);
+				vint												ReplaceMatches(const collections::List<elements::text::TextMatch>& matches, const WString& replacement);
 				bool												ProcessKey(vint code, bool shift, bool ctrl);
 					
 				void												OnGotFocus(compositions::GuiGraphicsComposition* sender, compositions::GuiEventArgs& arguments);
@@ -106,6 +108,7 @@ Common Interface
 				void												AddShortcutCommand(vint key, const Func<void()>& eventHandler);
 				elements::GuiColorizedTextElement*					GetTextElement();
 				void												UnsafeSetText(const WString& value);
+				void												UnsafeLoadText(stream::IStream& stream);
 
 			public:
 				GuiTextBoxCommonInterface();
@@ -192,6 +195,31 @@ Common Interface
 				/// <returns>The right-bottom text position of the selection.</returns>
 				TextPos												GetCaretLarge();
 
+				//================ searching
+
+				/// <summary>Find a string from the selection and select the match. Searching wraps around the beginning or the end of the text.</summary>
+				/// <returns>Returns true if a match is found.</returns>
+				/// <param name="pattern">The string to find.</param>
+				/// <param name="caseSensitive">Set to true to compare characters case sensitively.</param>
+				/// <param name="forward">Set to true to find the next match after the selection. Set to false to find the previous match before the selection.</param>
+				bool												Find(const WString& pattern, bool caseSensitive, bool forward);
+				/// <summary>Find a regular expression from the selection and select the match. Searching wraps around the beginning or the end of the text.</summary>
+				/// <returns>Returns true if a match is found.</returns>
+				/// <param name="pattern">The regular expression to find. A match never crosses lines.</param>
+				/// <param name="forward">Set to true to find the next match after the selection. Set to false to find the previous match before the selection.</param>
+				bool												Find(const regex::Regex& pattern, bool forward);
+				/// <summary>Replace all occurrences of a string. All replacements are applied in one modification, which is undone in one step.</summary>
+				/// <returns>The number of replaced occurrences.</returns>
+				/// <param name="pattern">The string to find.</param>
+				/// <param name="caseSensitive">Set to true to compare characters case sensitively.</param>
+				/// <param name="replacement">The string to replace every occurrence.</param>
+				vint												ReplaceAll(const WString& pattern, bool caseSensitive, const WString& replacement);
+				/// <summary>Replace all matches of a regular expression. All replacements are applied in one modification, which is undone in one step.</summary>
+				/// <returns>The number of replaced matches.</returns>
+				/// <param name="pattern">The regular expression to find. A match never crosses lines.</param>
+				/// <param name="replacement">The string to replace every match.</param>
+				vint												ReplaceAll(const regex::Regex& pattern, const WString& replacement);
+
 				//================ position query
 
 				/// <summary>Get the width of a row.</summary>
@@ -260,6 +288,12 @@ Common Interface
 				bool												GetModified();
 				/// <summary>Notify the text box that the current status is considered saved.</summary>
 				void												NotifyModificationSaved();
+				/// <summary>Get the memory budget of undo and redo information in bytes.</summary>
+				/// <returns>The memory budget. -1 means unlimited.</returns>
+				vint												GetUndoMemoryBudget();
+				/// <summary>Set the memory budget of undo and redo information in bytes. Oldest steps are removed when the budget is exceeded.</summary>
+				/// <param name="value">The memory budget. -1 means unlimited.</param>
+				void												SetUndoMemoryBudget(vint value);
 				/// <summary>Perform the undo action.</summary>
 				/// <returns>Returns true if this operation succeeded.</returns>
 				bool												Undo();
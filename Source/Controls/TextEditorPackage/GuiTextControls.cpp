@@ -183,6 +183,12 @@ GuiMultilineTextBox
 				CalculateView();
 			}
 
+			void GuiMultilineTextBox::LoadText(stream::IStream& stream)
+			{
+				UnsafeLoadText(stream);
+				CalculateView();
+			}
+
 			void GuiMultilineTextBox::SetFont(const FontProperties& value)
 			{
 				GuiControl::SetFont(value);
@@ -75,6 +75,10 @@ MultilineTextBox
 				const WString&								GetText()override;
 				void										SetText(const WString& value)override;
 				void										SetFont(const FontProperties& value)override;
+
+				/// <summary>Replace the text with the content of a stream. The encoding is detected from the beginning of the stream. Lines are created while reading, without decoding the whole content into one string. The undo history is cleared.</summary>
+				/// <param name="stream">The stream to read, it should be readable and seekable.</param>
+				void										LoadText(stream::IStream& stream);
 			};
 
 /***********************************************************************
@@ -789,45 +789,49 @@ GuiGrammarAutoComplete
 						return;
 					}
 				}
-				AutoCompleteContext newContext;
-				bool byGlobalCorrection=false;
-
-				if(input.node)
-				{
-					newContext.input=input;
-					ExecuteRefresh(newContext);
-					byGlobalCorrection=true;
-				}
-				else
+				// the incremental parsing updates syntax trees in place, so they are read under the lock
+				READER_LOCK(parsingExecutor->GetSyntaxTreeLock())
 				{
-					SPIN_LOCK(contextLock)
+					AutoCompleteContext newContext;
+					bool byGlobalCorrection=false;
+
+					if(input.node)
 					{
-						newContext=context;
-						newContext.modifiedNode=0;
-						newContext.autoComplete=0;
+						newContext.input=input;
+						ExecuteRefresh(newContext);
+						byGlobalCorrection=true;
 					}
-					if(newContext.originalNode)
+					else
 					{
-						ExecuteEdit(newContext);
+						SPIN_LOCK(contextLock)
+						{
+							newContext=context;
+							newContext.modifiedNode=0;
+							newContext.autoComplete=0;
+						}
+						if(newContext.originalNode)
+						{
+							ExecuteEdit(newContext);
+						}
 					}
-				}
 
-				if(newContext.originalNode)
-				{
-					ExecuteCalculateList(newContext);
-				}
+					if(newContext.originalNode)
+					{
+						ExecuteCalculateList(newContext);
+					}
 
-				SPIN_LOCK(contextLock)
-				{
-					context=newContext;
-				}
-				if(newContext.modifiedNode)
-				{
-					OnContextFinishedAsync(context);
-					GetApplication()->InvokeInMainThread(ownerComposition->GetRelatedControlHost(), [=]()
+					SPIN_LOCK(contextLock)
 					{
-						PostList(newContext, byGlobalCorrection);
-					});
+						context=newContext;
+					}
+					if(newContext.modifiedNode)
+					{
+						OnContextFinishedAsync(context);
+						GetApplication()->InvokeInMainThread(ownerComposition->GetRelatedControlHost(), [=]()
+						{
+							PostList(newContext, byGlobalCorrection);
+						});
+					}
 				}
 			}
 
@@ -198,34 +198,37 @@ GuiGrammarColorizer
 
 			void GuiGrammarColorizer::ColorizeTokenContextSensitive(vint lineIndex, const wchar_t* text, vint start, vint length, vint& token, vint& contextState)
 			{
-				SPIN_LOCK(contextLock)
+				READER_LOCK(parsingExecutor->GetSyntaxTreeLock())
 				{
-					ParsingTreeObject* node=context.node.Obj();
-					if(node && token!=-1 && parsingExecutor->GetTokenMetaData(token).hasContextColor)
+					SPIN_LOCK(contextLock)
 					{
-						ParsingTextPos pos(lineIndex, start);
-						SemanticColorizeContext scContext;
-						if(SemanticColorizeContext::RetriveContext(scContext, pos, node, parsingExecutor.Obj()))
+						ParsingTreeObject* node=context.node.Obj();
+						if(node && token!=-1 && parsingExecutor->GetTokenMetaData(token).hasContextColor)
 						{
-							const RepeatingParsingExecutor::FieldMetaData& md=parsingExecutor->GetFieldMetaData(scContext.type, scContext.field);
-							vint semantic=md.colorIndex;
-							scContext.semanticId=-1;
-
-							if(scContext.acceptableSemanticIds)
+							ParsingTextPos pos(lineIndex, start);
+							SemanticColorizeContext scContext;
+							if(SemanticColorizeContext::RetriveContext(scContext, pos, node, parsingExecutor.Obj()))
 							{
-								OnSemanticColorize(scContext, context);
-								if(md.semantics->Contains(scContext.semanticId))
+								const RepeatingParsingExecutor::FieldMetaData& md=parsingExecutor->GetFieldMetaData(scContext.type, scContext.field);
+								vint semantic=md.colorIndex;
+								scContext.semanticId=-1;
+
+								if(scContext.acceptableSemanticIds)
 								{
-									semantic=scContext.semanticId;
+									OnSemanticColorize(scContext, context);
+									if(md.semantics->Contains(scContext.semanticId))
+									{
+										semantic=scContext.semanticId;
+									}
 								}
-							}
 
-							if(semantic!=-1)
-							{
-								vint index=semanticColorMap.Keys().IndexOf(semantic);
-								if(index!=-1)
+								if(semantic!=-1)
 								{
-									token=semanticColorMap.Values()[index];
+									vint index=semanticColorMap.Keys().IndexOf(semantic);
+									if(index!=-1)
+									{
+										token=semanticColorMap.Values()[index];
+									}
 								}
 							}
 						}
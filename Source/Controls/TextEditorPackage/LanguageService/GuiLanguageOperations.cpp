@@ -1,4 +1,5 @@
 #include "GuiLanguageOperations.h"
+#include <chrono>
 
 namespace vl
 {
@@ -9,6 +10,7 @@ namespace vl
 			using namespace collections;
 			using namespace parsing;
 			using namespace parsing::tabling;
+			using namespace regex;
 			using namespace regex_internal;
 
 /***********************************************************************
@@ -133,6 +135,7 @@ RepeatingParsingExecutor::CallbackBase
 						RepeatingParsingInput input;
 						input.editVersion=editVersion;
 						input.code=callbackElement->GetLines().GetText();
+						input.submitTime=GetParsingClock();
 						parsingExecutor->SubmitTask(input);
 					}
 				}
@@ -173,20 +176,333 @@ RepeatingParsingExecutor::CallbackBase
 						RepeatingParsingInput input;
 						input.editVersion=editVersion;
 						input.code=callbackElement->GetLines().GetText();
+						input.submitTime=GetParsingClock();
 						parsingExecutor->SubmitTask(input);
 					}
 				}
 			}
 
+/***********************************************************************
+ParsingTreeShiftVisitor
+***********************************************************************/
+
+			class ParsingTreeShiftVisitor : public Object, public ParsingTreeNode::IVisitor
+			{
+			public:
+				// a position at or after mappingIndex is moved by indexDelta and rowDelta
+				// columnDelta is only applied to positions that are in the row of mappingIndex
+				vint										mappingIndex = 0;
+				vint										mappingRow = 0;
+				vint										indexDelta = 0;
+				vint										rowDelta = 0;
+				vint										columnDelta = 0;
+				// all token indices in shifted nodes are moved by tokenDelta
+				vint										tokenDelta = 0;
+
+				ParsingTextPos Map(ParsingTextPos pos)
+				{
+					if (pos.index >= mappingIndex)
+					{
+						if (pos.row == mappingRow)
+						{
+							pos.column += columnDelta;
+						}
+						pos.index += indexDelta;
+						pos.row += rowDelta;
+					}
+					return pos;
+				}
+
+				ParsingTextRange Map(ParsingTextRange range)
+				{
+					range.start = Map(range.start);
+					range.end = Map(range.end);
+					return range;
+				}
+
+				void Shift(ParsingTreeNode* node)
+				{
+					node->SetCodeRange(Map(node->GetCodeRange()));
+					node->Accept(this);
+				}
+
+				void Visit(ParsingTreeToken* node)override
+				{
+					if (node->GetTokenIndex() != -1)
+					{
+						node->SetTokenIndex(node->GetTokenIndex() + tokenDelta);
+					}
+				}
+
+				void Visit(ParsingTreeObject* node)override
+				{
+					FOREACH(Ptr<ParsingTreeNode>, member, node->GetMembers().Values())
+					{
+						Shift(member.Obj());
+					}
+				}
+
+				void Visit(ParsingTreeArray* node)override
+				{
+					FOREACH(Ptr<ParsingTreeNode>, item, node->GetItems())
+					{
+						Shift(item.Obj());
+					}
+				}
+			};
+
 /***********************************************************************
 RepeatingParsingExecutor
 ***********************************************************************/
 
-			void RepeatingParsingExecutor::Execute(const RepeatingParsingInput& input)
+			vint CountParsingTokens(const RegexLexer& lexer, const WString& code)
+			{
+				vint count = 0;
+				RegexTokens tokens = lexer.Parse(code);
+				FOREACH(RegexToken, token, tokens)
+				{
+					count++;
+				}
+				return count;
+			}
+
+			vint FindLastParsingToken(ParsingTreeNode* node, vint index, vint& tokenEnd)
 			{
+				// find the last token that ends before index, returns its token index and the position after it
+				if (auto token = dynamic_cast<ParsingTreeToken*>(node))
+				{
+					ParsingTextRange range = token->GetCodeRange();
+					if (token->GetTokenIndex() != -1 && 0 <= range.end.index && range.end.index < index)
+					{
+						tokenEnd = range.end.index + 1;
+						return token->GetTokenIndex();
+					}
+					return -1;
+				}
+
+				const auto& subNodes = node->GetSubNodes();
+				for (vint i = subNodes.Count() - 1; i >= 0; i--)
+				{
+					ParsingTextRange range = subNodes[i]->GetCodeRange();
+					if (0 <= range.start.index && range.start.index < index)
+					{
+						vint tokenIndex = FindLastParsingToken(subNodes[i].Obj(), index, tokenEnd);
+						if (tokenIndex != -1) return tokenIndex;
+					}
+				}
+				return -1;
+			}
+
+			Ptr<parsing::ParsingTreeObject> RepeatingParsingExecutor::ParseIncrementally(const RepeatingParsingInput& input)
+			{
+				Ptr<ParsingTreeObject> previousNode = previousOutput.node;
+				if (!previousNode) return nullptr;
+
+				// find the edited part by skipping the common prefix and suffix of both code
+				const WString& oldCode = previousOutput.code;
+				const WString& newCode = input.code;
+				vint oldLength = oldCode.Length();
+				vint newLength = newCode.Length();
+				vint minLength = oldLength < newLength ? oldLength : newLength;
+				const wchar_t* oldBuffer = oldCode.Buffer();
+				const wchar_t* newBuffer = newCode.Buffer();
+
+				vint editStart = 0;
+				while (editStart < minLength && oldBuffer[editStart] == newBuffer[editStart]) editStart++;
+				vint suffix = 0;
+				while (suffix < minLength - editStart && oldBuffer[oldLength - suffix - 1] == newBuffer[newLength - suffix - 1]) suffix++;
+				vint oldEditEnd = oldLength - suffix;
+				vint newEditEnd = newLength - suffix;
+
+				if (editStart == oldEditEnd && editStart == newEditEnd)
+				{
+					return previousNode;
+				}
+
+				// find the deepest node that contains the edited part, the first and the last character of the node should not be edited
+				ParsingTreeObject* selectedNode = nullptr;
+				ParsingTreeNode* current = previousNode.Obj();
+				while (current)
+				{
+					if (auto obj = dynamic_cast<ParsingTreeObject*>(current))
+					{
+						selectedNode = obj;
+					}
+
+					ParsingTreeNode* next = nullptr;
+					FOREACH(Ptr<ParsingTreeNode>, subNode, current->GetSubNodes())
+					{
+						ParsingTextRange range = subNode->GetCodeRange();
+						if (0 <= range.start.index && range.start.index < editStart && range.end.index >= oldEditEnd)
+						{
+							next = subNode.Obj();
+							break;
+						}
+					}
+					current = next;
+				}
+
+				// a node created by a left recursive rule may be extended by the following code
+				// so the top most node in a chain of left recursive nodes is chosen
+				{
+					ParsingTreeObject* leftRecursiveNode = nullptr;
+					current = selectedNode;
+					while (current)
+					{
+						if (auto obj = dynamic_cast<ParsingTreeObject*>(current))
+						{
+							bool leftRecursive = false;
+							FOREACH(WString, rule, obj->GetCreatorRules())
+							{
+								if (leftRecursiveRules.Contains(rule))
+								{
+									leftRecursive = true;
+									break;
+								}
+							}
+
+							if (leftRecursive)
+							{
+								leftRecursiveNode = obj;
+							}
+							else if (leftRecursiveNode)
+							{
+								break;
+							}
+						}
+						current = current->GetParent();
+					}
+
+					if (leftRecursiveNode)
+					{
+						selectedNode = leftRecursiveNode;
+					}
+				}
+
+				if (!selectedNode || selectedNode == previousNode.Obj() || selectedNode->GetCreatorRules().Count() == 0)
+				{
+					return nullptr;
+				}
+
+				// reparse the selected node using the rule that created it
+				ParsingTextRange selectedRange = selectedNode->GetCodeRange();
+				vint fragmentStart = selectedRange.start.index;
+				vint oldFragmentEnd = selectedRange.end.index + 1;
+				vint newFragmentEnd = oldFragmentEnd + newEditEnd - oldEditEnd;
+				WString rule = selectedNode->GetCreatorRules()[selectedNode->GetCreatorRules().Count() - 1];
+
+				WString fragmentCode = newCode.Sub(fragmentStart, newFragmentEnd - fragmentStart);
 				List<Ptr<ParsingError>> errors;
-				Ptr<ParsingTreeObject> node=grammarParser->Parse(input.code, grammarRule, errors).Cast<ParsingTreeObject>();
-				if(node)
+				Ptr<ParsingTreeObject> fragment = grammarParser->Parse(fragmentCode, rule, errors).Cast<ParsingTreeObject>();
+				if (!fragment || errors.Count() > 0)
+				{
+					return nullptr;
+				}
+
+				// token indices count all tokens from the beginning of the code
+				// so tokens in the fragment start after the last token before it, and tokens after the fragment are moved by the change of the token count
+				const RegexLexer& lexer = grammarParser->GetTable()->GetLexer();
+				vint tokenEnd = 0;
+				vint fragmentTokenStart = FindLastParsingToken(previousNode.Obj(), fragmentStart, tokenEnd) + 1;
+				fragmentTokenStart += CountParsingTokens(lexer, newCode.Sub(tokenEnd, fragmentStart - tokenEnd));
+				vint tokenDelta = CountParsingTokens(lexer, fragmentCode) - CountParsingTokens(lexer, oldCode.Sub(fragmentStart, oldFragmentEnd - fragmentStart));
+
+				// only rows and columns between the selected node and the edited part are counted
+				vint oldEditEndRow = selectedRange.start.row;
+				vint rowDelta = 0;
+				for (vint i = fragmentStart; i < oldEditEnd; i++)
+				{
+					if (oldBuffer[i] == L'\n') oldEditEndRow++;
+				}
+				for (vint i = editStart; i < oldEditEnd; i++)
+				{
+					if (oldBuffer[i] == L'\n') rowDelta--;
+				}
+				for (vint i = editStart; i < newEditEnd; i++)
+				{
+					if (newBuffer[i] == L'\n') rowDelta++;
+				}
+
+				vint oldEditEndColumn = 0;
+				vint newEditEndColumn = 0;
+				while (oldEditEndColumn < oldEditEnd && oldBuffer[oldEditEnd - oldEditEndColumn - 1] != L'\n') oldEditEndColumn++;
+				while (newEditEndColumn < newEditEnd && newBuffer[newEditEnd - newEditEndColumn - 1] != L'\n') newEditEndColumn++;
+
+				// the previous syntax tree is updated in place, only the reparsed node, its ancestors and following nodes are changed
+				WRITER_LOCK(syntaxTreeLock)
+				{
+					// move the reparsed node to where the selected node is
+					ParsingTreeShiftVisitor shifter;
+					shifter.indexDelta = fragmentStart;
+					shifter.rowDelta = selectedRange.start.row;
+					shifter.columnDelta = selectedRange.start.column;
+					shifter.tokenDelta = fragmentTokenStart;
+					shifter.Shift(fragment.Obj());
+
+					// the selected node object is kept, so that its parent does not need to be updated
+					List<WString> memberNames;
+					CopyFrom(memberNames, selectedNode->GetMembers().Keys());
+					FOREACH(WString, name, memberNames)
+					{
+						selectedNode->RemoveMember(name);
+					}
+					CopyFrom(memberNames, fragment->GetMembers().Keys());
+					FOREACH(WString, name, memberNames)
+					{
+						Ptr<ParsingTreeNode> member = fragment->GetMember(name);
+						fragment->RemoveMember(name);
+						selectedNode->SetMember(name, member);
+					}
+					selectedNode->SetType(fragment->GetType());
+					CopyFrom(selectedNode->GetCreatorRules(), fragment->GetCreatorRules());
+					selectedNode->SetCodeRange(fragment->GetCodeRange());
+					selectedNode->InitializeQueryCache();
+
+					// move all nodes after the edited part
+					shifter.mappingIndex = oldEditEnd;
+					shifter.mappingRow = oldEditEndRow;
+					shifter.indexDelta = newEditEnd - oldEditEnd;
+					shifter.rowDelta = rowDelta;
+					shifter.columnDelta = newEditEndColumn - oldEditEndColumn;
+					shifter.tokenDelta = tokenDelta;
+
+					ParsingTreeNode* child = selectedNode;
+					for (ParsingTreeNode* parent = child->GetParent(); parent; child = parent, parent = parent->GetParent())
+					{
+						parent->SetCodeRange(shifter.Map(parent->GetCodeRange()));
+						FOREACH(Ptr<ParsingTreeNode>, subNode, parent->GetSubNodes())
+						{
+							if (subNode.Obj() != child && subNode->GetCodeRange().start.index >= oldEditEnd)
+							{
+								shifter.Shift(subNode.Obj());
+							}
+						}
+					}
+				}
+				return previousNode;
+			}
+
+			void RepeatingParsingExecutor::Execute(const RepeatingParsingInput& input)
+			{
+				vuint64_t startTime = input.submitTime == 0 ? GetParsingClock() : input.submitTime;
+				Ptr<ParsingTreeObject> node;
+				bool incremental = false;
+				if (incrementalParsing)
+				{
+					if ((node = ParseIncrementally(input)))
+					{
+						incremental = true;
+					}
+				}
+
+				bool succeeded = true;
+				if (!node)
+				{
+					List<Ptr<ParsingError>> errors;
+					node = grammarParser->Parse(input.code, grammarRule, errors).Cast<ParsingTreeObject>();
+					succeeded = errors.Count() == 0;
+				}
+				if(node && node != previousOutput.node)
 				{
 					node->InitializeQueryCache();
 				}
@@ -195,6 +511,19 @@ RepeatingParsingExecutor
 				result.node=node;
 				result.editVersion=input.editVersion;
 				result.code=input.code;
+				result.incremental=incremental;
+
+				// only a syntax tree without errors could be reused in the next incremental parsing
+				if (incrementalParsing && node && succeeded)
+				{
+					previousOutput.node = node;
+					previousOutput.code = input.code;
+				}
+				else
+				{
+					previousOutput = RepeatingParsingOutput();
+				}
+
 				if(node)
 				{
 					OnContextFinishedAsync(result);
@@ -202,6 +531,8 @@ RepeatingParsingExecutor
 					{
 						callback->OnParsingFinishedAsync(result);
 					}
+					lastParsingIncremental = incremental;
+					lastParsingLatency = (vint)(GetParsingClock() - startTime);
 				}
 			}
 
@@ -212,6 +543,7 @@ RepeatingParsingExecutor
 				semanticIndexMap.Clear();
 				tokenMetaDatas.Clear();
 				fieldMetaDatas.Clear();
+				leftRecursiveRules.Clear();
 
 				Dictionary<vint, Ptr<ParsingTable::AttributeInfo>> tokenColorAtts, tokenContextColorAtts, tokenCandidateAtts, tokenAutoCompleteAtts;
 				Dictionary<FieldDesc, Ptr<ParsingTable::AttributeInfo>> fieldColorAtts, fieldSemanticAtts;
@@ -334,6 +666,29 @@ RepeatingParsingExecutor
 						fieldMetaDatas.Add(fieldDesc, md);
 					}
 				}
+				{
+					vint stateCount=table->GetStateCount();
+					vint tokenCount=table->GetTokenCount();
+					for(vint i=0;i<stateCount;i++)
+					{
+						for(vint j=0;j<tokenCount;j++)
+						{
+							if(Ptr<ParsingTable::TransitionBag> bag=table->GetTransitionBag(i, j))
+							{
+								FOREACH(Ptr<ParsingTable::TransitionItem>, item, bag->transitionItems)
+								{
+									FOREACH(ParsingTable::Instruction, ins, item->instructions)
+									{
+										if(ins.instructionType==ParsingTable::Instruction::LeftRecursiveReduce && !leftRecursiveRules.Contains(ins.creatorRule))
+										{
+											leftRecursiveRules.Add(ins.creatorRule);
+										}
+									}
+								}
+							}
+						}
+					}
+				}
 			}
 
 			void RepeatingParsingExecutor::OnContextFinishedAsync(RepeatingParsingOutput& context)
@@ -428,6 +783,37 @@ RepeatingParsingExecutor
 				return analyzer;
 			}
 
+			bool RepeatingParsingExecutor::GetIncrementalParsing()
+			{
+				return incrementalParsing;
+			}
+
+			void RepeatingParsingExecutor::SetIncrementalParsing(bool value)
+			{
+				incrementalParsing = value;
+			}
+
+			vuint64_t RepeatingParsingExecutor::GetParsingClock()
+			{
+				// the local time could be adjusted while parsing, so latencies are measured by a steady clock
+				return (vuint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+
+			ReaderWriterLock& RepeatingParsingExecutor::GetSyntaxTreeLock()
+			{
+				return syntaxTreeLock;
+			}
+
+			vint RepeatingParsingExecutor::GetLastParsingLatency()
+			{
+				return lastParsingLatency;
+			}
+
+			bool RepeatingParsingExecutor::GetLastParsingIncremental()
+			{
+				return lastParsingIncremental;
+			}
+
 			vint RepeatingParsingExecutor::GetTokenIndex(const WString& tokenName)
 			{
 				vint index=tokenIndexMap.Keys().IndexOf(tokenName);
@@ -31,6 +31,8 @@ ParsingInput
 				vuint													editVersion = 0;
 				/// <summary>The code.</summary>
 				WString													code;
+				/// <summary>The time in milliseconds from <see cref="RepeatingParsingExecutor::GetParsingClock"/> when the code is submitted, used to measure the parsing latency. Set to 0 to measure from the beginning of the parsing.</summary>
+				vuint64_t												submitTime = 0;
 			};
 
 /***********************************************************************
@@ -46,6 +48,8 @@ ParsingOutput
 				vuint													editVersion = 0;
 				/// <summary>The code.</summary>
 				WString													code;
+				/// <summary>True if the syntax tree is created by reparsing only the edited part of the previous syntax tree.</summary>
+				bool													incremental = false;
 				/// <summary>The cache created from [T:vl.presentation.controls.RepeatingParsingExecutor.IParsingAnalyzer].</summary>
 				Ptr<DescriptableObject>									cache;
 			};
@@ -241,11 +245,19 @@ RepeatingParsingExecutor
 				collections::SortedList<WString>							semanticIndexMap;
 				collections::Dictionary<vint, TokenMetaData>				tokenMetaDatas;
 				collections::Dictionary<FieldDesc, FieldMetaData>			fieldMetaDatas;
+				collections::SortedList<WString>							leftRecursiveRules;
+
+				bool														incrementalParsing = false;
+				RepeatingParsingOutput										previousOutput;
+				ReaderWriterLock											syntaxTreeLock;
+				volatile vint												lastParsingLatency = -1;
+				volatile bool												lastParsingIncremental = false;
 
 			protected:
 
 				void														Execute(const RepeatingParsingInput& input)override;
 				void														PrepareMetaData();
+				Ptr<parsing::ParsingTreeObject>								ParseIncrementally(const RepeatingParsingInput& input);
 
 				/// <summary>Called when semantic analyzing is needed. It is encouraged to set the "cache" fields in "context" argument. If there is an <see cref="RepeatingParsingExecutor::IParsingAnalyzer"/> binded to the <see cref="RepeatingParsingExecutor"/>, this function can be automatically done.</summary>
 				/// <param name="context">The parsing result.</param>
@@ -280,6 +292,24 @@ RepeatingParsingExecutor
 				/// <summary>Get the parsing analyzer.</summary>
 				/// <returns>The parsing analyzer.</returns>
 				Ptr<IParsingAnalyzer>										GetAnalyzer();
+				/// <summary>Test if the incremental parsing is enabled.</summary>
+				/// <returns>Returns true if the incremental parsing is enabled.</returns>
+				bool														GetIncrementalParsing();
+				/// <summary>Enable or disable the incremental parsing. When it is enabled, only the deepest syntax tree node that contains the edited part of the code is reparsed using the rule that created it, and the previous syntax tree is updated in place. If the edited part could not be reparsed alone, the whole code is parsed. Code that reads a syntax tree from this executor outside of the parsing thread should hold <see cref="GetSyntaxTreeLock"/> for reading.</summary>
+				/// <param name="value">Set to true to enable the incremental parsing.</param>
+				void														SetIncrementalParsing(bool value);
+				/// <summary>Get the time in milliseconds from submitting the code to notifying all callbacks with the parsing result, for the last finished parsing.</summary>
+				/// <returns>The latency. Returns -1 if no parsing has been finished.</returns>
+				vint														GetLastParsingLatency();
+				/// <summary>Get the lock that protects syntax trees from being updated by the incremental parsing.</summary>
+				/// <returns>The lock. The parsing thread holds it for writing when updating the previous syntax tree.</returns>
+				ReaderWriterLock&											GetSyntaxTreeLock();
+				/// <summary>Get the time in milliseconds from a steady clock, which is used to measure the parsing latency.</summary>
+				/// <returns>The time.</returns>
+				static vuint64_t											GetParsingClock();
+				/// <summary>Test if the last finished parsing is done incrementally.</summary>
+				/// <returns>Returns true if the last finished parsing is done incrementally.</returns>
+				bool														GetLastParsingIncremental();
 
 				vint														GetTokenIndex(const WString& tokenName);
 				vint														GetSemanticId(const WString& name);
@@ -42,5 +42,7 @@ using namespace vl::presentation::templates;
 extern int SetupWindowsGDIRenderer();
 extern int SetupWindowsDirect2DRenderer();
 extern int SetupOSXCoreGraphicsRenderer();
+extern int SetupHeadlessRenderer();
+extern int SetupSoftwareRenderer();
 
 #endif
\ No newline at end of file
@@ -22,7 +22,7 @@ GuiWindowComposition
 			{
 			}
 
-			Rect GuiWindowComposition::GetBounds()
+			Rect GuiWindowComposition::CalculateBounds()
 			{
 				Rect bounds;
 				if (relatedHostRecord)
@@ -60,6 +60,7 @@ GuiBoundsComposition
 			void GuiBoundsComposition::SetSizeAffectParent(bool value)
 			{
 				sizeAffectParent = value;
+				InvokeOnCompositionStateChanged();
 			}
 
 			bool GuiBoundsComposition::IsSizeAffectParent()
@@ -67,7 +68,7 @@ GuiBoundsComposition
 				return sizeAffectParent;
 			}
 
-			Rect GuiBoundsComposition::GetPreferredBounds()
+			Rect GuiBoundsComposition::CalculatePreferredBounds()
 			{
 				Rect result = GetBoundsInternal(compositionBounds);
 				if (GetParent() && IsAlignedToParent())
@@ -96,7 +97,7 @@ GuiBoundsComposition
 				return result;
 			}
 
-			Rect GuiBoundsComposition::GetBounds()
+			Rect GuiBoundsComposition::CalculateBounds()
 			{
 				Rect result = GetPreferredBounds();
 				if (GetParent() && IsAlignedToParent())
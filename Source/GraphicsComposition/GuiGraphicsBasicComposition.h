@@ -27,11 +27,12 @@ Basic Compositions
 			/// </summary>
 			class GuiWindowComposition : public GuiGraphicsSite, public Description<GuiWindowComposition>
 			{
+			protected:
+				Rect								CalculateBounds()override;
 			public:
 				GuiWindowComposition();
 				~GuiWindowComposition();
 
-				Rect								GetBounds()override;
 				void								SetMargin(Margin value)override;
 			};
 
@@ -45,6 +46,8 @@ Basic Compositions
 				Rect								compositionBounds;
 				Margin								alignmentToParent{ -1,-1,-1,-1 };
 				
+				Rect								CalculatePreferredBounds()override;
+				Rect								CalculateBounds()override;
 			public:
 				GuiBoundsComposition();
 				~GuiBoundsComposition();
@@ -57,8 +60,6 @@ Basic Compositions
 				void								SetSizeAffectParent(bool value);
 				
 				bool								IsSizeAffectParent()override;
-				Rect								GetPreferredBounds()override;
-				Rect								GetBounds()override;
 				/// <summary>Set the expected bounds.</summary>
 				/// <param name="value">The expected bounds.</param>
 				void								SetBounds(Rect value);
@@ -130,9 +130,9 @@ GuiSharedSizeRootComposition
 				FOREACH(GuiSharedSizeItemComposition*, item, childItems)
 				{
 					auto group = item->GetGroup();
-					auto minSize = item->GetPreferredMinSize();
-					item->SetPreferredMinSize(Size(0, 0));
-					auto size = item->GetPreferredBounds().GetSize();
+					auto minSize = item->preferredMinSize;
+					item->preferredMinSize = Size(0, 0);
+					auto size = item->CalculatePreferredBounds().GetSize();
 
 					if (item->GetSharedWidth())
 					{
@@ -143,7 +143,7 @@ GuiSharedSizeRootComposition
 						AddSizeComponent(heights, group, size.y);
 					}
 
-					item->SetPreferredMinSize(minSize);
+					item->preferredMinSize = minSize;
 				}
 			}
 
@@ -163,7 +163,10 @@ GuiSharedSizeRootComposition
 						size.y = heights[group];
 					}
 
-					item->SetPreferredMinSize(size);
+					if (item->GetPreferredMinSize() != size)
+					{
+						item->SetPreferredMinSize(size);
+					}
 				}
 			}
 
@@ -190,7 +193,7 @@ GuiSharedSizeRootComposition
 				GuiBoundsComposition::ForceCalculateSizeImmediately();
 			}
 
-			Rect GuiSharedSizeRootComposition::GetBounds()
+			Rect GuiSharedSizeRootComposition::CalculateBounds()
 			{
 				Dictionary<WString, vint> widths, heights;
 				CollectSizes(widths, heights);
@@ -203,7 +206,7 @@ GuiSharedSizeRootComposition
 					AlignSizes(itemWidths, itemHeights);
 					GuiBoundsComposition::ForceCalculateSizeImmediately();
 				}
-				return GuiBoundsComposition::GetBounds();
+				return GuiBoundsComposition::CalculateBounds();
 			}
 
 /***********************************************************************
@@ -43,6 +43,7 @@ namespace vl
 			/// <summary>A shared size composition that shares the same size with all other <see cref="GuiSharedSizeItemComposition"/> that has a same group name.</summary>
 			class GuiSharedSizeItemComposition : public GuiBoundsComposition, public Description<GuiSharedSizeItemComposition>
 			{
+				friend class GuiSharedSizeRootComposition;
 			protected:
 				GuiSharedSizeRootComposition*						parentRoot;
 				WString												group;
@@ -88,12 +89,12 @@ namespace vl
 				void												CollectSizes(collections::Dictionary<WString, vint>& widths, collections::Dictionary<WString, vint>& heights);
 				void												AlignSizes(collections::Dictionary<WString, vint>& widths, collections::Dictionary<WString, vint>& heights);
 				void												UpdateBounds();
+				Rect												CalculateBounds()override;
 			public:
 				GuiSharedSizeRootComposition();
 				~GuiSharedSizeRootComposition();
 
 				void												ForceCalculateSizeImmediately()override;
-				Rect												GetBounds()override;
 			};
 
 			/// <summary>A base class for all bindable repeat compositions.</summary>
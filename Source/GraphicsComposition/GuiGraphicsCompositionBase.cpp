@@ -16,6 +16,11 @@ namespace vl
 				composition->InvokeOnCompositionStateChanged();
 			}
 
+			void InvokeOnElementStateChanged(compositions::GuiGraphicsComposition* composition)
+			{
+				composition->InvokeOnElementStateChanged();
+			}
+
 /***********************************************************************
 GuiGraphicsComposition
 ***********************************************************************/
@@ -72,6 +77,7 @@ GuiGraphicsComposition
 			void GuiGraphicsComposition::UpdateRelatedHostRecord(GraphicsHostRecord* record)
 			{
 				relatedHostRecord = record;
+				ClearLayoutCache();
 				auto renderTarget = GetRenderTarget();
 
 				if (ownedElement)
@@ -120,12 +126,238 @@ GuiGraphicsComposition
 
 			void GuiGraphicsComposition::InvokeOnCompositionStateChanged()
 			{
+				InvalidateLayout();
 				if (relatedHostRecord)
 				{
 					relatedHostRecord->host->RequestRender();
 				}
 			}
 
+			void GuiGraphicsComposition::InvokeOnElementStateChanged()
+			{
+				if (preferredBoundsCached && cachedElementMinSize == GetOwnedElementMinSize())
+				{
+					// the layout is not affected, only the area that this composition occupied needs to be rendered again
+					if (relatedHostRecord)
+					{
+						relatedHostRecord->host->RequestPartialRender(renderedBounds);
+					}
+				}
+				else
+				{
+					InvokeOnCompositionStateChanged();
+				}
+			}
+
+			Size GuiGraphicsComposition::GetOwnedElementMinSize()
+			{
+				if (ownedElement)
+				{
+					if (auto renderer = ownedElement->GetRenderer())
+					{
+						return renderer->GetMinSize();
+					}
+				}
+				return Size();
+			}
+
+			void GuiGraphicsComposition::InvalidateLayout()
+			{
+				// the bounds of sub compositions could depend on properties of this composition
+				InvalidateChildrenBounds();
+
+				// the preferred bounds of all ancestors depend on this composition
+				auto composition = this;
+				while (composition)
+				{
+					composition->preferredBoundsCached = false;
+					composition->layoutVersion++;
+					composition = composition->parent;
+				}
+
+				// the hit test result of the graphics host could depend on this composition
+				if (relatedHostRecord)
+				{
+					relatedHostRecord->layoutVersion++;
+				}
+			}
+
+			void GuiGraphicsComposition::InvalidateChildrenBounds()
+			{
+				childrenBoundsVersion++;
+			}
+
+			void GuiGraphicsComposition::ClearLayoutCache()
+			{
+				preferredBoundsCached = false;
+				cachedBoundsVersion = 0;
+				hitTestIndex = nullptr;
+			}
+
+			GuiGraphicsComposition::HitTestIndex* GuiGraphicsComposition::GetHitTestIndex()
+			{
+				if (!relatedHostRecord || children.Count() < HitTestIndexThreshold)
+				{
+					hitTestIndex = nullptr;
+					return nullptr;
+				}
+				if (!hitTestIndex)
+				{
+					hitTestIndex = new HitTestIndex;
+				}
+				HitTestIndex& index = *hitTestIndex.Obj();
+				if (index.layoutVersion == layoutVersion && index.childrenBoundsVersion == childrenBoundsVersion)
+				{
+					return &index;
+				}
+
+				// sub compositions could move only when the layout of this composition or any sub composition is changed
+				vint version = layoutVersion;
+				vint boundsVersion = childrenBoundsVersion;
+				vint count = children.Count();
+				bool moved = index.childBounds.Count() != count;
+				if (moved)
+				{
+					index.childBounds.Resize(count);
+				}
+				for (vint i = 0; i < count; i++)
+				{
+					GuiGraphicsComposition* child = children[i];
+					Rect childBounds = child->visible ? child->GetBounds() : Rect();
+					if (index.childBounds[i] != childBounds)
+					{
+						index.childBounds[i] = childBounds;
+						moved = true;
+					}
+				}
+
+				if (moved)
+				{
+					BuildHitTestIndex(index);
+				}
+				bool stable = layoutVersion == version && childrenBoundsVersion == boundsVersion;
+				index.layoutVersion = stable ? version : 0;
+				index.childrenBoundsVersion = stable ? boundsVersion : 0;
+				return &index;
+			}
+
+			void GuiGraphicsComposition::BuildHitTestIndex(HitTestIndex& index)
+			{
+				vint count = index.childBounds.Count();
+				Rect area;
+				vint totalWidth = 0;
+				vint totalHeight = 0;
+				vint indexed = 0;
+				for (vint i = 0; i < count; i++)
+				{
+					Rect childBounds = index.childBounds[i];
+					if (childBounds.Width() <= 0 || childBounds.Height() <= 0) continue;
+					if (indexed == 0)
+					{
+						area = childBounds;
+					}
+					else
+					{
+						if (area.x1 > childBounds.x1) area.x1 = childBounds.x1;
+						if (area.y1 > childBounds.y1) area.y1 = childBounds.y1;
+						if (area.x2 < childBounds.x2) area.x2 = childBounds.x2;
+						if (area.y2 < childBounds.y2) area.y2 = childBounds.y2;
+					}
+					totalWidth += childBounds.Width();
+					totalHeight += childBounds.Height();
+					indexed++;
+				}
+
+				// cells are about the average size of sub compositions, so a stack gets one column or one row
+				vint columns = 1;
+				vint rows = 1;
+				if (indexed > 0)
+				{
+					vint averageWidth = totalWidth / indexed;
+					vint averageHeight = totalHeight / indexed;
+					columns = (area.Width() + averageWidth - 1) / averageWidth;
+					rows = (area.Height() + averageHeight - 1) / averageHeight;
+
+					vint maxCells = count * 4 < HitTestIndexMaxCells ? count * 4 : HitTestIndexMaxCells;
+					while (columns * rows > maxCells)
+					{
+						if (columns > 1) columns = (columns + 1) / 2;
+						if (rows > 1) rows = (rows + 1) / 2;
+					}
+				}
+
+				index.area = area;
+				index.columns = columns;
+				index.rows = rows;
+				index.cellSize = Size((area.Width() + columns - 1) / columns, (area.Height() + rows - 1) / rows);
+				if (index.cellSize.x < 1) index.cellSize.x = 1;
+				if (index.cellSize.y < 1) index.cellSize.y = 1;
+				index.childMarks.Resize(count);
+				for (vint i = 0; i < count; i++)
+				{
+					index.childMarks[i] = false;
+				}
+
+				// count sub compositions for each cell, and then fill them in reverse z-order
+				vint cellCount = index.columns * index.rows;
+				index.cellStarts.Resize(cellCount + 1);
+				for (vint i = 0; i <= cellCount; i++)
+				{
+					index.cellStarts[i] = 0;
+				}
+				for (vint pass = 0; pass < 2; pass++)
+				{
+					for (vint i = count - 1; i >= 0; i--)
+					{
+						Rect childBounds = index.childBounds[i];
+						if (childBounds.Width() <= 0 || childBounds.Height() <= 0) continue;
+						vint column1 = (childBounds.x1 - area.x1) / index.cellSize.x;
+						vint column2 = (childBounds.x2 - 1 - area.x1) / index.cellSize.x;
+						vint row1 = (childBounds.y1 - area.y1) / index.cellSize.y;
+						vint row2 = (childBounds.y2 - 1 - area.y1) / index.cellSize.y;
+						for (vint row = row1; row <= row2; row++)
+						{
+							for (vint column = column1; column <= column2; column++)
+							{
+								vint cell = row * index.columns + column;
+								if (pass == 0)
+								{
+									index.cellStarts[cell + 1]++;
+								}
+								else
+								{
+									index.cellChildren[index.cellStarts[cell]++] = i;
+								}
+							}
+						}
+					}
+
+					if (pass == 0)
+					{
+						for (vint i = 0; i < cellCount; i++)
+						{
+							index.cellStarts[i + 1] += index.cellStarts[i];
+						}
+						index.cellChildren.Resize(index.cellStarts[cellCount]);
+					}
+					else
+					{
+						// filling moves each start to the next cell
+						for (vint i = cellCount; i > 0; i--)
+						{
+							index.cellStarts[i] = index.cellStarts[i - 1];
+						}
+						index.cellStarts[0] = 0;
+					}
+				}
+			}
+
+			GuiGraphicsComposition* GuiGraphicsComposition::FindCompositionInChild(GuiGraphicsComposition* child, Point clientLocation, bool forMouseEvent)
+			{
+				Rect childBounds = child->GetBounds();
+				return child->FindComposition(clientLocation - Size(childBounds.x1, childBounds.y1), forMouseEvent);
+			}
+
 			bool GuiGraphicsComposition::SharedPtrDestructorProc(DescriptableObject* obj, bool forceDisposing)
 			{
 				GuiGraphicsComposition* value=dynamic_cast<GuiGraphicsComposition*>(obj);
@@ -289,12 +521,24 @@ GuiGraphicsComposition
 						bounds.y1 += offset.y;
 						bounds.y2 += offset.y;
 
+						renderedBounds = bounds;
+						if (!bounds.IntersectWith(renderTarget->GetClipper()))
+						{
+							relatedHostRecord->culledCompositions++;
+							return;
+						}
+
 						if (ownedElement)
 						{
 							IGuiGraphicsRenderer* renderer = ownedElement->GetRenderer();
 							if (renderer)
 							{
+								relatedHostRecord->drawnElements++;
 								renderer->Render(bounds);
+								if (preferredBoundsCached && cachedElementMinSize != renderer->GetMinSize())
+								{
+									InvokeOnCompositionStateChanged();
+								}
 							}
 						}
 						if (children.Count() > 0)
@@ -309,9 +553,16 @@ GuiGraphicsComposition
 								renderTarget->PushClipper(bounds);
 								if (!renderTarget->IsClipperCoverWholeTarget())
 								{
-									for (vint i = 0; i < children.Count(); i++)
+									if (auto index = GetHitTestIndex())
 									{
-										children[i]->Render(Size(bounds.x1, bounds.y1));
+										RenderIndexedChildren(index, Size(bounds.x1, bounds.y1));
+									}
+									else
+									{
+										for (vint i = 0; i < children.Count(); i++)
+										{
+											children[i]->Render(Size(bounds.x1, bounds.y1));
+										}
 									}
 								}
 								renderTarget->PopClipper();
@@ -321,6 +572,56 @@ GuiGraphicsComposition
 				}
 			}
 
+			void GuiGraphicsComposition::RenderIndexedChildren(HitTestIndex* index, Size offset)
+			{
+				// only sub compositions in cells that overlap the clipper could be rendered
+				Rect clipper = GetRenderTarget()->GetClipper();
+				vint x1 = clipper.x1 - offset.x - index->area.x1;
+				vint y1 = clipper.y1 - offset.y - index->area.y1;
+				vint x2 = clipper.x2 - offset.x - index->area.x1;
+				vint y2 = clipper.y2 - offset.y - index->area.y1;
+				if (x1 < 0) x1 = 0;
+				if (y1 < 0) y1 = 0;
+				if (x2 > index->area.Width()) x2 = index->area.Width();
+				if (y2 > index->area.Height()) y2 = index->area.Height();
+
+				// a sub composition could appear in multiple cells, mark them by their positions to render each of them once in z-order
+				vint first = children.Count();
+				vint last = -1;
+				if (x1 < x2 && y1 < y2)
+				{
+					for (vint row = y1 / index->cellSize.y; row <= (y2 - 1) / index->cellSize.y; row++)
+					{
+						for (vint column = x1 / index->cellSize.x; column <= (x2 - 1) / index->cellSize.x; column++)
+						{
+							vint cell = row * index->columns + column;
+							for (vint i = index->cellStarts[cell]; i < index->cellStarts[cell + 1]; i++)
+							{
+								vint child = index->cellChildren[i];
+								if (!index->childMarks[child])
+								{
+									index->childMarks[child] = true;
+									if (first > child) first = child;
+									if (last < child) last = child;
+								}
+							}
+						}
+					}
+				}
+
+				vint rendered = 0;
+				for (vint i = first; i <= last; i++)
+				{
+					if (index->childMarks[i])
+					{
+						index->childMarks[i] = false;
+						children[i]->Render(offset);
+						rendered++;
+					}
+				}
+				relatedHostRecord->culledCompositions += children.Count() - rendered;
+			}
+
 			GuiGraphicsEventReceiver* GuiGraphicsComposition::GetEventReceiver()
 			{
 				if(!eventReceiver)
@@ -343,17 +644,31 @@ GuiGraphicsComposition
 				if (relativeBounds.Contains(location))
 				{
 					Rect clientArea = GetClientArea();
-					for (vint i = children.Count() - 1; i >= 0; i--)
+					Point clientLocation = location - Size(clientArea.x1 - bounds.x1, clientArea.y1 - bounds.y1);
+					if (auto index = GetHitTestIndex())
 					{
-						GuiGraphicsComposition* child = children[i];
-						Rect childBounds = child->GetBounds();
-						vint offsetX = childBounds.x1 + (clientArea.x1 - bounds.x1);
-						vint offsetY = childBounds.y1 + (clientArea.y1 - bounds.y1);
-						Point newLocation = location - Size(offsetX, offsetY);
-						GuiGraphicsComposition* childResult = child->FindComposition(newLocation, forMouseEvent);
-						if (childResult)
+						if (index->area.Contains(clientLocation))
+						{
+							vint column = (clientLocation.x - index->area.x1) / index->cellSize.x;
+							vint row = (clientLocation.y - index->area.y1) / index->cellSize.y;
+							vint cell = row * index->columns + column;
+							for (vint i = index->cellStarts[cell]; i < index->cellStarts[cell + 1]; i++)
+							{
+								if (auto childResult = FindCompositionInChild(children[index->cellChildren[i]], clientLocation, forMouseEvent))
+								{
+									return childResult;
+								}
+							}
+						}
+					}
+					else
+					{
+						for (vint i = children.Count() - 1; i >= 0; i--)
 						{
-							return childResult;
+							if (auto childResult = FindCompositionInChild(children[i], clientLocation, forMouseEvent))
+							{
+								return childResult;
+							}
 						}
 					}
 
@@ -372,7 +687,14 @@ GuiGraphicsComposition
 
 			void GuiGraphicsComposition::SetTransparentToMouse(bool value)
 			{
-				transparentToMouse = value;
+				if (transparentToMouse != value)
+				{
+					transparentToMouse = value;
+					if (relatedHostRecord)
+					{
+						relatedHostRecord->hitTestVersion++;
+					}
+				}
 			}
 
 			Rect GuiGraphicsComposition::GetGlobalBounds()
@@ -520,6 +842,68 @@ GuiGraphicsComposition
 				return bounds;
 			}
 
+			Rect GuiGraphicsComposition::GetPreferredBounds()
+			{
+				if (!relatedHostRecord)
+				{
+					return CalculatePreferredBounds();
+				}
+
+				if (preferredBoundsCached)
+				{
+					if (cachedElementMinSize == GetOwnedElementMinSize())
+					{
+						return cachedPreferredBounds;
+					}
+					InvokeOnCompositionStateChanged();
+				}
+
+				vint version = layoutVersion;
+				Size elementMinSize = GetOwnedElementMinSize();
+				Rect bounds = CalculatePreferredBounds();
+				if (relatedHostRecord && layoutVersion == version)
+				{
+					preferredBoundsCached = true;
+					cachedPreferredBounds = bounds;
+					cachedElementMinSize = elementMinSize;
+				}
+				return bounds;
+			}
+
+			Rect GuiGraphicsComposition::GetBounds()
+			{
+				if (!relatedHostRecord)
+				{
+					return CalculateBounds();
+				}
+
+				// the bounds of this composition depend on the parent composition, which is updated first
+				vint parentVersion = 0;
+				if (parent)
+				{
+					parent->GetBounds();
+					parentVersion = parent->childrenBoundsVersion;
+				}
+				if (cachedBoundsVersion == layoutVersion && cachedParentBoundsVersion == parentVersion)
+				{
+					return cachedBounds;
+				}
+
+				vint version = layoutVersion;
+				Rect bounds = CalculateBounds();
+				if (cachedBounds != bounds)
+				{
+					cachedBounds = bounds;
+					InvalidateChildrenBounds();
+				}
+				if (relatedHostRecord && layoutVersion == version && (parent ? parent->childrenBoundsVersion : 0) == parentVersion)
+				{
+					cachedBoundsVersion = version;
+					cachedParentBoundsVersion = parentVersion;
+				}
+				return bounds;
+			}
+
 			void GuiGraphicsComposition::ForceCalculateSizeImmediately()
 			{
 				for (vint i = 0; i < children.Count(); i++)
@@ -603,7 +987,7 @@ GuiGraphicsSite
 				return minSize;
 			}
 
-			Rect GuiGraphicsSite::GetPreferredBounds()
+			Rect GuiGraphicsSite::CalculatePreferredBounds()
 			{
 				return GetBoundsInternal(Rect(Point(0, 0), GetMinPreferredClientSize()));
 			}
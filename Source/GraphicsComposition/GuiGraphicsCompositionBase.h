@@ -43,6 +43,7 @@ Basic Construction
 				friend class controls::GuiControl;
 				friend class GuiGraphicsHost;
 				friend void InvokeOnCompositionStateChanged(compositions::GuiGraphicsComposition* composition);
+				friend void InvokeOnElementStateChanged(compositions::GuiGraphicsComposition* composition);
 			public:
 				/// <summary>
 				/// Minimum size limitation.
@@ -57,6 +58,11 @@ Basic Construction
 					LimitToElementAndChildren,
 				};
 
+				/// <summary>The minimum number of sub compositions to index them by a grid for <see cref="FindComposition"/>.</summary>
+				static const vint							HitTestIndexThreshold = 32;
+				/// <summary>The maximum number of cells of the grid to index sub compositions.</summary>
+				static const vint							HitTestIndexMaxCells = 4096;
+
 			protected:
 
 				struct GraphicsHostRecord
@@ -64,6 +70,25 @@ Basic Construction
 					GuiGraphicsHost*						host = nullptr;
 					elements::IGuiGraphicsRenderTarget*		renderTarget = nullptr;
 					INativeWindow*							nativeWindow = nullptr;
+					vint									layoutVersion = 1;
+					vint									hitTestVersion = 1;
+					vint									drawnElements = 0;
+					vint									culledCompositions = 0;
+				};
+
+				// sub compositions by the grid cells they overlap, in reverse z-order
+				struct HitTestIndex
+				{
+					vint									layoutVersion = 0;
+					vint									childrenBoundsVersion = 0;
+					collections::Array<Rect>				childBounds;
+					Rect									area;
+					Size									cellSize;
+					vint									columns = 0;
+					vint									rows = 0;
+					collections::Array<vint>				cellStarts;
+					collections::Array<vint>				cellChildren;
+					collections::Array<bool>				childMarks;
 				};
 
 			protected:
@@ -84,6 +109,17 @@ Basic Construction
 				Margin										internalMargin;
 				Size										preferredMinSize;
 
+				bool										preferredBoundsCached = false;
+				Rect										cachedPreferredBounds;
+				Size										cachedElementMinSize;
+				vint										layoutVersion = 1;
+				vint										childrenBoundsVersion = 1;
+				vint										cachedBoundsVersion = 0;
+				vint										cachedParentBoundsVersion = 0;
+				Rect										cachedBounds;
+				Rect										renderedBounds;
+				Ptr<HitTestIndex>							hitTestIndex;
+
 				virtual void								OnControlParentChanged(controls::GuiControl* control);
 				virtual void								OnChildInserted(GuiGraphicsComposition* child);
 				virtual void								OnChildRemoved(GuiGraphicsComposition* child);
@@ -94,6 +130,22 @@ Basic Construction
 				void										UpdateRelatedHostRecord(GraphicsHostRecord* record);
 				void										SetAssociatedControl(controls::GuiControl* control);
 				void										InvokeOnCompositionStateChanged();
+				void										InvokeOnElementStateChanged();
+				Size										GetOwnedElementMinSize();
+				void										InvalidateLayout();
+				void										InvalidateChildrenBounds();
+				void										ClearLayoutCache();
+				HitTestIndex*								GetHitTestIndex();
+				void										BuildHitTestIndex(HitTestIndex& index);
+				GuiGraphicsComposition*						FindCompositionInChild(GuiGraphicsComposition* child, Point clientLocation, bool forMouseEvent);
+				void										RenderIndexedChildren(HitTestIndex* index, Size offset);
+
+				/// <summary>Calculate the preferred bounds. The result is cached by <see cref="GetPreferredBounds"/> until the layout of this composition or any sub composition is changed.</summary>
+				/// <returns>The preferred bounds.</returns>
+				virtual Rect								CalculatePreferredBounds()=0;
+				/// <summary>Calculate the bounds. The result is cached by <see cref="GetBounds"/> until the layout of this composition or any sub composition is changed, or the parent composition requires sub compositions to calculate the bounds again.</summary>
+				/// <returns>The bounds.</returns>
+				virtual Rect								CalculateBounds()=0;
 
 				static bool									SharedPtrDestructorProc(DescriptableObject* obj, bool forceDisposing);
 			public:
@@ -147,7 +199,7 @@ Basic Construction
 				/// <returns>The binded render target.</returns>
 				elements::IGuiGraphicsRenderTarget*			GetRenderTarget();
 
-				/// <summary>Render the composition using an offset.</summary>
+				/// <summary>Render the composition using an offset. A composition that does not intersect the clipper is skipped with all sub compositions, before its element is rendered.</summary>
 				/// <param name="offset">The offset.</param>
 				void										Render(Size offset);
 				/// <summary>Get the event receiver object. All user input events can be found in this object. If an event receiver is never been requested from the composition, the event receiver will not be created, and all route events will not pass through this event receiver(performance will be better).</summary>
@@ -156,7 +208,7 @@ Basic Construction
 				/// <summary>Test if any event receiver has already been requested.</summary>
 				/// <returns>Returns true if any event receiver has already been requested.</returns>
 				bool										HasEventReceiver();
-				/// <summary>Find a deepest composition that under a specified location. If the location is inside a compsition but not hit any sub composition, this function will return this composition.</summary>
+				/// <summary>Find a deepest composition that under a specified location. If the location is inside a compsition but not hit any sub composition, this function will return this composition. When there are many sub compositions, only those overlapping the location are tested, by a grid that is built again after the layout is changed.</summary>
 				/// <returns>The deepest composition that under a specified location.</returns>
 				/// <param name="location">The specified location.</param>
 				/// <param name="forMouseEvent">Find a composition for mouse event, it will ignore all compositions that are transparent to mouse events.</param>
@@ -233,12 +285,12 @@ Basic Construction
 				/// <summary>Get the preferred minimum client size.</summary>
 				/// <returns>The preferred minimum client size.</returns>
 				virtual Size								GetMinPreferredClientSize()=0;
-				/// <summary>Get the preferred bounds.</summary>
+				/// <summary>Get the preferred bounds. To change the preferred bounds, override <see cref="CalculatePreferredBounds"/>.</summary>
 				/// <returns>The preferred bounds.</returns>
-				virtual Rect								GetPreferredBounds()=0;
-				/// <summary>Get the bounds.</summary>
+				Rect										GetPreferredBounds();
+				/// <summary>Get the bounds. To change the bounds, override <see cref="CalculateBounds"/>.</summary>
 				/// <returns>The bounds.</returns>
-				virtual Rect								GetBounds()=0;
+				Rect										GetBounds();
 			};
 
 			/// <summary>
@@ -255,6 +307,7 @@ Basic Construction
 				virtual Rect						GetBoundsInternal(Rect expectedBounds);
 
 				void								UpdatePreviousBounds(Rect bounds);
+				Rect								CalculatePreferredBounds()override;
 			public:
 				GuiGraphicsSite();
 				~GuiGraphicsSite();
@@ -264,7 +317,6 @@ Basic Construction
 				
 				bool								IsSizeAffectParent()override;
 				Size								GetMinPreferredClientSize()override;
-				Rect								GetPreferredBounds()override;
 			};
 
 /***********************************************************************
@@ -38,6 +38,7 @@ Event Receiver
 				,lostFocus(_sender)
 				,caretNotify(_sender)
 				,clipboardNotify(_sender)
+				,renderTargetChanged(_sender)
 			{
 			}
 
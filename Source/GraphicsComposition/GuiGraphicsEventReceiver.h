@@ -52,7 +52,7 @@ Event
 			};
 
 			template<typename T>
-			class GuiGraphicsEvent : public Object, public Description<GuiGraphicsEvent<T>>
+			class GuiGraphicsEvent
 			{
 			public:
 				typedef void(RawFunctionType)(GuiGraphicsComposition*, T&);
@@ -63,6 +63,7 @@ Event
 				{
 				public:
 					bool					isAttached = true;
+					vint					index = -1;
 					FunctionType			handler;
 
 					FunctionHandler(const FunctionType& _handler)
@@ -81,32 +82,56 @@ Event
 					}
 				};
 			protected:
-				struct HandlerNode
-				{
-					Ptr<FunctionHandler>								handler;
-					Ptr<HandlerNode>									next;
+				// Handlers are stored in a flat list that is only allocated when the first handler is attached.
+				// A detached handler leaves an empty slot, slots are compacted when at least half of them are empty.
+				// The storage is reference counted so that an executing event survives the destruction of its owner.
+				struct HandlerStorage
+				{
+					collections::List<Ptr<FunctionHandler>>				handlers;
+					vint												references = 1;
+					vint												executing = 0;
+					vint												detached = 0;
 				};
 
 				GuiGraphicsComposition*									sender;
-				Ptr<HandlerNode>										handlers;
+				HandlerStorage*											storage = nullptr;
 
-				bool Attach(Ptr<FunctionHandler> handler)
+				static void ReleaseStorage(HandlerStorage* target)
 				{
-					Ptr<HandlerNode>* currentHandler = &handlers;
-					while (*currentHandler)
+					if (--target->references == 0)
 					{
-						if ((*currentHandler)->handler == handler)
-						{
-							return false;
-						}
-						else
+						delete target;
+					}
+				}
+
+				static void CompactStorage(HandlerStorage* target)
+				{
+					if (target->executing > 0 || target->detached == 0 || target->detached * 2 < target->handlers.Count())
+					{
+						return;
+					}
+
+					vint count = 0;
+					for (vint i = 0; i < target->handlers.Count(); i++)
+					{
+						auto handler = target->handlers[i];
+						if (handler)
 						{
-							currentHandler = &(*currentHandler)->next;
+							handler->index = count;
+							target->handlers.Set(count++, handler);
 						}
 					}
-					(*currentHandler) = new HandlerNode;
-					(*currentHandler)->handler = handler;
-					return true;
+					target->handlers.RemoveRange(count, target->handlers.Count() - count);
+					target->detached = 0;
+				}
+
+				void Attach(Ptr<FunctionHandler> handler)
+				{
+					if (!storage)
+					{
+						storage = new HandlerStorage;
+					}
+					handler->index = storage->handlers.Add(handler);
 				}
 			public:
 				GuiGraphicsEvent(GuiGraphicsComposition* _sender=0)
@@ -114,8 +139,17 @@ Event
 				{
 				}
 
+				GuiGraphicsEvent(const GuiGraphicsEvent<T>&) = delete;
+				GuiGraphicsEvent<T>& operator=(const GuiGraphicsEvent<T>&) = delete;
+
 				~GuiGraphicsEvent()
 				{
+					if (storage)
+					{
+						// if the owner is destroyed in a handler, the remaining handlers are not executed
+						storage->handlers.Clear();
+						ReleaseStorage(storage);
+					}
 				}
 
 				GuiGraphicsComposition* GetAssociatedComposition()
@@ -128,6 +162,11 @@ Event
 					sender=_sender;
 				}
 
+				bool HasHandlers()
+				{
+					return storage && storage->handlers.Count() > storage->detached;
+				}
+
 				template<typename TClass, typename TMethod>
 				Ptr<IGuiGraphicsEventHandler> AttachMethod(TClass* receiver, TMethod TClass::* method)
 				{
@@ -161,38 +200,56 @@ Event
 				bool Detach(Ptr<IGuiGraphicsEventHandler> handler)
 				{
 					auto typedHandler = handler.Cast<FunctionHandler>();
-					if (!typedHandler)
+					if (!typedHandler || !storage)
 					{
 						return false;
 					}
 
-					auto currentHandler=&handlers;
-					while(*currentHandler)
+					vint index = typedHandler->index;
+					if (index < 0 || index >= storage->handlers.Count() || storage->handlers[index] != typedHandler)
 					{
-						if((*currentHandler)->handler == typedHandler)
-						{
-							(*currentHandler)->handler->isAttached = false;
+						return false;
+					}
 
-							auto next=(*currentHandler)->next;
-							(*currentHandler)=next;
-							return true;
-						}
-						else
-						{
-							currentHandler=&(*currentHandler)->next;
-						}
+					typedHandler->isAttached = false;
+					typedHandler->index = -1;
+					storage->handlers.Set(index, nullptr);
+					storage->detached++;
+
+					if (storage->executing == 0 && storage->detached == storage->handlers.Count())
+					{
+						ReleaseStorage(storage);
+						storage = nullptr;
+					}
+					else
+					{
+						CompactStorage(storage);
 					}
-					return false;
+					return true;
 				}
 
 				void ExecuteWithNewSender(T& argument, GuiGraphicsComposition* newSender)
 				{
-					auto currentHandler=&handlers;
-					while(*currentHandler)
+					if (!storage)
 					{
-						(*currentHandler)->handler->Execute(newSender?newSender:sender, argument);
-						currentHandler=&(*currentHandler)->next;
+						return;
+					}
+
+					auto target = storage;
+					auto actualSender = newSender ? newSender : sender;
+					target->references++;
+					target->executing++;
+					for (vint i = 0; i < target->handlers.Count(); i++)
+					{
+						auto handler = target->handlers[i];
+						if (handler)
+						{
+							handler->Execute(actualSender, argument);
+						}
 					}
+					target->executing--;
+					CompactStorage(target);
+					ReleaseStorage(target);
 				}
 
 				void Execute(T& argument)
@@ -420,6 +477,9 @@ Event Receiver
 			/// <summary>
 			/// Contains all available user input events for a <see cref="GuiGraphicsComposition"/>. Almost all events are routed events. Routed events means, not only the activated composition receives the event, all it direct or indirect parents receives the event. The argument(all derives from <see cref="GuiEventArgs"/>) for the event will store the original event raiser composition.
 			/// </summary>
+			// Events are data members because the host and the reflection refer to them by &GuiGraphicsEventReceiver::xxx.
+			// So there is no sparse table per event kind: GetEventReceiver allocates every event (432 bytes on 64-bit platforms),
+			// and only the handler list of an event is allocated when its first handler is attached.
 			class GuiGraphicsEventReceiver : public Object
 			{
 			protected:
@@ -287,7 +287,7 @@ GuiFlowComposition
 				return minSize + Size(x, y);
 			}
 
-			Rect GuiFlowComposition::GetBounds()
+			Rect GuiFlowComposition::CalculateBounds()
 			{
 				if (!needUpdate)
 				{
@@ -306,7 +306,7 @@ GuiFlowComposition
 					UpdateFlowItemBounds(true);
 				}
 
-				bounds = GuiBoundsComposition::GetBounds();
+				bounds = GuiBoundsComposition::CalculateBounds();
 				return bounds;
 			}
 
@@ -339,7 +339,7 @@ GuiFlowItemComposition
 				return false;
 			}
 
-			Rect GuiFlowItemComposition::GetBounds()
+			Rect GuiFlowItemComposition::CalculateBounds()
 			{
 				Rect result = bounds;
 				if(flowParent)
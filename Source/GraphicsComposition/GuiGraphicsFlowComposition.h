@@ -63,6 +63,7 @@ Flow Compositions
 				void								OnBoundsChanged(GuiGraphicsComposition* sender, GuiEventArgs& arguments);
 				void								OnChildInserted(GuiGraphicsComposition* child)override;
 				void								OnChildRemoved(GuiGraphicsComposition* child)override;
+				Rect								CalculateBounds()override;
 			public:
 				GuiFlowComposition();
 				~GuiFlowComposition();
@@ -113,7 +114,6 @@ Flow Compositions
 				
 				void								ForceCalculateSizeImmediately()override;
 				Size								GetMinPreferredClientSize()override;
-				Rect								GetBounds()override;
 			};
 			
 			/// <summary>
@@ -154,12 +154,12 @@ Flow Compositions
 
 				void								OnParentChanged(GuiGraphicsComposition* oldParent, GuiGraphicsComposition* newParent)override;
 				Size								GetMinSize();
+				Rect								CalculateBounds()override;
 			public:
 				GuiFlowItemComposition();
 				~GuiFlowItemComposition();
 				
 				bool								IsSizeAffectParent()override;
-				Rect								GetBounds()override;
 				void								SetBounds(Rect value);
 				
 				/// <summary>Get the extra margin for this flow item. An extra margin is used to enlarge the bounds of the flow item, but only the non-extra part will be used for deciding the flow item layout.</summary>
@@ -64,7 +64,7 @@ GuiSideAlignedComposition
 				return false;
 			}
 
-			Rect GuiSideAlignedComposition::GetBounds()
+			Rect GuiSideAlignedComposition::CalculateBounds()
 			{
 				Rect result;
 				GuiGraphicsComposition* parent = GetParent();
@@ -169,7 +169,7 @@ GuiPartialViewComposition
 				return false;
 			}
 
-			Rect GuiPartialViewComposition::GetBounds()
+			Rect GuiPartialViewComposition::CalculateBounds()
 			{
 				Rect result;
 				GuiGraphicsComposition* parent = GetParent();
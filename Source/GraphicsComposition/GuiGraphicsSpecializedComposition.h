@@ -44,6 +44,8 @@ Specialized Compositions
 				Direction							direction;
 				vint								maxLength;
 				double								maxRatio;
+
+				Rect								CalculateBounds()override;
 			public:
 				GuiSideAlignedComposition();
 				~GuiSideAlignedComposition();
@@ -68,7 +70,6 @@ Specialized Compositions
 				void								SetMaxRatio(double value);
 				
 				bool								IsSizeAffectParent()override;
-				Rect								GetBounds()override;
 			};
 
 			/// <summary>
@@ -82,6 +83,7 @@ Specialized Compositions
 				double								hRatio;
 				double								hPageSize;
 
+				Rect								CalculateBounds()override;
 			public:
 				GuiPartialViewComposition();
 				~GuiPartialViewComposition();
@@ -112,7 +114,6 @@ Specialized Compositions
 				void								SetHeightPageSize(double value);
 				
 				bool								IsSizeAffectParent()override;
-				Rect								GetBounds()override;
 			};
 		}
 	}
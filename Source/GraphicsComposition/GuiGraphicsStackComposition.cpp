@@ -13,6 +13,7 @@ GuiStackComposition
 
 			void GuiStackComposition::UpdateStackItemBounds()
 			{
+				InvalidateChildrenBounds();
 				if (stackItemBounds.Count() != stackItems.Count())
 				{
 					stackItemBounds.Resize(stackItems.Count());
@@ -215,7 +216,7 @@ GuiStackComposition
 				return minSize + Size(x, y);
 			}
 
-			Rect GuiStackComposition::GetBounds()
+			Rect GuiStackComposition::CalculateBounds()
 			{
 				for (vint i = 0; i < stackItems.Count(); i++)
 				{
@@ -226,7 +227,7 @@ GuiStackComposition
 					}
 				}
 
-				Rect bounds = GuiBoundsComposition::GetBounds();
+				Rect bounds = GuiBoundsComposition::CalculateBounds();
 				previousBounds = bounds;
 				UpdatePreviousBounds(previousBounds);
 				return bounds;
@@ -316,7 +317,7 @@ GuiStackItemComposition
 				return false;
 			}
 
-			Rect GuiStackItemComposition::GetBounds()
+			Rect GuiStackItemComposition::CalculateBounds()
 			{
 				Rect result = bounds;
 				if(stackParent)
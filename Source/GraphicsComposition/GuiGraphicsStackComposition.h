@@ -64,6 +64,7 @@ Stack Compositions
 				void								OnBoundsChanged(GuiGraphicsComposition* sender, GuiEventArgs& arguments);
 				void								OnChildInserted(GuiGraphicsComposition* child)override;
 				void								OnChildRemoved(GuiGraphicsComposition* child)override;
+				Rect								CalculateBounds()override;
 			public:
 				GuiStackComposition();
 				~GuiStackComposition();
@@ -92,7 +93,6 @@ Stack Compositions
 				
 				void								ForceCalculateSizeImmediately()override;
 				Size								GetMinPreferredClientSize()override;
-				Rect								GetBounds()override;
 				
 				/// <summary>Get the extra margin inside the stack composition.</summary>
 				/// <returns>The extra margin inside the stack composition.</returns>
@@ -122,12 +122,12 @@ Stack Compositions
 
 				void								OnParentChanged(GuiGraphicsComposition* oldParent, GuiGraphicsComposition* newParent)override;
 				Size								GetMinSize();
+				Rect								CalculateBounds()override;
 			public:
 				GuiStackItemComposition();
 				~GuiStackItemComposition();
 				
 				bool								IsSizeAffectParent()override;
-				Rect								GetBounds()override;
 				/// <summary>Set the expected bounds of a stack item. In most of the cases only the size of the bounds is used.</summary>
 				/// <param name="value">The expected bounds of a stack item.</param>
 				void								SetBounds(Rect value);
@@ -307,6 +307,7 @@ GuiTableComposition
 
 			void GuiTableComposition::UpdateCellBoundsInternal()
 			{
+				InvalidateChildrenBounds();
 				rowOffsets.Resize(rows);
 				rowSizes.Resize(rows);
 				columnOffsets.Resize(columns);
@@ -536,7 +537,7 @@ GuiTableComposition
 
 			Rect GuiTableComposition::GetCellArea()
 			{
-				Rect bounds(Point(0, 0), GuiBoundsComposition::GetBounds().GetSize());
+				Rect bounds(Point(0, 0), GuiBoundsComposition::CalculateBounds().GetSize());
 				vint borderThickness = borderVisible ? cellPadding : 0;
 				bounds.x1 += margin.left + internalMargin.left + borderThickness;
 				bounds.y1 += margin.top + internalMargin.top + borderThickness;
@@ -566,7 +567,7 @@ GuiTableComposition
 				return Size(tableContentMinSize.x + offset, tableContentMinSize.y + offset);
 			}
 
-			Rect GuiTableComposition::GetBounds()
+			Rect GuiTableComposition::CalculateBounds()
 			{
 				Rect result;
 				if (!IsAlignedToParent() && GetMinSizeLimitation() != GuiGraphicsComposition::NoLimit)
@@ -575,7 +576,7 @@ GuiTableComposition
 				}
 				else
 				{
-					result = GuiBoundsComposition::GetBounds();
+					result = GuiBoundsComposition::CalculateBounds();
 				}
 
 				bool cellMinSizeModified = false;
@@ -759,7 +760,7 @@ GuiCellComposition
 				}
 			}
 
-			Rect GuiCellComposition::GetBounds()
+			Rect GuiCellComposition::CalculateBounds()
 			{
 				Rect result;
 				if(tableParent && row!=-1 && column!=-1)
@@ -998,7 +999,7 @@ GuiRowSplitterComposition
 				InvokeOnCompositionStateChanged();
 			}
 
-			Rect GuiRowSplitterComposition::GetBounds()
+			Rect GuiRowSplitterComposition::CalculateBounds()
 			{
 				return GetBoundsHelper(
 					rowsToTheTop,
@@ -1050,7 +1051,7 @@ GuiColumnSplitterComposition
 				InvokeOnCompositionStateChanged();
 			}
 
-			Rect GuiColumnSplitterComposition::GetBounds()
+			Rect GuiColumnSplitterComposition::CalculateBounds()
 			{
 				return GetBoundsHelper(
 					columnsToTheLeft,
@@ -155,6 +155,7 @@ Table Compositions
 				void								UpdateCellBoundsInternal();
 				void								UpdateTableContentMinSize();
 				void								OnRenderContextChanged()override;
+				Rect								CalculateBounds()override;
 			public:
 				GuiTableComposition();
 				~GuiTableComposition();
@@ -216,7 +217,6 @@ Table Compositions
 				
 				void								ForceCalculateSizeImmediately()override;
 				Size								GetMinPreferredClientSize()override;
-				Rect								GetBounds()override;
 			};
 
 			/// <summary>
@@ -239,6 +239,7 @@ Table Compositions
 				bool								SetSiteInternal(vint _row, vint _column, vint _rowSpan, vint _columnSpan);
 				void								OnParentChanged(GuiGraphicsComposition* oldParent, GuiGraphicsComposition* newParent)override;
 				void								OnTableRowsAndColumnsChanged();
+				Rect								CalculateBounds()override;
 			public:
 				GuiCellComposition();
 				~GuiCellComposition();
@@ -267,7 +268,6 @@ Table Compositions
 				/// <param name="_columnSpan">The total numbers of acrossed columns for this cell composition.</param>
 				bool								SetSite(vint _row, vint _column, vint _rowSpan, vint _columnSpan);
 
-				Rect								GetBounds()override;
 			};
 
 			class GuiTableSplitterCompositionBase : public GuiGraphicsSite, public Description<GuiTableSplitterCompositionBase>
@@ -319,6 +319,7 @@ Table Compositions
 				vint								rowsToTheTop;
 				
 				void								OnMouseMove(GuiGraphicsComposition* sender, GuiMouseEventArgs& arguments);
+				Rect								CalculateBounds()override;
 			public:
 				GuiRowSplitterComposition();
 				~GuiRowSplitterComposition();
@@ -330,7 +331,6 @@ Table Compositions
 				/// <param name="value">The number of rows that above the splitter</param>
 				void								SetRowsToTheTop(vint value);
 
-				Rect								GetBounds()override;
 			};
 			
 			/// <summary>
@@ -342,6 +342,7 @@ Table Compositions
 				vint								columnsToTheLeft;
 				
 				void								OnMouseMove(GuiGraphicsComposition* sender, GuiMouseEventArgs& arguments);
+				Rect								CalculateBounds()override;
 			public:
 				GuiColumnSplitterComposition();
 				~GuiColumnSplitterComposition();
@@ -353,7 +354,6 @@ Table Compositions
 				/// <param name="value">The number of columns that before the splitter</param>
 				void								SetColumnsToTheLeft(vint value);
 
-				Rect								GetBounds()override;
 			};
 		}
 	}
@@ -258,13 +258,9 @@ GuiDocumentElement::GuiDocumentElementRenderer
 
 			void GuiDocumentElement::GuiDocumentElementRenderer::RenderTargetChangedInternal(IGuiGraphicsRenderTarget* oldRenderTarget, IGuiGraphicsRenderTarget* newRenderTarget)
 			{
-				for(vint i=0;i<paragraphCaches.Count();i++)
+				while(leastRecentlyUsed)
 				{
-					ParagraphCache* cache=paragraphCaches[i].Obj();
-					if(cache)
-					{
-						cache->graphicsParagraph=0;
-					}
+					ReleaseParagraph(leastRecentlyUsed);
 				}
 			}
 
@@ -287,46 +283,187 @@ GuiDocumentElement::GuiDocumentElementRenderer
 						cache->graphicsParagraph=layoutProvider->CreateParagraph(cache->fullText, renderTarget, this);
 						cache->graphicsParagraph->SetParagraphAlignment(paragraph->alignment ? paragraph->alignment.Value() : Alignment::Left);
 						SetPropertiesVisitor::SetProperty(element->document.Obj(), this, cache, paragraph, cache->selectionBegin, cache->selectionEnd);
+						if(paragraphIndex==lastCaret.row && element->caretVisible)
+						{
+							cache->graphicsParagraph->OpenCaret(lastCaret.column, lastCaretColor, lastCaretFrontSide);
+						}
+
+						UseParagraph(cache.Obj());
+						if(usedParagraphCount>element->paragraphCacheCapacity)
+						{
+							ReleaseParagraphs();
+						}
+					}
+					else
+					{
+						UseParagraph(cache.Obj());
 					}
 					if(cache->graphicsParagraph->GetMaxWidth()!=lastMaxWidth)
 					{
 						cache->graphicsParagraph->SetMaxWidth(lastMaxWidth);
 					}
+					SetParagraphHeight(paragraphIndex, cache->graphicsParagraph->GetHeight());
+				}
+
+				return cache;
+			}
 
-					vint paragraphHeight=paragraphHeights[paragraphIndex];
-					vint height=cache->graphicsParagraph->GetHeight();
-					if(paragraphHeight!=height)
+			void GuiDocumentElement::GuiDocumentElementRenderer::UseParagraph(ParagraphCache* cache)
+			{
+				// move the paragraph to the head of the used list
+				if(cache==mostRecentlyUsed) return;
+				if(cache->previousUsed)
+				{
+					cache->previousUsed->nextUsed=cache->nextUsed;
+					if(cache->nextUsed)
 					{
-						cachedTotalHeight+=height-paragraphHeight;
-						paragraphHeight=height;
-						paragraphHeights[paragraphIndex]=paragraphHeight;
-						minSize=Size(0, cachedTotalHeight);
+						cache->nextUsed->previousUsed=cache->previousUsed;
 					}
+					else
+					{
+						leastRecentlyUsed=cache->previousUsed;
+					}
+				}
+				else
+				{
+					usedParagraphCount++;
 				}
 
-				return cache;
+				cache->previousUsed=nullptr;
+				cache->nextUsed=mostRecentlyUsed;
+				if(mostRecentlyUsed)
+				{
+					mostRecentlyUsed->previousUsed=cache;
+				}
+				else
+				{
+					leastRecentlyUsed=cache;
+				}
+				mostRecentlyUsed=cache;
 			}
 
-			bool GuiDocumentElement::GuiDocumentElementRenderer::GetParagraphIndexFromPoint(Point point, vint& top, vint& index)
+			void GuiDocumentElement::GuiDocumentElementRenderer::ReleaseParagraph(ParagraphCache* cache)
+			{
+				// remove the paragraph from the used list and release its layout
+				if(!cache->graphicsParagraph) return;
+				if(cache->previousUsed)
+				{
+					cache->previousUsed->nextUsed=cache->nextUsed;
+				}
+				else
+				{
+					mostRecentlyUsed=cache->nextUsed;
+				}
+				if(cache->nextUsed)
+				{
+					cache->nextUsed->previousUsed=cache->previousUsed;
+				}
+				else
+				{
+					leastRecentlyUsed=cache->previousUsed;
+				}
+
+				cache->previousUsed=nullptr;
+				cache->nextUsed=nullptr;
+				cache->graphicsParagraph=0;
+				usedParagraphCount--;
+			}
+
+			void GuiDocumentElement::GuiDocumentElementRenderer::ReleaseParagraphs()
 			{
-				vint y=0;
-				for(vint i=0;i<paragraphHeights.Count();i++)
+				// release least recently used layouts until only half of the capacity is used
+				// the two most recently used layouts are always kept because callers may still be using them
+				vint keepCount=element->paragraphCacheCapacity/2;
+				if(keepCount<2)
 				{
-					vint paragraphHeight=paragraphHeights[i];
-					vint nextY=y+paragraphHeight+paragraphDistance;
-					top=y;
-					index=i;
+					keepCount=2;
+				}
+
+				while(usedParagraphCount>keepCount)
+				{
+					ReleaseParagraph(leastRecentlyUsed);
+				}
+			}
 
-					if(nextY<=point.y)
+			void GuiDocumentElement::GuiDocumentElementRenderer::BuildParagraphTops()
+			{
+				// paragraphTopTree is a binary indexed tree of (paragraphHeights[i]+paragraphDistance), the first element is not used
+				vint count=paragraphHeights.Count();
+				paragraphTopTree.Resize(count+1);
+				paragraphTopTree[0]=0;
+				for(vint i=1;i<=count;i++)
+				{
+					paragraphTopTree[i]=paragraphHeights[i-1]+paragraphDistance;
+				}
+				for(vint i=1;i<=count;i++)
+				{
+					vint j=i+(i&-i);
+					if(j<=count)
 					{
-						y=nextY;
-						continue;
+						paragraphTopTree[j]+=paragraphTopTree[i];
 					}
-					else
+				}
+
+				cachedTotalHeight=count==0?0:GetParagraphTop(count)-paragraphDistance;
+				minSize=Size(0, cachedTotalHeight);
+			}
+
+			void GuiDocumentElement::GuiDocumentElementRenderer::SetParagraphHeight(vint paragraphIndex, vint height)
+			{
+				vint offset=height-paragraphHeights[paragraphIndex];
+				if(offset!=0)
+				{
+					paragraphHeights[paragraphIndex]=height;
+					for(vint i=paragraphIndex+1;i<paragraphTopTree.Count();i+=i&-i)
+					{
+						paragraphTopTree[i]+=offset;
+					}
+					cachedTotalHeight+=offset;
+					minSize=Size(0, cachedTotalHeight);
+				}
+			}
+
+			vint GuiDocumentElement::GuiDocumentElementRenderer::GetParagraphTop(vint paragraphIndex)
+			{
+				vint top=0;
+				for(vint i=paragraphIndex;i>0;i-=i&-i)
+				{
+					top+=paragraphTopTree[i];
+				}
+				return top;
+			}
+
+			bool GuiDocumentElement::GuiDocumentElementRenderer::GetParagraphIndexFromPoint(Point point, vint& top, vint& index)
+			{
+				vint count=paragraphHeights.Count();
+				if(count==0)
+				{
+					return false;
+				}
+
+				// find the last paragraph whose top is not below the point
+				vint step=1;
+				while(step*2<=count)
+				{
+					step*=2;
+				}
+
+				index=0;
+				top=0;
+				for(;step>0;step/=2)
+				{
+					if(index+step<=count && top+paragraphTopTree[index+step]<=point.y)
 					{
-						break;
+						index+=step;
+						top+=paragraphTopTree[index];
 					}
 				}
+
+				if(index==count)
+				{
+					index=count-1;
+					top-=paragraphHeights[index]+paragraphDistance;
+				}
 				return true;
 			}
 
@@ -356,10 +493,16 @@ GuiDocumentElement::GuiDocumentElementRenderer
 					vint y1=clipper.Top()-bounds.Top();
 					vint y2=y1+clipper.Height();
 					vint y=0;
+					vint startIndex=0;
 
 					lastMaxWidth=maxWidth;
+					if(!GetParagraphIndexFromPoint(Point(0, y1), y, startIndex))
+					{
+						startIndex=0;
+						y=0;
+					}
 
-					for(vint i=0;i<paragraphHeights.Count();i++)
+					for(vint i=startIndex;i<paragraphHeights.Count();i++)
 					{
 						vint paragraphHeight=paragraphHeights[i];
 						if(y+paragraphHeight<=y1)
@@ -373,15 +516,7 @@ GuiDocumentElement::GuiDocumentElementRenderer
 						}
 						else
 						{
-							Ptr<DocumentParagraphRun> paragraph=element->document->paragraphs[i];
-							Ptr<ParagraphCache> cache=paragraphCaches[i];
-							bool created=cache && cache->graphicsParagraph;
-							cache=EnsureAndGetCache(i, true);
-							if(!created && i==lastCaret.row && element->caretVisible)
-							{
-								cache->graphicsParagraph->OpenCaret(lastCaret.column, lastCaretColor, lastCaretFrontSide);
-							}
-
+							Ptr<ParagraphCache> cache=EnsureAndGetCache(i, true);
 							paragraphHeight=cache->graphicsParagraph->GetHeight();
 
 							renderingParagraph = i;
@@ -402,7 +537,7 @@ GuiDocumentElement::GuiDocumentElementRenderer
 
 							if (resized)
 							{
-								cache->graphicsParagraph = 0;
+								ReleaseParagraph(cache.Obj());
 							}
 						}
 
@@ -418,6 +553,11 @@ GuiDocumentElement::GuiDocumentElementRenderer
 
 			void GuiDocumentElement::GuiDocumentElementRenderer::OnElementStateChanged()
 			{
+				while (leastRecentlyUsed)
+				{
+					ReleaseParagraph(leastRecentlyUsed);
+				}
+
 				if (element->document && element->document->paragraphs.Count() > 0)
 				{
 					vint defaultSize = GetCurrentController()->ResourceService()->GetDefaultFont().size;
@@ -435,21 +575,13 @@ GuiDocumentElement::GuiDocumentElementRenderer
 					{
 						paragraphHeights[i] = defaultHeight;
 					}
-
-					cachedTotalHeight = paragraphHeights.Count() * (defaultHeight + paragraphDistance);
-					if (paragraphHeights.Count()>0)
-					{
-						cachedTotalHeight -= paragraphDistance;
-					}
-					minSize = Size(0, cachedTotalHeight);
 				}
 				else
 				{
 					paragraphCaches.Resize(0);
 					paragraphHeights.Resize(0);
-					cachedTotalHeight = 0;
-					minSize = Size(0, 0);
 				}
+				BuildParagraphTops();
 
 				nameCallbackIdMap.Clear();
 				freeCallbackIds.Clear();
@@ -467,13 +599,22 @@ GuiDocumentElement::GuiDocumentElementRenderer
 					ParagraphCacheArray oldCaches;
 					CopyFrom(oldCaches, paragraphCaches);
 					paragraphCaches.Resize(paragraphCount);
+					if (updatedText)
+					{
+						for (vint i = index; i < index + oldCount; i++)
+						{
+							if (auto cache = oldCaches[i])
+							{
+								ReleaseParagraph(cache.Obj());
+							}
+						}
+					}
 
 					ParagraphHeightArray oldHeights;
 					CopyFrom(oldHeights, paragraphHeights);
 					paragraphHeights.Resize(paragraphCount);
 
 					vint defaultHeight = GetCurrentController()->ResourceService()->GetDefaultFont().size;
-					cachedTotalHeight = 0;
 
 					for (vint i = 0; i < paragraphCount; i++)
 					{
@@ -491,7 +632,7 @@ GuiDocumentElement::GuiDocumentElementRenderer
 								auto cache = oldCaches[i];
 								if(cache)
 								{
-									cache->graphicsParagraph = 0;
+									ReleaseParagraph(cache.Obj());
 								}
 								paragraphCaches[i] = cache;
 								paragraphHeights[i] = oldHeights[i];
@@ -502,12 +643,8 @@ GuiDocumentElement::GuiDocumentElementRenderer
 							paragraphCaches[i] = oldCaches[i - (newCount - oldCount)];
 							paragraphHeights[i] = oldHeights[i - (newCount - oldCount)];
 						}
-						cachedTotalHeight += paragraphHeights[i] + paragraphDistance;
-					}
-					if (paragraphCount > 0)
-					{
-						cachedTotalHeight -= paragraphDistance;
 					}
+					BuildParagraphTops();
 
 					if (updatedText)
 					{
@@ -745,13 +882,7 @@ GuiDocumentElement::GuiDocumentElementRenderer
 					Rect bounds=cache->graphicsParagraph->GetCaretBounds(caret.column, frontSide);
 					if(bounds!=Rect())
 					{
-						vint y=0;
-						for(vint i=0;i<caret.row;i++)
-						{
-							EnsureAndGetCache(i, true);
-							y+=paragraphHeights[i]+paragraphDistance;
-						}
-
+						vint y=GetParagraphTop(caret.row);
 						bounds.y1+=y;
 						bounds.y2+=y;
 						return bounds;
@@ -866,6 +997,17 @@ GuiDocumentElement
 				UpdateCaret();
 			}
 
+			vint GuiDocumentElement::GetParagraphCacheCapacity()
+			{
+				return paragraphCacheCapacity;
+			}
+
+			void GuiDocumentElement::SetParagraphCacheCapacity(vint value)
+			{
+				CHECK_ERROR(value>=1, L"GuiDocumentElement::SetParagraphCacheCapacity(vint)#The capacity should be at least 1.");
+				paragraphCacheCapacity=value;
+			}
+
 			TextPos GuiDocumentElement::CalculateCaret(TextPos comparingCaret, IGuiGraphicsParagraph::CaretRelativePosition position, bool& preferFrontSide)
 			{
 				Ptr<GuiDocumentElementRenderer> elementRenderer=renderer.Cast<GuiDocumentElementRenderer>();
@@ -74,6 +74,9 @@ Rich Content Document (element)
 						IdEmbeddedObjectMap					embeddedObjects;
 						vint								selectionBegin;
 						vint								selectionEnd;
+						// paragraphs with a layout are linked from the most recently used one to the least recently used one
+						ParagraphCache*						previousUsed = nullptr;
+						ParagraphCache*						nextUsed = nullptr;
 
 						ParagraphCache()
 							:selectionBegin(-1)
@@ -95,6 +98,10 @@ Rich Content Document (element)
 					IGuiGraphicsLayoutProvider*				layoutProvider;
 					ParagraphCacheArray						paragraphCaches;
 					ParagraphHeightArray					paragraphHeights;
+					ParagraphHeightArray					paragraphTopTree;
+					ParagraphCache*							mostRecentlyUsed = nullptr;
+					ParagraphCache*							leastRecentlyUsed = nullptr;
+					vint									usedParagraphCount = 0;
 
 					TextPos									lastCaret;
 					Color									lastCaretColor;
@@ -111,6 +118,12 @@ Rich Content Document (element)
 					void									FinalizeInternal();
 					void									RenderTargetChangedInternal(IGuiGraphicsRenderTarget* oldRenderTarget, IGuiGraphicsRenderTarget* newRenderTarget);
 					Ptr<ParagraphCache>						EnsureAndGetCache(vint paragraphIndex, bool createParagraph);
+					void									UseParagraph(ParagraphCache* cache);
+					void									ReleaseParagraph(ParagraphCache* cache);
+					void									ReleaseParagraphs();
+					void									BuildParagraphTops();
+					void									SetParagraphHeight(vint paragraphIndex, vint height);
+					vint									GetParagraphTop(vint paragraphIndex);
 					bool									GetParagraphIndexFromPoint(Point point, vint& top, vint& index);
 				public:
 					GuiDocumentElementRenderer();
@@ -136,6 +149,7 @@ Rich Content Document (element)
 				bool										caretVisible;
 				bool										caretFrontSide;
 				Color										caretColor;
+				vint										paragraphCacheCapacity = 1024;
 
 				void										UpdateCaret();
 
@@ -197,6 +211,17 @@ Rich Content Document (element)
 				/// <param name="value">The color of the caret.</param>
 				void										SetCaretColor(Color value);
 
+				/// <summary>
+				/// Get the maximum number of paragraphs that keep their layout.
+				/// </summary>
+				/// <returns>The maximum number of paragraphs that keep their layout.</returns>
+				vint										GetParagraphCacheCapacity();
+				/// <summary>
+				/// Set the maximum number of paragraphs that keep their layout. When there are too many, layouts of least recently used paragraphs are released, and they will be created again when they are needed.
+				/// </summary>
+				/// <param name="value">The maximum number of paragraphs that keep their layout. It should be at least 1.</param>
+				void										SetParagraphCacheCapacity(vint value);
+
 				/// <summary>Calculate a caret using a specified comparing caret and a relative position.</summary>
 				/// <returns>The calculated caret.</returns>
 				/// <param name="comparingCaret">The comparing caret.</param>
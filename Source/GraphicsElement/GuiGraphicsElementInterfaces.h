@@ -22,6 +22,7 @@ namespace vl
 			class GuiGraphicsComposition;
 
 			extern void											InvokeOnCompositionStateChanged(compositions::GuiGraphicsComposition* composition);
+			extern void											InvokeOnElementStateChanged(compositions::GuiGraphicsComposition* composition);
 		}
 
 		namespace elements
@@ -182,6 +183,12 @@ Basic Construction
 				/// </summary>
 				/// <returns>Return true if the combined clipper is as large as the render target.</returns>
 				virtual bool							IsClipperCoverWholeTarget()=0;
+				/// <summary>
+				/// Test is the content of the previous rendering kept when a new rendering starts.
+				/// If it is kept, a graphics host only renders regions that are changed.
+				/// </summary>
+				/// <returns>Returns true if the content of the previous rendering is kept.</returns>
+				virtual bool							IsContentRetained()=0;
 			};
 		}
 	}
@@ -1,5 +1,5 @@
 #include "GuiGraphicsHost.h"
-#include "../Controls/GuiWindowControls.h"
+#include "../Controls/GuiApplication.h"
 #include "../Controls/Templates/GuiThemeStyleFactory.h"
 
 namespace vl
@@ -13,6 +13,14 @@ namespace vl
 			using namespace elements;
 			using namespace theme;
 
+			void RequestNextFrame()
+			{
+				if (auto application = GetApplication())
+				{
+					application->GetFrameScheduler()->RequestFrame();
+				}
+			}
+
 /***********************************************************************
 GuiGraphicsTimerManager
 ***********************************************************************/
@@ -28,6 +36,12 @@ GuiGraphicsTimerManager
 			void GuiGraphicsTimerManager::AddCallback(Ptr<IGuiGraphicsTimerCallback> callback)
 			{
 				callbacks.Add(callback);
+				RequestNextFrame();
+			}
+
+			bool GuiGraphicsTimerManager::HasCallbacks()
+			{
+				return callbacks.Count() > 0;
 			}
 
 			void GuiGraphicsTimerManager::Play()
@@ -308,6 +322,54 @@ GuiGraphicsHost
 				windowComposition->UpdateRelatedHostRecord(&hostRecord);
 			}
 
+			void GuiGraphicsHost::MergeDamagedRegions(List<Rect>& regions)
+			{
+				Rect clientBounds(Point(0, 0), hostRecord.nativeWindow ? hostRecord.nativeWindow->GetClientSize() : Size());
+				FOREACH(Rect, damaged, damagedRegions)
+				{
+					// damaged regions that are empty or outside of the window are not rendered
+					Rect region;
+					region.x1 = damaged.x1 > clientBounds.x1 ? damaged.x1 : clientBounds.x1;
+					region.y1 = damaged.y1 > clientBounds.y1 ? damaged.y1 : clientBounds.y1;
+					region.x2 = damaged.x2 < clientBounds.x2 ? damaged.x2 : clientBounds.x2;
+					region.y2 = damaged.y2 < clientBounds.y2 ? damaged.y2 : clientBounds.y2;
+					if (region.x1 >= region.x2 || region.y1 >= region.y2)
+					{
+						continue;
+					}
+
+					// absorb all regions that overlap the damaged region
+					for (vint i = regions.Count() - 1; i >= 0; i--)
+					{
+						Rect merging = regions[i];
+						if (region.x1 <= merging.x2 && merging.x1 <= region.x2 && region.y1 <= merging.y2 && merging.y1 <= region.y2)
+						{
+							region.x1 = region.x1 < merging.x1 ? region.x1 : merging.x1;
+							region.y1 = region.y1 < merging.y1 ? region.y1 : merging.y1;
+							region.x2 = region.x2 > merging.x2 ? region.x2 : merging.x2;
+							region.y2 = region.y2 > merging.y2 ? region.y2 : merging.y2;
+							regions.RemoveAt(i);
+							i = regions.Count();
+						}
+					}
+					regions.Add(region);
+				}
+
+				if (regions.Count() > MaxDamagedRegions)
+				{
+					Rect region = regions[0];
+					FOREACH(Rect, merging, regions)
+					{
+						region.x1 = region.x1 < merging.x1 ? region.x1 : merging.x1;
+						region.y1 = region.y1 < merging.y1 ? region.y1 : merging.y1;
+						region.x2 = region.x2 > merging.x2 ? region.x2 : merging.x2;
+						region.y2 = region.y2 > merging.y2 ? region.y2 : merging.y2;
+					}
+					regions.Clear();
+					regions.Add(region);
+				}
+			}
+
 			void GuiGraphicsHost::DisconnectCompositionInternal(GuiGraphicsComposition* composition)
 			{
 				for(vint i=0;i<composition->Children().Count();i++)
@@ -327,6 +389,26 @@ GuiGraphicsHost
 					focusedComposition=0;
 				}
 				mouseEnterCompositions.Remove(composition);
+				if(hitTestCache.composition==composition)
+				{
+					hitTestCache=HitTestCache();
+				}
+			}
+
+			GuiGraphicsComposition* GuiGraphicsHost::FindMouseComposition(Point location, Rect& globalBounds)
+			{
+				if(hitTestCache.location!=location || hitTestCache.layoutVersion!=hostRecord.layoutVersion || hitTestCache.hitTestVersion!=hostRecord.hitTestVersion)
+				{
+					vint layoutVersion=hostRecord.layoutVersion;
+					hitTestCache.location=location;
+					hitTestCache.hitTestVersion=hostRecord.hitTestVersion;
+					hitTestCache.composition=windowComposition->FindComposition(location, true);
+					hitTestCache.globalBounds=hitTestCache.composition?hitTestCache.composition->GetGlobalBounds():Rect();
+					// do not reuse the result if the layout is changed while searching
+					hitTestCache.layoutVersion=hostRecord.layoutVersion==layoutVersion?layoutVersion:0;
+				}
+				globalBounds=hitTestCache.globalBounds;
+				return hitTestCache.composition;
 			}
 
 			void GuiGraphicsHost::MouseCapture(const NativeWindowMouseInfo& info)
@@ -336,7 +418,8 @@ GuiGraphicsHost
 					if(!hostRecord.nativeWindow->IsCapturing() && !info.nonClient)
 					{
 						hostRecord.nativeWindow->RequireCapture();
-						mouseCaptureComposition=windowComposition->FindComposition(Point(info.x, info.y), true);
+						Rect globalBounds;
+						mouseCaptureComposition=FindMouseComposition(Point(info.x, info.y), globalBounds);
 					}
 				}
 			}
@@ -460,17 +543,18 @@ GuiGraphicsHost
 			void GuiGraphicsHost::OnMouseInput(const NativeWindowMouseInfo& info, GuiMouseEvent GuiGraphicsEventReceiver::* eventReceiverEvent)
 			{
 				GuiGraphicsComposition* composition=0;
+				Rect bounds;
 				if(mouseCaptureComposition)
 				{
 					composition=mouseCaptureComposition;
+					bounds=composition->GetGlobalBounds();
 				}
 				else
 				{
-					composition=windowComposition->FindComposition(Point(info.x, info.y), true);
+					composition=FindMouseComposition(Point(info.x, info.y), bounds);
 				}
 				if(composition)
 				{
-					Rect bounds=composition->GetGlobalBounds();
 					GuiMouseEventArgs arguments;
 					(NativeWindowMouseInfo&)arguments=info;
 					arguments.x-=bounds.x1;
@@ -549,8 +633,9 @@ GuiGraphicsHost
 				if (previousClientSize != size)
 				{
 					previousClientSize = size;
+					windowComposition->InvokeOnCompositionStateChanged();
 					minSize = windowComposition->GetPreferredBounds().GetSize();
-					needRender = true;
+					RequestRender();
 				}
 			}
 
@@ -558,7 +643,7 @@ GuiGraphicsHost
 			{
 				if (!supressPaint)
 				{
-					needRender = true;
+					RequestRender();
 				}
 			}
 
@@ -633,7 +718,8 @@ GuiGraphicsHost
 			{
 				CompositionList newCompositions;
 				{
-					GuiGraphicsComposition* composition = windowComposition->FindComposition(Point(info.x, info.y), true);
+					Rect globalBounds;
+					GuiGraphicsComposition* composition = FindMouseComposition(Point(info.x, info.y), globalBounds);
 					while (composition)
 					{
 						newCompositions.Insert(0, composition);
@@ -823,23 +909,6 @@ GuiGraphicsHost
 				}
 			}
 
-			void GuiGraphicsHost::GlobalTimer()
-			{
-				timerManager.Play();
-
-				DateTime now=DateTime::UtcTime();
-				if(now.totalMilliseconds-lastCaretTime>=CaretInterval)
-				{
-					lastCaretTime=now.totalMilliseconds;
-					if(focusedComposition && focusedComposition->HasEventReceiver())
-					{
-						focusedComposition->GetEventReceiver()->caretNotify.Execute(GuiEventArgs(focusedComposition));
-					}
-				}
-				
-				Render(false);
-			}
-
 			GuiGraphicsHost::GuiGraphicsHost(controls::GuiControlHost* _controlHost, GuiGraphicsComposition* boundsComposition)
 				:controlHost(_controlHost)
 			{
@@ -852,6 +921,10 @@ GuiGraphicsHost
 
 			GuiGraphicsHost::~GuiGraphicsHost()
 			{
+				if (auto application = GetApplication())
+				{
+					application->GetFrameScheduler()->UnregisterHost(this);
+				}
 				windowComposition->RemoveChild(windowComposition->Children()[0]);
 				NotifyFinalizeInstance(windowComposition);
 				if(shortcutKeyManager)
@@ -873,21 +946,30 @@ GuiGraphicsHost
 				{
 					if (hostRecord.nativeWindow)
 					{
-						GetCurrentController()->CallbackService()->UninstallListener(this);
+						if (auto application = GetApplication())
+						{
+							application->GetFrameScheduler()->UnregisterHost(this);
+						}
 						hostRecord.nativeWindow->UninstallListener(this);
 					}
 
 					if (_nativeWindow)
 					{
 						_nativeWindow->InstallListener(this);
-						GetCurrentController()->CallbackService()->InstallListener(this);
+						if (auto application = GetApplication())
+						{
+							application->GetFrameScheduler()->RegisterHost(this);
+						}
 						previousClientSize = _nativeWindow->GetClientSize();
 						minSize = windowComposition->GetPreferredBounds().GetSize();
 						_nativeWindow->SetCaretPoint(caretPoint);
-						needRender = true;
 					}
 
 					RefreshRelatedHostRecord(_nativeWindow);
+					if (_nativeWindow)
+					{
+						RequestRender();
+					}
 				}
 			}
 
@@ -898,17 +980,51 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::Render(bool forceUpdate)
 			{
-				if (!forceUpdate && !needRender)
+				if (!forceUpdate && !needRender && damagedRegions.Count() == 0)
 				{
 					return;
 				}
+
+				bool renderAll = forceUpdate || needRender;
+				List<Rect> regions;
+				if (!renderAll)
+				{
+					MergeDamagedRegions(regions);
+				}
 				needRender = false;
+				damagedRegions.Clear();
+				if (!renderAll && regions.Count() == 0)
+				{
+					return;
+				}
 
 				if(hostRecord.nativeWindow && hostRecord.nativeWindow->IsVisible())
 				{
+					if (!hostRecord.renderTarget->IsContentRetained())
+					{
+						renderAll = true;
+					}
+
 					supressPaint = true;
+					hostRecord.drawnElements = 0;
+					hostRecord.culledCompositions = 0;
 					hostRecord.renderTarget->StartRendering();
-					windowComposition->Render(Size());
+					if (renderAll)
+					{
+						windowComposition->Render(Size());
+					}
+					else
+					{
+						FOREACH(Rect, region, regions)
+						{
+							hostRecord.renderTarget->PushClipper(region);
+							if (!hostRecord.renderTarget->IsClipperCoverWholeTarget())
+							{
+								windowComposition->Render(Size());
+							}
+							hostRecord.renderTarget->PopClipper();
+						}
+					}
 					{
 						auto bounds = windowComposition->GetBounds();
 						auto preferred = windowComposition->GetPreferredBounds();
@@ -947,6 +1063,60 @@ GuiGraphicsHost
 			void GuiGraphicsHost::RequestRender()
 			{
 				needRender = true;
+				RequestNextFrame();
+			}
+
+			void GuiGraphicsHost::RequestPartialRender(Rect damagedBounds)
+			{
+				if (!needRender && damagedBounds.Width() > 0 && damagedBounds.Height() > 0)
+				{
+					damagedRegions.Add(damagedBounds);
+					RequestNextFrame();
+				}
+			}
+
+			void GuiGraphicsHost::ProcessFrame(vuint64_t now)
+			{
+				timerManager.Play();
+
+				if (now - lastCaretTime >= CaretInterval)
+				{
+					lastCaretTime = now;
+					if (focusedComposition && focusedComposition->HasEventReceiver())
+					{
+						focusedComposition->GetEventReceiver()->caretNotify.Execute(GuiEventArgs(focusedComposition));
+					}
+				}
+
+				Render(false);
+			}
+
+			bool GuiGraphicsHost::IsFrameRequired()
+			{
+				return needRender || damagedRegions.Count() > 0 || timerManager.HasCallbacks();
+			}
+
+			bool GuiGraphicsHost::GetCaretDeadline(vuint64_t& deadline)
+			{
+				if (hostRecord.nativeWindow && hostRecord.nativeWindow->IsVisible())
+				{
+					if (focusedComposition && focusedComposition->HasEventReceiver() && focusedComposition->GetEventReceiver()->caretNotify.HasHandlers())
+					{
+						deadline = lastCaretTime + CaretInterval;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			vint GuiGraphicsHost::GetDrawnElementCount()
+			{
+				return hostRecord.drawnElements;
+			}
+
+			vint GuiGraphicsHost::GetCulledCompositionCount()
+			{
+				return hostRecord.culledCompositions;
 			}
 
 			IGuiShortcutKeyManager* GuiGraphicsHost::GetShortcutKeyManager()
@@ -974,6 +1144,7 @@ GuiGraphicsHost
 				}
 				focusedComposition=composition;
 				SetCaretPoint(Point(0, 0));
+				RequestNextFrame();
 				if(focusedComposition && focusedComposition->HasEventReceiver())
 				{
 					GuiEventArgs arguments;
@@ -54,6 +54,9 @@ Animation
 				/// <summary>Add a new callback.</summary>
 				/// <param name="callback">The new callback to add.</param>
 				void							AddCallback(Ptr<IGuiGraphicsTimerCallback> callback);
+				/// <summary>Test if there is any callback that is still playing.</summary>
+				/// <returns>Returns true if there is any callback.</returns>
+				bool							HasCallbacks();
 				/// <summary>Called periodically.</summary>
 				void							Play();
 			};
@@ -153,18 +156,30 @@ Host
 			/// <summary>
 			/// GuiGraphicsHost hosts an <see cref="GuiWindowComposition"/> in an <see cref="INativeWindow"/>. The composition will fill the whole window.
 			/// </summary>
-			class GuiGraphicsHost : public Object, private INativeWindowListener, private INativeControllerListener, public Description<GuiGraphicsHost>
+			class GuiGraphicsHost : public Object, private INativeWindowListener, public Description<GuiGraphicsHost>
 			{
 				typedef collections::List<GuiGraphicsComposition*>							CompositionList;
 				typedef collections::Dictionary<WString, IGuiAltAction*>					AltActionMap;
 				typedef collections::Dictionary<WString, controls::GuiControl*>				AltControlMap;
 				typedef GuiGraphicsComposition::GraphicsHostRecord							HostRecord;
+
+				// the composition under the mouse, reused until the location, the layout or any transparency to mouse changes
+				struct HitTestCache
+				{
+					Point								location;
+					vint								layoutVersion = 0;
+					vint								hitTestVersion = 0;
+					GuiGraphicsComposition*				composition = nullptr;
+					Rect								globalBounds;
+				};
 			public:
 				static const vuint64_t					CaretInterval = 500;
+				static const vint						MaxDamagedRegions = 16;
 			protected:
 				HostRecord								hostRecord;
 				bool									supressPaint = false;
 				bool									needRender = true;
+				collections::List<Rect>					damagedRegions;
 
 				IGuiShortcutKeyManager*					shortcutKeyManager = nullptr;
 				controls::GuiControlHost*				controlHost = nullptr;
@@ -178,6 +193,7 @@ Host
 				GuiGraphicsTimerManager					timerManager;
 				GuiGraphicsComposition*					mouseCaptureComposition = nullptr;
 				CompositionList							mouseEnterCompositions;
+				HitTestCache							hitTestCache;
 
 				IGuiAltActionHost*						currentAltHost = nullptr;
 				AltActionMap							currentActiveAltActions;
@@ -194,8 +210,10 @@ Host
 				void									ClearAltHost();
 				void									CloseAltHost();
 				void									RefreshRelatedHostRecord(INativeWindow* nativeWindow);
+				void									MergeDamagedRegions(collections::List<Rect>& regions);
 
 				void									DisconnectCompositionInternal(GuiGraphicsComposition* composition);
+				GuiGraphicsComposition*					FindMouseComposition(Point location, Rect& globalBounds);
 				void									MouseCapture(const NativeWindowMouseInfo& info);
 				void									MouseUncapture(const NativeWindowMouseInfo& info);
 				void									OnCharInput(const NativeWindowCharInfo& info, GuiGraphicsComposition* composition, GuiCharEvent GuiGraphicsEventReceiver::* eventReceiverEvent);
@@ -229,8 +247,6 @@ Host
 				void									SysKeyDown(const NativeWindowKeyInfo& info)override;
 				void									SysKeyUp(const NativeWindowKeyInfo& info)override;
 				void									Char(const NativeWindowCharInfo& info)override;
-
-				void									GlobalTimer()override;
 			public:
 				GuiGraphicsHost(controls::GuiControlHost* _controlHost, GuiGraphicsComposition* boundsComposition);
 				~GuiGraphicsHost();
@@ -248,6 +264,25 @@ Host
 				void									Render(bool forceUpdate);
 				/// <summary>Request a rendering</summary>
 				void									RequestRender();
+				/// <summary>Request a rendering for a damaged region. If no full rendering is requested before the next rendering, and the render target keeps the previous content, only compositions that intersect damaged regions are rendered.</summary>
+				/// <param name="damagedBounds">The damaged region in the space of the client area in the main composition.</param>
+				void									RequestPartialRender(Rect damagedBounds);
+				/// <summary>Play animations, blink the caret and render if necessary. This function is called by <see cref="controls::GuiFrameScheduler"/> once per frame.</summary>
+				/// <param name="now">The current time in milliseconds from the clock of the frame scheduler.</param>
+				void									ProcessFrame(vuint64_t now);
+				/// <summary>Test if the next frame has anything to do: a pending rendering or a running animation.</summary>
+				/// <returns>Returns true if the next frame is required.</returns>
+				bool									IsFrameRequired();
+				/// <summary>Get the time when a visible caret blinks next. A caret only needs a frame at this time, instead of requiring every frame.</summary>
+				/// <returns>Returns true if a caret is visible.</returns>
+				/// <param name="deadline">The time in milliseconds from the clock of the frame scheduler.</param>
+				bool									GetCaretDeadline(vuint64_t& deadline);
+				/// <summary>Get the number of elements rendered in the last rendering.</summary>
+				/// <returns>The number of rendered elements.</returns>
+				vint									GetDrawnElementCount();
+				/// <summary>Get the number of compositions skipped in the last rendering because they are outside of the clipper. Sub compositions of a skipped composition are not counted.</summary>
+				/// <returns>The number of skipped compositions.</returns>
+				vint									GetCulledCompositionCount();
 
 				/// <summary>Get the <see cref="IGuiShortcutKeyManager"/> attached with this graphics host.</summary>
 				/// <returns>The shortcut key manager.</returns>
@@ -159,7 +159,10 @@ Helpers
 					{
 						renderer->OnElementStateChanged();
 					}
-					InvokeOnCompositionStateChanged();
+					if (ownerComposition)
+					{
+						compositions::InvokeOnElementStateChanged(ownerComposition);
+					}
 				}
 			public:
 				static TElement* Create()
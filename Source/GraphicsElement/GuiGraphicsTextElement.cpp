@@ -1,5 +1,10 @@
 #include "GuiGraphicsTextElement.h"
 
+#if defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__
+#define GUI_TEXT_SCANNING_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace vl
 {
 	using namespace collections;
@@ -11,10 +16,210 @@ namespace vl
 			namespace text
 			{
 
+/***********************************************************************
+Text Scanning
+***********************************************************************/
+
+#ifdef GUI_TEXT_SCANNING_SSE2
+				// compare 16 bytes of characters at once, wchar_t is 2 bytes in MSVC and 4 bytes in GCC
+				static __m128i CompareCharacters(__m128i chars, wchar_t value)
+				{
+					return sizeof(wchar_t) == 2
+						? _mm_cmpeq_epi16(chars, _mm_set1_epi16((short)value))
+						: _mm_cmpeq_epi32(chars, _mm_set1_epi32((int)value));
+				}
+#endif
+
+				const wchar_t* FindLineBreak(const wchar_t* reading, const wchar_t* end)
+				{
+#ifdef GUI_TEXT_SCANNING_SSE2
+					const vint lanes = sizeof(__m128i) / sizeof(wchar_t);
+					while (end - reading >= lanes)
+					{
+						__m128i chars = _mm_loadu_si128((const __m128i*)reading);
+						__m128i found = _mm_or_si128(CompareCharacters(chars, L'\r'), CompareCharacters(chars, L'\n'));
+						// the scalar loop below locates the character in this block
+						if (_mm_movemask_epi8(found) != 0) break;
+						reading += lanes;
+					}
+#endif
+					while (reading < end && *reading != L'\r' && *reading != L'\n') reading++;
+					return reading;
+				}
+
+				const wchar_t* FindSpecialCharacter(const wchar_t* reading, const wchar_t* end)
+				{
+#ifdef GUI_TEXT_SCANNING_SSE2
+					const vint lanes = sizeof(__m128i) / sizeof(wchar_t);
+					const __m128i surrogateMask = sizeof(wchar_t) == 2 ? _mm_set1_epi16((short)0xF800) : _mm_set1_epi32((int)0xFFFFF800);
+					while (end - reading >= lanes)
+					{
+						__m128i chars = _mm_loadu_si128((const __m128i*)reading);
+						__m128i found = _mm_or_si128(CompareCharacters(chars, L'\t'), CompareCharacters(_mm_and_si128(chars, surrogateMask), (wchar_t)0xD800));
+						if (_mm_movemask_epi8(found) != 0) break;
+						reading += lanes;
+					}
+#endif
+					while (reading < end && *reading != L'\t' && (*reading & ~0x7FF) != 0xD800) reading++;
+					return reading;
+				}
+
+/***********************************************************************
+Text Searching
+***********************************************************************/
+
+				// non-ASCII characters are folded by INVLOC 256 characters at a time, and a page is only folded when a character in it is searched
+				struct CaseFoldingCache
+				{
+					static const vint				PageCount = sizeof(wchar_t) == 2 ? 0x100 : 0x1100;
+					wchar_t*						pages[PageCount];
+
+					CaseFoldingCache()
+					{
+						memset(pages, 0, sizeof(pages));
+					}
+
+					~CaseFoldingCache()
+					{
+						for (vint i = 0; i < PageCount; i++)
+						{
+							delete[] pages[i];
+						}
+					}
+
+					const wchar_t* GetPage(vint index)
+					{
+						if (!pages[index])
+						{
+							wchar_t page[256];
+							for (vint j = 0; j < 256; j++)
+							{
+								// the null character and surrogates are not folded
+								wchar_t c = (wchar_t)(index * 256 + j);
+								page[j] = c == 0 || (c & ~0x7FF) == 0xD800 ? L' ' : c;
+							}
+
+							// a character is folded only when it could be converted back, so that a broken conversion never makes two characters equal
+							WString folded = INVLOC.ToLower(WString(page, (vint)256));
+							WString restored = INVLOC.ToUpper(folded);
+							bool available = folded.Length() == 256 && restored.Length() == 256;
+							wchar_t* lower = new wchar_t[256];
+							for (vint j = 0; j < 256; j++)
+							{
+								wchar_t c = (wchar_t)(index * 256 + j);
+								lower[j] = available && page[j] == c && restored[j] == c ? folded[j] : c;
+							}
+							pages[index] = lower;
+						}
+						return pages[index];
+					}
+				};
+
+				static wchar_t FoldCharacter(wchar_t c)
+				{
+					if (c < 128)
+					{
+						return L'A' <= c && c <= L'Z' ? c - L'A' + L'a' : c;
+					}
+					vint index = (vint)(vuint32_t)c >> 8;
+					if (index >= CaseFoldingCache::PageCount) return c;
+					static CaseFoldingCache cache;
+					return cache.GetPage(index)[c & 0xFF];
+				}
+
+				static bool EqualCharacters(const wchar_t* a, const wchar_t* b, vint count, bool caseSensitive)
+				{
+					if (caseSensitive)
+					{
+						return memcmp(a, b, count * sizeof(wchar_t)) == 0;
+					}
+					for (vint i = 0; i < count; i++)
+					{
+						if (a[i] != b[i] && FoldCharacter(a[i]) != FoldCharacter(b[i])) return false;
+					}
+					return true;
+				}
+
+				// a pattern is split into lines in the same way as TextLines::Modify
+				struct TextSearchPattern
+				{
+					List<const wchar_t*>	lines;
+					List<vint>				lengths;
+					wchar_t					firstCharacter = 0;
+					bool					caseSensitive;
+
+					TextSearchPattern(const WString& pattern, bool _caseSensitive)
+						:caseSensitive(_caseSensitive)
+					{
+						const wchar_t* previous = pattern.Buffer();
+						const wchar_t* end = previous + pattern.Length();
+						while (true)
+						{
+							const wchar_t* current = FindLineBreak(previous, end);
+							lines.Add(previous);
+							lengths.Add(current - previous);
+							if (current == end) break;
+							previous = current + (current[0] == L'\r' && current + 1 < end && current[1] == L'\n' ? 2 : 1);
+						}
+						if (lengths[0] > 0)
+						{
+							firstCharacter = caseSensitive ? lines[0][0] : FoldCharacter(lines[0][0]);
+						}
+					}
+
+					// test the first character before calling MatchAt, which is much cheaper than comparing the whole pattern
+					bool StartsAt(const TextLine& line, vint column)
+					{
+						if (lengths[0] == 0) return true;
+						wchar_t c = line.text[column];
+						return c == firstCharacter || (!caseSensitive && FoldCharacter(c) == firstCharacter);
+					}
+
+					// test if the pattern appears at the specified position
+					bool MatchAt(TextLineList& textLines, vint row, vint column)
+					{
+						vint last = lines.Count() - 1;
+						if (row + last >= textLines.Count()) return false;
+
+						TextLine& first = textLines[row];
+						if (last == 0)
+						{
+							return column + lengths[0] <= first.dataLength && EqualCharacters(first.text + column, lines[0], lengths[0], caseSensitive);
+						}
+
+						if (column + lengths[0] != first.dataLength || !EqualCharacters(first.text + column, lines[0], lengths[0], caseSensitive)) return false;
+						for (vint i = 1; i < last; i++)
+						{
+							TextLine& line = textLines[row + i];
+							if (line.dataLength != lengths[i] || !EqualCharacters(line.text, lines[i], lengths[i], caseSensitive)) return false;
+						}
+						TextLine& line = textLines[row + last];
+						return lengths[last] <= line.dataLength && EqualCharacters(line.text, lines[last], lengths[last], caseSensitive);
+					}
+
+					TextMatch GetMatch(vint row, vint column)
+					{
+						vint last = lines.Count() - 1;
+						return TextMatch(TextPos(row, column), TextPos(row + last, last == 0 ? column + lengths[0] : lengths[last]));
+					}
+				};
+
 /***********************************************************************
 text::TextLine
 ***********************************************************************/
 
+				// characters are stored after their attributes in the same buffer, so that a line allocates memory once
+				static void AllocateLineBuffer(vint bufferLength, wchar_t*& text, CharAtt*& att)
+				{
+					att=(CharAtt*)new char[bufferLength*(sizeof(CharAtt)+sizeof(wchar_t))];
+					text=(wchar_t*)(att+bufferLength);
+				}
+
+				static void FreeLineBuffer(CharAtt* att)
+				{
+					delete[] (char*)att;
+				}
+
 				TextLine::TextLine()
 					:text(0)
 					,att(0)
@@ -44,8 +249,7 @@ text::TextLine
 				void TextLine::Initialize()
 				{
 					Finalize();
-					text=new wchar_t[BlockSize];
-					att=new CharAtt[BlockSize];
+					AllocateLineBuffer(BlockSize, text, att);
 					bufferLength=BlockSize;
 
 					memset(text, 0, sizeof(wchar_t)*bufferLength);
@@ -54,14 +258,10 @@ text::TextLine
 
 				void TextLine::Finalize()
 				{
-					if(text)
-					{
-						delete[] text;
-						text=0;
-					}
 					if(att)
 					{
-						delete[] att;
+						FreeLineBuffer(att);
+						text=0;
 						att=0;
 					}
 					availableOffsetCount=0;
@@ -82,18 +282,18 @@ text::TextLine
 					vint newBufferLength=CalculateBufferLength(newDataLength);
 					if(newBufferLength!=bufferLength)
 					{
-						wchar_t* newText=new wchar_t[newBufferLength];
+						wchar_t* newText=0;
+						CharAtt* newAtt=0;
+						AllocateLineBuffer(newBufferLength, newText, newAtt);
 						memcpy(newText, text, start*sizeof(wchar_t));
 						memcpy(newText+start, input, inputCount*sizeof(wchar_t));
 						memcpy(newText+start+inputCount, text+start+count, (dataLength-start-count)*sizeof(wchar_t));
 
-						CharAtt* newAtt=new CharAtt[newBufferLength];
 						memcpy(newAtt, att, start*sizeof(CharAtt));
 						memset(newAtt+start, 0, inputCount*sizeof(CharAtt));
 						memcpy(newAtt+start+inputCount, att+start+count, (dataLength-start-count)*sizeof(CharAtt));
 
-						delete[] text;
-						delete[] att;
+						FreeLineBuffer(att);
 						text=newText;
 						att=newAtt;
 					}
@@ -138,15 +338,70 @@ text::TextLine
 text::CharMeasurer
 ***********************************************************************/
 
+				vint CharMeasurer::WriteCodePoint(UnicodeCodePoint codePoint, wchar_t* buffer)
+				{
+					if(sizeof(wchar_t)==2 && codePoint>=0x10000)
+					{
+						codePoint-=0x10000;
+						buffer[0]=(wchar_t)(0xD800+(codePoint>>10));
+						buffer[1]=(wchar_t)(0xDC00+(codePoint&0x3FF));
+						return 2;
+					}
+					else
+					{
+						buffer[0]=(wchar_t)codePoint;
+						return 1;
+					}
+				}
+
+				vint* CharMeasurer::GetWidthEntry(UnicodeCodePoint codePoint)
+				{
+					if(codePoint>=0x110000)
+					{
+						codePoint=0xFFFD;
+					}
+					vint*& page=widthPages[codePoint>>WidthPageBits];
+					if(!page)
+					{
+						page=new vint[WidthPageSize];
+						for(vint i=0;i<WidthPageSize;i++)
+						{
+							page[i]=-1;
+						}
+					}
+					return &page[codePoint&(WidthPageSize-1)];
+				}
+
+				void CharMeasurer::ClearWidths()
+				{
+					for(vint i=0;i<WidthPageCount;i++)
+					{
+						if(widthPages[i])
+						{
+							delete[] widthPages[i];
+							widthPages[i]=0;
+						}
+					}
+				}
+
+				void CharMeasurer::MeasureWidthsInternal(const UnicodeCodePoint* codePoints, vint* widths, vint count, IGuiGraphicsRenderTarget* renderTarget)
+				{
+					for(vint i=0;i<count;i++)
+					{
+						widths[i]=MeasureWidthInternal(codePoints[i], renderTarget);
+					}
+				}
+
 				CharMeasurer::CharMeasurer(vint _rowHeight)
 					:oldRenderTarget(0)
 					,rowHeight(_rowHeight)
 				{
-					memset(widths, 0, sizeof(widths));
+					memset(widthPages, 0, sizeof(widthPages));
 				}
 
 				CharMeasurer::~CharMeasurer()
 				{
+					ClearWidths();
 				}
 
 				void CharMeasurer::SetRenderTarget(IGuiGraphicsRenderTarget* value)
@@ -155,18 +410,48 @@ text::CharMeasurer
 					{
 						oldRenderTarget=value;
 						rowHeight=GetRowHeightInternal(oldRenderTarget);
-						memset(widths, 0, sizeof(widths));
+						ClearWidths();
+					}
+				}
+
+				vint CharMeasurer::MeasureWidth(UnicodeCodePoint codePoint)
+				{
+					vint* entry=GetWidthEntry(codePoint);
+					if(*entry<0)
+					{
+						*entry=MeasureWidthInternal(codePoint, oldRenderTarget);
 					}
+					return *entry;
 				}
 
-				vint CharMeasurer::MeasureWidth(wchar_t character)
+				void CharMeasurer::MeasureWidths(const UnicodeCodePoint* codePoints, vint* widths, vint count)
 				{
-					vint w=widths[character];
-					if(w==0)
+					// -2 marks a character that is already scheduled for measuring, so that repeated characters are measured once
+					List<UnicodeCodePoint> missing;
+					for(vint i=0;i<count;i++)
+					{
+						vint* entry=GetWidthEntry(codePoints[i]);
+						if(*entry==-1)
+						{
+							*entry=-2;
+							missing.Add(codePoints[i]);
+						}
+					}
+
+					if(missing.Count()>0)
+					{
+						Array<vint> missingWidths(missing.Count());
+						MeasureWidthsInternal(&missing[0], &missingWidths[0], missing.Count(), oldRenderTarget);
+						for(vint i=0;i<missing.Count();i++)
+						{
+							*GetWidthEntry(missing[i])=missingWidths[i];
+						}
+					}
+
+					for(vint i=0;i<count;i++)
 					{
-						widths[character]=w=MeasureWidthInternal(character, oldRenderTarget);
+						widths[i]=*GetWidthEntry(codePoints[i]);
 					}
-					return w;
 				}
 
 				vint CharMeasurer::GetRowHeight()
@@ -174,6 +459,437 @@ text::CharMeasurer
 					return rowHeight;
 				}
 
+/***********************************************************************
+text::TextLineList
+***********************************************************************/
+
+				vint TextLineList::GetLineCount(Block* block)
+				{
+					return block->lines.Count() + block->pendingStarts.Count();
+				}
+
+				void TextLineList::MaterializeBlock(vint block)
+				{
+					auto current = blocks[block];
+					vint pendingCount = current->pendingStarts.Count();
+					if (pendingCount == 0) return;
+
+					for (vint i = 0; i < pendingCount; i++)
+					{
+						vint start = current->pendingStarts[i];
+						vint end = i + 1 < pendingCount ? current->pendingStarts[i + 1] : current->pendingLength;
+						TextLine line;
+						line.Initialize();
+						if (start < end)
+						{
+							line.Modify(0, 0, &current->pendingText[start], end - start);
+						}
+						current->lines.Add(line);
+					}
+					current->pendingText.Resize(0);
+					current->pendingLength = 0;
+					current->pendingStarts.Clear();
+				}
+
+				vint TextLineList::InsertBlock(vint blockIndex)
+				{
+					auto block = MakePtr<Block>();
+					block->handle = blockTree.Insert(blockIndex, {});
+					if (block->handle == blocks.Count())
+					{
+						blocks.Add(block);
+					}
+					else
+					{
+						blocks[block->handle] = block;
+					}
+					cachedBlock = -1;
+					return block->handle;
+				}
+
+				void TextLineList::RemoveBlock(vint block)
+				{
+					blockTree.Remove(block);
+					blocks[block]->handle = -1;
+					blocks[block] = nullptr;
+					cachedBlock = -1;
+				}
+
+				void TextLineList::UpdateBlock(vint block)
+				{
+					BlockSummary summary;
+					summary.lineCount = GetLineCount(blocks[block].Obj());
+					summary.maxWidth = blocks[block]->maxWidth;
+					blockTree.Set(block, summary);
+				}
+
+				void TextLineList::InvalidateBlockWidth(const Ptr<Block>& block)
+				{
+					if (!block->widthDirty)
+					{
+						block->widthDirty = true;
+						dirtyBlocks.Add(block);
+					}
+				}
+
+				vint TextLineList::FindBlock(vint index, vint& start)
+				{
+					if (cachedBlock != -1 && cachedStart <= index && index < cachedStart + GetLineCount(blocks[cachedBlock].Obj()))
+					{
+						start = cachedStart;
+						return cachedBlock;
+					}
+
+					vint blockIndex = 0;
+					BlockSummary before;
+					cachedBlock = blockTree.Find([=](vint, const BlockSummary& sum) { return index < sum.lineCount; }, blockIndex, before);
+					cachedStart = before.lineCount;
+					start = cachedStart;
+					MaterializeBlock(cachedBlock);
+					return cachedBlock;
+				}
+
+				bool TextLineList::BalanceBlock(vint blockIndex)
+				{
+					// a block under half capacity is merged into a neighbour, or takes lines from it if they do not fit in one block
+					vint blockCount = blockTree.Count();
+					if (blockIndex < 0 || blockIndex >= blockCount || blockCount < 2) return false;
+					if (GetLineCount(blocks[blockTree.GetHandle(blockIndex)].Obj()) >= MaxBlockSize / 2) return false;
+
+					vint firstIndex = blockIndex + 1 < blockCount ? blockIndex : blockIndex - 1;
+					vint firstBlock = blockTree.GetHandle(firstIndex);
+					vint secondBlock = blockTree.GetHandle(firstIndex + 1);
+					MaterializeBlock(firstBlock);
+					MaterializeBlock(secondBlock);
+					auto first = blocks[firstBlock];
+					auto second = blocks[secondBlock];
+					vint total = first->lines.Count() + second->lines.Count();
+
+					if (total <= MaxBlockSize)
+					{
+						for (vint i = 0; i < second->lines.Count(); i++)
+						{
+							first->lines.Add(second->lines[i]);
+						}
+						if (first->maxWidth < second->maxWidth)
+						{
+							first->maxWidth = second->maxWidth;
+						}
+						if (second->widthDirty)
+						{
+							InvalidateBlockWidth(first);
+						}
+						RemoveBlock(secondBlock);
+					}
+					else
+					{
+						vint firstCount = total / 2;
+						if (first->lines.Count() < firstCount)
+						{
+							vint moving = firstCount - first->lines.Count();
+							for (vint i = 0; i < moving; i++)
+							{
+								first->lines.Add(second->lines[i]);
+							}
+							second->lines.RemoveRange(0, moving);
+						}
+						else
+						{
+							collections::List<TextLine> lines;
+							for (vint i = firstCount; i < first->lines.Count(); i++)
+							{
+								lines.Add(first->lines[i]);
+							}
+							for (vint i = 0; i < second->lines.Count(); i++)
+							{
+								lines.Add(second->lines[i]);
+							}
+							first->lines.RemoveRange(firstCount, first->lines.Count() - firstCount);
+							CopyFrom(second->lines, lines);
+						}
+						InvalidateBlockWidth(first);
+						InvalidateBlockWidth(second);
+						UpdateBlock(secondBlock);
+					}
+					UpdateBlock(firstBlock);
+					cachedBlock = -1;
+					return true;
+				}
+
+				TextLineList::TextLineList()
+					:count(0)
+					,cachedBlock(-1)
+					,cachedStart(0)
+				{
+				}
+
+				TextLineList::~TextLineList()
+				{
+				}
+
+				vint TextLineList::Count()
+				{
+					return count;
+				}
+
+				TextLine& TextLineList::operator[](vint index)
+				{
+					CHECK_ERROR(0 <= index && index < count, L"TextLineList::operator[](vint)#Argument index not in range.");
+					vint start = 0;
+					vint block = FindBlock(index, start);
+					return blocks[block]->lines[index - start];
+				}
+
+				void TextLineList::Add(const TextLine& line)
+				{
+					Insert(count, line);
+				}
+
+				void TextLineList::Insert(vint index, const TextLine& line)
+				{
+					CHECK_ERROR(0 <= index && index <= count, L"TextLineList::Insert(vint, const TextLine&)#Argument index not in range.");
+					vint block = 0;
+					vint local = 0;
+					if (count == 0)
+					{
+						block = blockTree.Count() == 0 ? InsertBlock(0) : blockTree.GetHandle(0);
+					}
+					else
+					{
+						// appending goes to the block of the last line
+						vint start = 0;
+						block = FindBlock(index == count ? index - 1 : index, start);
+						local = index - start;
+					}
+
+					auto current = blocks[block];
+					current->lines.Insert(local, line);
+					InvalidateBlockWidth(current);
+					count++;
+
+					if (current->lines.Count() > MaxBlockSize)
+					{
+						// appending to the last block starts a new one, so that sequential loading leaves full blocks behind
+						vint blockIndex = blockTree.GetIndex(block);
+						vint split = local == current->lines.Count() - 1 && blockIndex == blockTree.Count() - 1 ? local : current->lines.Count() / 2;
+						vint nextBlock = InsertBlock(blockIndex + 1);
+						auto next = blocks[nextBlock];
+						for (vint i = split; i < current->lines.Count(); i++)
+						{
+							next->lines.Add(current->lines[i]);
+						}
+						current->lines.RemoveRange(split, current->lines.Count() - split);
+						next->maxWidth = current->maxWidth;
+						InvalidateBlockWidth(next);
+						UpdateBlock(nextBlock);
+					}
+					else if (cachedBlock != block)
+					{
+						cachedBlock = -1;
+					}
+					UpdateBlock(block);
+				}
+
+				void TextLineList::RemoveAt(vint index)
+				{
+					RemoveRange(index, 1);
+				}
+
+				void TextLineList::RemoveRange(vint index, vint _count)
+				{
+					CHECK_ERROR(0 <= index && 0 <= _count && index + _count <= count, L"TextLineList::RemoveRange(vint, vint)#Argument index not in range.");
+					if (_count == 0) return;
+
+					vint start = 0;
+					vint block = FindBlock(index, start);
+					vint local = index - start;
+					count -= _count;
+
+					auto current = blocks[block];
+					if (local + _count < current->lines.Count())
+					{
+						current->lines.RemoveRange(local, _count);
+						InvalidateBlockWidth(current);
+						UpdateBlock(block);
+						if (!BalanceBlock(blockTree.GetIndex(block)) && cachedBlock != block)
+						{
+							cachedBlock = -1;
+						}
+						return;
+					}
+
+					// all touched blocks except the first and the last one become empty
+					vint firstIndex = blockTree.GetIndex(block);
+					vint blockIndex = firstIndex;
+					bool firstRemoved = false;
+					while (_count > 0)
+					{
+						block = blockTree.GetHandle(blockIndex);
+						current = blocks[block];
+						vint removing = GetLineCount(current.Obj()) - local;
+						if (removing > _count) removing = _count;
+						_count -= removing;
+
+						if (local == 0 && removing == GetLineCount(current.Obj()))
+						{
+							// a block that is entirely removed is not materialized
+							if (blockIndex == firstIndex) firstRemoved = true;
+							RemoveBlock(block);
+						}
+						else
+						{
+							MaterializeBlock(block);
+							current->lines.RemoveRange(local, removing);
+							InvalidateBlockWidth(current);
+							UpdateBlock(block);
+							blockIndex++;
+						}
+						local = 0;
+					}
+
+					// the first and the last touched blocks are neighbours now, and they could be small
+					vint lastIndex = firstRemoved ? firstIndex : firstIndex + 1;
+					BalanceBlock(lastIndex);
+					BalanceBlock(lastIndex - 1);
+					cachedBlock = -1;
+				}
+
+				void TextLineList::Clear()
+				{
+					for (vint i = 0; i < blocks.Count(); i++)
+					{
+						if (auto block = blocks[i])
+						{
+							for (vint j = 0; j < block->lines.Count(); j++)
+							{
+								block->lines[j].Finalize();
+							}
+							block->handle = -1;
+						}
+					}
+					blockTree.Clear();
+					blocks.Clear();
+					dirtyBlocks.Clear();
+					count = 0;
+					cachedBlock = -1;
+				}
+
+				void TextLineList::AppendLine()
+				{
+					vint blockCount = blockTree.Count();
+					vint block = blockCount == 0 ? -1 : blockTree.GetHandle(blockCount - 1);
+					if (block != -1 && blocks[block]->pendingStarts.Count() == 0)
+					{
+						TextLine line;
+						line.Initialize();
+						Add(line);
+						return;
+					}
+
+					if (block == -1 || blocks[block]->pendingStarts.Count() == MaxBlockSize)
+					{
+						if (block != -1)
+						{
+							// a full block receives no more characters
+							blocks[block]->pendingText.Resize(blocks[block]->pendingLength);
+						}
+						block = InsertBlock(blockCount);
+					}
+
+					auto current = blocks[block];
+					current->pendingStarts.Add(current->pendingLength);
+					InvalidateBlockWidth(current);
+					UpdateBlock(block);
+					count++;
+				}
+
+				void TextLineList::AppendText(const wchar_t* text, vint length)
+				{
+					CHECK_ERROR(count > 0, L"TextLineList::AppendText(const wchar_t*, vint)#There is no text line to append characters to.");
+					if (length == 0) return;
+
+					auto current = blocks[blockTree.GetHandle(blockTree.Count() - 1)];
+					if (current->pendingStarts.Count() > 0)
+					{
+						vint pendingLength = current->pendingLength + length;
+						if (pendingLength > current->pendingText.Count())
+						{
+							vint capacity = current->pendingText.Count() * 2;
+							current->pendingText.Resize(capacity < pendingLength ? pendingLength : capacity);
+						}
+						memcpy(&current->pendingText[current->pendingLength], text, length * sizeof(wchar_t));
+						current->pendingLength = pendingLength;
+					}
+					else
+					{
+						auto& line = current->lines[current->lines.Count() - 1];
+						line.Modify(line.dataLength, 0, text, length);
+					}
+					InvalidateBlockWidth(current);
+				}
+
+				void TextLineList::InvalidateWidth(vint index)
+				{
+					vint start = 0;
+					vint block = FindBlock(index, start);
+					InvalidateBlockWidth(blocks[block]);
+				}
+
+				void TextLineList::InvalidateWidths()
+				{
+					for (vint i = 0; i < blocks.Count(); i++)
+					{
+						if (blocks[i])
+						{
+							InvalidateBlockWidth(blocks[i]);
+						}
+					}
+				}
+
+				vint TextLineList::GetMaxWidth(const Func<vint(TextLine&)>& measureLine)
+				{
+					for (vint i = 0; i < dirtyBlocks.Count(); i++)
+					{
+						auto block = dirtyBlocks[i];
+						block->widthDirty = false;
+						if (block->handle == -1) continue;
+
+						vint maxWidth = 0;
+						for (vint j = 0; j < block->lines.Count(); j++)
+						{
+							vint width = measureLine(block->lines[j]);
+							if (maxWidth < width)
+							{
+								maxWidth = width;
+							}
+						}
+
+						vint pendingCount = block->pendingStarts.Count();
+						if (pendingCount > 0)
+						{
+							// characters are copied to a temporary text line for measuring, so that measuring does not materialize the block
+							TextLine line;
+							line.Initialize();
+							for (vint j = 0; j < pendingCount; j++)
+							{
+								vint start = block->pendingStarts[j];
+								vint end = j + 1 < pendingCount ? block->pendingStarts[j + 1] : block->pendingLength;
+								line.Modify(0, line.dataLength, (start < end ? &block->pendingText[start] : L""), end - start);
+								vint width = measureLine(line);
+								if (maxWidth < width)
+								{
+									maxWidth = width;
+								}
+							}
+							line.Finalize();
+						}
+						block->maxWidth = maxWidth;
+						UpdateBlock(block->handle);
+					}
+					dirtyBlocks.Clear();
+					return blockTree.GetTotal().maxWidth;
+				}
+
 /***********************************************************************
 text::TextLines
 ***********************************************************************/
@@ -193,7 +909,7 @@ text::TextLines
 
 				TextLines::~TextLines()
 				{
-					RemoveLines(0, lines.Count());
+					lines.Clear();
 				}
 
 				//--------------------------------------------------------
@@ -292,6 +1008,88 @@ text::TextLines
 					Modify(TextPos(0, 0), TextPos(lines.Count()-1, lines[lines.Count()-1].dataLength), value);
 				}
 
+				void TextLines::LoadText(stream::IStream& stream)
+				{
+					using namespace stream;
+					CHECK_ERROR(stream.CanRead() && stream.CanSeek(), L"TextLines::LoadText(IStream&)#The stream should be readable and seekable.");
+
+					// detect the encoding and skip the BOM
+					pos_t position = stream.Position();
+					Array<wchar_t> buffer(LoadBufferSize);
+					vint headerSize = stream.Read(&buffer[0], LoadBufferSize);
+					BomEncoder::Encoding encoding = BomEncoder::Mbcs;
+					bool containsBom = false;
+					TestEncoding((unsigned char*)&buffer[0], headerSize, encoding, containsBom);
+
+					Ptr<IDecoder> decoder;
+					vint bomSize = 0;
+					switch (encoding)
+					{
+					case BomEncoder::Utf8:
+						decoder = new Utf8Decoder;
+						bomSize = 3;
+						break;
+					case BomEncoder::Utf16:
+						decoder = new Utf16Decoder;
+						bomSize = 2;
+						break;
+					case BomEncoder::Utf16BE:
+						decoder = new Utf16BEDecoder;
+						bomSize = 2;
+						break;
+					default:
+						decoder = new MbcsDecoder;
+					}
+					stream.SeekFromBegin(position + (containsBom ? bomSize : 0));
+					DecoderStream decoderStream(stream, *decoder.Obj());
+
+					// lines are appended as characters, and they are created when they are accessed
+					lines.Clear();
+					lines.AppendLine();
+
+					// a line could cross chunks, and so could a CRLF
+					bool skipLF = false;
+					while (true)
+					{
+						vint length = decoderStream.Read(&buffer[0], LoadBufferSize * sizeof(wchar_t)) / sizeof(wchar_t);
+						if (length == 0) break;
+
+						const wchar_t* reading = &buffer[0];
+						const wchar_t* end = reading + length;
+						if (skipLF && *reading == L'\n')
+						{
+							reading++;
+						}
+						skipLF = false;
+
+						while (reading < end)
+						{
+							const wchar_t* lineEnd = FindLineBreak(reading, end);
+							lines.AppendText(reading, lineEnd - reading);
+							if (lineEnd == end) break;
+							lines.AppendLine();
+
+							if (*lineEnd == L'\r')
+							{
+								if (lineEnd + 1 == end)
+								{
+									skipLF = true;
+								}
+								else if (lineEnd[1] == L'\n')
+								{
+									lineEnd++;
+								}
+							}
+							reading = lineEnd + 1;
+						}
+					}
+
+					if (ownerElement)
+					{
+						ownerElement->InvokeOnElementStateChanged();
+					}
+				}
+
 				//--------------------------------------------------------
 
 				bool TextLines::RemoveLines(vint start, vint count)
@@ -351,6 +1149,7 @@ text::TextLines
 						if(start.row==end.row)
 						{
 							lines[start.row].Modify(start.column, end.column-start.column, inputs[0], inputCounts[0]);
+							lines.InvalidateWidth(start.row);
 						}
 						else
 						{
@@ -362,6 +1161,7 @@ text::TextLines
 							lines[start.row].AppendAndFinalize(lines[start.row+1]);
 							lines.RemoveAt(start.row+1);
 							lines[start.row].Modify(start.column, modifyCount, inputs[0], inputCounts[0]);
+							lines.InvalidateWidth(start.row);
 						}
 						return TextPos(start.row, start.column+inputCounts[0]);
 					}
@@ -396,6 +1196,10 @@ text::TextLines
 					{
 						lines[start.row+i].Modify(0, lines[start.row+i].dataLength, inputs[i], inputCounts[i]);
 					}
+					for(vint i=start.row;i<=end.row;i++)
+					{
+						lines.InvalidateWidth(i);
+					}
 					return TextPos(end.row, inputCounts[rows-1]);
 				}
 
@@ -404,27 +1208,19 @@ text::TextLines
 					List<const wchar_t*> inputs;
 					List<vint> inputCounts;
 					const wchar_t* previous=input;
-					const wchar_t* current=input;
+					const wchar_t* inputEnd=input+inputCount;
 
 					while(true)
 					{
-						if(current==input+inputCount)
+						const wchar_t* current=FindLineBreak(previous, inputEnd);
+						inputs.Add(previous);
+						inputCounts.Add(current-previous);
+						if(current==inputEnd)
 						{
-							inputs.Add(previous);
-							inputCounts.Add(current-previous);
 							break;
 						}
-						else if(*current==L'\r' || *current==L'\n')
-						{
-							inputs.Add(previous);
-							inputCounts.Add(current-previous);
-							previous=current+(current[1]==L'\n'?2:1);
-							current=previous;
-						}
-						else
-						{
-							current++;
-						}
+						// only CRLF is one line break, LFLF or CRCR are two
+						previous=current+(current[0]==L'\r' && current+1<inputEnd && current[1]==L'\n'?2:1);
 					}
 
 					return Modify(start, end, &inputs[0], &inputCounts[0], inputs.Count());
@@ -460,6 +1256,7 @@ text::TextLines
 					{
 						lines[i].availableOffsetCount = 0;
 					}
+					lines.InvalidateWidths();
 
 					tabWidth = tabSpaceCount * (charMeasurer ? charMeasurer->MeasureWidth(L' ') : 1);
 					if (tabWidth == 0)
@@ -488,52 +1285,150 @@ text::TextLines
 					}
 				}
 
-				void TextLines::MeasureRow(vint row)
+				void TextLines::MeasureLine(TextLine& line)
 				{
-					TextLine& line=lines[row];
+					vint start=line.availableOffsetCount;
+					if(start>0 && CharMeasurer::IsHighSurrogate(line.text[start-1]))
+					{
+						// the previous character may start or stop being a surrogate pair with this one
+						start--;
+					}
+					if(start>=line.dataLength)
+					{
+						line.availableOffsetCount=line.dataLength;
+						return;
+					}
+
 					vint offset=0;
-					if(line.availableOffsetCount)
+					if(start>0)
 					{
-						offset=line.att[line.availableOffsetCount-1].rightOffset;
+						offset=line.att[start-1].rightOffset;
 					}
-					for(vint i=line.availableOffsetCount;i<line.dataLength;i++)
+
+					const wchar_t* text=line.text;
+					vint length=line.dataLength;
+					if(passwordChar)
 					{
-						CharAtt& att=line.att[i];
-						wchar_t c=line.text[i];
-						vint width=0;
-						if(passwordChar)
+						// every character looks the same
+						vint width = charMeasurer ? charMeasurer->MeasureWidth(passwordChar) : 1;
+						for(vint i=start;i<length;i++)
+						{
+							offset+=width;
+							line.att[i].rightOffset=(int)offset;
+						}
+						line.availableOffsetCount=length;
+						return;
+					}
+
+					vint measuringCount=0;
+					if(charMeasurer)
+					{
+						// collect all characters that need measuring, so that the measurer could measure new characters together
+						if(measuringCodePoints.Count()<length-start)
+						{
+							measuringCodePoints.Resize(length-start);
+							measuringWidths.Resize(length-start);
+						}
+						UnicodeCodePoint* codePoints=&measuringCodePoints[0];
+						for(vint i=start;i<length;)
+						{
+							// characters before the next tab or surrogate are copied in bulk
+							vint runEnd=FindSpecialCharacter(text+i, text+length)-text;
+							for(;i<runEnd;i++)
+							{
+								codePoints[measuringCount++]=(UnicodeCodePoint)text[i];
+							}
+							if(i==length) break;
+
+							// tabs are not measured
+							wchar_t c=text[i];
+							if(CharMeasurer::IsHighSurrogate(c) && i+1<length && CharMeasurer::IsLowSurrogate(text[i+1]))
+							{
+								codePoints[measuringCount++]=CharMeasurer::CombineSurrogates(c, text[i+1]);
+								i++;
+							}
+							else if(c!=L'\t')
+							{
+								codePoints[measuringCount++]=(UnicodeCodePoint)c;
+							}
+							i++;
+						}
+						if(measuringCount>0)
+						{
+							charMeasurer->MeasureWidths(codePoints, &measuringWidths[0], measuringCount);
+						}
+					}
+
+					const vint* widths=measuringCount>0?&measuringWidths[0]:0;
+					vint measured=0;
+					for(vint i=start;i<length;)
+					{
+						vint runEnd=FindSpecialCharacter(text+i, text+length)-text;
+						if(widths)
+						{
+							for(;i<runEnd;i++)
+							{
+								offset+=widths[measured++];
+								line.att[i].rightOffset=(int)offset;
+							}
+						}
+						else
 						{
-							width = charMeasurer ? charMeasurer->MeasureWidth(passwordChar) : 1;
+							for(;i<runEnd;i++)
+							{
+								offset++;
+								line.att[i].rightOffset=(int)offset;
+							}
 						}
-						else if(c==L'\t')
+						if(i==length) break;
+
+						wchar_t c=text[i];
+						vint width=0;
+						if(c==L'\t')
 						{
 							width=tabWidth-offset%tabWidth;
 						}
 						else
 						{
-							width = charMeasurer ? charMeasurer->MeasureWidth(line.text[i]) : 1;
+							if(CharMeasurer::IsHighSurrogate(c) && i+1<length && CharMeasurer::IsLowSurrogate(text[i+1]))
+							{
+								// the width of a surrogate pair belongs to the second half
+								line.att[i].rightOffset=(int)offset;
+								i++;
+							}
+							width = widths ? widths[measured++] : 1;
 						}
 						offset+=width;
-						att.rightOffset=(int)offset;
+						line.att[i].rightOffset=(int)offset;
+						i++;
 					}
 					line.availableOffsetCount=line.dataLength;
 				}
 
-				vint TextLines::GetRowWidth(vint row)
+				vint TextLines::GetLineWidth(TextLine& line)
 				{
-					if(row<0 || row>=lines.Count()) return -1;
-					TextLine& line=lines[row];
 					if(line.dataLength==0)
 					{
 						return 0;
 					}
 					else
 					{
-						MeasureRow(row);
+						MeasureLine(line);
 						return line.att[line.dataLength-1].rightOffset;
 					}
 				}
 
+				void TextLines::MeasureRow(vint row)
+				{
+					MeasureLine(lines[row]);
+				}
+
+				vint TextLines::GetRowWidth(vint row)
+				{
+					if(row<0 || row>=lines.Count()) return -1;
+					return GetLineWidth(lines[row]);
+				}
+
 				vint TextLines::GetRowHeight()
 				{
 					return charMeasurer ? charMeasurer->GetRowHeight() : 1;
@@ -541,16 +1436,10 @@ text::TextLines
 
 				vint TextLines::GetMaxWidth()
 				{
-					vint width=0;
-					for(vint i=0;i<lines.Count();i++)
+					return lines.GetMaxWidth([this](TextLine& line)
 					{
-						vint rowWidth=GetRowWidth(i);
-						if(width<rowWidth)
-						{
-							width=rowWidth;
-						}
-					}
-					return width;
+						return GetLineWidth(line);
+					});
 				}
 
 				vint TextLines::GetMaxHeight()
@@ -657,6 +1546,157 @@ text::TextLines
 					passwordChar=value;
 					ClearMeasurement();
 				}
+
+				//--------------------------------------------------------
+
+				bool TextLines::Find(const WString& pattern, bool caseSensitive, bool forward, TextPos position, TextMatch& match)
+				{
+					CHECK_ERROR(pattern.Length()>0, L"TextLines::Find(const WString&, bool, bool, TextPos, TextMatch&)#The pattern should not be empty.");
+					TextSearchPattern searchPattern(pattern, caseSensitive);
+					vint extraRows=searchPattern.lines.Count()-1;
+					vint firstLength=searchPattern.lengths[0];
+					position=Normalize(position);
+
+					if(forward)
+					{
+						for(vint row=position.row;row+extraRows<lines.Count();row++)
+						{
+							TextLine& line=lines[row];
+
+							vint minColumn=row==position.row?position.column:0;
+							vint maxColumn=line.dataLength-firstLength;
+							if(extraRows>0 && minColumn<maxColumn)
+							{
+								// the first line of a multiple lines pattern should end with the line
+								minColumn=maxColumn;
+							}
+							for(vint column=minColumn;column<=maxColumn;column++)
+							{
+								if(searchPattern.StartsAt(line, column) && searchPattern.MatchAt(lines, row, column))
+								{
+									match=searchPattern.GetMatch(row, column);
+									return true;
+								}
+							}
+						}
+					}
+					else
+					{
+						for(vint row=position.row-extraRows;row>=0;row--)
+						{
+							TextLine& line=lines[row];
+
+							vint maxColumn=line.dataLength-firstLength;
+							vint minColumn=extraRows>0?maxColumn:0;
+							if(row+extraRows==position.row)
+							{
+								// the match should end at or before the position
+								if(extraRows==0)
+								{
+									if(maxColumn>position.column-firstLength)
+									{
+										maxColumn=position.column-firstLength;
+									}
+								}
+								else if(searchPattern.lengths[extraRows]>position.column)
+								{
+									continue;
+								}
+							}
+							for(vint column=maxColumn;column>=minColumn;column--)
+							{
+								if(searchPattern.StartsAt(line, column) && searchPattern.MatchAt(lines, row, column))
+								{
+									match=searchPattern.GetMatch(row, column);
+									return true;
+								}
+							}
+						}
+					}
+					return false;
+				}
+
+				bool TextLines::Find(const regex::Regex& pattern, bool forward, TextPos position, TextMatch& match)
+				{
+					position=Normalize(position);
+					regex::RegexMatch::List matches;
+					vint row=position.row;
+					while(0<=row && row<lines.Count())
+					{
+						TextLine& line=lines[row];
+						matches.Clear();
+						pattern.Search(WString(line.text, line.dataLength), matches);
+
+						for(vint i=0;i<matches.Count();i++)
+						{
+							regex::RegexString result=matches[forward?i:matches.Count()-1-i]->Result();
+							if(result.Length()==0) continue;
+							if(row==position.row && (forward?result.Start()<position.column:result.Start()+result.Length()>position.column)) continue;
+
+							match=TextMatch(TextPos(row, result.Start()), TextPos(row, result.Start()+result.Length()));
+							return true;
+						}
+						row+=forward?1:-1;
+					}
+					return false;
+				}
+
+				vint TextLines::FindAll(const WString& pattern, bool caseSensitive, collections::List<TextMatch>& matches)
+				{
+					CHECK_ERROR(pattern.Length()>0, L"TextLines::FindAll(const WString&, bool, List<TextMatch>&)#The pattern should not be empty.");
+					TextSearchPattern searchPattern(pattern, caseSensitive);
+					vint extraRows=searchPattern.lines.Count()-1;
+					vint firstLength=searchPattern.lengths[0];
+					matches.Clear();
+
+					// matches do not overlap, so searching continues after the previous match
+					TextPos next(0, 0);
+					for(vint row=0;row+extraRows<lines.Count();row++)
+					{
+						if(row<next.row) continue;
+						TextLine& line=lines[row];
+
+						vint minColumn=row==next.row?next.column:0;
+						vint maxColumn=line.dataLength-firstLength;
+						if(extraRows>0 && minColumn<maxColumn)
+						{
+							minColumn=maxColumn;
+						}
+						for(vint column=minColumn;column<=maxColumn;column++)
+						{
+							if(searchPattern.StartsAt(line, column) && searchPattern.MatchAt(lines, row, column))
+							{
+								TextMatch match=searchPattern.GetMatch(row, column);
+								matches.Add(match);
+								next=match.end;
+								if(extraRows>0) break;
+								column=next.column-1;
+							}
+						}
+					}
+					return matches.Count();
+				}
+
+				vint TextLines::FindAll(const regex::Regex& pattern, collections::List<TextMatch>& matches)
+				{
+					matches.Clear();
+					regex::RegexMatch::List lineMatches;
+					for(vint row=0;row<lines.Count();row++)
+					{
+						TextLine& line=lines[row];
+						lineMatches.Clear();
+						pattern.Search(WString(line.text, line.dataLength), lineMatches);
+						for(vint i=0;i<lineMatches.Count();i++)
+						{
+							regex::RegexString result=lineMatches[i]->Result();
+							if(result.Length()>0)
+							{
+								matches.Add(TextMatch(TextPos(row, result.Start()), TextPos(row, result.Start()+result.Length())));
+							}
+						}
+					}
+					return matches.Count();
+				}
 			}
 
 			using namespace text;
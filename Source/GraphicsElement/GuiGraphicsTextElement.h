@@ -10,6 +10,7 @@ Interfaces:
 #define VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSTEXTELEMENT
 
 #include "GuiGraphicsElement.h"
+#include "../GuiImplicitTreap.h"
 
 namespace vl
 {
@@ -25,6 +26,17 @@ Colorized Plain Text (model)
 
 			namespace text
 			{
+				/// <summary>Find the first CR or LF in a range of characters.</summary>
+				/// <returns>The first CR or LF, or the end of the range if there is none.</returns>
+				/// <param name="reading">The first character.</param>
+				/// <param name="end">The position after the last character.</param>
+				extern const wchar_t*				FindLineBreak(const wchar_t* reading, const wchar_t* end);
+				/// <summary>Find the first tab or UTF-16 surrogate in a range of characters. Characters before the result could be measured without looking at their neighbors.</summary>
+				/// <returns>The first tab or UTF-16 surrogate, or the end of the range if there is none.</returns>
+				/// <param name="reading">The first character.</param>
+				/// <param name="end">The position after the last character.</param>
+				extern const wchar_t*				FindSpecialCharacter(const wchar_t* reading, const wchar_t* end);
+
 				/// <summary>
 				/// Represents the extra information of a character to display.
 				/// </summary>
@@ -119,23 +131,72 @@ Colorized Plain Text (model)
 					void							AppendAndFinalize(TextLine& line);
 				};
 
+				/// <summary>
+				/// Represents a Unicode code point.
+				/// </summary>
+				typedef vuint32_t					UnicodeCodePoint;
+
 				/// <summary>
 				/// An abstract class for character size measuring in differect rendering technology.
+				/// Widths are cached by code point in pages that are allocated on demand.
+				/// Instances are shared between all text elements using the same font.
 				/// </summary>
 				class CharMeasurer : public virtual IDescriptable
 				{
+				public:
+					static const vint				WidthPageBits=10;
+					static const vint				WidthPageSize=1<<WidthPageBits;
+					static const vint				WidthPageCount=0x110000>>WidthPageBits;
+
+					/// <summary>
+					/// Test if a character is the first half of a surrogate pair.
+					/// </summary>
+					/// <returns>Returns true if the character is the first half of a surrogate pair.</returns>
+					/// <param name="character">The character to test.</param>
+					static bool						IsHighSurrogate(wchar_t character){return 0xD800<=character && character<0xDC00;}
+					/// <summary>
+					/// Test if a character is the second half of a surrogate pair.
+					/// </summary>
+					/// <returns>Returns true if the character is the second half of a surrogate pair.</returns>
+					/// <param name="character">The character to test.</param>
+					static bool						IsLowSurrogate(wchar_t character){return 0xDC00<=character && character<0xE000;}
+					/// <summary>
+					/// Combine a surrogate pair to a code point.
+					/// </summary>
+					/// <returns>The code point.</returns>
+					/// <param name="high">The first half of the surrogate pair.</param>
+					/// <param name="low">The second half of the surrogate pair.</param>
+					static UnicodeCodePoint			CombineSurrogates(wchar_t high, wchar_t low){return 0x10000+((((UnicodeCodePoint)high-0xD800)<<10)|((UnicodeCodePoint)low-0xDC00));}
+					/// <summary>
+					/// Write a code point to a UTF-16 or UTF-32 buffer depending on the size of wchar_t.
+					/// </summary>
+					/// <returns>The number of characters written to the buffer.</returns>
+					/// <param name="codePoint">The code point.</param>
+					/// <param name="buffer">The buffer with at least 2 characters.</param>
+					static vint						WriteCodePoint(UnicodeCodePoint codePoint, wchar_t* buffer);
 				protected:
 					IGuiGraphicsRenderTarget*		oldRenderTarget;
 					vint								rowHeight;
-					vint								widths[65536];
+					vint*							widthPages[WidthPageCount];
+
+					vint*							GetWidthEntry(UnicodeCodePoint codePoint);
+					void							ClearWidths();
 					
 					/// <summary>
 					/// Measure the width of a character.
 					/// </summary>
 					/// <returns>The width in pixel.</returns>
-					/// <param name="character">The character to measure. This is a pure virtual member function to be overrided.</param>
+					/// <param name="codePoint">The character to measure. This is a pure virtual member function to be overrided.</param>
 					/// <param name="renderTarget">The render target which the character is going to be rendered. This is a pure virtual member function to be overrided.</param>
-					virtual vint						MeasureWidthInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)=0;
+					virtual vint						MeasureWidthInternal(UnicodeCodePoint codePoint, IGuiGraphicsRenderTarget* renderTarget)=0;
+					/// <summary>
+					/// Measure the width of multiple characters. The default implementation calls [M:vl.presentation.elements.text.CharMeasurer.MeasureWidthInternal] for each character.
+					/// </summary>
+					/// <param name="codePoints">The characters to measure.</param>
+					/// <param name="widths">The buffer to receive widths in pixel.</param>
+					/// <param name="count">The number of characters.</param>
+					/// <param name="renderTarget">The render target which the character is going to be rendered.</param>
+					virtual void						MeasureWidthsInternal(const UnicodeCodePoint* codePoints, vint* widths, vint count, IGuiGraphicsRenderTarget* renderTarget);
 					/// <summary>
 					/// Measure the height of a character.
 					/// </summary>
@@ -160,8 +221,15 @@ Colorized Plain Text (model)
 					/// Measure the width of a character using the binded render target.
 					/// </summary>
 					/// <returns>The width of a character, in pixel.</returns>
-					/// <param name="character">The character to measure.</param>
-					vint								MeasureWidth(wchar_t character);
+					/// <param name="codePoint">The character to measure.</param>
+					vint								MeasureWidth(UnicodeCodePoint codePoint);
+					/// <summary>
+					/// Measure the width of multiple characters using the binded render target. Characters that are not cached are measured in one call.
+					/// </summary>
+					/// <param name="codePoints">The characters to measure.</param>
+					/// <param name="widths">The buffer to receive widths in pixel.</param>
+					/// <param name="count">The number of characters.</param>
+					void								MeasureWidths(const UnicodeCodePoint* codePoints, vint* widths, vint count);
 					/// <summary>
 					/// Measure the height of a character.
 					/// </summary>
@@ -169,12 +237,128 @@ Colorized Plain Text (model)
 					vint								GetRowHeight();
 				};
 
+				/// <summary>
+				/// A list of text lines that are stored in blocks, so that inserting or removing lines in the middle of a large document only moves lines in one block.
+				/// Blocks are indexed by an implicit treap of their numbers of lines and maximum widths, so that finding, splitting and merging blocks take logarithm time.
+				/// </summary>
+				class TextLineList : public Object
+				{
+					struct Block
+					{
+						collections::List<TextLine>	lines;
+						collections::Array<wchar_t>	pendingText;
+						vint						pendingLength = 0;
+						collections::List<vint>		pendingStarts;
+						vint						handle = -1;
+						vint						maxWidth = 0;
+						bool						widthDirty = false;
+					};
+
+					struct BlockSummary
+					{
+						vint						lineCount = 0;
+						vint						maxWidth = 0;
+
+						BlockSummary operator+(const BlockSummary& value)const
+						{
+							BlockSummary result;
+							result.lineCount = lineCount + value.lineCount;
+							result.maxWidth = maxWidth > value.maxWidth ? maxWidth : value.maxWidth;
+							return result;
+						}
+					};
+					typedef collections::List<Ptr<Block>>			BlockList;
+				public:
+					static const vint				MaxBlockSize=512;
+				protected:
+					ImplicitTreap<BlockSummary>		blockTree;
+					BlockList						blocks;
+					BlockList						dirtyBlocks;
+					vint							count;
+					vint							cachedBlock;
+					vint							cachedStart;
+
+					static vint						GetLineCount(Block* block);
+					void							MaterializeBlock(vint block);
+					vint							InsertBlock(vint blockIndex);
+					void							RemoveBlock(vint block);
+					void							UpdateBlock(vint block);
+					void							InvalidateBlockWidth(const Ptr<Block>& block);
+					vint							FindBlock(vint index, vint& start);
+					bool							BalanceBlock(vint blockIndex);
+				public:
+					TextLineList();
+					~TextLineList();
+
+					/// <summary>Get the number of text lines.</summary>
+					/// <returns>The number of text lines.</returns>
+					vint							Count();
+					/// <summary>Get a text line. The reference is valid until the list is modified.</summary>
+					/// <returns>The text line.</returns>
+					/// <param name="index">The index of the text line.</param>
+					TextLine&						operator[](vint index);
+					/// <summary>Append a text line.</summary>
+					/// <param name="line">The text line.</param>
+					void							Add(const TextLine& line);
+					/// <summary>Insert a text line.</summary>
+					/// <param name="index">The position to insert.</param>
+					/// <param name="line">The text line.</param>
+					void							Insert(vint index, const TextLine& line);
+					/// <summary>Remove a text line. The text line is not finalized.</summary>
+					/// <param name="index">The index of the text line.</param>
+					void							RemoveAt(vint index);
+					/// <summary>Remove text lines in a range. Text lines are not finalized.</summary>
+					/// <param name="index">The index of the first text line.</param>
+					/// <param name="_count">The number of text lines.</param>
+					void							RemoveRange(vint index, vint _count);
+					/// <summary>Remove and finalize all text lines.</summary>
+					void							Clear();
+					/// <summary>Append an empty text line. When the list only contains text lines appended in this way, characters of these text lines are kept in their blocks, and text lines in a block are created when any of them is accessed.</summary>
+					void							AppendLine();
+					/// <summary>Append characters to the last text line.</summary>
+					/// <param name="text">The characters.</param>
+					/// <param name="length">The number of characters.</param>
+					void							AppendText(const wchar_t* text, vint length);
+
+					/// <summary>Notify that the width of a text line is changed.</summary>
+					/// <param name="index">The index of the text line.</param>
+					void							InvalidateWidth(vint index);
+					/// <summary>Notify that the width of all text lines are changed.</summary>
+					void							InvalidateWidths();
+					/// <summary>Get the maximum width of all text lines. Only text lines in blocks that are changed since the last call are measured again.</summary>
+					/// <returns>The maximum width.</returns>
+					/// <param name="measureLine">The callback to measure the width of a text line.</param>
+					vint							GetMaxWidth(const Func<vint(TextLine&)>& measureLine);
+				};
+
+				/// <summary>
+				/// Represents a range of characters found by searching.
+				/// </summary>
+				struct TextMatch
+				{
+					/// <summary>
+					/// The position of the first character.
+					/// </summary>
+					TextPos							start;
+					/// <summary>
+					/// The position after the last character.
+					/// </summary>
+					TextPos							end;
+
+					TextMatch(){}
+					TextMatch(TextPos _start, TextPos _end):start(_start),end(_end){}
+
+					bool							operator==(const TextMatch& value)const { return start == value.start && end == value.end; }
+					bool							operator!=(const TextMatch& value)const { return !(*this == value); }
+				};
+
 				/// <summary>
 				/// A class to maintain multiple lines of text buffer.
 				/// </summary>
 				class TextLines : public Object, public Description<TextLines>
 				{
-					typedef collections::List<TextLine>		TextLineList;
+				public:
+					static const vint				LoadBufferSize=65536;
 				protected:
 					GuiColorizedTextElement*		ownerElement;
 					TextLineList					lines;
@@ -183,6 +367,12 @@ Colorized Plain Text (model)
 					vint							tabWidth;
 					vint							tabSpaceCount;
 					wchar_t							passwordChar;
+
+					collections::Array<UnicodeCodePoint>	measuringCodePoints;
+					collections::Array<vint>		measuringWidths;
+
+					void							MeasureLine(TextLine& line);
+					vint							GetLineWidth(TextLine& line);
 				public:
 					TextLines(GuiColorizedTextElement* _ownerElement);
 					~TextLines();
@@ -235,6 +425,11 @@ Colorized Plain Text (model)
 					/// </summary>
 					/// <param name="value">The string to set into the text lines.</param>
 					void							SetText(const WString& value);
+					/// <summary>
+					/// Replace the whole text with the content of a stream. The encoding is detected from the beginning of the stream. Characters are kept in blocks of text lines while reading, without decoding the whole content into one string, and text lines in a block are created when any of them is accessed.
+					/// </summary>
+					/// <param name="stream">The stream to read, it should be readable and seekable.</param>
+					void							LoadText(stream::IStream& stream);
 					
 					/// <summary>
 					/// Remove text lines in a specified range.
@@ -363,6 +558,41 @@ Colorized Plain Text (model)
 					/// </summary>
 					/// <param name="value">The password mode displaying character. Set to L'\0' to deactivate the password mode.</param>
 					void							SetPasswordChar(wchar_t value);
+
+					/// <summary>
+					/// Find a string in the text lines. Text lines are searched directly without being concatenated, and the whole pattern is only compared at positions where its first character appears.
+					/// </summary>
+					/// <returns>Returns true if a match is found.</returns>
+					/// <param name="pattern">The string to find, which could contain line breaks.</param>
+					/// <param name="caseSensitive">Set to true to compare characters case sensitively.</param>
+					/// <param name="forward">Set to true to find the first match that starts at or after the position. Set to false to find the last match that ends at or before the position.</param>
+					/// <param name="position">The position to search from.</param>
+					/// <param name="match">The found match.</param>
+					bool							Find(const WString& pattern, bool caseSensitive, bool forward, TextPos position, TextMatch& match);
+					/// <summary>
+					/// Find a regular expression in the text lines. Each line is matched separately, so a match never crosses lines. Empty matches are ignored.
+					/// </summary>
+					/// <returns>Returns true if a match is found.</returns>
+					/// <param name="pattern">The regular expression to find.</param>
+					/// <param name="forward">Set to true to find the first match that starts at or after the position. Set to false to find the last match that ends at or before the position.</param>
+					/// <param name="position">The position to search from.</param>
+					/// <param name="match">The found match.</param>
+					bool							Find(const regex::Regex& pattern, bool forward, TextPos position, TextMatch& match);
+					/// <summary>
+					/// Find all non-overlapping occurrences of a string in the text lines.
+					/// </summary>
+					/// <returns>The number of matches.</returns>
+					/// <param name="pattern">The string to find, which could contain line breaks.</param>
+					/// <param name="caseSensitive">Set to true to compare characters case sensitively.</param>
+					/// <param name="matches">The list to receive matches in order.</param>
+					vint							FindAll(const WString& pattern, bool caseSensitive, collections::List<TextMatch>& matches);
+					/// <summary>
+					/// Find all non-empty matches of a regular expression in the text lines.
+					/// </summary>
+					/// <returns>The number of matches.</returns>
+					/// <param name="pattern">The regular expression to find.</param>
+					/// <param name="matches">The list to receive matches in order.</param>
+					vint							FindAll(const regex::Regex& pattern, collections::List<TextMatch>& matches);
 				};
 				
 				/// <summary>
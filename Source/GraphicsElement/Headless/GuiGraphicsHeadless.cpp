@@ -0,0 +1,481 @@
+#include "GuiGraphicsHeadless.h"
+#include "GuiGraphicsRenderersHeadless.h"
+#include "GuiGraphicsLayoutProviderHeadless.h"
+#include "../GuiGraphicsDocumentElement.h"
+#include "../../Controls/GuiApplication.h"
+#include "../../NativeWindow/Headless/ServicesImpl/HeadlessImageService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_headless
+		{
+			using namespace elements;
+			using namespace collections;
+
+/***********************************************************************
+Font Metrics
+***********************************************************************/
+
+			vint GetHeadlessCharWidth(vuint32_t character, vint fontSize)
+			{
+				if(fontSize<0) fontSize=-fontSize;
+				return character>=0x1100?fontSize:(fontSize+1)/2;
+			}
+
+			vint GetHeadlessRowHeight(vint fontSize)
+			{
+				return fontSize<0?-fontSize:fontSize;
+			}
+
+/***********************************************************************
+HeadlessRenderTarget
+***********************************************************************/
+
+			class HeadlessRenderTarget : public Object, public IHeadlessRenderTarget
+			{
+			protected:
+				INativeWindow*					window;
+				List<Rect>						clippers;
+				vint							clipperCoverWholeTargetCounter;
+				vint							frameCount;
+				List<HeadlessDrawCall>			drawCalls;
+				Ptr<SoftwareFramebuffer>		framebuffer;
+
+				void ApplyClipper()
+				{
+					if(framebuffer)
+					{
+						framebuffer->SetClipper(clipperCoverWholeTargetCounter>0?Rect():GetClipper());
+					}
+				}
+			public:
+				HeadlessRenderTarget(INativeWindow* _window, bool rasterize)
+					:window(_window)
+					,clipperCoverWholeTargetCounter(0)
+					,frameCount(0)
+				{
+					if(rasterize)
+					{
+						framebuffer=new SoftwareFramebuffer(window->GetClientSize());
+					}
+				}
+
+				void ResizeFramebuffer()
+				{
+					if(framebuffer && framebuffer->GetSize()!=window->GetClientSize())
+					{
+						framebuffer->Resize(window->GetClientSize());
+					}
+				}
+
+				void StartRendering()override
+				{
+					frameCount++;
+					drawCalls.Clear();
+					ResizeFramebuffer();
+					ApplyClipper();
+				}
+
+				RenderTargetFailure StopRendering()override
+				{
+					return RenderTargetFailure::None;
+				}
+
+				void PushClipper(Rect clipper)override
+				{
+					if(clipperCoverWholeTargetCounter>0)
+					{
+						clipperCoverWholeTargetCounter++;
+					}
+					else
+					{
+						Rect previousClipper=GetClipper();
+						Rect currentClipper;
+
+						currentClipper.x1=(previousClipper.x1>clipper.x1?previousClipper.x1:clipper.x1);
+						currentClipper.y1=(previousClipper.y1>clipper.y1?previousClipper.y1:clipper.y1);
+						currentClipper.x2=(previousClipper.x2<clipper.x2?previousClipper.x2:clipper.x2);
+						currentClipper.y2=(previousClipper.y2<clipper.y2?previousClipper.y2:clipper.y2);
+
+						if(currentClipper.x1<currentClipper.x2 && currentClipper.y1<currentClipper.y2)
+						{
+							clippers.Add(currentClipper);
+						}
+						else
+						{
+							clipperCoverWholeTargetCounter++;
+						}
+					}
+					ApplyClipper();
+				}
+
+				void PopClipper()override
+				{
+					if(clipperCoverWholeTargetCounter>0)
+					{
+						clipperCoverWholeTargetCounter--;
+						ApplyClipper();
+					}
+					else if(clippers.Count()>0)
+					{
+						clippers.RemoveAt(clippers.Count()-1);
+						ApplyClipper();
+					}
+				}
+
+				Rect GetClipper()override
+				{
+					if(clippers.Count()==0)
+					{
+						return Rect(Point(0, 0), window->GetClientSize());
+					}
+					else
+					{
+						return clippers[clippers.Count()-1];
+					}
+				}
+
+				bool IsClipperCoverWholeTarget()override
+				{
+					return clipperCoverWholeTargetCounter>0;
+				}
+
+				bool IsContentRetained()override
+				{
+					// recorded draw calls are only discarded when a new frame starts
+					return true;
+				}
+
+				void RecordDrawCall(const WString& type, IGuiGraphicsElement* element, Rect bounds)override
+				{
+					if(clipperCoverWholeTargetCounter==0)
+					{
+						Rect clipper=GetClipper();
+						if(bounds.x1<clipper.x2 && clipper.x1<bounds.x2 && bounds.y1<clipper.y2 && clipper.y1<bounds.y2)
+						{
+							drawCalls.Add(HeadlessDrawCall(type, element, bounds, clipper));
+						}
+					}
+				}
+
+				vint GetFrameCount()override
+				{
+					return frameCount;
+				}
+
+				const List<HeadlessDrawCall>& GetDrawCalls()override
+				{
+					return drawCalls;
+				}
+
+				SoftwareFramebuffer* GetFramebuffer()override
+				{
+					return framebuffer.Obj();
+				}
+			};
+
+/***********************************************************************
+CachedResourceAllocator
+***********************************************************************/
+
+			class CachedCharMeasurerAllocator
+			{
+				DEFINE_CACHED_RESOURCE_ALLOCATOR(FontProperties, Ptr<text::CharMeasurer>)
+
+			protected:
+				class HeadlessCharMeasurer : public text::CharMeasurer
+				{
+				protected:
+					vint						size;
+
+					vint MeasureWidthInternal(text::UnicodeCodePoint codePoint, IGuiGraphicsRenderTarget* renderTarget)
+					{
+						return GetHeadlessCharWidth(codePoint, size);
+					}
+
+					vint GetRowHeightInternal(IGuiGraphicsRenderTarget* renderTarget)
+					{
+						return GetHeadlessRowHeight(size);
+					}
+				public:
+					HeadlessCharMeasurer(vint _size)
+						:text::CharMeasurer(GetHeadlessRowHeight(_size))
+						,size(_size)
+					{
+					}
+				};
+			public:
+				Ptr<text::CharMeasurer> CreateInternal(const FontProperties& value)
+				{
+					return new HeadlessCharMeasurer(value.size);
+				}
+			};
+
+/***********************************************************************
+HeadlessResourceManager
+***********************************************************************/
+
+			class HeadlessImageFrameCache : public Object, public INativeImageFrameCache
+			{
+			protected:
+				INativeImageFrame*					cachedFrame;
+				Ptr<SoftwareFramebuffer>			bitmap;
+				Ptr<SoftwareFramebuffer>			disabledBitmap;
+
+				static vint ReadInt(const Array<vuint8_t>& data, vint offset, vint bytes)
+				{
+					vuint32_t value=0;
+					for(vint i=bytes-1;i>=0;i--)
+					{
+						value=(value<<8)|data[offset+i];
+					}
+					return bytes==4?(vint)(vint32_t)value:(vint)value;
+				}
+
+				static Ptr<SoftwareFramebuffer> DecodeBitmap(const Array<vuint8_t>& data)
+				{
+					if(data.Count()<54 || data[0]!='B' || data[1]!='M') return 0;
+					vint pixelOffset=ReadInt(data, 10, 4);
+					vint width=ReadInt(data, 18, 4);
+					vint height=ReadInt(data, 22, 4);
+					vint bitCount=ReadInt(data, 28, 2);
+					vint compression=ReadInt(data, 30, 4);
+
+					// only BI_RGB, and BI_BITFIELDS with the default BGRA masks, are supported
+					if(bitCount!=24 && bitCount!=32) return 0;
+					if(compression!=0 && !(compression==3 && bitCount==32)) return 0;
+
+					bool topDown=height<0;
+					if(topDown) height=-height;
+					vint stride=(width*bitCount+31)/32*4;
+					if(width<=0 || pixelOffset<0 || pixelOffset+stride*height>data.Count()) return 0;
+
+					Ptr<SoftwareFramebuffer> bitmap=new SoftwareFramebuffer(Size(width, height));
+					bool hasAlpha=false;
+					for(vint y=0;y<height;y++)
+					{
+						const vuint8_t* read=&data[pixelOffset+stride*(topDown?y:height-y-1)];
+						vuint32_t* write=bitmap->GetScanLine(y);
+						for(vint x=0;x<width;x++)
+						{
+							Color color(read[2], read[1], read[0], (bitCount==32?read[3]:255));
+							if(color.a!=0) hasAlpha=true;
+							write[x]=color.value;
+							read+=bitCount/8;
+						}
+					}
+
+					if(!hasAlpha)
+					{
+						// a 32 bits bitmap without any alpha value is opaque
+						for(vint y=0;y<height;y++)
+						{
+							vuint32_t* write=bitmap->GetScanLine(y);
+							for(vint x=0;x<width;x++)
+							{
+								write[x]|=Color(0, 0, 0, 255).value;
+							}
+						}
+					}
+					return bitmap;
+				}
+			public:
+				HeadlessImageFrameCache()
+					:cachedFrame(0)
+				{
+				}
+
+				void OnAttach(INativeImageFrame* frame)override
+				{
+					cachedFrame=frame;
+					if(auto image=dynamic_cast<headless::HeadlessImage*>(frame->GetImage()))
+					{
+						if(image->GetFormat()==INativeImage::Bmp)
+						{
+							bitmap=DecodeBitmap(image->GetData());
+						}
+					}
+				}
+
+				void OnDetach(INativeImageFrame* frame)override
+				{
+					bitmap=0;
+					disabledBitmap=0;
+				}
+
+				Ptr<SoftwareFramebuffer> GetBitmap(bool enabled)
+				{
+					if(enabled || !bitmap)
+					{
+						return bitmap;
+					}
+					else
+					{
+						if(!disabledBitmap)
+						{
+							Size size=bitmap->GetSize();
+							disabledBitmap=new SoftwareFramebuffer(size);
+							for(vint y=0;y<size.y;y++)
+							{
+								vuint32_t* read=bitmap->GetScanLine(y);
+								vuint32_t* write=disabledBitmap->GetScanLine(y);
+								for(vint x=0;x<size.x;x++)
+								{
+									Color color;
+									color.value=read[x];
+									unsigned char g=(unsigned char)((color.r+color.g+color.b)/6+color.a/2);
+									write[x]=Color(g, g, g, color.a).value;
+								}
+							}
+						}
+						return disabledBitmap;
+					}
+				}
+			};
+
+			class HeadlessResourceManager : public GuiGraphicsResourceManager, public IHeadlessResourceManager, public INativeControllerListener
+			{
+			protected:
+				bool														rasterize;
+				Dictionary<INativeWindow*, Ptr<HeadlessRenderTarget>>		renderTargets;
+				Ptr<HeadlessLayoutProvider>									layoutProvider;
+				CachedCharMeasurerAllocator									charMeasurers;
+			public:
+				HeadlessResourceManager(bool _rasterize)
+					:rasterize(_rasterize)
+				{
+					layoutProvider=new HeadlessLayoutProvider;
+				}
+
+				IGuiGraphicsRenderTarget* GetRenderTarget(INativeWindow* window)override
+				{
+					return GetHeadlessRenderTarget(window);
+				}
+
+				void RecreateRenderTarget(INativeWindow* window)override
+				{
+				}
+
+				void ResizeRenderTarget(INativeWindow* window)override
+				{
+					vint index=renderTargets.Keys().IndexOf(window);
+					if(index!=-1)
+					{
+						renderTargets.Values()[index]->ResizeFramebuffer();
+					}
+				}
+
+				IGuiGraphicsLayoutProvider* GetLayoutProvider()override
+				{
+					return layoutProvider.Obj();
+				}
+
+				void NativeWindowCreated(INativeWindow* window)override
+				{
+					renderTargets.Add(window, new HeadlessRenderTarget(window, rasterize));
+				}
+
+				void NativeWindowDestroying(INativeWindow* window)override
+				{
+					renderTargets.Remove(window);
+				}
+
+				IHeadlessRenderTarget* GetHeadlessRenderTarget(INativeWindow* window)override
+				{
+					vint index=renderTargets.Keys().IndexOf(window);
+					return index==-1?0:renderTargets.Values()[index].Obj();
+				}
+
+				Ptr<text::CharMeasurer> CreateCharMeasurer(const FontProperties& fontProperties)override
+				{
+					return charMeasurers.Create(fontProperties);
+				}
+
+				void DestroyCharMeasurer(const FontProperties& fontProperties)override
+				{
+					charMeasurers.Destroy(fontProperties);
+				}
+
+				Ptr<SoftwareFramebuffer> GetBitmap(INativeImageFrame* frame, bool enabled)override
+				{
+					Ptr<INativeImageFrameCache> cache=frame->GetCache(this);
+					if(cache)
+					{
+						return cache.Cast<HeadlessImageFrameCache>()->GetBitmap(enabled);
+					}
+					else
+					{
+						Ptr<HeadlessImageFrameCache> headlessCache=new HeadlessImageFrameCache;
+						if(frame->SetCache(this, headlessCache))
+						{
+							return headlessCache->GetBitmap(enabled);
+						}
+						else
+						{
+							return 0;
+						}
+					}
+				}
+			};
+		}
+
+		namespace elements_headless
+		{
+			IHeadlessResourceManager* headlessResourceManager=0;
+
+			IHeadlessResourceManager* GetHeadlessResourceManager()
+			{
+				return headlessResourceManager;
+			}
+
+			void SetHeadlessResourceManager(IHeadlessResourceManager* resourceManager)
+			{
+				headlessResourceManager=resourceManager;
+			}
+		}
+	}
+}
+
+/***********************************************************************
+NativeMain
+***********************************************************************/
+
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+
+void RendererMainHeadlessInternal(bool rasterize)
+{
+	elements_headless::HeadlessResourceManager resourceManager(rasterize);
+	SetGuiGraphicsResourceManager(&resourceManager);
+	elements_headless::SetHeadlessResourceManager(&resourceManager);
+	GetCurrentController()->CallbackService()->InstallListener(&resourceManager);
+
+	elements_headless::GuiSolidBorderElementRenderer::Register();
+	elements_headless::Gui3DBorderElementRenderer::Register();
+	elements_headless::Gui3DSplitterElementRenderer::Register();
+	elements_headless::GuiSolidBackgroundElementRenderer::Register();
+	elements_headless::GuiGradientBackgroundElementRenderer::Register();
+	elements_headless::GuiInnerShadowElementRenderer::Register();
+	elements_headless::GuiSolidLabelElementRenderer::Register();
+	elements_headless::GuiImageFrameElementRenderer::Register();
+	elements_headless::GuiPolygonElementRenderer::Register();
+	elements_headless::GuiColorizedTextElementRenderer::Register();
+	elements::GuiDocumentElement::GuiDocumentElementRenderer::Register();
+
+	GuiApplicationMain();
+	GetCurrentController()->CallbackService()->UninstallListener(&resourceManager);
+	elements_headless::SetHeadlessResourceManager(0);
+	SetGuiGraphicsResourceManager(0);
+}
+
+void RendererMainHeadless()
+{
+	RendererMainHeadlessInternal(false);
+}
+
+void RendererMainSoftware()
+{
+	RendererMainHeadlessInternal(true);
+}
@@ -0,0 +1,117 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Provider::Renderer
+
+Interfaces:
+  IHeadlessRenderTarget					: Render target that records draw calls
+  IHeadlessResourceManager				: Resource manager with fixed font metrics
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSHEADLESS
+#define VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSHEADLESS
+
+#include "../GuiGraphicsElement.h"
+#include "../GuiGraphicsTextElement.h"
+#include "../GuiGraphicsDocumentInterfaces.h"
+#include "GuiGraphicsSoftware.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_headless
+		{
+
+/***********************************************************************
+Functionality
+***********************************************************************/
+
+			/// <summary>A draw call that is recorded by a headless render target.</summary>
+			struct HeadlessDrawCall
+			{
+				/// <summary>The element type name of the renderer that issues this draw call, or "Paragraph" and "Caret" for paragraphs.</summary>
+				WString								type;
+				/// <summary>The element to render. It is null when the draw call is issued by a paragraph.</summary>
+				elements::IGuiGraphicsElement*		element;
+				/// <summary>The bounds to render.</summary>
+				Rect								bounds;
+				/// <summary>The clipper when the draw call is issued.</summary>
+				Rect								clipper;
+
+				HeadlessDrawCall()
+					:element(0)
+				{
+				}
+
+				HeadlessDrawCall(const WString& _type, elements::IGuiGraphicsElement* _element, Rect _bounds, Rect _clipper)
+					:type(_type)
+					,element(_element)
+					,bounds(_bounds)
+					,clipper(_clipper)
+				{
+				}
+
+				bool operator==(const HeadlessDrawCall& value)const{return type==value.type && element==value.element && bounds==value.bounds && clipper==value.clipper;}
+				bool operator!=(const HeadlessDrawCall& value)const{return !(*this==value);}
+			};
+
+			/// <summary>A render target that records all draw calls in the last frame. When it is created by <see cref="RendererMainSoftware"/>, elements are also rasterized into a framebuffer.</summary>
+			class IHeadlessRenderTarget : public elements::IGuiGraphicsRenderTarget
+			{
+			public:
+				/// <summary>Record a draw call. Draw calls that are completely clipped are ignored.</summary>
+				/// <param name="type">The type of the draw call.</param>
+				/// <param name="element">The element to render.</param>
+				/// <param name="bounds">The bounds to render.</param>
+				virtual void													RecordDrawCall(const WString& type, elements::IGuiGraphicsElement* element, Rect bounds)=0;
+				/// <summary>Get how many frames have been rendered to this render target.</summary>
+				/// <returns>The number of frames.</returns>
+				virtual vint													GetFrameCount()=0;
+				/// <summary>Get all draw calls in the last frame.</summary>
+				/// <returns>All draw calls.</returns>
+				virtual const collections::List<HeadlessDrawCall>&				GetDrawCalls()=0;
+				/// <summary>Get the framebuffer, which always has the same size as the client area of the window. The clipper of the framebuffer follows the clipper of the render target.</summary>
+				/// <returns>The framebuffer. Returns null if the software rasterizer is not enabled.</returns>
+				virtual SoftwareFramebuffer*									GetFramebuffer()=0;
+			};
+
+			/// <summary>
+			/// The resource manager for the headless renderer.
+			/// All fonts are measured in fixed metrics: the row height is the font size, a character from U+1100 is as wide as the font size, and other characters are half as wide as the font size.
+			/// </summary>
+			class IHeadlessResourceManager : public Interface
+			{
+			public:
+				/// <summary>Get the render target of a window.</summary>
+				/// <returns>The render target.</returns>
+				/// <param name="window">The window.</param>
+				virtual IHeadlessRenderTarget*									GetHeadlessRenderTarget(INativeWindow* window)=0;
+				virtual Ptr<elements::text::CharMeasurer>						CreateCharMeasurer(const FontProperties& fontProperties)=0;
+				virtual void													DestroyCharMeasurer(const FontProperties& fontProperties)=0;
+				/// <summary>Get the decoded pixels of an image frame. Only uncompressed 24 bits and 32 bits BMP images are decoded.</summary>
+				/// <returns>The decoded pixels. Returns null if the image frame cannot be decoded.</returns>
+				/// <param name="frame">The image frame.</param>
+				/// <param name="enabled">Set to false to get the gray version of the image.</param>
+				virtual Ptr<SoftwareFramebuffer>								GetBitmap(INativeImageFrame* frame, bool enabled)=0;
+			};
+
+			extern IHeadlessResourceManager*									GetHeadlessResourceManager();
+
+			/// <summary>Get the width of a character in the fixed font metrics.</summary>
+			/// <returns>The width of the character.</returns>
+			/// <param name="character">The code point of the character.</param>
+			/// <param name="fontSize">The font size.</param>
+			extern vint															GetHeadlessCharWidth(vuint32_t character, vint fontSize);
+			/// <summary>Get the height of a row in the fixed font metrics.</summary>
+			/// <returns>The height of a row.</returns>
+			/// <param name="fontSize">The font size.</param>
+			extern vint															GetHeadlessRowHeight(vint fontSize);
+		}
+	}
+}
+
+extern void RendererMainHeadless();
+extern void RendererMainSoftware();
+
+#endif
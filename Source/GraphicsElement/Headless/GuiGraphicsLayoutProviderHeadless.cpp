@@ -0,0 +1,579 @@
+#include "GuiGraphicsLayoutProviderHeadless.h"
+#include "GuiGraphicsHeadless.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_headless
+		{
+			using namespace elements;
+			using namespace collections;
+
+/***********************************************************************
+HeadlessParagraph
+***********************************************************************/
+
+			class HeadlessParagraph : public Object, public IGuiGraphicsParagraph
+			{
+			protected:
+				struct InlineObject
+				{
+					vint							start;
+					vint							length;
+					InlineObjectProperties			properties;
+
+					bool operator==(const InlineObject& value)const{return false;}
+					bool operator!=(const InlineObject& value)const{return true;}
+				};
+
+				struct Line
+				{
+					vint							start;
+					vint							end;
+					vint							x;
+					vint							y;
+					vint							width;
+					vint							height;
+
+					bool operator==(const Line& value)const{return false;}
+					bool operator!=(const Line& value)const{return true;}
+				};
+
+				IGuiGraphicsLayoutProvider*			provider;
+				WString								text;
+				IHeadlessRenderTarget*				renderTarget;
+				IGuiGraphicsParagraphCallback*		paragraphCallback;
+				bool								wrapLine;
+				vint								maxWidth;
+				Alignment							paragraphAlignment;
+				Array<vint>							sizes;
+				List<InlineObject>					inlineObjects;
+
+				vint								caret;
+				Color								caretColor;
+				bool								caretFrontSide;
+
+				bool								layouted;
+				List<Line>							lines;
+				Array<vint>							caretLines;
+				Array<vint>							caretOffsets;
+				vint								height;
+
+				bool IsValidRange(vint start, vint length)
+				{
+					return 0<=start && start<text.Length() && length>=0 && 0<=start+length && start+length<=text.Length();
+				}
+
+				vint GetInlineObjectIndex(vint textPos)
+				{
+					for(vint i=0;i<inlineObjects.Count();i++)
+					{
+						const InlineObject& inlineObject=inlineObjects[i];
+						if(inlineObject.start<=textPos && textPos<inlineObject.start+inlineObject.length)
+						{
+							return i;
+						}
+					}
+					return -1;
+				}
+
+				void AddLine(Line& line, vint end, vint x, vint lineHeight)
+				{
+					line.end=end;
+					line.width=x;
+					line.height=lineHeight;
+					line.y=height;
+					height+=lineHeight;
+					lines.Add(line);
+				}
+
+				void Layout()
+				{
+					if(layouted) return;
+					layouted=true;
+					lines.Clear();
+					height=0;
+					caretLines.Resize(text.Length()+1);
+					caretOffsets.Resize(text.Length()+1);
+
+					vint emptyHeight=GetHeadlessRowHeight(GetCurrentController()->ResourceService()->GetDefaultFont().size);
+					Line line;
+					line.start=0;
+					vint x=0;
+					vint lineHeight=0;
+					vint i=0;
+					while(i<text.Length())
+					{
+						if(text[i]==L'\n')
+						{
+							caretLines[i]=lines.Count();
+							caretOffsets[i]=x;
+							AddLine(line, i, x, lineHeight==0?emptyHeight:lineHeight);
+							line.start=i+1;
+							x=0;
+							lineHeight=0;
+							i++;
+							continue;
+						}
+
+						vint length=1;
+						Size unit;
+						vint index=GetInlineObjectIndex(i);
+						if(index!=-1)
+						{
+							length=inlineObjects[index].length;
+							unit=inlineObjects[index].properties.size;
+						}
+						else if(text[i]!=L'\r')
+						{
+							unit=Size(GetHeadlessCharWidth(text[i], sizes[i]), GetHeadlessRowHeight(sizes[i]));
+						}
+
+						if(wrapLine && maxWidth>0 && x>0 && x+unit.x>maxWidth)
+						{
+							AddLine(line, i, x, lineHeight==0?emptyHeight:lineHeight);
+							line.start=i;
+							x=0;
+							lineHeight=0;
+						}
+
+						for(vint j=0;j<length;j++)
+						{
+							caretLines[i+j]=lines.Count();
+							caretOffsets[i+j]=x;
+						}
+						x+=unit.x;
+						if(lineHeight<unit.y) lineHeight=unit.y;
+						i+=length;
+					}
+					caretLines[text.Length()]=lines.Count();
+					caretOffsets[text.Length()]=x;
+					AddLine(line, text.Length(), x, lineHeight==0?emptyHeight:lineHeight);
+
+					for(vint j=0;j<lines.Count();j++)
+					{
+						Line& current=lines[j];
+						current.x=0;
+						if(maxWidth>0)
+						{
+							switch(paragraphAlignment)
+							{
+							case Alignment::Center:
+								current.x=(maxWidth-current.width)/2;
+								break;
+							case Alignment::Right:
+								current.x=maxWidth-current.width;
+								break;
+							default:;
+							}
+						}
+					}
+				}
+
+				Rect GetInlineObjectBounds(const InlineObject& inlineObject)
+				{
+					const Line& line=lines[caretLines[inlineObject.start]];
+					Size size=inlineObject.properties.size;
+					vint x=line.x+caretOffsets[inlineObject.start];
+					vint y=line.y+line.height-size.y;
+					return Rect(Point(x, y), size);
+				}
+
+				vint GetCaretFromLine(vint lineIndex, vint x)
+				{
+					const Line& line=lines[lineIndex];
+					x-=line.x;
+					vint lastCaret=line.start;
+					for(vint i=line.start;i<=line.end;i++)
+					{
+						if(!IsValidCaret(i) || caretLines[i]!=lineIndex) continue;
+						if(caretOffsets[i]>=x)
+						{
+							if(i>line.start && x-caretOffsets[lastCaret]<caretOffsets[i]-x)
+							{
+								return lastCaret;
+							}
+							return i;
+						}
+						lastCaret=i;
+					}
+					return lastCaret;
+				}
+			public:
+				HeadlessParagraph(IGuiGraphicsLayoutProvider* _provider, const WString& _text, IGuiGraphicsRenderTarget* _renderTarget, IGuiGraphicsParagraphCallback* _paragraphCallback)
+					:provider(_provider)
+					,text(_text)
+					,renderTarget(dynamic_cast<IHeadlessRenderTarget*>(_renderTarget))
+					,paragraphCallback(_paragraphCallback)
+					,wrapLine(true)
+					,maxWidth(-1)
+					,paragraphAlignment(Alignment::Left)
+					,caret(-1)
+					,caretFrontSide(false)
+					,layouted(false)
+					,height(0)
+				{
+					vint defaultSize=GetCurrentController()->ResourceService()->GetDefaultFont().size;
+					sizes.Resize(text.Length());
+					for(vint i=0;i<sizes.Count();i++)
+					{
+						sizes[i]=defaultSize;
+					}
+				}
+
+				~HeadlessParagraph()
+				{
+					CloseCaret();
+				}
+
+				IGuiGraphicsLayoutProvider* GetProvider()override
+				{
+					return provider;
+				}
+
+				IGuiGraphicsRenderTarget* GetRenderTarget()override
+				{
+					return renderTarget;
+				}
+
+				bool GetWrapLine()override
+				{
+					return wrapLine;
+				}
+
+				void SetWrapLine(bool value)override
+				{
+					if(wrapLine!=value)
+					{
+						wrapLine=value;
+						layouted=false;
+					}
+				}
+
+				vint GetMaxWidth()override
+				{
+					return maxWidth;
+				}
+
+				void SetMaxWidth(vint value)override
+				{
+					if(maxWidth!=value)
+					{
+						maxWidth=value;
+						layouted=false;
+					}
+				}
+
+				Alignment GetParagraphAlignment()override
+				{
+					return paragraphAlignment;
+				}
+
+				void SetParagraphAlignment(Alignment value)override
+				{
+					if(paragraphAlignment!=value)
+					{
+						paragraphAlignment=value;
+						layouted=false;
+					}
+				}
+
+				bool SetFont(vint start, vint length, const WString& value)override
+				{
+					if(length==0) return true;
+					return IsValidRange(start, length);
+				}
+
+				bool SetSize(vint start, vint length, vint value)override
+				{
+					if(length==0) return true;
+					if(IsValidRange(start, length))
+					{
+						for(vint i=0;i<length;i++)
+						{
+							sizes[start+i]=value;
+						}
+						layouted=false;
+						return true;
+					}
+					else
+					{
+						return false;
+					}
+				}
+
+				bool SetStyle(vint start, vint length, TextStyle value)override
+				{
+					if(length==0) return true;
+					return IsValidRange(start, length);
+				}
+
+				bool SetColor(vint start, vint length, Color value)override
+				{
+					if(length==0) return true;
+					return IsValidRange(start, length);
+				}
+
+				bool SetBackgroundColor(vint start, vint length, Color value)override
+				{
+					if(length==0) return true;
+					return IsValidRange(start, length);
+				}
+
+				bool SetInlineObject(vint start, vint length, const InlineObjectProperties& properties)override
+				{
+					if(length==0) return true;
+					if(IsValidRange(start, length))
+					{
+						for(vint i=0;i<inlineObjects.Count();i++)
+						{
+							const InlineObject& inlineObject=inlineObjects[i];
+							if(inlineObject.start<start+length && start<inlineObject.start+inlineObject.length)
+							{
+								return false;
+							}
+						}
+
+						InlineObject inlineObject;
+						inlineObject.start=start;
+						inlineObject.length=length;
+						inlineObject.properties=properties;
+						inlineObjects.Add(inlineObject);
+						layouted=false;
+
+						if (properties.backgroundImage)
+						{
+							IGuiGraphicsRenderer* renderer=properties.backgroundImage->GetRenderer();
+							if(renderer)
+							{
+								renderer->SetRenderTarget(renderTarget);
+							}
+						}
+						return true;
+					}
+					return false;
+				}
+
+				bool ResetInlineObject(vint start, vint length)override
+				{
+					if(length==0) return true;
+					if(IsValidRange(start, length))
+					{
+						for(vint i=0;i<inlineObjects.Count();i++)
+						{
+							InlineObject inlineObject=inlineObjects[i];
+							if(inlineObject.start==start && inlineObject.length==length)
+							{
+								inlineObjects.RemoveAt(i);
+								layouted=false;
+
+								if (auto element = inlineObject.properties.backgroundImage)
+								{
+									auto renderer=element->GetRenderer();
+									if(renderer)
+									{
+										renderer->SetRenderTarget(0);
+									}
+								}
+								return true;
+							}
+						}
+					}
+					return false;
+				}
+
+				vint GetHeight()override
+				{
+					Layout();
+					return height;
+				}
+
+				bool OpenCaret(vint _caret, Color _color, bool _frontSide)override
+				{
+					if(!IsValidCaret(_caret)) return false;
+					if(caret!=-1) CloseCaret();
+					caret=_caret;
+					caretColor=_color;
+					caretFrontSide=_frontSide;
+					return true;
+				}
+
+				bool CloseCaret()override
+				{
+					if(caret==-1) return false;
+					caret=-1;
+					return true;
+				}
+
+				void Render(Rect bounds)override
+				{
+					Layout();
+					renderTarget->RecordDrawCall(L"Paragraph", 0, bounds);
+
+					bool sizeChanged=false;
+					for(vint i=0;i<inlineObjects.Count();i++)
+					{
+						InlineObject& inlineObject=inlineObjects[i];
+						Rect location=GetInlineObjectBounds(inlineObject);
+						location.x1+=bounds.x1;
+						location.x2+=bounds.x1;
+						location.y1+=bounds.y1;
+						location.y2+=bounds.y1;
+
+						if(auto element=inlineObject.properties.backgroundImage)
+						{
+							if(auto renderer=element->GetRenderer())
+							{
+								renderer->Render(location);
+							}
+						}
+						if(paragraphCallback && inlineObject.properties.callbackId!=-1)
+						{
+							Size size=paragraphCallback->OnRenderInlineObject(inlineObject.properties.callbackId, location);
+							if(size!=inlineObject.properties.size)
+							{
+								inlineObject.properties.size=size;
+								sizeChanged=true;
+							}
+						}
+					}
+					if(sizeChanged)
+					{
+						layouted=false;
+					}
+
+					if(caret!=-1)
+					{
+						Rect caretBounds=GetCaretBounds(caret, caretFrontSide);
+						vint x=caretBounds.x1+bounds.x1;
+						vint y=caretBounds.y1+bounds.y1;
+						renderTarget->RecordDrawCall(L"Caret", 0, Rect(x-1, y, x+1, y+caretBounds.Height()));
+					}
+				}
+
+				vint GetCaret(vint comparingCaret, CaretRelativePosition position, bool& preferFrontSide)override
+				{
+					Layout();
+					if(position==CaretFirst) return 0;
+					if(position==CaretLast) return text.Length();
+					if(!IsValidCaret(comparingCaret)) return -1;
+
+					vint lineIndex=caretLines[comparingCaret];
+					switch(position)
+					{
+					case CaretLineFirst:
+						return lines[lineIndex].start;
+					case CaretLineLast:
+						return lines[lineIndex].end;
+					case CaretMoveLeft:
+						{
+							if(comparingCaret==0) return 0;
+							vint index=GetInlineObjectIndex(comparingCaret-1);
+							return index==-1?comparingCaret-1:inlineObjects[index].start;
+						}
+					case CaretMoveRight:
+						{
+							if(comparingCaret==text.Length()) return text.Length();
+							vint index=GetInlineObjectIndex(comparingCaret);
+							return index==-1?comparingCaret+1:inlineObjects[index].start+inlineObjects[index].length;
+						}
+					case CaretMoveUp:
+					case CaretMoveDown:
+						{
+							vint targetLine=position==CaretMoveUp?lineIndex-1:lineIndex+1;
+							if(targetLine<0 || targetLine>=lines.Count()) return comparingCaret;
+							vint x=lines[lineIndex].x+caretOffsets[comparingCaret];
+							return GetCaretFromLine(targetLine, x);
+						}
+					default:
+						return -1;
+					}
+				}
+
+				Rect GetCaretBounds(vint caret, bool frontSide)override
+				{
+					Layout();
+					if(!IsValidCaret(caret)) return Rect();
+					const Line& line=lines[caretLines[caret]];
+					vint x=line.x+caretOffsets[caret];
+					return Rect(x, line.y, x, line.y+line.height);
+				}
+
+				vint GetCaretFromPoint(Point point)override
+				{
+					Layout();
+					for(vint i=0;i<inlineObjects.Count();i++)
+					{
+						const InlineObject& inlineObject=inlineObjects[i];
+						Rect bounds=GetInlineObjectBounds(inlineObject);
+						if(bounds.Contains(point))
+						{
+							return point.x<(bounds.x1+bounds.x2)/2?inlineObject.start:inlineObject.start+inlineObject.length;
+						}
+					}
+
+					vint lineIndex=lines.Count()-1;
+					for(vint i=0;i<lines.Count();i++)
+					{
+						if(point.y<lines[i].y+lines[i].height)
+						{
+							lineIndex=i;
+							break;
+						}
+					}
+					return GetCaretFromLine(lineIndex, point.x);
+				}
+
+				Nullable<InlineObjectProperties> GetInlineObjectFromPoint(Point point, vint& start, vint& length)override
+				{
+					Layout();
+					for(vint i=0;i<inlineObjects.Count();i++)
+					{
+						const InlineObject& inlineObject=inlineObjects[i];
+						if(GetInlineObjectBounds(inlineObject).Contains(point))
+						{
+							start=inlineObject.start;
+							length=inlineObject.length;
+							return inlineObject.properties;
+						}
+					}
+					return Nullable<InlineObjectProperties>();
+				}
+
+				vint GetNearestCaretFromTextPos(vint textPos, bool frontSide)override
+				{
+					if(!IsValidTextPos(textPos)) return -1;
+					vint index=textPos==text.Length()?-1:GetInlineObjectIndex(textPos);
+					if(index==-1 || inlineObjects[index].start==textPos)
+					{
+						return textPos;
+					}
+					const InlineObject& inlineObject=inlineObjects[index];
+					return frontSide?inlineObject.start:inlineObject.start+inlineObject.length;
+				}
+
+				bool IsValidCaret(vint caret)override
+				{
+					if(!IsValidTextPos(caret)) return false;
+					vint index=caret==text.Length()?-1:GetInlineObjectIndex(caret);
+					return index==-1 || inlineObjects[index].start==caret;
+				}
+
+				bool IsValidTextPos(vint textPos)override
+				{
+					return 0<=textPos && textPos<=text.Length();
+				}
+			};
+
+/***********************************************************************
+HeadlessLayoutProvider
+***********************************************************************/
+
+			Ptr<IGuiGraphicsParagraph> HeadlessLayoutProvider::CreateParagraph(const WString& text, IGuiGraphicsRenderTarget* renderTarget, elements::IGuiGraphicsParagraphCallback* callback)
+			{
+				return new HeadlessParagraph(this, text, renderTarget, callback);
+			}
+		}
+	}
+}
@@ -0,0 +1,29 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Provider::Renderer
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSLAYOUTPROVIDERHEADLESS
+#define VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSLAYOUTPROVIDERHEADLESS
+
+#include "../GuiGraphicsDocumentInterfaces.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_headless
+		{
+			class HeadlessLayoutProvider : public Object, public elements::IGuiGraphicsLayoutProvider
+			{
+			public:
+				 Ptr<elements::IGuiGraphicsParagraph>		CreateParagraph(const WString& text, elements::IGuiGraphicsRenderTarget* renderTarget, elements::IGuiGraphicsParagraphCallback* callback)override;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
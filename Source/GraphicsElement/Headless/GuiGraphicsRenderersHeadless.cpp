@@ -0,0 +1,530 @@
+#include "GuiGraphicsRenderersHeadless.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_headless
+		{
+			using namespace collections;
+
+/***********************************************************************
+Text Measuring
+***********************************************************************/
+
+			Size MeasureHeadlessText(const WString& text, vint fontSize, bool multiline, vint maxWidth)
+			{
+				vint rowHeight=GetHeadlessRowHeight(fontSize);
+				vint width=0;
+				vint rows=1;
+				vint x=0;
+				for(vint i=0;i<text.Length();i++)
+				{
+					wchar_t c=text[i];
+					if(c==L'\r')
+					{
+						continue;
+					}
+					if(c==L'\n' && multiline)
+					{
+						rows++;
+						x=0;
+						continue;
+					}
+					vint charWidth=GetHeadlessCharWidth(c, fontSize);
+					if(maxWidth>0 && x>0 && x+charWidth>maxWidth)
+					{
+						rows++;
+						x=0;
+					}
+					x+=charWidth;
+					if(width<x) width=x;
+				}
+				return Size(width, rows*rowHeight);
+			}
+
+/***********************************************************************
+GuiSolidBorderElementRenderer
+***********************************************************************/
+
+			void GuiSolidBorderElementRenderer::InitializeInternal()
+			{
+			}
+
+			void GuiSolidBorderElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiSolidBorderElementRenderer::RenderTargetChangedInternal(IHeadlessRenderTarget* oldRenderTarget, IHeadlessRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiSolidBorderElementRenderer::Render(Rect bounds)
+			{
+				renderTarget->RecordDrawCall(element->GetFactory()->GetElementTypeName(), element, bounds);
+				if(auto framebuffer=renderTarget->GetFramebuffer())
+				{
+					framebuffer->DrawShapeBorder(bounds, element->GetShape(), element->GetColor());
+				}
+			}
+
+			void GuiSolidBorderElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+Gui3DBorderElementRenderer
+***********************************************************************/
+
+			void Gui3DBorderElementRenderer::InitializeInternal()
+			{
+			}
+
+			void Gui3DBorderElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void Gui3DBorderElementRenderer::RenderTargetChangedInternal(IHeadlessRenderTarget* oldRenderTarget, IHeadlessRenderTarget* newRenderTarget)
+			{
+			}
+
+			void Gui3DBorderElementRenderer::Render(Rect bounds)
+			{
+				renderTarget->RecordDrawCall(element->GetFactory()->GetElementTypeName(), element, bounds);
+				if(auto framebuffer=renderTarget->GetFramebuffer())
+				{
+					Color color1=element->GetColor1();
+					Color color2=element->GetColor2();
+					framebuffer->DrawLine(Point(bounds.x1, bounds.y1), Point(bounds.x2, bounds.y1), color1);
+					framebuffer->DrawLine(Point(bounds.x1, bounds.y1), Point(bounds.x1, bounds.y2), color1);
+					framebuffer->DrawLine(Point(bounds.x2-1, bounds.y2-1), Point(bounds.x1, bounds.y2-1), color2);
+					framebuffer->DrawLine(Point(bounds.x2-1, bounds.y2-1), Point(bounds.x2-1, bounds.y1), color2);
+				}
+			}
+
+			void Gui3DBorderElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+Gui3DSplitterElementRenderer
+***********************************************************************/
+
+			void Gui3DSplitterElementRenderer::InitializeInternal()
+			{
+			}
+
+			void Gui3DSplitterElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void Gui3DSplitterElementRenderer::RenderTargetChangedInternal(IHeadlessRenderTarget* oldRenderTarget, IHeadlessRenderTarget* newRenderTarget)
+			{
+			}
+
+			void Gui3DSplitterElementRenderer::Render(Rect bounds)
+			{
+				renderTarget->RecordDrawCall(element->GetFactory()->GetElementTypeName(), element, bounds);
+				if(auto framebuffer=renderTarget->GetFramebuffer())
+				{
+					Color color1=element->GetColor1();
+					Color color2=element->GetColor2();
+					switch(element->GetDirection())
+					{
+					case Gui3DSplitterElement::Horizontal:
+						{
+							vint y=bounds.y1+bounds.Height()/2-1;
+							framebuffer->DrawLine(Point(bounds.x1, y), Point(bounds.x2, y), color1);
+							framebuffer->DrawLine(Point(bounds.x1, y+1), Point(bounds.x2, y+1), color2);
+						}
+						break;
+					case Gui3DSplitterElement::Vertical:
+						{
+							vint x=bounds.x1+bounds.Width()/2-1;
+							framebuffer->DrawLine(Point(x, bounds.y1), Point(x, bounds.y2), color1);
+							framebuffer->DrawLine(Point(x+1, bounds.y1), Point(x+1, bounds.y2), color2);
+						}
+						break;
+					}
+				}
+			}
+
+			void Gui3DSplitterElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+GuiSolidBackgroundElementRenderer
+***********************************************************************/
+
+			void GuiSolidBackgroundElementRenderer::InitializeInternal()
+			{
+			}
+
+			void GuiSolidBackgroundElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiSolidBackgroundElementRenderer::RenderTargetChangedInternal(IHeadlessRenderTarget* oldRenderTarget, IHeadlessRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiSolidBackgroundElementRenderer::Render(Rect bounds)
+			{
+				renderTarget->RecordDrawCall(element->GetFactory()->GetElementTypeName(), element, bounds);
+				if(auto framebuffer=renderTarget->GetFramebuffer())
+				{
+					framebuffer->FillShape(bounds, element->GetShape(), element->GetColor());
+				}
+			}
+
+			void GuiSolidBackgroundElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+GuiGradientBackgroundElementRenderer
+***********************************************************************/
+
+			void GuiGradientBackgroundElementRenderer::InitializeInternal()
+			{
+			}
+
+			void GuiGradientBackgroundElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiGradientBackgroundElementRenderer::RenderTargetChangedInternal(IHeadlessRenderTarget* oldRenderTarget, IHeadlessRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiGradientBackgroundElementRenderer::Render(Rect bounds)
+			{
+				renderTarget->RecordDrawCall(element->GetFactory()->GetElementTypeName(), element, bounds);
+				if(auto framebuffer=renderTarget->GetFramebuffer())
+				{
+					framebuffer->FillGradientShape(bounds, element->GetShape(), element->GetColor1(), element->GetColor2(), element->GetDirection());
+				}
+			}
+
+			void GuiGradientBackgroundElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+GuiInnerShadowElementRenderer
+***********************************************************************/
+
+			void GuiInnerShadowElementRenderer::InitializeInternal()
+			{
+			}
+
+			void GuiInnerShadowElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiInnerShadowElementRenderer::RenderTargetChangedInternal(IHeadlessRenderTarget* oldRenderTarget, IHeadlessRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiInnerShadowElementRenderer::Render(Rect bounds)
+			{
+				renderTarget->RecordDrawCall(element->GetFactory()->GetElementTypeName(), element, bounds);
+				if(auto framebuffer=renderTarget->GetFramebuffer())
+				{
+					vint t=element->GetThickness();
+					if(t>0 && bounds.Width()>2*t && bounds.Height()>2*t)
+					{
+						// the shadow is opaque at the border, and fades out towards the inner rectangle
+						Color color=element->GetColor();
+						Color transparent(color.r, color.g, color.b, 0);
+						vint x1=bounds.x1, x2=x1+t, x4=bounds.x2, x3=x4-t;
+						vint y1=bounds.y1, y2=y1+t, y4=bounds.y2, y3=y4-t;
+
+						for(vint y=y1;y<y2;y++)
+						{
+							Color rowColor=Color(color.r, color.g, color.b, (unsigned char)(color.a*(y2-y)/t));
+							framebuffer->FillSpan(y, x2, x3, rowColor);
+						}
+						for(vint y=y3;y<y4;y++)
+						{
+							Color rowColor=Color(color.r, color.g, color.b, (unsigned char)(color.a*(y-y3+1)/t));
+							framebuffer->FillSpan(y, x2, x3, rowColor);
+						}
+						for(vint y=y2;y<y3;y++)
+						{
+							framebuffer->FillInterpolatedSpan(y, x1, x2, color, transparent);
+							framebuffer->FillInterpolatedSpan(y, x3, x4, transparent, color);
+						}
+						framebuffer->FillRadialGradientRect(Rect(x1, y1, x2, y2), Point(x2, y2), t, transparent, color);
+						framebuffer->FillRadialGradientRect(Rect(x3, y1, x4, y2), Point(x3, y2), t, transparent, color);
+						framebuffer->FillRadialGradientRect(Rect(x1, y3, x2, y4), Point(x2, y3), t, transparent, color);
+						framebuffer->FillRadialGradientRect(Rect(x3, y3, x4, y4), Point(x3, y3), t, transparent, color);
+					}
+				}
+			}
+
+			void GuiInnerShadowElementRenderer::OnElementStateChanged()
+			{
+			}
+
+/***********************************************************************
+GuiSolidLabelElementRenderer
+***********************************************************************/
+
+			void GuiSolidLabelElementRenderer::UpdateMinSize()
+			{
+				if(renderTarget)
+				{
+					const WString& text=element->GetText();
+					vint fontSize=element->GetFont().size;
+					Size size;
+					if(element->GetWrapLine())
+					{
+						if(element->GetWrapLineHeightCalculation())
+						{
+							if(oldMaxWidth==-1 || text.Length()==0)
+							{
+								size=MeasureHeadlessText(L" ", fontSize, false, -1);
+							}
+							else
+							{
+								size=MeasureHeadlessText(text, fontSize, true, oldMaxWidth);
+							}
+						}
+					}
+					else
+					{
+						size=MeasureHeadlessText((text.Length()==0?WString(L" "):text), fontSize, element->GetMultiline(), -1);
+					}
+					minSize=Size((element->GetEllipse()?0:size.x), size.y);
+				}
+				else
+				{
+					minSize=Size();
+				}
+			}
+
+			void GuiSolidLabelElementRenderer::InitializeInternal()
+			{
+			}
+
+			void GuiSolidLabelElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiSolidLabelElementRenderer::RenderTargetChangedInternal(IHeadlessRenderTarget* oldRenderTarget, IHeadlessRenderTarget* newRenderTarget)
+			{
+				UpdateMinSize();
+			}
+
+			GuiSolidLabelElementRenderer::GuiSolidLabelElementRenderer()
+				:oldMaxWidth(-1)
+			{
+			}
+
+			void GuiSolidLabelElementRenderer::Render(Rect bounds)
+			{
+				renderTarget->RecordDrawCall(element->GetFactory()->GetElementTypeName(), element, bounds);
+				if(oldMaxWidth!=bounds.Width())
+				{
+					oldMaxWidth=bounds.Width();
+					UpdateMinSize();
+				}
+			}
+
+			void GuiSolidLabelElementRenderer::OnElementStateChanged()
+			{
+				UpdateMinSize();
+			}
+
+/***********************************************************************
+GuiImageFrameElementRenderer
+***********************************************************************/
+
+			void GuiImageFrameElementRenderer::UpdateMinSize()
+			{
+				if(element->GetImage() && !element->GetStretch())
+				{
+					INativeImageFrame* frame=element->GetImage()->GetFrame(element->GetFrameIndex());
+					minSize=frame->GetSize();
+				}
+				else
+				{
+					minSize=Size(0, 0);
+				}
+			}
+
+			void GuiImageFrameElementRenderer::InitializeInternal()
+			{
+				UpdateMinSize();
+			}
+
+			void GuiImageFrameElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiImageFrameElementRenderer::RenderTargetChangedInternal(IHeadlessRenderTarget* oldRenderTarget, IHeadlessRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiImageFrameElementRenderer::Render(Rect bounds)
+			{
+				if(element->GetImage())
+				{
+					renderTarget->RecordDrawCall(element->GetFactory()->GetElementTypeName(), element, bounds);
+					if(auto framebuffer=renderTarget->GetFramebuffer())
+					{
+						INativeImageFrame* frame=element->GetImage()->GetFrame(element->GetFrameIndex());
+						Ptr<SoftwareFramebuffer> bitmap=GetHeadlessResourceManager()->GetBitmap(frame, element->GetEnabled());
+						if(!bitmap) return;
+
+						Size size=frame->GetSize();
+						Rect source(0, 0, size.x, size.y);
+						Rect destination;
+						if(element->GetStretch())
+						{
+							destination=bounds;
+						}
+						else
+						{
+							vint x=0;
+							vint y=0;
+							switch(element->GetHorizontalAlignment())
+							{
+							case Alignment::Left:
+								x=bounds.Left();
+								break;
+							case Alignment::Center:
+								x=bounds.Left()+(bounds.Width()-size.x)/2;
+								break;
+							case Alignment::Right:
+								x=bounds.Right()-size.x;
+								break;
+							}
+							switch(element->GetVerticalAlignment())
+							{
+							case Alignment::Top:
+								y=bounds.Top();
+								break;
+							case Alignment::Center:
+								y=bounds.Top()+(bounds.Height()-size.y)/2;
+								break;
+							case Alignment::Bottom:
+								y=bounds.Bottom()-size.y;
+								break;
+							}
+							destination=Rect(x, y, x+size.x, y+size.y);
+						}
+						framebuffer->DrawBitmap(destination, bitmap.Obj(), source);
+					}
+				}
+			}
+
+			void GuiImageFrameElementRenderer::OnElementStateChanged()
+			{
+				UpdateMinSize();
+			}
+
+/***********************************************************************
+GuiPolygonElementRenderer
+***********************************************************************/
+
+			void GuiPolygonElementRenderer::InitializeInternal()
+			{
+				minSize=element->GetSize();
+			}
+
+			void GuiPolygonElementRenderer::FinalizeInternal()
+			{
+			}
+
+			void GuiPolygonElementRenderer::RenderTargetChangedInternal(IHeadlessRenderTarget* oldRenderTarget, IHeadlessRenderTarget* newRenderTarget)
+			{
+			}
+
+			void GuiPolygonElementRenderer::Render(Rect bounds)
+			{
+				renderTarget->RecordDrawCall(element->GetFactory()->GetElementTypeName(), element, bounds);
+				if(auto framebuffer=renderTarget->GetFramebuffer())
+				{
+					vint count=element->GetPointCount();
+					if(count>=3)
+					{
+						vint offsetX=(bounds.Width()-minSize.x)/2+bounds.x1;
+						vint offsetY=(bounds.Height()-minSize.y)/2+bounds.y1;
+						Array<Point> points(count);
+						for(vint i=0;i<count;i++)
+						{
+							Point p=element->GetPoint(i);
+							points[i]=Point(p.x+offsetX, p.y+offsetY);
+						}
+						framebuffer->FillPolygon(&points[0], count, element->GetBackgroundColor());
+						framebuffer->DrawPolygonBorder(&points[0], count, element->GetBorderColor());
+					}
+				}
+			}
+
+			void GuiPolygonElementRenderer::OnElementStateChanged()
+			{
+				minSize=element->GetSize();
+			}
+
+/***********************************************************************
+GuiColorizedTextElementRenderer
+***********************************************************************/
+
+			void GuiColorizedTextElementRenderer::ColorChanged()
+			{
+			}
+
+			void GuiColorizedTextElementRenderer::FontChanged()
+			{
+				IHeadlessResourceManager* resourceManager=GetHeadlessResourceManager();
+				if(fontCreated)
+				{
+					element->GetLines().SetCharMeasurer(0);
+					resourceManager->DestroyCharMeasurer(oldFont);
+				}
+				oldFont=element->GetFont();
+				fontCreated=true;
+				element->GetLines().SetCharMeasurer(resourceManager->CreateCharMeasurer(oldFont).Obj());
+			}
+
+			void GuiColorizedTextElementRenderer::InitializeInternal()
+			{
+				element->SetCallback(this);
+			}
+
+			void GuiColorizedTextElementRenderer::FinalizeInternal()
+			{
+				if(fontCreated)
+				{
+					GetHeadlessResourceManager()->DestroyCharMeasurer(oldFont);
+				}
+			}
+
+			void GuiColorizedTextElementRenderer::RenderTargetChangedInternal(IHeadlessRenderTarget* oldRenderTarget, IHeadlessRenderTarget* newRenderTarget)
+			{
+				element->GetLines().SetRenderTarget(newRenderTarget);
+			}
+
+			GuiColorizedTextElementRenderer::GuiColorizedTextElementRenderer()
+				:fontCreated(false)
+			{
+			}
+
+			void GuiColorizedTextElementRenderer::Render(Rect bounds)
+			{
+				if(renderTarget)
+				{
+					renderTarget->RecordDrawCall(element->GetFactory()->GetElementTypeName(), element, bounds);
+				}
+			}
+
+			void GuiColorizedTextElementRenderer::OnElementStateChanged()
+			{
+			}
+		}
+	}
+}
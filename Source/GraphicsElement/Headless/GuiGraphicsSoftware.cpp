@@ -0,0 +1,643 @@
+#include "GuiGraphicsSoftware.h"
+#include <math.h>
+
+#if defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__
+#define GUI_SOFTWARE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_headless
+		{
+			using namespace elements;
+			using namespace collections;
+
+/***********************************************************************
+Pixel Blending
+***********************************************************************/
+
+			namespace software_blending
+			{
+				// colors are blended two channels at a time: (r, b) and (g, a) are each packed in a 32 bits integer with 16 bits per channel
+				static const vuint32_t		ChannelMask = 0x00FF00FF;
+				static const vuint32_t		RoundingBias = 0x00800080;
+
+				inline vuint32_t AlphaBits()
+				{
+					return Color(0, 0, 0, 255).value;
+				}
+
+				inline vuint32_t DivideBy255(vuint32_t channels)
+				{
+					return ((channels + RoundingBias + ((channels >> 8) & ChannelMask)) >> 8) & ChannelMask;
+				}
+
+				inline vuint32_t Blend(vuint32_t source, vuint32_t alpha, vuint32_t destination)
+				{
+					// the alpha channel of the source is treated as 255, so that the result alpha is sa+da*(1-sa)
+					source |= AlphaBits();
+					vuint32_t inverse = 255 - alpha;
+					vuint32_t rb = (source & ChannelMask) * alpha + (destination & ChannelMask) * inverse;
+					vuint32_t ga = ((source >> 8) & ChannelMask) * alpha + ((destination >> 8) & ChannelMask) * inverse;
+					return DivideBy255(rb) | (DivideBy255(ga) << 8);
+				}
+
+				void FillPixels(vuint32_t* write, vint count, vuint32_t value)
+				{
+					vint i = 0;
+#ifdef GUI_SOFTWARE_SSE2
+					__m128i values = _mm_set1_epi32((int)value);
+					for (; i + 4 <= count; i += 4)
+					{
+						_mm_storeu_si128((__m128i*)(write + i), values);
+					}
+#endif
+					for (; i < count; i++)
+					{
+						write[i] = value;
+					}
+				}
+			}
+			using namespace software_blending;
+
+/***********************************************************************
+SoftwareFramebuffer
+***********************************************************************/
+
+			void SoftwareFramebuffer::BlendSpanInternal(vuint32_t* write, vint count, Color color)
+			{
+				if (color.a == 255)
+				{
+					FillPixels(write, count, color.value);
+				}
+				else if (color.a > 0)
+				{
+					vint i = 0;
+					// the source part of the blending is the same for all pixels in the span
+					vuint32_t alpha = color.a;
+					vuint32_t inverse = 255 - alpha;
+					vuint32_t source = color.value | AlphaBits();
+#ifdef GUI_SOFTWARE_SSE2
+					{
+						// two pixels are blended in 8 channels of 16 bits, producing the same result as the scalar code
+						__m128i zero = _mm_setzero_si128();
+						__m128i sourceChannels = _mm_unpacklo_epi8(_mm_set1_epi32((int)source), zero);
+						__m128i sourceTerm = _mm_mullo_epi16(sourceChannels, _mm_set1_epi16((short)alpha));
+						__m128i inverseTerm = _mm_set1_epi16((short)inverse);
+						__m128i bias = _mm_set1_epi16(0x80);
+						for (; i + 4 <= count; i += 4)
+						{
+							__m128i destination = _mm_loadu_si128((const __m128i*)(write + i));
+							__m128i low = _mm_add_epi16(sourceTerm, _mm_mullo_epi16(_mm_unpacklo_epi8(destination, zero), inverseTerm));
+							__m128i high = _mm_add_epi16(sourceTerm, _mm_mullo_epi16(_mm_unpackhi_epi8(destination, zero), inverseTerm));
+							low = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(low, bias), _mm_srli_epi16(low, 8)), 8);
+							high = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(high, bias), _mm_srli_epi16(high, 8)), 8);
+							_mm_storeu_si128((__m128i*)(write + i), _mm_packus_epi16(low, high));
+						}
+					}
+#endif
+					vuint32_t sourceRB = (source & ChannelMask) * alpha;
+					vuint32_t sourceGA = ((source >> 8) & ChannelMask) * alpha;
+					for (; i < count; i++)
+					{
+						vuint32_t destination = write[i];
+						vuint32_t rb = sourceRB + (destination & ChannelMask) * inverse;
+						vuint32_t ga = sourceGA + ((destination >> 8) & ChannelMask) * inverse;
+						write[i] = DivideBy255(rb) | (DivideBy255(ga) << 8);
+					}
+				}
+			}
+
+			void SoftwareFramebuffer::BlendInterpolatedSpanInternal(vint y, vint x1, vint x2, Color color1, Color color2, vint clippedX1, vint clippedX2)
+			{
+				vint length = x2 - x1;
+				if (length <= 0 || clippedX1 >= clippedX2) return;
+
+				// channels are interpolated in 16.16 fixed point numbers
+				vint64_t c[4] = { (vint64_t)color1.r << 16, (vint64_t)color1.g << 16, (vint64_t)color1.b << 16, (vint64_t)color1.a << 16 };
+				vint64_t d[4] =
+				{
+					(((vint64_t)color2.r - color1.r) << 16) / length,
+					(((vint64_t)color2.g - color1.g) << 16) / length,
+					(((vint64_t)color2.b - color1.b) << 16) / length,
+					(((vint64_t)color2.a - color1.a) << 16) / length,
+				};
+				vint skip = clippedX1 - x1;
+				for (vint i = 0; i < 4; i++)
+				{
+					c[i] += d[i] * skip;
+				}
+
+				vuint32_t* write = GetScanLine(y) + clippedX1;
+				for (vint x = clippedX1; x < clippedX2; x++)
+				{
+					Color color((unsigned char)(c[0] >> 16), (unsigned char)(c[1] >> 16), (unsigned char)(c[2] >> 16), (unsigned char)(c[3] >> 16));
+					if (color.a == 255)
+					{
+						*write = color.value;
+					}
+					else if (color.a > 0)
+					{
+						*write = Blend(color.value, color.a, *write);
+					}
+					write++;
+					for (vint i = 0; i < 4; i++)
+					{
+						c[i] += d[i];
+					}
+				}
+			}
+
+			SoftwareFramebuffer::SoftwareFramebuffer(Size _size, Color background)
+			{
+				Resize(_size, background);
+			}
+
+			SoftwareFramebuffer::~SoftwareFramebuffer()
+			{
+			}
+
+			Size SoftwareFramebuffer::GetSize()
+			{
+				return size;
+			}
+
+			void SoftwareFramebuffer::Resize(Size _size, Color background)
+			{
+				size = Size(_size.x < 0 ? 0 : _size.x, _size.y < 0 ? 0 : _size.y);
+				pixels.Resize(size.x * size.y);
+				clipper = Rect(Point(0, 0), size);
+				Clear(background);
+			}
+
+			vuint32_t* SoftwareFramebuffer::GetScanLine(vint y)
+			{
+				if (y < 0 || y >= size.y || size.x == 0) return 0;
+				return &pixels[y * size.x];
+			}
+
+			Color SoftwareFramebuffer::GetPixel(vint x, vint y)
+			{
+				Color color(0, 0, 0, 0);
+				if (0 <= x && x < size.x && 0 <= y && y < size.y)
+				{
+					color.value = pixels[y * size.x + x];
+				}
+				return color;
+			}
+
+			Rect SoftwareFramebuffer::GetClipper()
+			{
+				return clipper;
+			}
+
+			void SoftwareFramebuffer::SetClipper(Rect value)
+			{
+				clipper.x1 = value.x1 < 0 ? 0 : value.x1;
+				clipper.y1 = value.y1 < 0 ? 0 : value.y1;
+				clipper.x2 = value.x2 > size.x ? size.x : value.x2;
+				clipper.y2 = value.y2 > size.y ? size.y : value.y2;
+				if (clipper.x2 < clipper.x1) clipper.x2 = clipper.x1;
+				if (clipper.y2 < clipper.y1) clipper.y2 = clipper.y1;
+			}
+
+			void SoftwareFramebuffer::Clear(Color color)
+			{
+				if (pixels.Count() > 0)
+				{
+					FillPixels(&pixels[0], pixels.Count(), color.value);
+				}
+			}
+
+			void SoftwareFramebuffer::FillSpan(vint y, vint x1, vint x2, Color color)
+			{
+				if (color.a == 0 || y < clipper.y1 || y >= clipper.y2) return;
+				if (x1 < clipper.x1) x1 = clipper.x1;
+				if (x2 > clipper.x2) x2 = clipper.x2;
+				if (x1 >= x2) return;
+				BlendSpanInternal(GetScanLine(y) + x1, x2 - x1, color);
+			}
+
+			void SoftwareFramebuffer::FillInterpolatedSpan(vint y, vint x1, vint x2, Color color1, Color color2)
+			{
+				if ((color1.a == 0 && color2.a == 0) || y < clipper.y1 || y >= clipper.y2) return;
+				if (color1 == color2)
+				{
+					FillSpan(y, x1, x2, color1);
+					return;
+				}
+				vint clippedX1 = x1 < clipper.x1 ? clipper.x1 : x1;
+				vint clippedX2 = x2 > clipper.x2 ? clipper.x2 : x2;
+				BlendInterpolatedSpanInternal(y, x1, x2, color1, color2, clippedX1, clippedX2);
+			}
+
+			void SoftwareFramebuffer::FillRect(Rect rect, Color color)
+			{
+				vint y1 = rect.y1 < clipper.y1 ? clipper.y1 : rect.y1;
+				vint y2 = rect.y2 > clipper.y2 ? clipper.y2 : rect.y2;
+				for (vint y = y1; y < y2; y++)
+				{
+					FillSpan(y, rect.x1, rect.x2, color);
+				}
+			}
+
+			void SoftwareFramebuffer::FillShape(Rect bounds, ElementShape shape, Color color)
+			{
+				if (shape.shapeType == ElementShapeType::Rectangle)
+				{
+					FillRect(bounds, color);
+					return;
+				}
+
+				vint y1 = bounds.y1 < clipper.y1 ? clipper.y1 : bounds.y1;
+				vint y2 = bounds.y2 > clipper.y2 ? clipper.y2 : bounds.y2;
+				for (vint y = y1; y < y2; y++)
+				{
+					vint x1 = 0, x2 = 0;
+					if (GetShapeSpan(bounds, shape, y, x1, x2))
+					{
+						FillSpan(y, x1, x2, color);
+					}
+				}
+			}
+
+			void SoftwareFramebuffer::DrawShapeBorder(Rect bounds, ElementShape shape, Color color)
+			{
+				if (bounds.Width() <= 0 || bounds.Height() <= 0) return;
+				if (shape.shapeType == ElementShapeType::Rectangle)
+				{
+					FillSpan(bounds.y1, bounds.x1, bounds.x2, color);
+					if (bounds.Height() > 1)
+					{
+						FillSpan(bounds.y2 - 1, bounds.x1, bounds.x2, color);
+					}
+					for (vint y = bounds.y1 + 1; y < bounds.y2 - 1; y++)
+					{
+						FillSpan(y, bounds.x1, bounds.x1 + 1, color);
+						if (bounds.Width() > 1)
+						{
+							FillSpan(y, bounds.x2 - 1, bounds.x2, color);
+						}
+					}
+					return;
+				}
+
+				// a pixel is on the border if any of its four neighbors is outside of the shape
+				vint y1 = bounds.y1 < clipper.y1 ? clipper.y1 : bounds.y1;
+				vint y2 = bounds.y2 > clipper.y2 ? clipper.y2 : bounds.y2;
+				for (vint y = y1; y < y2; y++)
+				{
+					vint x1 = 0, x2 = 0;
+					if (!GetShapeSpan(bounds, shape, y, x1, x2)) continue;
+
+					vint ux1 = 0, ux2 = 0, dx1 = 0, dx2 = 0;
+					bool up = GetShapeSpan(bounds, shape, y - 1, ux1, ux2);
+					bool down = GetShapeSpan(bounds, shape, y + 1, dx1, dx2);
+					if (!up || !down)
+					{
+						FillSpan(y, x1, x2, color);
+						continue;
+					}
+
+					vint inner1 = x1 + 1;
+					if (inner1 < ux1) inner1 = ux1;
+					if (inner1 < dx1) inner1 = dx1;
+					vint inner2 = x2 - 1;
+					if (inner2 > ux2) inner2 = ux2;
+					if (inner2 > dx2) inner2 = dx2;
+
+					if (inner1 >= inner2)
+					{
+						FillSpan(y, x1, x2, color);
+					}
+					else
+					{
+						FillSpan(y, x1, inner1, color);
+						FillSpan(y, inner2, x2, color);
+					}
+				}
+			}
+
+			void SoftwareFramebuffer::FillGradientShape(Rect bounds, ElementShape shape, Color color1, Color color2, GuiGradientBackgroundElement::Direction direction)
+			{
+				vint w = bounds.Width();
+				vint h = bounds.Height();
+				if (w <= 0 || h <= 0) return;
+
+				vint y1 = bounds.y1 < clipper.y1 ? clipper.y1 : bounds.y1;
+				vint y2 = bounds.y2 > clipper.y2 ? clipper.y2 : bounds.y2;
+				for (vint y = y1; y < y2; y++)
+				{
+					vint x1 = 0, x2 = 0;
+					if (!GetShapeSpan(bounds, shape, y, x1, x2)) continue;
+
+					// the gradient position of a pixel is (ax*x+ay*y+c)/d, which is linear in every row
+					vint ax = 0, ay = 0, c = 0, d = 1;
+					switch (direction)
+					{
+					case GuiGradientBackgroundElement::Horizontal:
+						ax = 1; c = -bounds.x1; d = w;
+						break;
+					case GuiGradientBackgroundElement::Vertical:
+						ay = 1; c = -bounds.y1; d = h;
+						break;
+					case GuiGradientBackgroundElement::Slash:
+						ax = -1; ay = 1; c = bounds.x2 - bounds.y1; d = w + h;
+						break;
+					case GuiGradientBackgroundElement::Backslash:
+						ax = 1; ay = 1; c = -bounds.x1 - bounds.y1; d = w + h;
+						break;
+					}
+
+					auto colorAt = [&](vint x)
+					{
+						vint p = ax * x + ay * y + c;
+						if (p < 0) p = 0;
+						if (p > d) p = d;
+						return Color(
+							(unsigned char)(color1.r + (color2.r - color1.r) * p / d),
+							(unsigned char)(color1.g + (color2.g - color1.g) * p / d),
+							(unsigned char)(color1.b + (color2.b - color1.b) * p / d),
+							(unsigned char)(color1.a + (color2.a - color1.a) * p / d)
+							);
+					};
+					FillInterpolatedSpan(y, x1, x2, colorAt(x1), colorAt(x2));
+				}
+			}
+
+			void SoftwareFramebuffer::FillRadialGradientRect(Rect rect, Point center, vint radius, Color inner, Color outer)
+			{
+				if (radius <= 0)
+				{
+					FillRect(rect, outer);
+					return;
+				}
+
+				vint x1 = rect.x1 < clipper.x1 ? clipper.x1 : rect.x1;
+				vint x2 = rect.x2 > clipper.x2 ? clipper.x2 : rect.x2;
+				vint y1 = rect.y1 < clipper.y1 ? clipper.y1 : rect.y1;
+				vint y2 = rect.y2 > clipper.y2 ? clipper.y2 : rect.y2;
+				for (vint y = y1; y < y2; y++)
+				{
+					vuint32_t* write = GetScanLine(y);
+					double dy = y + 0.5 - center.y;
+					for (vint x = x1; x < x2; x++)
+					{
+						double dx = x + 0.5 - center.x;
+						double p = sqrt(dx * dx + dy * dy) / radius;
+						if (p > 1) p = 1;
+						Color color(
+							(unsigned char)(inner.r + (outer.r - inner.r) * p),
+							(unsigned char)(inner.g + (outer.g - inner.g) * p),
+							(unsigned char)(inner.b + (outer.b - inner.b) * p),
+							(unsigned char)(inner.a + (outer.a - inner.a) * p)
+							);
+						if (color.a == 255)
+						{
+							write[x] = color.value;
+						}
+						else if (color.a > 0)
+						{
+							write[x] = Blend(color.value, color.a, write[x]);
+						}
+					}
+				}
+			}
+
+			void SoftwareFramebuffer::DrawLine(Point p1, Point p2, Color color)
+			{
+				if (p1.y == p2.y)
+				{
+					if (p1.x < p2.x) FillSpan(p1.y, p1.x, p2.x, color);
+					else FillSpan(p1.y, p2.x + 1, p1.x + 1, color);
+					return;
+				}
+				if (p1.x == p2.x)
+				{
+					if (p1.y < p2.y) FillRect(Rect(p1.x, p1.y, p1.x + 1, p2.y), color);
+					else FillRect(Rect(p1.x, p2.y + 1, p1.x + 1, p1.y + 1), color);
+					return;
+				}
+
+				vint dx = p2.x > p1.x ? p2.x - p1.x : p1.x - p2.x;
+				vint dy = p2.y > p1.y ? p2.y - p1.y : p1.y - p2.y;
+				vint sx = p1.x < p2.x ? 1 : -1;
+				vint sy = p1.y < p2.y ? 1 : -1;
+				vint error = dx - dy;
+				vint x = p1.x;
+				vint y = p1.y;
+				while (x != p2.x || y != p2.y)
+				{
+					FillSpan(y, x, x + 1, color);
+					vint e2 = error * 2;
+					if (e2 > -dy)
+					{
+						error -= dy;
+						x += sx;
+					}
+					if (e2 < dx)
+					{
+						error += dx;
+						y += sy;
+					}
+				}
+			}
+
+			void SoftwareFramebuffer::FillPolygon(const Point* points, vint count, Color color)
+			{
+				if (count < 3 || color.a == 0) return;
+
+				vint minY = points[0].y;
+				vint maxY = points[0].y;
+				for (vint i = 1; i < count; i++)
+				{
+					if (minY > points[i].y) minY = points[i].y;
+					if (maxY < points[i].y) maxY = points[i].y;
+				}
+				if (minY < clipper.y1) minY = clipper.y1;
+				if (maxY > clipper.y2) maxY = clipper.y2;
+
+				List<double> crossings;
+				for (vint y = minY; y < maxY; y++)
+				{
+					// sample at the center of pixels
+					double sampleY = y + 0.5;
+					crossings.Clear();
+					for (vint i = 0; i < count; i++)
+					{
+						Point a = points[i];
+						Point b = points[(i + 1) % count];
+						if ((a.y <= sampleY && sampleY < b.y) || (b.y <= sampleY && sampleY < a.y))
+						{
+							crossings.Add(a.x + (sampleY - a.y) * (b.x - a.x) / (b.y - a.y));
+						}
+					}
+
+					for (vint i = 1; i < crossings.Count(); i++)
+					{
+						double value = crossings[i];
+						vint j = i - 1;
+						while (j >= 0 && crossings[j] > value)
+						{
+							crossings.Set(j + 1, crossings[j]);
+							j--;
+						}
+						crossings.Set(j + 1, value);
+					}
+
+					for (vint i = 0; i + 1 < crossings.Count(); i += 2)
+					{
+						vint x1 = (vint)ceil(crossings[i] - 0.5);
+						vint x2 = (vint)ceil(crossings[i + 1] - 0.5);
+						FillSpan(y, x1, x2, color);
+					}
+				}
+			}
+
+			void SoftwareFramebuffer::DrawPolygonBorder(const Point* points, vint count, Color color)
+			{
+				if (count < 2 || color.a == 0) return;
+				for (vint i = 0; i < count; i++)
+				{
+					DrawLine(points[i], points[(i + 1) % count], color);
+				}
+			}
+
+			void SoftwareFramebuffer::DrawBitmap(Rect destination, SoftwareFramebuffer* bitmap, Rect source)
+			{
+				vint dw = destination.Width();
+				vint dh = destination.Height();
+				vint sw = source.Width();
+				vint sh = source.Height();
+				if (dw <= 0 || dh <= 0 || sw <= 0 || sh <= 0) return;
+
+				vint x1 = destination.x1 < clipper.x1 ? clipper.x1 : destination.x1;
+				vint x2 = destination.x2 > clipper.x2 ? clipper.x2 : destination.x2;
+				vint y1 = destination.y1 < clipper.y1 ? clipper.y1 : destination.y1;
+				vint y2 = destination.y2 > clipper.y2 ? clipper.y2 : destination.y2;
+				Size bitmapSize = bitmap->GetSize();
+
+				for (vint y = y1; y < y2; y++)
+				{
+					vint sy = source.y1 + (y - destination.y1) * sh / dh;
+					if (sy < 0 || sy >= bitmapSize.y) continue;
+					const vuint32_t* read = bitmap->GetScanLine(sy);
+					vuint32_t* write = GetScanLine(y);
+					for (vint x = x1; x < x2; x++)
+					{
+						vint sx = source.x1 + (x - destination.x1) * sw / dw;
+						if (sx < 0 || sx >= bitmapSize.x) continue;
+						Color color;
+						color.value = read[sx];
+						if (color.a == 255)
+						{
+							write[x] = color.value;
+						}
+						else if (color.a > 0)
+						{
+							write[x] = Blend(color.value, color.a, write[x]);
+						}
+					}
+				}
+			}
+
+			void SoftwareFramebuffer::SaveAsBitmap(stream::IStream& stream)
+			{
+				auto writeInt = [&](vuint32_t value, vint bytes)
+				{
+					vuint8_t buffer[4];
+					for (vint i = 0; i < bytes; i++)
+					{
+						buffer[i] = (vuint8_t)(value >> (i * 8));
+					}
+					stream.Write(buffer, bytes);
+				};
+
+				vuint32_t imageSize = (vuint32_t)(size.x * size.y * 4);
+				// BITMAPFILEHEADER
+				writeInt(0x4D42, 2);
+				writeInt(14 + 40 + imageSize, 4);
+				writeInt(0, 4);
+				writeInt(14 + 40, 4);
+				// BITMAPINFOHEADER, the negative height makes rows stored from top to bottom
+				writeInt(40, 4);
+				writeInt((vuint32_t)size.x, 4);
+				writeInt((vuint32_t)-size.y, 4);
+				writeInt(1, 2);
+				writeInt(32, 2);
+				writeInt(0, 4);
+				writeInt(imageSize, 4);
+				writeInt(2835, 4);
+				writeInt(2835, 4);
+				writeInt(0, 4);
+				writeInt(0, 4);
+
+				Array<vuint8_t> row(size.x * 4);
+				for (vint y = 0; y < size.y; y++)
+				{
+					for (vint x = 0; x < size.x; x++)
+					{
+						Color color = GetPixel(x, y);
+						row[x * 4 + 0] = color.b;
+						row[x * 4 + 1] = color.g;
+						row[x * 4 + 2] = color.r;
+						row[x * 4 + 3] = color.a;
+					}
+					if (row.Count() > 0)
+					{
+						stream.Write(&row[0], row.Count());
+					}
+				}
+			}
+
+			bool SoftwareFramebuffer::GetShapeSpan(Rect bounds, ElementShape shape, vint y, vint& x1, vint& x2)
+			{
+				if (y < bounds.y1 || y >= bounds.y2 || bounds.x1 >= bounds.x2) return false;
+				switch (shape.shapeType)
+				{
+				case ElementShapeType::Ellipse:
+					{
+						double rx = bounds.Width() / 2.0;
+						double ry = bounds.Height() / 2.0;
+						double dy = (y + 0.5 - (bounds.y1 + ry)) / ry;
+						double dx = rx * sqrt(dy * dy < 1 ? 1 - dy * dy : 0);
+						double cx = bounds.x1 + rx;
+						x1 = (vint)ceil(cx - dx - 0.5);
+						x2 = (vint)ceil(cx + dx - 0.5);
+					}
+					break;
+				case ElementShapeType::RoundRect:
+					{
+						double rx = shape.radiusX < bounds.Width() / 2.0 ? shape.radiusX : bounds.Width() / 2.0;
+						double ry = shape.radiusY < bounds.Height() / 2.0 ? shape.radiusY : bounds.Height() / 2.0;
+						double sampleY = y + 0.5;
+						double dy = 0;
+						if (sampleY < bounds.y1 + ry) dy = bounds.y1 + ry - sampleY;
+						else if (sampleY > bounds.y2 - ry) dy = sampleY - (bounds.y2 - ry);
+
+						if (dy > 0 && rx > 0 && ry > 0)
+						{
+							double t = dy / ry;
+							double dx = rx * sqrt(t < 1 ? 1 - t * t : 0);
+							x1 = (vint)ceil(bounds.x1 + rx - dx - 0.5);
+							x2 = (vint)ceil(bounds.x2 - rx + dx - 0.5);
+						}
+						else
+						{
+							x1 = bounds.x1;
+							x2 = bounds.x2;
+						}
+					}
+					break;
+				default:
+					x1 = bounds.x1;
+					x2 = bounds.x2;
+				}
+				return x1 < x2;
+			}
+		}
+	}
+}
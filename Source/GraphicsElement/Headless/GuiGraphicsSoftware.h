@@ -0,0 +1,150 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Provider::Software Rasterizer
+
+Classes:
+  SoftwareFramebuffer					: In-memory RGBA pixels with rasterizing functions
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSSOFTWARE
+#define VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSSOFTWARE
+
+#include "../GuiGraphicsElement.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace elements_headless
+		{
+
+/***********************************************************************
+SoftwareFramebuffer
+***********************************************************************/
+
+			/// <summary>
+			/// In-memory pixels. Each pixel has the same memory layout as <see cref="Color"/>, colors are not premultiplied.
+			/// All rasterizing functions are clipped by the current clipper, and blend the color to existing pixels when it is not opaque.
+			/// </summary>
+			class SoftwareFramebuffer : public Object
+			{
+			protected:
+				Size								size;
+				collections::Array<vuint32_t>		pixels;
+				Rect								clipper;
+
+				void								BlendSpanInternal(vuint32_t* write, vint count, Color color);
+				void								BlendInterpolatedSpanInternal(vint y, vint x1, vint x2, Color color1, Color color2, vint clippedX1, vint clippedX2);
+			public:
+				/// <summary>Create a framebuffer.</summary>
+				/// <param name="_size">The size of the framebuffer.</param>
+				/// <param name="background">The initial color for all pixels.</param>
+				SoftwareFramebuffer(Size _size, Color background=Color());
+				~SoftwareFramebuffer();
+
+				/// <summary>Get the size.</summary>
+				/// <returns>The size.</returns>
+				Size								GetSize();
+				/// <summary>Resize the framebuffer. All pixels are reset and the clipper becomes the whole framebuffer.</summary>
+				/// <param name="_size">The new size.</param>
+				/// <param name="background">The new color for all pixels.</param>
+				void								Resize(Size _size, Color background=Color());
+				/// <summary>Get the pixels of a row.</summary>
+				/// <returns>The pixels. Returns null if the row is out of range.</returns>
+				/// <param name="y">The row.</param>
+				vuint32_t*							GetScanLine(vint y);
+				/// <summary>Get the color of a pixel.</summary>
+				/// <returns>The color. Returns a transparent color if the pixel is out of range.</returns>
+				/// <param name="x">The column.</param>
+				/// <param name="y">The row.</param>
+				Color								GetPixel(vint x, vint y);
+				/// <summary>Get the current clipper.</summary>
+				/// <returns>The current clipper.</returns>
+				Rect								GetClipper();
+				/// <summary>Set the current clipper. The clipper is limited inside the framebuffer.</summary>
+				/// <param name="value">The new clipper.</param>
+				void								SetClipper(Rect value);
+
+				/// <summary>Set all pixels to a color, ignoring the clipper.</summary>
+				/// <param name="color">The color.</param>
+				void								Clear(Color color);
+				/// <summary>Fill pixels from x1 to x2 (excluded) in a row.</summary>
+				/// <param name="y">The row.</param>
+				/// <param name="x1">The first column.</param>
+				/// <param name="x2">The column after the last column.</param>
+				/// <param name="color">The color.</param>
+				void								FillSpan(vint y, vint x1, vint x2, Color color);
+				/// <summary>Fill pixels from x1 to x2 (excluded) in a row, with a color that changes linearly from color1 at x1 to color2 at x2.</summary>
+				/// <param name="y">The row.</param>
+				/// <param name="x1">The first column.</param>
+				/// <param name="x2">The column after the last column.</param>
+				/// <param name="color1">The color at x1.</param>
+				/// <param name="color2">The color at x2.</param>
+				void								FillInterpolatedSpan(vint y, vint x1, vint x2, Color color1, Color color2);
+				/// <summary>Fill a rectangle.</summary>
+				/// <param name="rect">The rectangle.</param>
+				/// <param name="color">The color.</param>
+				void								FillRect(Rect rect, Color color);
+				/// <summary>Fill a shape.</summary>
+				/// <param name="bounds">The bounds of the shape.</param>
+				/// <param name="shape">The shape.</param>
+				/// <param name="color">The color.</param>
+				void								FillShape(Rect bounds, elements::ElementShape shape, Color color);
+				/// <summary>Draw the one pixel outline of a shape.</summary>
+				/// <param name="bounds">The bounds of the shape.</param>
+				/// <param name="shape">The shape.</param>
+				/// <param name="color">The color.</param>
+				void								DrawShapeBorder(Rect bounds, elements::ElementShape shape, Color color);
+				/// <summary>Fill a shape with a linear gradient.</summary>
+				/// <param name="bounds">The bounds of the shape.</param>
+				/// <param name="shape">The shape.</param>
+				/// <param name="color1">The color at the beginning of the gradient.</param>
+				/// <param name="color2">The color at the end of the gradient.</param>
+				/// <param name="direction">The direction of the gradient.</param>
+				void								FillGradientShape(Rect bounds, elements::ElementShape shape, Color color1, Color color2, elements::GuiGradientBackgroundElement::Direction direction);
+				/// <summary>Fill a rectangle with a radial gradient.</summary>
+				/// <param name="rect">The rectangle.</param>
+				/// <param name="center">The center of the gradient.</param>
+				/// <param name="radius">The radius of the gradient. Pixels outside of the radius use the outer color.</param>
+				/// <param name="inner">The color at the center.</param>
+				/// <param name="outer">The color at the radius.</param>
+				void								FillRadialGradientRect(Rect rect, Point center, vint radius, Color inner, Color outer);
+				/// <summary>Draw a line. Like LineTo in GDI, the end point is not drawn.</summary>
+				/// <param name="p1">The start point.</param>
+				/// <param name="p2">The end point.</param>
+				/// <param name="color">The color.</param>
+				void								DrawLine(Point p1, Point p2, Color color);
+				/// <summary>Fill a polygon using the even-odd rule.</summary>
+				/// <param name="points">The points.</param>
+				/// <param name="count">The number of points.</param>
+				/// <param name="color">The color.</param>
+				void								FillPolygon(const Point* points, vint count, Color color);
+				/// <summary>Draw the outline of a polygon.</summary>
+				/// <param name="points">The points.</param>
+				/// <param name="count">The number of points.</param>
+				/// <param name="color">The color.</param>
+				void								DrawPolygonBorder(const Point* points, vint count, Color color);
+				/// <summary>Draw a part of another framebuffer, scaled to fill the destination with the nearest pixels.</summary>
+				/// <param name="destination">The destination rectangle.</param>
+				/// <param name="bitmap">The source framebuffer.</param>
+				/// <param name="source">The source rectangle.</param>
+				void								DrawBitmap(Rect destination, SoftwareFramebuffer* bitmap, Rect source);
+				/// <summary>Save all pixels as a 32 bits BMP file.</summary>
+				/// <param name="stream">The stream to write.</param>
+				void								SaveAsBitmap(stream::IStream& stream);
+
+				/// <summary>Get the horizontal range of a shape in a row.</summary>
+				/// <returns>Returns false if the row does not intersect with the shape.</returns>
+				/// <param name="bounds">The bounds of the shape.</param>
+				/// <param name="shape">The shape.</param>
+				/// <param name="y">The row.</param>
+				/// <param name="x1">The first column in the shape.</param>
+				/// <param name="x2">The column after the last column in the shape.</param>
+				static bool							GetShapeSpan(Rect bounds, elements::ElementShape shape, vint y, vint& x1, vint& x2);
+			};
+		}
+	}
+}
+
+#endif
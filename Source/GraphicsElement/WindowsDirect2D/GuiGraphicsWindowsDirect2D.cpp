@@ -224,13 +224,15 @@ CachedResourceAllocator
 					ComPtr<IDWriteTextFormat>		font;
 					vint								size;
 
-					Size MeasureInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
+					Size MeasureInternal(text::UnicodeCodePoint codePoint, IGuiGraphicsRenderTarget* renderTarget)
 					{
 						Size charSize(0, 0);
+						wchar_t buffer[2];
+						vint length=text::CharMeasurer::WriteCodePoint(codePoint, buffer);
 						IDWriteTextLayout* textLayout=0;
 						HRESULT hr=GetWindowsDirect2DObjectProvider()->GetDirectWriteFactory()->CreateTextLayout(
-							&character,
-							1,
+							buffer,
+							(UINT32)length,
 							font.Obj(),
 							0,
 							0,
@@ -248,9 +250,9 @@ CachedResourceAllocator
 						return charSize;
 					}
 
-					vint MeasureWidthInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
+					vint MeasureWidthInternal(text::UnicodeCodePoint codePoint, IGuiGraphicsRenderTarget* renderTarget)
 					{
-						return MeasureInternal(character, renderTarget).x;
+						return MeasureInternal(codePoint, renderTarget).x;
 					}
 
 					vint GetRowHeightInternal(IGuiGraphicsRenderTarget* renderTarget)
@@ -572,6 +574,12 @@ WindowsDirect2DRenderTarget
 					return clipperCoverWholeTargetCounter>0;
 				}
 
+				bool IsContentRetained()override
+				{
+					// the whole render target is cleared in StartRendering
+					return false;
+				}
+
 				ID2D1SolidColorBrush* CreateDirect2DBrush(Color color)override
 				{
 					return solidBrushes.Create(color).Obj();
@@ -106,16 +106,14 @@ WindowsGDIRenderTarget
 
 				void PopClipper()override
 				{
-					if(clippers.Count()>0)
+					if(clipperCoverWholeTargetCounter>0)
 					{
-						if(clipperCoverWholeTargetCounter>0)
-						{
-							clipperCoverWholeTargetCounter--;
-						}
-						else
-						{
-							clippers.RemoveAt(clippers.Count()-1);
-						}
+						clipperCoverWholeTargetCounter--;
+						ApplyClipper();
+					}
+					else if(clippers.Count()>0)
+					{
+						clippers.RemoveAt(clippers.Count()-1);
 						ApplyClipper();
 					}
 				}
@@ -136,6 +134,12 @@ WindowsGDIRenderTarget
 				{
 					return clipperCoverWholeTargetCounter>0;
 				}
+
+				bool IsContentRetained()override
+				{
+					// the buffer of the window is only recreated when the window is resized
+					return true;
+				}
 			};
 
 /***********************************************************************
@@ -189,14 +193,16 @@ CachedResourceAllocator
 					Ptr<WinFont>			font;
 					vint						size;
 
-					Size MeasureInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
+					Size MeasureInternal(text::UnicodeCodePoint codePoint, IGuiGraphicsRenderTarget* renderTarget)
 					{
 						if(renderTarget)
 						{
 							WindowsGDIRenderTarget* gdiRenderTarget=dynamic_cast<WindowsGDIRenderTarget*>(renderTarget);
 							WinDC* dc=gdiRenderTarget->GetDC();
 							dc->SetFont(font);
-							SIZE size=dc->MeasureBuffer(&character, 1, -1);
+							wchar_t buffer[2];
+							vint length=text::CharMeasurer::WriteCodePoint(codePoint, buffer);
+							SIZE size=dc->MeasureBuffer(buffer, length, -1);
 							return Size(size.cx, size.cy);
 						}
 						else
@@ -205,9 +211,32 @@ CachedResourceAllocator
 						}
 					}
 
-					vint MeasureWidthInternal(wchar_t character, IGuiGraphicsRenderTarget* renderTarget)
+					vint MeasureWidthInternal(text::UnicodeCodePoint codePoint, IGuiGraphicsRenderTarget* renderTarget)
+					{
+						return MeasureInternal(codePoint, renderTarget).x;
+					}
+
+					void MeasureWidthsInternal(const text::UnicodeCodePoint* codePoints, vint* widths, vint count, IGuiGraphicsRenderTarget* renderTarget)
 					{
-						return MeasureInternal(character, renderTarget).x;
+						if(renderTarget)
+						{
+							WindowsGDIRenderTarget* gdiRenderTarget=dynamic_cast<WindowsGDIRenderTarget*>(renderTarget);
+							WinDC* dc=gdiRenderTarget->GetDC();
+							dc->SetFont(font);
+							for(vint i=0;i<count;i++)
+							{
+								wchar_t buffer[2];
+								vint length=text::CharMeasurer::WriteCodePoint(codePoints[i], buffer);
+								widths[i]=dc->MeasureBuffer(buffer, length, -1).cx;
+							}
+						}
+						else
+						{
+							for(vint i=0;i<count;i++)
+							{
+								widths[i]=0;
+							}
+						}
 					}
 
 					vint GetRowHeightInternal(IGuiGraphicsRenderTarget* renderTarget)
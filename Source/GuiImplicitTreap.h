@@ -0,0 +1,387 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Implicit Treap
+
+Classes:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_GUIIMPLICITTREAP
+#define VCZH_PRESENTATION_GUIIMPLICITTREAP
+
+#include "GuiTypes.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+
+/***********************************************************************
+ImplicitTreap
+***********************************************************************/
+
+		/// <summary>
+		/// A sequence of values stored in an implicit treap ordered by indices. Each sub tree keeps the number and the sum of its values, so that inserting, removing, updating and searching by sums take logarithm time.
+		/// Each value is identified by a handle, which does not change when other values are inserted or removed.
+		/// </summary>
+		/// <typeparam name="T">The type of values. A default constructed value is the sum of no values, and operator+ sums two values in their order in the sequence.</typeparam>
+		template<typename T>
+		class ImplicitTreap : public Object
+		{
+		protected:
+			struct Node
+			{
+				vint							left = -1;
+				vint							right = -1;
+				vint							parent = -1;
+				vuint32_t						priority = 0;
+				vint							count = 1;
+				T								value = T();
+				T								total = T();
+			};
+
+			collections::List<Node>				nodes;
+			vint								root = -1;
+			vint								freeNode = -1;
+			vuint32_t							seed = 1;
+
+			vint NewNode(const T& value)
+			{
+				vint node = freeNode;
+				if (node == -1)
+				{
+					node = nodes.Count();
+					nodes.Add({});
+				}
+				else
+				{
+					freeNode = nodes[node].left;
+				}
+
+				// xorshift keeps priorities deterministic, which keeps the expected depth of the treap at O(log n)
+				seed ^= seed << 13;
+				seed ^= seed >> 17;
+				seed ^= seed << 5;
+
+				auto& record = nodes[node];
+				record = {};
+				record.priority = seed;
+				record.value = value;
+				record.total = value;
+				return node;
+			}
+
+			void FreeNodes(vint node)
+			{
+				if (node == -1) return;
+				collections::List<vint> freeing;
+				freeing.Add(node);
+				while (freeing.Count() > 0)
+				{
+					vint current = freeing[freeing.Count() - 1];
+					freeing.RemoveAt(freeing.Count() - 1);
+					auto& record = nodes[current];
+					if (record.left != -1) freeing.Add(record.left);
+					if (record.right != -1) freeing.Add(record.right);
+					record.left = freeNode;
+					freeNode = current;
+				}
+			}
+
+			void UpdateNode(vint node)
+			{
+				auto& record = nodes[node];
+				record.count = 1;
+				record.total = record.value;
+				if (record.left != -1)
+				{
+					auto& left = nodes[record.left];
+					left.parent = node;
+					record.count += left.count;
+					record.total = left.total + record.total;
+				}
+				if (record.right != -1)
+				{
+					auto& right = nodes[record.right];
+					right.parent = node;
+					record.count += right.count;
+					record.total = record.total + right.total;
+				}
+			}
+
+			void Split(vint node, vint index, vint& left, vint& right)
+			{
+				// values before index go to left, the rest go to right
+				if (node == -1)
+				{
+					left = -1;
+					right = -1;
+					return;
+				}
+
+				auto& record = nodes[node];
+				vint leftCount = record.left == -1 ? 0 : nodes[record.left].count;
+				vint splitted = -1;
+				if (index <= leftCount)
+				{
+					Split(record.left, index, left, splitted);
+					nodes[node].left = splitted;
+					right = node;
+				}
+				else
+				{
+					Split(record.right, index - leftCount - 1, splitted, right);
+					nodes[node].right = splitted;
+					left = node;
+				}
+				UpdateNode(node);
+				nodes[node].parent = -1;
+			}
+
+			vint Merge(vint left, vint right)
+			{
+				if (left == -1) return right;
+				if (right == -1) return left;
+
+				if (nodes[left].priority > nodes[right].priority)
+				{
+					vint merged = Merge(nodes[left].right, right);
+					nodes[left].right = merged;
+					UpdateNode(left);
+					return left;
+				}
+				else
+				{
+					vint merged = Merge(left, nodes[right].left);
+					nodes[right].left = merged;
+					UpdateNode(right);
+					return right;
+				}
+			}
+
+			void SetRoot(vint node)
+			{
+				root = node;
+				if (root != -1)
+				{
+					nodes[root].parent = -1;
+				}
+			}
+		public:
+			ImplicitTreap()
+			{
+			}
+
+			~ImplicitTreap()
+			{
+			}
+
+			/// <summary>Remove all values.</summary>
+			void Clear()
+			{
+				nodes.Clear();
+				root = -1;
+				freeNode = -1;
+			}
+
+			/// <summary>Get the number of values.</summary>
+			/// <returns>The number of values.</returns>
+			vint Count()
+			{
+				return root == -1 ? 0 : nodes[root].count;
+			}
+
+			/// <summary>Get the sum of all values.</summary>
+			/// <returns>The sum of all values.</returns>
+			T GetTotal()
+			{
+				return root == -1 ? T() : nodes[root].total;
+			}
+
+			/// <summary>Insert a value.</summary>
+			/// <returns>The handle of the value.</returns>
+			/// <param name="index">The index of the value.</param>
+			/// <param name="value">The value.</param>
+			vint Insert(vint index, const T& value)
+			{
+				vint left = -1, right = -1;
+				Split(root, index, left, right);
+				vint node = NewNode(value);
+				SetRoot(Merge(Merge(left, node), right));
+				return node;
+			}
+
+			/// <summary>Insert copies of a value.</summary>
+			/// <param name="index">The index of the first copy.</param>
+			/// <param name="count">The number of copies.</param>
+			/// <param name="value">The value.</param>
+			void InsertRange(vint index, vint count, const T& value)
+			{
+				vint left = -1, right = -1;
+				Split(root, index, left, right);
+				vint middle = -1;
+				for (vint i = 0; i < count; i++)
+				{
+					middle = Merge(middle, NewNode(value));
+				}
+				SetRoot(Merge(Merge(left, middle), right));
+			}
+
+			/// <summary>Remove values in a range.</summary>
+			/// <param name="index">The index of the first value.</param>
+			/// <param name="count">The number of values.</param>
+			void RemoveRange(vint index, vint count)
+			{
+				vint left = -1, middle = -1, right = -1;
+				Split(root, index, left, right);
+				Split(right, count, middle, right);
+				FreeNodes(middle);
+				SetRoot(Merge(left, right));
+			}
+
+			/// <summary>Remove a value.</summary>
+			/// <param name="handle">The handle of the value.</param>
+			void Remove(vint handle)
+			{
+				RemoveRange(GetIndex(handle), 1);
+			}
+
+			/// <summary>Get the index of a value.</summary>
+			/// <returns>The index of the value.</returns>
+			/// <param name="handle">The handle of the value.</param>
+			vint GetIndex(vint handle)
+			{
+				vint index = nodes[handle].left == -1 ? 0 : nodes[nodes[handle].left].count;
+				for (vint node = handle; nodes[node].parent != -1; node = nodes[node].parent)
+				{
+					auto& parent = nodes[nodes[node].parent];
+					if (parent.right == node)
+					{
+						index += 1 + (parent.left == -1 ? 0 : nodes[parent.left].count);
+					}
+				}
+				return index;
+			}
+
+			/// <summary>Get the handle of a value.</summary>
+			/// <returns>The handle of the value.</returns>
+			/// <param name="index">The index of the value.</param>
+			vint GetHandle(vint index)
+			{
+				vint node = root;
+				while (node != -1)
+				{
+					auto& record = nodes[node];
+					vint leftCount = record.left == -1 ? 0 : nodes[record.left].count;
+					if (index < leftCount)
+					{
+						node = record.left;
+					}
+					else if (index == leftCount)
+					{
+						return node;
+					}
+					else
+					{
+						index -= leftCount + 1;
+						node = record.right;
+					}
+				}
+				return -1;
+			}
+
+			/// <summary>Get a value.</summary>
+			/// <returns>The value.</returns>
+			/// <param name="handle">The handle of the value.</param>
+			const T& Get(vint handle)
+			{
+				return nodes[handle].value;
+			}
+
+			/// <summary>Change a value.</summary>
+			/// <param name="handle">The handle of the value.</param>
+			/// <param name="value">The new value.</param>
+			void Set(vint handle, const T& value)
+			{
+				nodes[handle].value = value;
+				for (vint node = handle; node != -1; node = nodes[node].parent)
+				{
+					UpdateNode(node);
+				}
+			}
+
+			/// <summary>Get the sum of values before an index.</summary>
+			/// <returns>The sum of values.</returns>
+			/// <param name="index">The number of values to sum from the beginning.</param>
+			T GetSum(vint index)
+			{
+				T sum = T();
+				vint node = root;
+				while (node != -1 && index > 0)
+				{
+					auto& record = nodes[node];
+					vint leftCount = record.left == -1 ? 0 : nodes[record.left].count;
+					if (index <= leftCount)
+					{
+						node = record.left;
+					}
+					else
+					{
+						if (record.left != -1)
+						{
+							sum = sum + nodes[record.left].total;
+						}
+						sum = sum + record.value;
+						index -= leftCount + 1;
+						node = record.right;
+					}
+				}
+				return sum;
+			}
+
+			/// <summary>Find the first value that makes a predicate true on values from the beginning to it. The predicate should stay true when more values are included.</summary>
+			/// <returns>The handle of the found value. Returns -1 if the predicate is false on all values.</returns>
+			/// <param name="inside">The predicate, which accepts the number of values from the beginning and the sum of them.</param>
+			/// <param name="index">Returns the index of the found value, or the number of values if nothing is found.</param>
+			/// <param name="before">Returns the sum of values before the found value, or the sum of all values if nothing is found.</param>
+			template<typename TPredicate>
+			vint Find(const TPredicate& inside, vint& index, T& before)
+			{
+				index = 0;
+				before = T();
+				vint node = root;
+				while (node != -1)
+				{
+					auto& record = nodes[node];
+					vint leftIndex = index;
+					T leftSum = before;
+					if (record.left != -1)
+					{
+						auto& left = nodes[record.left];
+						leftIndex += left.count;
+						leftSum = leftSum + left.total;
+						if (inside(leftIndex, leftSum))
+						{
+							node = record.left;
+							continue;
+						}
+					}
+
+					T sum = leftSum + record.value;
+					if (inside(leftIndex + 1, sum))
+					{
+						index = leftIndex;
+						before = leftSum;
+						return node;
+					}
+					index = leftIndex + 1;
+					before = sum;
+					node = record.right;
+				}
+				return -1;
+			}
+		};
+	}
+}
+
+#endif
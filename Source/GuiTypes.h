@@ -359,6 +359,11 @@ Rectangle
 			{
 				return x1<=p.x && p.x<x2 && y1<=p.y && p.y<y2;
 			}
+
+			bool IntersectWith(Rect rect)
+			{
+				return x1<rect.x2 && rect.x1<x2 && y1<rect.y2 && rect.y1<y2;
+			}
 		};
 
 /***********************************************************************
@@ -0,0 +1,47 @@
+#include "HeadlessApplication.h"
+#include "../../GraphicsElement/Headless/GuiGraphicsHeadless.h"
+
+#if defined VCZH_MSVC
+#include <Windows.h>
+#elif defined VCZH_GCC
+#include <unistd.h>
+#endif
+
+using namespace vl;
+using namespace vl::presentation;
+using namespace vl::presentation::headless;
+
+WString GetHeadlessExecutablePath()
+{
+#if defined VCZH_MSVC
+	wchar_t buffer[65536]={0};
+	GetModuleFileNameW(NULL, buffer, sizeof(buffer)/sizeof(*buffer));
+	return buffer;
+#elif defined VCZH_GCC
+	char buffer[4096]={0};
+	ssize_t length=readlink("/proc/self/exe", buffer, sizeof(buffer)-1);
+	return length>0?atow(AString(buffer)):L"";
+#endif
+}
+
+int HeadlessMain(void(*RendererMain)())
+{
+	// create controller
+	INativeController* controller=CreateHeadlessNativeController(GetHeadlessExecutablePath());
+	SetCurrentController(controller);
+	// main
+	RendererMain();
+	// destroy controller
+	DestroyHeadlessNativeController(controller);
+	return 0;
+}
+
+int SetupHeadlessRenderer()
+{
+	return HeadlessMain(&RendererMainHeadless);
+}
+
+int SetupSoftwareRenderer()
+{
+	return HeadlessMain(&RendererMainSoftware);
+}
@@ -0,0 +1,16 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_HEADLESSAPPLICATION
+#define VCZH_PRESENTATION_HEADLESS_HEADLESSAPPLICATION
+
+#include "HeadlessNativeWindow.h"
+
+extern int HeadlessMain(void(*RendererMain)());
+
+#endif
@@ -0,0 +1,1207 @@
+#include "HeadlessNativeWindow.h"
+#include "ServicesImpl/HeadlessAsyncService.h"
+#include "ServicesImpl/HeadlessCallbackService.h"
+#include "ServicesImpl/HeadlessClipboardService.h"
+#include "ServicesImpl/HeadlessDialogService.h"
+#include "ServicesImpl/HeadlessImageService.h"
+#include "ServicesImpl/HeadlessInputService.h"
+#include "ServicesImpl/HeadlessResourceService.h"
+#include "ServicesImpl/HeadlessScreenService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			using namespace collections;
+
+/***********************************************************************
+HeadlessWindow
+***********************************************************************/
+
+			class HeadlessController;
+
+			class HeadlessWindow : public Object, public INativeWindow
+			{
+			protected:
+				HeadlessController*					controller;
+				List<INativeWindowListener*>		listeners;
+				Rect								bounds;
+				Rect								restoredBounds;
+				WString								title;
+				INativeCursor*						cursor;
+				Point								caretPoint;
+				HeadlessWindow*						parentWindow;
+				bool								alwaysPassFocusToParent;
+				bool								customFrameMode;
+				WindowSizeState						sizeState;
+				bool								visible;
+				bool								enabled;
+				bool								enabledActivate;
+				bool								appearedInTaskBar;
+				bool								maximizedBox;
+				bool								minimizedBox;
+				bool								border;
+				bool								sizeBox;
+				bool								iconVisible;
+				bool								titleBar;
+				bool								topMost;
+
+				void SetBoundsInternal(Rect newBounds, bool fixSizeOnly)
+				{
+					for(vint i=0;i<listeners.Count();i++)
+					{
+						listeners[i]->Moving(newBounds, fixSizeOnly);
+					}
+					if(bounds!=newBounds)
+					{
+						bounds=newBounds;
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							listeners[i]->Moved();
+						}
+					}
+				}
+
+				void ShowInternal(WindowSizeState state, bool activate);
+			public:
+				HeadlessWindow(HeadlessController* _controller)
+					:controller(_controller)
+					,bounds(0, 0, 640, 480)
+					,restoredBounds(0, 0, 640, 480)
+					,cursor(0)
+					,parentWindow(0)
+					,alwaysPassFocusToParent(false)
+					,customFrameMode(false)
+					,sizeState(INativeWindow::Restored)
+					,visible(false)
+					,enabled(true)
+					,enabledActivate(true)
+					,appearedInTaskBar(true)
+					,maximizedBox(true)
+					,minimizedBox(true)
+					,border(true)
+					,sizeBox(true)
+					,iconVisible(true)
+					,titleBar(true)
+					,topMost(false)
+				{
+				}
+
+				~HeadlessWindow()
+				{
+				}
+
+				void InvokeDestroying()
+				{
+					for(vint i=0;i<listeners.Count();i++)
+					{
+						listeners[i]->Destroying();
+					}
+				}
+
+				NativeWindowMouseInfo ConvertMouse(Point position, vint wheel);
+				NativeWindowKeyInfo ConvertKey(vint code);
+				NativeWindowCharInfo ConvertChar(wchar_t code);
+
+				const List<INativeWindowListener*>& GetListeners()
+				{
+					return listeners;
+				}
+
+				bool IsAlwaysPassFocusToParent()
+				{
+					return alwaysPassFocusToParent && parentWindow;
+				}
+
+				HeadlessWindow* GetParentWindow()
+				{
+					return parentWindow;
+				}
+
+				//=======================================================================
+
+				Rect GetBounds()override
+				{
+					return bounds;
+				}
+
+				void SetBounds(const Rect& _bounds)override
+				{
+					SetBoundsInternal(_bounds, true);
+				}
+
+				Size GetClientSize()override
+				{
+					return bounds.GetSize();
+				}
+
+				void SetClientSize(Size size)override
+				{
+					SetBounds(Rect(bounds.LeftTop(), size));
+				}
+
+				Rect GetClientBoundsInScreen()override
+				{
+					// a headless window has no non-client area
+					return bounds;
+				}
+
+				WString GetTitle()override
+				{
+					return title;
+				}
+
+				void SetTitle(WString _title)override
+				{
+					title=_title;
+				}
+
+				INativeCursor* GetWindowCursor()override
+				{
+					return cursor;
+				}
+
+				void SetWindowCursor(INativeCursor* _cursor)override
+				{
+					if(_cursor)
+					{
+						cursor=_cursor;
+					}
+				}
+
+				Point GetCaretPoint()override
+				{
+					return caretPoint;
+				}
+
+				void SetCaretPoint(Point point)override
+				{
+					caretPoint=point;
+				}
+
+				INativeWindow* GetParent()override
+				{
+					return parentWindow;
+				}
+
+				void SetParent(INativeWindow* parent)override
+				{
+					parentWindow=dynamic_cast<HeadlessWindow*>(parent);
+				}
+
+				bool GetAlwaysPassFocusToParent()override
+				{
+					return alwaysPassFocusToParent;
+				}
+
+				void SetAlwaysPassFocusToParent(bool value)override
+				{
+					alwaysPassFocusToParent=value;
+				}
+
+				void EnableCustomFrameMode()override
+				{
+					customFrameMode=true;
+				}
+
+				void DisableCustomFrameMode()override
+				{
+					customFrameMode=false;
+				}
+
+				bool IsCustomFrameModeEnabled()override
+				{
+					return customFrameMode;
+				}
+
+				WindowSizeState GetSizeState()override
+				{
+					return sizeState;
+				}
+
+				void Show()override
+				{
+					ShowInternal(sizeState==INativeWindow::Minimized?INativeWindow::Restored:sizeState, true);
+				}
+
+				void ShowDeactivated()override
+				{
+					ShowInternal(sizeState==INativeWindow::Minimized?INativeWindow::Restored:sizeState, false);
+				}
+
+				void ShowRestored()override
+				{
+					ShowInternal(INativeWindow::Restored, true);
+				}
+
+				void ShowMaximized()override
+				{
+					ShowInternal(INativeWindow::Maximized, true);
+				}
+
+				void ShowMinimized()override
+				{
+					ShowInternal(INativeWindow::Minimized, false);
+				}
+
+				void Hide()override;
+
+				bool IsVisible()override
+				{
+					return visible;
+				}
+
+				void Enable()override
+				{
+					if(!enabled)
+					{
+						enabled=true;
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							listeners[i]->Enabled();
+						}
+					}
+				}
+
+				void Disable()override
+				{
+					if(enabled)
+					{
+						enabled=false;
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							listeners[i]->Disabled();
+						}
+					}
+				}
+
+				bool IsEnabled()override
+				{
+					return enabled;
+				}
+
+				void SetFocus()override;
+				bool IsFocused()override;
+				void SetActivate()override;
+				bool IsActivated()override;
+
+				void ShowInTaskBar()override
+				{
+					appearedInTaskBar=true;
+				}
+
+				void HideInTaskBar()override
+				{
+					appearedInTaskBar=false;
+				}
+
+				bool IsAppearedInTaskBar()override
+				{
+					return appearedInTaskBar;
+				}
+
+				void EnableActivate()override
+				{
+					enabledActivate=true;
+				}
+
+				void DisableActivate()override
+				{
+					enabledActivate=false;
+				}
+
+				bool IsEnabledActivate()override
+				{
+					return enabledActivate;
+				}
+
+				bool RequireCapture()override;
+				bool ReleaseCapture()override;
+				bool IsCapturing()override;
+
+				bool GetMaximizedBox()override
+				{
+					return maximizedBox;
+				}
+
+				void SetMaximizedBox(bool visible)override
+				{
+					maximizedBox=visible;
+				}
+
+				bool GetMinimizedBox()override
+				{
+					return minimizedBox;
+				}
+
+				void SetMinimizedBox(bool visible)override
+				{
+					minimizedBox=visible;
+				}
+
+				bool GetBorder()override
+				{
+					return border;
+				}
+
+				void SetBorder(bool visible)override
+				{
+					border=visible;
+				}
+
+				bool GetSizeBox()override
+				{
+					return sizeBox;
+				}
+
+				void SetSizeBox(bool visible)override
+				{
+					sizeBox=visible;
+				}
+
+				bool GetIconVisible()override
+				{
+					return iconVisible;
+				}
+
+				void SetIconVisible(bool visible)override
+				{
+					iconVisible=visible;
+				}
+
+				bool GetTitleBar()override
+				{
+					return titleBar;
+				}
+
+				void SetTitleBar(bool visible)override
+				{
+					titleBar=visible;
+				}
+
+				bool GetTopMost()override
+				{
+					return topMost;
+				}
+
+				void SetTopMost(bool topmost)override;
+
+				void SupressAlt()override
+				{
+				}
+
+				bool InstallListener(INativeWindowListener* listener)override
+				{
+					if(listeners.Contains(listener))
+					{
+						return false;
+					}
+					else
+					{
+						listeners.Add(listener);
+						return true;
+					}
+				}
+
+				bool UninstallListener(INativeWindowListener* listener)override
+				{
+					if(listeners.Contains(listener))
+					{
+						listeners.Remove(listener);
+						return true;
+					}
+					else
+					{
+						return false;
+					}
+				}
+
+				void RedrawContent()override
+				{
+					// there is no screen to present the render target to
+				}
+			};
+
+/***********************************************************************
+HeadlessController
+***********************************************************************/
+
+			class HeadlessController : public Object, public virtual INativeController, public virtual INativeWindowService, public IHeadlessController
+			{
+			protected:
+				WString								executablePath;
+				List<HeadlessWindow*>				windows;
+				HeadlessWindow*						mainWindow;
+				bool								quitting;
+				vint								runTimeLimit;
+
+				HeadlessWindow*						activatedWindow;
+				HeadlessWindow*						focusedWindow;
+				HeadlessWindow*						capturingWindow;
+				HeadlessWindow*						hoveringWindow;
+				Point								mousePosition;
+				vint								lastClickButton;
+				vuint64_t							lastClickTime;
+				Point								lastClickPosition;
+
+				HeadlessCallbackService				callbackService;
+				HeadlessResourceService				resourceService;
+				HeadlessAsyncService				asyncService;
+				HeadlessClipboardService			clipboardService;
+				HeadlessImageService				imageService;
+				HeadlessScreenService				screenService;
+				HeadlessInputService				inputService;
+				HeadlessDialogService				dialogService;
+
+				HeadlessWindow* GetMouseTarget()
+				{
+					if(capturingWindow)
+					{
+						return capturingWindow;
+					}
+					auto window=dynamic_cast<HeadlessWindow*>(GetWindow(mousePosition));
+					return window && window->IsEnabled()?window:0;
+				}
+
+				HeadlessWindow* GetKeyTarget()
+				{
+					return focusedWindow && focusedWindow->IsEnabled()?focusedWindow:0;
+				}
+
+				vint GetButtonKey(HeadlessMouseButton button)
+				{
+					switch(button)
+					{
+					case HeadlessMouseButton::Left:
+						return VKEY_LBUTTON;
+					case HeadlessMouseButton::Middle:
+						return VKEY_MBUTTON;
+					default:
+						return VKEY_RBUTTON;
+					}
+				}
+
+				void UpdateHoveringWindow()
+				{
+					auto window=dynamic_cast<HeadlessWindow*>(GetWindow(mousePosition));
+					if(hoveringWindow!=window)
+					{
+						if(hoveringWindow)
+						{
+							auto& listeners=hoveringWindow->GetListeners();
+							for(vint i=0;i<listeners.Count();i++)
+							{
+								listeners[i]->MouseLeaved();
+							}
+						}
+						hoveringWindow=window;
+						if(hoveringWindow)
+						{
+							auto& listeners=hoveringWindow->GetListeners();
+							for(vint i=0;i<listeners.Count();i++)
+							{
+								listeners[i]->MouseEntered();
+							}
+						}
+					}
+				}
+
+				void ActivateNextWindow(HeadlessWindow* window)
+				{
+					HeadlessWindow* next=window->GetParentWindow();
+					if(!next || !next->IsVisible())
+					{
+						next=0;
+						for(vint i=windows.Count()-1;i>=0;i--)
+						{
+							if(windows[i]!=window && windows[i]->IsVisible() && windows[i]->IsEnabledActivate())
+							{
+								next=windows[i];
+								break;
+							}
+						}
+					}
+					SetActivatedWindow(next);
+				}
+			public:
+				HeadlessController(const WString& _executablePath)
+					:executablePath(_executablePath)
+					,mainWindow(0)
+					,quitting(false)
+					,runTimeLimit(-1)
+					,activatedWindow(0)
+					,focusedWindow(0)
+					,capturingWindow(0)
+					,hoveringWindow(0)
+					,lastClickButton(-1)
+					,lastClickTime(0)
+					,clipboardService(&callbackService)
+				{
+				}
+
+				~HeadlessController()
+				{
+					while(windows.Count())
+					{
+						DestroyNativeWindow(windows[0]);
+					}
+				}
+
+				//=======================================================================
+
+				void RaiseWindow(HeadlessWindow* window)
+				{
+					windows.Remove(window);
+					vint index=windows.Count();
+					if(!window->GetTopMost())
+					{
+						while(index>0 && windows[index-1]->GetTopMost())
+						{
+							index--;
+						}
+					}
+					windows.Insert(index, window);
+				}
+
+				void SetActivatedWindow(HeadlessWindow* window)
+				{
+					if(activatedWindow!=window)
+					{
+						if(activatedWindow)
+						{
+							auto& listeners=activatedWindow->GetListeners();
+							for(vint i=0;i<listeners.Count();i++)
+							{
+								listeners[i]->Deactivated();
+							}
+						}
+						activatedWindow=window;
+						if(activatedWindow)
+						{
+							RaiseWindow(activatedWindow);
+							auto& listeners=activatedWindow->GetListeners();
+							for(vint i=0;i<listeners.Count();i++)
+							{
+								listeners[i]->Activated();
+							}
+						}
+					}
+					SetFocusedWindow(window);
+				}
+
+				HeadlessWindow* GetActivatedWindow()
+				{
+					return activatedWindow;
+				}
+
+				void SetFocusedWindow(HeadlessWindow* window)
+				{
+					while(window && window->IsAlwaysPassFocusToParent())
+					{
+						window=window->GetParentWindow();
+					}
+					if(focusedWindow!=window)
+					{
+						if(focusedWindow)
+						{
+							auto& listeners=focusedWindow->GetListeners();
+							for(vint i=0;i<listeners.Count();i++)
+							{
+								listeners[i]->LostFocus();
+							}
+						}
+						focusedWindow=window;
+						if(focusedWindow)
+						{
+							auto& listeners=focusedWindow->GetListeners();
+							for(vint i=0;i<listeners.Count();i++)
+							{
+								listeners[i]->GotFocus();
+							}
+						}
+					}
+				}
+
+				HeadlessWindow* GetFocusedWindow()
+				{
+					return focusedWindow;
+				}
+
+				void SetCapturingWindow(HeadlessWindow* window)
+				{
+					capturingWindow=window;
+				}
+
+				HeadlessWindow* GetCapturingWindow()
+				{
+					return capturingWindow;
+				}
+
+				void WindowHidden(HeadlessWindow* window)
+				{
+					if(capturingWindow==window)
+					{
+						capturingWindow=0;
+					}
+					if(activatedWindow==window || focusedWindow==window)
+					{
+						ActivateNextWindow(window);
+					}
+					UpdateHoveringWindow();
+					if(window==mainWindow)
+					{
+						quitting=true;
+					}
+				}
+
+				Rect GetScreenBounds()
+				{
+					return screenService.GetScreen((vint)0)->GetClientBounds();
+				}
+
+				HeadlessInputService* GetInputService()
+				{
+					return &inputService;
+				}
+
+				//=======================================================================
+
+				INativeWindow* CreateNativeWindow()override
+				{
+					HeadlessWindow* window=new HeadlessWindow(this);
+					windows.Insert(0, window);
+					callbackService.InvokeNativeWindowCreated(window);
+					window->SetWindowCursor(resourceService.GetDefaultSystemCursor());
+					return window;
+				}
+
+				void DestroyNativeWindow(INativeWindow* window)override
+				{
+					HeadlessWindow* headlessWindow=dynamic_cast<HeadlessWindow*>(window);
+					if(headlessWindow!=0 && windows.Contains(headlessWindow))
+					{
+						headlessWindow->InvokeDestroying();
+						callbackService.InvokeNativeWindowDestroyed(window);
+						windows.Remove(headlessWindow);
+
+						if(activatedWindow==headlessWindow) activatedWindow=0;
+						if(focusedWindow==headlessWindow) focusedWindow=0;
+						if(capturingWindow==headlessWindow) capturingWindow=0;
+						if(hoveringWindow==headlessWindow) hoveringWindow=0;
+						if(mainWindow==headlessWindow) mainWindow=0;
+						delete headlessWindow;
+					}
+				}
+
+				INativeWindow* GetMainWindow()override
+				{
+					return mainWindow;
+				}
+
+				INativeWindow* GetWindow(Point location)override
+				{
+					for(vint i=windows.Count()-1;i>=0;i--)
+					{
+						HeadlessWindow* window=windows[i];
+						if(window->IsVisible() && window->GetSizeState()!=INativeWindow::Minimized && window->GetBounds().Contains(location))
+						{
+							return window;
+						}
+					}
+					return 0;
+				}
+
+				void Run(INativeWindow* window)override
+				{
+					mainWindow=dynamic_cast<HeadlessWindow*>(window);
+					quitting=false;
+					vuint64_t startTime=asyncService.GetVirtualTime();
+					mainWindow->Show();
+					while(!quitting)
+					{
+						if(runTimeLimit>=0 && asyncService.GetVirtualTime()-startTime>=(vuint64_t)runTimeLimit)
+						{
+							mainWindow->Hide();
+							break;
+						}
+						AdvanceTime(TimerInterval);
+					}
+
+					for(vint i=0;i<windows.Count();i++)
+					{
+						if(windows[i]->IsVisible())
+						{
+							windows[i]->Hide();
+						}
+					}
+					while(windows.Count())
+					{
+						DestroyNativeWindow(windows[0]);
+					}
+					mainWindow=0;
+				}
+
+				//=======================================================================
+
+				INativeCallbackService* CallbackService()override
+				{
+					return &callbackService;
+				}
+
+				INativeResourceService* ResourceService()override
+				{
+					return &resourceService;
+				}
+
+				INativeAsyncService* AsyncService()override
+				{
+					return &asyncService;
+				}
+
+				INativeClipboardService* ClipboardService()override
+				{
+					return &clipboardService;
+				}
+
+				INativeImageService* ImageService()override
+				{
+					return &imageService;
+				}
+
+				INativeScreenService* ScreenService()override
+				{
+					return &screenService;
+				}
+
+				INativeWindowService* WindowService()override
+				{
+					return this;
+				}
+
+				INativeInputService* InputService()override
+				{
+					return &inputService;
+				}
+
+				INativeDialogService* DialogService()override
+				{
+					return &dialogService;
+				}
+
+				WString GetExecutablePath()override
+				{
+					return executablePath;
+				}
+
+				//=======================================================================
+
+				vuint64_t GetVirtualTime()override
+				{
+					return asyncService.GetVirtualTime();
+				}
+
+				void AdvanceTime(vint milliseconds)override
+				{
+					vuint64_t target=asyncService.GetVirtualTime()+(milliseconds>0?milliseconds:0);
+					while(true)
+					{
+						asyncService.ExecuteAsyncTasks();
+
+						vuint64_t now=asyncService.GetVirtualTime();
+						vuint64_t next=target;
+						vuint64_t nextTick=(now/TimerInterval+1)*TimerInterval;
+						if(inputService.IsTimerEnabled() && nextTick<next)
+						{
+							next=nextTick;
+						}
+						vuint64_t delayTime=0;
+						if(asyncService.GetNextDelayTime(delayTime) && delayTime<next)
+						{
+							next=delayTime<now?now:delayTime;
+						}
+
+						asyncService.SetVirtualTime(next);
+						if(inputService.IsTimerEnabled() && next==nextTick)
+						{
+							callbackService.InvokeGlobalTimer();
+						}
+						if(next==target)
+						{
+							asyncService.ExecuteAsyncTasks();
+							break;
+						}
+					}
+				}
+
+				void SetRunTimeLimit(vint milliseconds)override
+				{
+					runTimeLimit=milliseconds;
+				}
+
+				void SetScreenSize(Size size)override
+				{
+					screenService.SetScreenSize(size);
+				}
+
+				Point GetMousePosition()override
+				{
+					return mousePosition;
+				}
+
+				void MouseMove(Point position)override
+				{
+					mousePosition=position;
+					if(inputService.IsHookingMouse())
+					{
+						callbackService.InvokeMouseMoving(position);
+					}
+					UpdateHoveringWindow();
+					if(auto window=GetMouseTarget())
+					{
+						auto info=window->ConvertMouse(position, 0);
+						auto& listeners=window->GetListeners();
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							listeners[i]->MouseMoving(info);
+						}
+					}
+				}
+
+				void MouseDown(HeadlessMouseButton button)override
+				{
+					vint key=GetButtonKey(button);
+					inputService.SetKeyPressing(key, true);
+					if(inputService.IsHookingMouse())
+					{
+						switch(button)
+						{
+						case HeadlessMouseButton::Left:
+							callbackService.InvokeLeftButtonDown(mousePosition);
+							break;
+						case HeadlessMouseButton::Right:
+							callbackService.InvokeRightButtonDown(mousePosition);
+							break;
+						default:;
+						}
+					}
+
+					vuint64_t now=asyncService.GetVirtualTime();
+					bool doubleClick=lastClickButton==key && lastClickPosition==mousePosition && now-lastClickTime<=(vuint64_t)DoubleClickInterval;
+					lastClickButton=doubleClick?-1:key;
+					lastClickTime=now;
+					lastClickPosition=mousePosition;
+
+					if(auto window=GetMouseTarget())
+					{
+						if(window!=activatedWindow && window->IsEnabledActivate())
+						{
+							SetActivatedWindow(window);
+						}
+						auto info=window->ConvertMouse(mousePosition, 0);
+						auto& listeners=window->GetListeners();
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							switch(button)
+							{
+							case HeadlessMouseButton::Left:
+								if(doubleClick) listeners[i]->LeftButtonDoubleClick(info); else listeners[i]->LeftButtonDown(info);
+								break;
+							case HeadlessMouseButton::Middle:
+								if(doubleClick) listeners[i]->MiddleButtonDoubleClick(info); else listeners[i]->MiddleButtonDown(info);
+								break;
+							case HeadlessMouseButton::Right:
+								if(doubleClick) listeners[i]->RightButtonDoubleClick(info); else listeners[i]->RightButtonDown(info);
+								break;
+							}
+						}
+					}
+				}
+
+				void MouseUp(HeadlessMouseButton button)override
+				{
+					inputService.SetKeyPressing(GetButtonKey(button), false);
+					if(inputService.IsHookingMouse())
+					{
+						switch(button)
+						{
+						case HeadlessMouseButton::Left:
+							callbackService.InvokeLeftButtonUp(mousePosition);
+							break;
+						case HeadlessMouseButton::Right:
+							callbackService.InvokeRightButtonUp(mousePosition);
+							break;
+						default:;
+						}
+					}
+
+					if(auto window=GetMouseTarget())
+					{
+						auto info=window->ConvertMouse(mousePosition, 0);
+						auto& listeners=window->GetListeners();
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							switch(button)
+							{
+							case HeadlessMouseButton::Left:
+								listeners[i]->LeftButtonUp(info);
+								break;
+							case HeadlessMouseButton::Middle:
+								listeners[i]->MiddleButtonUp(info);
+								break;
+							case HeadlessMouseButton::Right:
+								listeners[i]->RightButtonUp(info);
+								break;
+							}
+						}
+					}
+				}
+
+				void MouseWheel(vint delta, bool horizontal)override
+				{
+					if(auto window=GetMouseTarget())
+					{
+						auto info=window->ConvertMouse(mousePosition, delta);
+						auto& listeners=window->GetListeners();
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							if(horizontal)
+							{
+								listeners[i]->HorizontalWheel(info);
+							}
+							else
+							{
+								listeners[i]->VerticalWheel(info);
+							}
+						}
+					}
+				}
+
+				void KeyDown(vint code)override
+				{
+					inputService.SetKeyPressing(code, true);
+					if(auto window=GetKeyTarget())
+					{
+						auto info=window->ConvertKey(code);
+						bool sysKey=info.alt || code==VKEY_F10;
+						auto& listeners=window->GetListeners();
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							if(sysKey)
+							{
+								listeners[i]->SysKeyDown(info);
+							}
+							else
+							{
+								listeners[i]->KeyDown(info);
+							}
+						}
+					}
+				}
+
+				void KeyUp(vint code)override
+				{
+					bool sysKey=inputService.IsKeyPressing(VKEY_MENU) || code==VKEY_F10;
+					inputService.SetKeyPressing(code, false);
+					if(auto window=GetKeyTarget())
+					{
+						auto info=window->ConvertKey(code);
+						auto& listeners=window->GetListeners();
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							if(sysKey)
+							{
+								listeners[i]->SysKeyUp(info);
+							}
+							else
+							{
+								listeners[i]->KeyUp(info);
+							}
+						}
+					}
+				}
+
+				void TypeChar(wchar_t code)override
+				{
+					if(auto window=GetKeyTarget())
+					{
+						auto info=window->ConvertChar(code);
+						auto& listeners=window->GetListeners();
+						for(vint i=0;i<listeners.Count();i++)
+						{
+							listeners[i]->Char(info);
+						}
+					}
+				}
+			};
+
+/***********************************************************************
+HeadlessWindow (Controller Related)
+***********************************************************************/
+
+			void HeadlessWindow::ShowInternal(WindowSizeState state, bool activate)
+			{
+				if(sizeState!=state)
+				{
+					if(state==INativeWindow::Maximized)
+					{
+						restoredBounds=bounds;
+						sizeState=state;
+						SetBoundsInternal(controller->GetScreenBounds(), false);
+					}
+					else if(sizeState==INativeWindow::Maximized)
+					{
+						sizeState=state;
+						SetBoundsInternal(restoredBounds, false);
+					}
+					else
+					{
+						sizeState=state;
+					}
+				}
+
+				if(!visible)
+				{
+					visible=true;
+					for(vint i=0;i<listeners.Count();i++)
+					{
+						listeners[i]->Opened();
+					}
+				}
+
+				if(activate && enabledActivate && sizeState!=INativeWindow::Minimized)
+				{
+					controller->SetActivatedWindow(this);
+				}
+				else
+				{
+					controller->RaiseWindow(this);
+				}
+			}
+
+			void HeadlessWindow::Hide()
+			{
+				bool cancel=false;
+				for(vint i=0;i<listeners.Count();i++)
+				{
+					listeners[i]->Closing(cancel);
+				}
+				if(!cancel && visible)
+				{
+					visible=false;
+					for(vint i=0;i<listeners.Count();i++)
+					{
+						listeners[i]->Closed();
+					}
+					controller->WindowHidden(this);
+				}
+			}
+
+			void HeadlessWindow::SetFocus()
+			{
+				controller->SetFocusedWindow(this);
+			}
+
+			bool HeadlessWindow::IsFocused()
+			{
+				return controller->GetFocusedWindow()==this;
+			}
+
+			void HeadlessWindow::SetActivate()
+			{
+				controller->SetActivatedWindow(this);
+			}
+
+			bool HeadlessWindow::IsActivated()
+			{
+				return controller->GetActivatedWindow()==this;
+			}
+
+			bool HeadlessWindow::RequireCapture()
+			{
+				controller->SetCapturingWindow(this);
+				return true;
+			}
+
+			bool HeadlessWindow::ReleaseCapture()
+			{
+				if(controller->GetCapturingWindow()==this)
+				{
+					controller->SetCapturingWindow(0);
+				}
+				return true;
+			}
+
+			bool HeadlessWindow::IsCapturing()
+			{
+				return controller->GetCapturingWindow()==this;
+			}
+
+			void HeadlessWindow::SetTopMost(bool topmost)
+			{
+				topMost=topmost;
+				controller->RaiseWindow(this);
+			}
+
+			NativeWindowMouseInfo HeadlessWindow::ConvertMouse(Point position, vint wheel)
+			{
+				auto inputService=controller->GetInputService();
+				NativeWindowMouseInfo info;
+				info.ctrl=inputService->IsKeyPressing(VKEY_CONTROL);
+				info.shift=inputService->IsKeyPressing(VKEY_SHIFT);
+				info.left=inputService->IsKeyPressing(VKEY_LBUTTON);
+				info.middle=inputService->IsKeyPressing(VKEY_MBUTTON);
+				info.right=inputService->IsKeyPressing(VKEY_RBUTTON);
+				info.x=position.x-bounds.x1;
+				info.y=position.y-bounds.y1;
+				info.wheel=wheel;
+				info.nonClient=false;
+				return info;
+			}
+
+			NativeWindowKeyInfo HeadlessWindow::ConvertKey(vint code)
+			{
+				auto inputService=controller->GetInputService();
+				NativeWindowKeyInfo info;
+				info.code=code;
+				info.ctrl=inputService->IsKeyPressing(VKEY_CONTROL);
+				info.shift=inputService->IsKeyPressing(VKEY_SHIFT);
+				info.alt=inputService->IsKeyPressing(VKEY_MENU);
+				info.capslock=inputService->IsKeyToggled(VKEY_CAPITAL);
+				return info;
+			}
+
+			NativeWindowCharInfo HeadlessWindow::ConvertChar(wchar_t code)
+			{
+				auto inputService=controller->GetInputService();
+				NativeWindowCharInfo info;
+				info.code=code;
+				info.ctrl=inputService->IsKeyPressing(VKEY_CONTROL);
+				info.shift=inputService->IsKeyPressing(VKEY_SHIFT);
+				info.alt=inputService->IsKeyPressing(VKEY_MENU);
+				info.capslock=inputService->IsKeyToggled(VKEY_CAPITAL);
+				return info;
+			}
+
+/***********************************************************************
+Headless Platform Native Controller
+***********************************************************************/
+
+			INativeController* CreateHeadlessNativeController(const WString& executablePath)
+			{
+				return new HeadlessController(executablePath);
+			}
+
+			IHeadlessController* GetHeadlessController(INativeController* controller)
+			{
+				return dynamic_cast<HeadlessController*>(controller);
+			}
+
+			void DestroyHeadlessNativeController(INativeController* controller)
+			{
+				delete controller;
+			}
+		}
+	}
+}
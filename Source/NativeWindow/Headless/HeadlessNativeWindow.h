@@ -0,0 +1,104 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+  IHeadlessController					: Virtual clock and virtual input devices
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_HEADLESSNATIVEWINDOW
+#define VCZH_PRESENTATION_HEADLESS_HEADLESSNATIVEWINDOW
+
+#include "../GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+
+/***********************************************************************
+Headless Platform Native Controller
+***********************************************************************/
+
+			/// <summary>Mouse buttons for input injection.</summary>
+			enum class HeadlessMouseButton
+			{
+				/// <summary>The left button.</summary>
+				Left,
+				/// <summary>The middle button.</summary>
+				Middle,
+				/// <summary>The right button.</summary>
+				Right,
+			};
+
+			/// <summary>
+			/// Drives a headless native controller.
+			/// Windows in a headless controller are not backed by any display, the time only moves when <see cref="AdvanceTime"/> is called, and all mouse and keyboard input are injected by calling functions of this interface.
+			/// </summary>
+			class IHeadlessController : public Interface
+			{
+			public:
+				/// <summary>The interval of the global timer in milliseconds.</summary>
+				static const vint							TimerInterval = 16;
+				/// <summary>The maximum interval between two clicks to make a double click in milliseconds.</summary>
+				static const vint							DoubleClickInterval = 500;
+
+				/// <summary>Get the virtual time in milliseconds since the controller is created.</summary>
+				/// <returns>The virtual time.</returns>
+				virtual vuint64_t							GetVirtualTime() = 0;
+				/// <summary>Move the virtual clock forward. Pending tasks, delayed tasks that become due and global timer ticks are executed in order.</summary>
+				/// <param name="milliseconds">The time to move forward.</param>
+				virtual void								AdvanceTime(vint milliseconds) = 0;
+				/// <summary>Limit the virtual time that <see cref="INativeWindowService::Run"/> is allowed to spend. The main window is closed when the limit is reached.</summary>
+				/// <param name="milliseconds">The time limit. Set to -1 to remove the limitation.</param>
+				virtual void								SetRunTimeLimit(vint milliseconds) = 0;
+				/// <summary>Resize the only virtual screen.</summary>
+				/// <param name="size">The new size of the virtual screen.</param>
+				virtual void								SetScreenSize(Size size) = 0;
+
+				/// <summary>Get the position of the virtual mouse in screen coordinate.</summary>
+				/// <returns>The position of the virtual mouse.</returns>
+				virtual Point								GetMousePosition() = 0;
+				/// <summary>Move the virtual mouse. The window under the mouse, or the window that captures the mouse, receives the message.</summary>
+				/// <param name="position">The new position in screen coordinate.</param>
+				virtual void								MouseMove(Point position) = 0;
+				/// <summary>Press a mouse button. A double click message is sent instead if the same button is pressed at the same position within <see cref="DoubleClickInterval"/>.</summary>
+				/// <param name="button">The mouse button.</param>
+				virtual void								MouseDown(HeadlessMouseButton button) = 0;
+				/// <summary>Release a mouse button.</summary>
+				/// <param name="button">The mouse button.</param>
+				virtual void								MouseUp(HeadlessMouseButton button) = 0;
+				/// <summary>Scroll the mouse wheel.</summary>
+				/// <param name="delta">The wheel delta. 120 is one notch.</param>
+				/// <param name="horizontal">Set to true to scroll the horizontal wheel.</param>
+				virtual void								MouseWheel(vint delta, bool horizontal) = 0;
+				/// <summary>Press a key. The focused window receives the message.</summary>
+				/// <param name="code">The key code, which is one of the VKEY_* constants.</param>
+				virtual void								KeyDown(vint code) = 0;
+				/// <summary>Release a key. The focused window receives the message.</summary>
+				/// <param name="code">The key code, which is one of the VKEY_* constants.</param>
+				virtual void								KeyUp(vint code) = 0;
+				/// <summary>Input a character. The focused window receives the message.</summary>
+				/// <param name="code">The character.</param>
+				virtual void								TypeChar(wchar_t code) = 0;
+			};
+
+			/// <summary>Create a headless native controller. It can be created in any operating system.</summary>
+			/// <returns>The created native controller.</returns>
+			/// <param name="executablePath">The value to return from <see cref="INativeController::GetExecutablePath"/>.</param>
+			extern INativeController*						CreateHeadlessNativeController(const WString& executablePath);
+			/// <summary>Get the <see cref="IHeadlessController"/> from a headless native controller.</summary>
+			/// <returns>The headless controller. Returns null if the native controller is not a headless one.</returns>
+			/// <param name="controller">The native controller.</param>
+			extern IHeadlessController*						GetHeadlessController(INativeController* controller);
+			/// <summary>Destroy a headless native controller.</summary>
+			/// <param name="controller">The native controller to destroy.</param>
+			extern void										DestroyHeadlessNativeController(INativeController* controller);
+		}
+	}
+}
+
+#endif
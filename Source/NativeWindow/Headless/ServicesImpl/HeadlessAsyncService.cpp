@@ -0,0 +1,270 @@
+#include "HeadlessAsyncService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			using namespace collections;
+
+/***********************************************************************
+HeadlessAsyncService::TaskCompletion
+***********************************************************************/
+
+			HeadlessAsyncService::TaskCompletion::TaskCompletion()
+			{
+				semaphore.Create(0, 1);
+			}
+
+			void HeadlessAsyncService::TaskCompletion::Release(bool _finished)
+			{
+				if(waiting)
+				{
+					waiting=false;
+					finished=_finished;
+					semaphore.Release();
+				}
+			}
+
+/***********************************************************************
+HeadlessAsyncService::TaskItem
+***********************************************************************/
+
+			HeadlessAsyncService::TaskItem::TaskItem()
+			{
+			}
+
+			HeadlessAsyncService::TaskItem::TaskItem(Ptr<TaskCompletion> _completion, const Func<void()>& _proc)
+				:completion(_completion)
+				,proc(_proc)
+			{
+			}
+
+			HeadlessAsyncService::TaskItem::~TaskItem()
+			{
+			}
+
+/***********************************************************************
+HeadlessAsyncService::DelayItem
+***********************************************************************/
+
+			HeadlessAsyncService::DelayItem::DelayItem(HeadlessAsyncService* _service, const Func<void()>& _proc, bool _executeInMainThread, vint milliseconds)
+				:service(_service)
+				,proc(_proc)
+				,status(INativeDelay::Pending)
+				,executeTime(_service->virtualTime+(milliseconds>0?milliseconds:0))
+				,executeInMainThread(_executeInMainThread)
+			{
+			}
+
+			HeadlessAsyncService::DelayItem::~DelayItem()
+			{
+			}
+
+			INativeDelay::ExecuteStatus HeadlessAsyncService::DelayItem::GetStatus()
+			{
+				return status;
+			}
+
+			bool HeadlessAsyncService::DelayItem::Delay(vint milliseconds)
+			{
+				SPIN_LOCK(service->taskListLock)
+				{
+					if(status==INativeDelay::Pending)
+					{
+						executeTime=service->virtualTime+(milliseconds>0?milliseconds:0);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			bool HeadlessAsyncService::DelayItem::Cancel()
+			{
+				SPIN_LOCK(service->taskListLock)
+				{
+					if(status==INativeDelay::Pending)
+					{
+						if(service->delayItems.Remove(this))
+						{
+							status=INativeDelay::Canceled;
+							return true;
+						}
+					}
+				}
+				return false;
+			}
+
+/***********************************************************************
+HeadlessAsyncService
+***********************************************************************/
+
+			HeadlessAsyncService::HeadlessAsyncService()
+				:mainThreadId(Thread::GetCurrentThreadId())
+				,virtualTime(0)
+			{
+			}
+
+			HeadlessAsyncService::~HeadlessAsyncService()
+			{
+				SPIN_LOCK(taskListLock)
+				{
+					FOREACH(TaskItem, item, taskItems)
+					{
+						if(item.completion)
+						{
+							item.completion->Release(false);
+						}
+					}
+				}
+			}
+
+			vuint64_t HeadlessAsyncService::GetVirtualTime()
+			{
+				return virtualTime;
+			}
+
+			void HeadlessAsyncService::SetVirtualTime(vuint64_t time)
+			{
+				SPIN_LOCK(taskListLock)
+				{
+					if(virtualTime<time)
+					{
+						virtualTime=time;
+					}
+
+					// threads waiting for tasks that are not executed in time stop waiting
+					FOREACH(TaskItem, item, taskItems)
+					{
+						if(item.completion && item.completion->hasDeadline && item.completion->deadline<=virtualTime)
+						{
+							item.completion->Release(false);
+						}
+					}
+				}
+			}
+
+			bool HeadlessAsyncService::GetNextDelayTime(vuint64_t& time)
+			{
+				bool found=false;
+				SPIN_LOCK(taskListLock)
+				{
+					FOREACH(Ptr<DelayItem>, item, delayItems)
+					{
+						if(!found || item->executeTime<time)
+						{
+							time=item->executeTime;
+							found=true;
+						}
+					}
+				}
+				return found;
+			}
+
+			void HeadlessAsyncService::ExecuteAsyncTasks()
+			{
+				Array<TaskItem> items;
+				List<Ptr<DelayItem>> executableDelayItems;
+
+				SPIN_LOCK(taskListLock)
+				{
+					CopyFrom(items, taskItems);
+					taskItems.RemoveRange(0, items.Count());
+					for(vint i=0;i<delayItems.Count();i++)
+					{
+						Ptr<DelayItem> item=delayItems[i];
+						if(virtualTime>=item->executeTime)
+						{
+							// keep due delayed tasks ordered by their execution time, tasks with the same time keep their creation order
+							vint index=executableDelayItems.Count();
+							while(index>0 && executableDelayItems[index-1]->executeTime>item->executeTime)
+							{
+								index--;
+							}
+							item->status=INativeDelay::Executing;
+							executableDelayItems.Insert(index, item);
+							delayItems.RemoveAt(i--);
+						}
+					}
+				}
+
+				FOREACH(TaskItem, item, items)
+				{
+					item.proc();
+					if(item.completion)
+					{
+						item.completion->Release(true);
+					}
+				}
+
+				// tasks from DelayExecute are also executed here instead of in the thread pool, to keep them in the order of the virtual clock
+				FOREACH(Ptr<DelayItem>, item, executableDelayItems)
+				{
+					item->proc();
+					item->status=INativeDelay::Executed;
+				}
+			}
+
+			bool HeadlessAsyncService::IsInMainThread()
+			{
+				return Thread::GetCurrentThreadId()==mainThreadId;
+			}
+
+			void HeadlessAsyncService::InvokeAsync(const Func<void()>& proc)
+			{
+				ThreadPoolLite::Queue(proc);
+			}
+
+			void HeadlessAsyncService::InvokeInMainThread(INativeWindow* window, const Func<void()>& proc)
+			{
+				SPIN_LOCK(taskListLock)
+				{
+					TaskItem item(nullptr, proc);
+					taskItems.Add(item);
+				}
+			}
+
+			bool HeadlessAsyncService::InvokeInMainThreadAndWait(INativeWindow* window, const Func<void()>& proc, vint milliseconds)
+			{
+				auto completion=MakePtr<TaskCompletion>();
+				SPIN_LOCK(taskListLock)
+				{
+					if(milliseconds>=0)
+					{
+						completion->hasDeadline=true;
+						completion->deadline=virtualTime+milliseconds;
+					}
+					TaskItem item(completion, proc);
+					taskItems.Add(item);
+				}
+
+				// the semaphore is released by the main thread when the task is executed, or when the virtual clock passes the deadline
+				completion->semaphore.Wait();
+				return completion->finished;
+			}
+
+			Ptr<INativeDelay> HeadlessAsyncService::DelayExecute(const Func<void()>& proc, vint milliseconds)
+			{
+				Ptr<DelayItem> delay;
+				SPIN_LOCK(taskListLock)
+				{
+					delay=new DelayItem(this, proc, false, milliseconds);
+					delayItems.Add(delay);
+				}
+				return delay;
+			}
+
+			Ptr<INativeDelay> HeadlessAsyncService::DelayExecuteInMainThread(const Func<void()>& proc, vint milliseconds)
+			{
+				Ptr<DelayItem> delay;
+				SPIN_LOCK(taskListLock)
+				{
+					delay=new DelayItem(this, proc, true, milliseconds);
+					delayItems.Add(delay);
+				}
+				return delay;
+			}
+		}
+	}
+}
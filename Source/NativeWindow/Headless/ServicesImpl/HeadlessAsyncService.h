@@ -0,0 +1,100 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSASYNCSERVICE
+#define VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSASYNCSERVICE
+
+#include "../../GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			/// <summary>
+			/// An async service whose delayed tasks are scheduled against a virtual clock.
+			/// The clock only moves when <see cref="SetVirtualTime"/> is called, so the order and the timing of all delayed tasks are reproducible.
+			/// Delayed tasks are always executed in <see cref="ExecuteAsyncTasks"/>, including those created by <see cref="DelayExecute"/>.
+			/// The timeout of <see cref="InvokeInMainThreadAndWait"/> is also measured in virtual time.
+			/// </summary>
+			class HeadlessAsyncService : public INativeAsyncService
+			{
+			protected:
+				struct TaskCompletion
+				{
+					Semaphore							semaphore;
+					bool								waiting = true;
+					bool								finished = false;
+					bool								hasDeadline = false;
+					vuint64_t							deadline = 0;
+
+					TaskCompletion();
+					void								Release(bool _finished);
+				};
+
+				struct TaskItem
+				{
+					Ptr<TaskCompletion>					completion;
+					Func<void()>						proc;
+
+					TaskItem();
+					TaskItem(Ptr<TaskCompletion> _completion, const Func<void()>& _proc);
+					~TaskItem();
+				};
+
+				class DelayItem : public Object, public INativeDelay
+				{
+				public:
+					DelayItem(HeadlessAsyncService* _service, const Func<void()>& _proc, bool _executeInMainThread, vint milliseconds);
+					~DelayItem();
+
+					HeadlessAsyncService*				service;
+					Func<void()>						proc;
+					ExecuteStatus						status;
+					vuint64_t							executeTime;
+					bool								executeInMainThread;
+
+					ExecuteStatus						GetStatus()override;
+					bool								Delay(vint milliseconds)override;
+					bool								Cancel()override;
+				};
+			protected:
+				vint									mainThreadId;
+				SpinLock								taskListLock;
+				collections::List<TaskItem>				taskItems;
+				collections::List<Ptr<DelayItem>>		delayItems;
+				vuint64_t								virtualTime;
+			public:
+				HeadlessAsyncService();
+				~HeadlessAsyncService();
+
+				/// <summary>Get the current virtual time in milliseconds.</summary>
+				/// <returns>The current virtual time.</returns>
+				vuint64_t								GetVirtualTime();
+				/// <summary>Move the virtual clock forward. Delayed tasks that become due are executed in the next <see cref="ExecuteAsyncTasks"/>.</summary>
+				/// <param name="time">The new virtual time in milliseconds, which cannot be earlier than the current virtual time.</param>
+				void									SetVirtualTime(vuint64_t time);
+				/// <summary>Get the virtual time when the earliest pending delayed task becomes due.</summary>
+				/// <returns>Returns false if there is no pending delayed task.</returns>
+				/// <param name="time">The virtual time of the earliest pending delayed task.</param>
+				bool									GetNextDelayTime(vuint64_t& time);
+
+				void									ExecuteAsyncTasks();
+				bool									IsInMainThread()override;
+				void									InvokeAsync(const Func<void()>& proc)override;
+				void									InvokeInMainThread(INativeWindow* window, const Func<void()>& proc)override;
+				bool									InvokeInMainThreadAndWait(INativeWindow* window, const Func<void()>& proc, vint milliseconds)override;
+				Ptr<INativeDelay>						DelayExecute(const Func<void()>& proc, vint milliseconds)override;
+				Ptr<INativeDelay>						DelayExecuteInMainThread(const Func<void()>& proc, vint milliseconds)override;
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,117 @@
+#include "HeadlessCallbackService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+
+/***********************************************************************
+HeadlessCallbackService
+***********************************************************************/
+
+			HeadlessCallbackService::HeadlessCallbackService()
+			{
+			}
+
+			bool HeadlessCallbackService::InstallListener(INativeControllerListener* listener)
+			{
+				if(listeners.Contains(listener))
+				{
+					return false;
+				}
+				else
+				{
+					listeners.Add(listener);
+					return true;
+				}
+			}
+
+			bool HeadlessCallbackService::UninstallListener(INativeControllerListener* listener)
+			{
+				if(listeners.Contains(listener))
+				{
+					listeners.Remove(listener);
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			void HeadlessCallbackService::InvokeLeftButtonDown(Point location)
+			{
+				for(vint i=0;i<listeners.Count();i++)
+				{
+					listeners[i]->LeftButtonDown(location);
+				}
+			}
+
+			void HeadlessCallbackService::InvokeLeftButtonUp(Point location)
+			{
+				for(vint i=0;i<listeners.Count();i++)
+				{
+					listeners[i]->LeftButtonUp(location);
+				}
+			}
+
+			void HeadlessCallbackService::InvokeRightButtonDown(Point location)
+			{
+				for(vint i=0;i<listeners.Count();i++)
+				{
+					listeners[i]->RightButtonDown(location);
+				}
+			}
+
+			void HeadlessCallbackService::InvokeRightButtonUp(Point location)
+			{
+				for(vint i=0;i<listeners.Count();i++)
+				{
+					listeners[i]->RightButtonUp(location);
+				}
+			}
+
+			void HeadlessCallbackService::InvokeMouseMoving(Point location)
+			{
+				for(vint i=0;i<listeners.Count();i++)
+				{
+					listeners[i]->MouseMoving(location);
+				}
+			}
+
+			void HeadlessCallbackService::InvokeGlobalTimer()
+			{
+				for(vint i=0;i<listeners.Count();i++)
+				{
+					listeners[i]->GlobalTimer();
+				}
+			}
+
+			void HeadlessCallbackService::InvokeClipboardUpdated()
+			{
+				for(vint i=0;i<listeners.Count();i++)
+				{
+					listeners[i]->ClipboardUpdated();
+				}
+			}
+
+			void HeadlessCallbackService::InvokeNativeWindowCreated(INativeWindow* window)
+			{
+				for(vint i=0;i<listeners.Count();i++)
+				{
+					listeners[i]->NativeWindowCreated(window);
+				}
+			}
+
+			void HeadlessCallbackService::InvokeNativeWindowDestroyed(INativeWindow* window)
+			{
+				for(vint i=0;i<listeners.Count();i++)
+				{
+					listeners[i]->NativeWindowDestroying(window);
+				}
+			}
+		}
+	}
+}
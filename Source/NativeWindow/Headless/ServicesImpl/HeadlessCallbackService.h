@@ -0,0 +1,45 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSCALLBACKSERVICE
+#define VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSCALLBACKSERVICE
+
+#include "../../GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			class HeadlessCallbackService : public Object, public INativeCallbackService
+			{
+			protected:
+				collections::List<INativeControllerListener*>	listeners;
+
+			public:
+				HeadlessCallbackService();
+
+				bool											InstallListener(INativeControllerListener* listener)override;
+				bool											UninstallListener(INativeControllerListener* listener)override;
+
+				void											InvokeLeftButtonDown(Point location);
+				void											InvokeLeftButtonUp(Point location);
+				void											InvokeRightButtonDown(Point location);
+				void											InvokeRightButtonUp(Point location);
+				void											InvokeMouseMoving(Point location);
+				void											InvokeGlobalTimer();
+				void											InvokeClipboardUpdated();
+				void											InvokeNativeWindowCreated(INativeWindow* window);
+				void											InvokeNativeWindowDestroyed(INativeWindow* window);
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,39 @@
+#include "HeadlessClipboardService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+
+/***********************************************************************
+HeadlessClipboardService
+***********************************************************************/
+
+			HeadlessClipboardService::HeadlessClipboardService(HeadlessCallbackService* _callbackService)
+				:callbackService(_callbackService)
+				,containsText(false)
+			{
+			}
+
+			bool HeadlessClipboardService::ContainsText()
+			{
+				return containsText;
+			}
+
+			WString HeadlessClipboardService::GetText()
+			{
+				return text;
+			}
+
+			bool HeadlessClipboardService::SetText(const WString& value)
+			{
+				containsText=true;
+				text=value;
+				callbackService->InvokeClipboardUpdated();
+				return true;
+			}
+		}
+	}
+}
@@ -0,0 +1,37 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSCLIPBOARDSERVICE
+#define VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSCLIPBOARDSERVICE
+
+#include "HeadlessCallbackService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			class HeadlessClipboardService : public Object, public INativeClipboardService
+			{
+			protected:
+				HeadlessCallbackService*	callbackService;
+				bool						containsText;
+				WString						text;
+			public:
+				HeadlessClipboardService(HeadlessCallbackService* _callbackService);
+
+				bool						ContainsText()override;
+				WString						GetText()override;
+				bool						SetText(const WString& value)override;
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "HeadlessDialogService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			using namespace collections;
+
+/***********************************************************************
+HeadlessDialogService
+***********************************************************************/
+
+			HeadlessDialogService::HeadlessDialogService()
+			{
+			}
+
+			INativeDialogService::MessageBoxButtonsOutput HeadlessDialogService::ShowMessageBox(
+				INativeWindow* window,
+				const WString& text,
+				const WString& title,
+				MessageBoxButtonsInput buttons,
+				MessageBoxDefaultButton defaultButton,
+				MessageBoxIcons icon,
+				MessageBoxModalOptions modal)
+			{
+				MessageBoxButtonsOutput outputs[3]={SelectOK, SelectOK, SelectOK};
+				vint count=1;
+
+#define MAP(A, B, C, D, N) case A: outputs[0]=B; outputs[1]=C; outputs[2]=D; count=N; break
+				switch(buttons)
+				{
+					MAP(DisplayOK, SelectOK, SelectOK, SelectOK, 1);
+					MAP(DisplayOKCancel, SelectOK, SelectCancel, SelectOK, 2);
+					MAP(DisplayYesNo, SelectYes, SelectNo, SelectOK, 2);
+					MAP(DisplayYesNoCancel, SelectYes, SelectNo, SelectCancel, 3);
+					MAP(DisplayRetryCancel, SelectRetry, SelectCancel, SelectOK, 2);
+					MAP(DisplayAbortRetryIgnore, SelectAbort, SelectRetry, SelectIgnore, 3);
+					MAP(DisplayCancelTryAgainContinue, SelectCancel, SelectTryAgain, SelectContinue, 3);
+				}
+#undef MAP
+
+				vint index=0;
+				switch(defaultButton)
+				{
+				case DefaultFirst:
+					index=0;
+					break;
+				case DefaultSecond:
+					index=1;
+					break;
+				case DefaultThird:
+					index=2;
+					break;
+				}
+				return outputs[index<count?index:0];
+			}
+
+			bool HeadlessDialogService::ShowColorDialog(INativeWindow* window, Color& selection, bool selected, ColorDialogCustomColorOptions customColorOptions, Color* customColors)
+			{
+				return false;
+			}
+
+			bool HeadlessDialogService::ShowFontDialog(INativeWindow* window, FontProperties& selectionFont, Color& selectionColor, bool selected, bool showEffect, bool forceFontExist)
+			{
+				return false;
+			}
+
+			bool HeadlessDialogService::ShowFileDialog(INativeWindow* window, collections::List<WString>& selectionFileNames, vint& selectionFilterIndex, FileDialogTypes dialogType, const WString& title, const WString& initialFileName, const WString& initialDirectory, const WString& defaultExtension, const WString& filter, FileDialogOptions options)
+			{
+				return false;
+			}
+		}
+	}
+}
@@ -0,0 +1,37 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSDIALOGSERVICE
+#define VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSDIALOGSERVICE
+
+#include "../../GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			/// <summary>
+			/// A dialog service that never blocks. A message box is answered with its default button, and all other dialogs are canceled.
+			/// </summary>
+			class HeadlessDialogService : public INativeDialogService
+			{
+			public:
+				HeadlessDialogService();
+
+				MessageBoxButtonsOutput			ShowMessageBox(INativeWindow* window, const WString& text, const WString& title, MessageBoxButtonsInput buttons, MessageBoxDefaultButton defaultButton, MessageBoxIcons icon, MessageBoxModalOptions modal)override;
+				bool							ShowColorDialog(INativeWindow* window, Color& selection, bool selected, ColorDialogCustomColorOptions customColorOptions, Color* customColors)override;
+				bool							ShowFontDialog(INativeWindow* window, FontProperties& selectionFont, Color& selectionColor, bool selected, bool showEffect, bool forceFontExist)override;
+				bool							ShowFileDialog(INativeWindow* window, collections::List<WString>& selectionFileNames, vint& selectionFilterIndex, FileDialogTypes dialogType, const WString& title, const WString& initialFileName, const WString& initialDirectory, const WString& defaultExtension, const WString& filter, FileDialogOptions options)override;
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,237 @@
+#include "HeadlessImageService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			using namespace collections;
+
+/***********************************************************************
+Image Header Parsing
+***********************************************************************/
+
+			vint ReadBigEndian(const vuint8_t* data, vint bytes)
+			{
+				vint result=0;
+				for(vint i=0;i<bytes;i++)
+				{
+					result=(result<<8)|data[i];
+				}
+				return result;
+			}
+
+			vint ReadLittleEndian(const vuint8_t* data, vint bytes)
+			{
+				vint result=0;
+				for(vint i=bytes-1;i>=0;i--)
+				{
+					result=(result<<8)|data[i];
+				}
+				return result;
+			}
+
+			bool ReadImageHeader(const vuint8_t* data, vint length, INativeImage::FormatType& format, Size& size)
+			{
+				if(length>=24 && data[0]==0x89 && data[1]=='P' && data[2]=='N' && data[3]=='G')
+				{
+					format=INativeImage::Png;
+					size=Size(ReadBigEndian(data+16, 4), ReadBigEndian(data+20, 4));
+					return true;
+				}
+				if(length>=10 && data[0]=='G' && data[1]=='I' && data[2]=='F')
+				{
+					format=INativeImage::Gif;
+					size=Size(ReadLittleEndian(data+6, 2), ReadLittleEndian(data+8, 2));
+					return true;
+				}
+				if(length>=26 && data[0]=='B' && data[1]=='M')
+				{
+					format=INativeImage::Bmp;
+					vint width=(vint)(vint32_t)ReadLittleEndian(data+18, 4);
+					vint height=(vint)(vint32_t)ReadLittleEndian(data+22, 4);
+					size=Size(width<0?-width:width, height<0?-height:height);
+					return true;
+				}
+				if(length>=4 && data[0]==0xFF && data[1]==0xD8)
+				{
+					// walk through JPEG segments until a start-of-frame marker is found
+					vint offset=2;
+					while(offset+9<length)
+					{
+						if(data[offset]!=0xFF)
+						{
+							return false;
+						}
+						vuint8_t marker=data[offset+1];
+						bool startOfFrame=0xC0<=marker && marker<=0xCF && marker!=0xC4 && marker!=0xC8 && marker!=0xCC;
+						if(startOfFrame)
+						{
+							format=INativeImage::Jpeg;
+							size=Size(ReadBigEndian(data+offset+7, 2), ReadBigEndian(data+offset+5, 2));
+							return true;
+						}
+						offset+=2+ReadBigEndian(data+offset+2, 2);
+					}
+				}
+				return false;
+			}
+
+/***********************************************************************
+HeadlessImageFrame
+***********************************************************************/
+
+			HeadlessImageFrame::HeadlessImageFrame(INativeImage* _image, Size _size)
+				:image(_image)
+				,size(_size)
+			{
+			}
+
+			HeadlessImageFrame::~HeadlessImageFrame()
+			{
+				for(vint i=0;i<caches.Count();i++)
+				{
+					caches.Values().Get(i)->OnDetach(this);
+				}
+			}
+
+			INativeImage* HeadlessImageFrame::GetImage()
+			{
+				return image;
+			}
+
+			Size HeadlessImageFrame::GetSize()
+			{
+				return size;
+			}
+
+			bool HeadlessImageFrame::SetCache(void* key, Ptr<INativeImageFrameCache> cache)
+			{
+				vint index=caches.Keys().IndexOf(key);
+				if(index!=-1)
+				{
+					return false;
+				}
+				caches.Add(key, cache);
+				cache->OnAttach(this);
+				return true;
+			}
+
+			Ptr<INativeImageFrameCache> HeadlessImageFrame::GetCache(void* key)
+			{
+				vint index=caches.Keys().IndexOf(key);
+				return index==-1?nullptr:caches.Values().Get(index);
+			}
+
+			Ptr<INativeImageFrameCache> HeadlessImageFrame::RemoveCache(void* key)
+			{
+				vint index=caches.Keys().IndexOf(key);
+				if(index==-1)
+				{
+					return 0;
+				}
+				Ptr<INativeImageFrameCache> cache=caches.Values().Get(index);
+				cache->OnDetach(this);
+				caches.Remove(key);
+				return cache;
+			}
+
+/***********************************************************************
+HeadlessImage
+***********************************************************************/
+
+			HeadlessImage::HeadlessImage(INativeImageService* _imageService, FormatType _formatType, Size _size, collections::Array<vuint8_t>& _data)
+				:imageService(_imageService)
+				,formatType(_formatType)
+			{
+				CopyFrom(data, _data);
+				frame=new HeadlessImageFrame(this, _size);
+			}
+
+			HeadlessImage::~HeadlessImage()
+			{
+			}
+
+			const collections::Array<vuint8_t>& HeadlessImage::GetData()
+			{
+				return data;
+			}
+
+			INativeImageService* HeadlessImage::GetImageService()
+			{
+				return imageService;
+			}
+
+			INativeImage::FormatType HeadlessImage::GetFormat()
+			{
+				return formatType;
+			}
+
+			vint HeadlessImage::GetFrameCount()
+			{
+				return 1;
+			}
+
+			INativeImageFrame* HeadlessImage::GetFrame(vint index)
+			{
+				return index==0?frame.Obj():0;
+			}
+
+/***********************************************************************
+HeadlessImageService
+***********************************************************************/
+
+			HeadlessImageService::HeadlessImageService()
+			{
+			}
+
+			HeadlessImageService::~HeadlessImageService()
+			{
+			}
+
+			Ptr<INativeImage> HeadlessImageService::CreateImageFromFile(const WString& path)
+			{
+				stream::FileStream fileStream(path, stream::FileStream::ReadOnly);
+				if(!fileStream.IsAvailable())
+				{
+					return 0;
+				}
+				return CreateImageFromStream(fileStream);
+			}
+
+			Ptr<INativeImage> HeadlessImageService::CreateImageFromMemory(void* buffer, vint length)
+			{
+				INativeImage::FormatType format=INativeImage::Unknown;
+				Size size;
+				if(!ReadImageHeader((const vuint8_t*)buffer, length, format, size))
+				{
+					return 0;
+				}
+
+				Array<vuint8_t> data(length);
+				if(length>0)
+				{
+					memcpy(&data[0], buffer, length);
+				}
+				return new HeadlessImage(this, format, size, data);
+			}
+
+			Ptr<INativeImage> HeadlessImageService::CreateImageFromStream(stream::IStream& stream)
+			{
+				stream::MemoryStream memoryStream;
+				char buffer[65536];
+				while(true)
+				{
+					vint length=stream.Read(buffer, sizeof(buffer));
+					memoryStream.Write(buffer, length);
+					if(length!=sizeof(buffer))
+					{
+						break;
+					}
+				}
+				return CreateImageFromMemory(memoryStream.GetInternalBuffer(), (vint)memoryStream.Size());
+			}
+		}
+	}
+}
@@ -0,0 +1,77 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSIMAGESERVICE
+#define VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSIMAGESERVICE
+
+#include "../../GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			class HeadlessImageFrame : public Object, public INativeImageFrame
+			{
+			protected:
+				INativeImage*													image;
+				Size															size;
+				collections::Dictionary<void*, Ptr<INativeImageFrameCache>>		caches;
+			public:
+				HeadlessImageFrame(INativeImage* _image, Size _size);
+				~HeadlessImageFrame();
+
+				INativeImage*								GetImage()override;
+				Size										GetSize()override;
+				bool										SetCache(void* key, Ptr<INativeImageFrameCache> cache)override;
+				Ptr<INativeImageFrameCache>					GetCache(void* key)override;
+				Ptr<INativeImageFrameCache>					RemoveCache(void* key)override;
+			};
+
+			/// <summary>
+			/// An image that only knows its format and size.
+			/// Pixels are never decoded, but the original file content is kept so that a software renderer can decode it on demand.
+			/// </summary>
+			class HeadlessImage : public Object, public INativeImage
+			{
+			protected:
+				INativeImageService*						imageService;
+				FormatType									formatType;
+				collections::Array<vuint8_t>				data;
+				Ptr<HeadlessImageFrame>						frame;
+			public:
+				HeadlessImage(INativeImageService* _imageService, FormatType _formatType, Size _size, collections::Array<vuint8_t>& _data);
+				~HeadlessImage();
+
+				/// <summary>Get the original file content of this image.</summary>
+				/// <returns>The original file content.</returns>
+				const collections::Array<vuint8_t>&			GetData();
+
+				INativeImageService*						GetImageService()override;
+				FormatType									GetFormat()override;
+				vint										GetFrameCount()override;
+				INativeImageFrame*							GetFrame(vint index)override;
+			};
+
+			/// <summary>An image service that reads the format and the size from the header of BMP, GIF, JPEG and PNG files.</summary>
+			class HeadlessImageService : public Object, public INativeImageService
+			{
+			public:
+				HeadlessImageService();
+				~HeadlessImageService();
+
+				Ptr<INativeImage>							CreateImageFromFile(const WString& path)override;
+				Ptr<INativeImage>							CreateImageFromMemory(void* buffer, vint length)override;
+				Ptr<INativeImage>							CreateImageFromStream(stream::IStream& stream)override;
+			};
+		}
+	}
+}
+
+#endif
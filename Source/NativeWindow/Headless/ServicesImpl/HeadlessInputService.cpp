@@ -0,0 +1,171 @@
+#include "HeadlessInputService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+
+/***********************************************************************
+HeadlessInputService
+***********************************************************************/
+
+			WString HeadlessInputService::GetKeyNameInternal(vint code)
+			{
+				if((VKEY_0<=code && code<=VKEY_9) || (VKEY_A<=code && code<=VKEY_Z))
+				{
+					wchar_t name[]={(wchar_t)code, 0};
+					return name;
+				}
+				if(VKEY_F1<=code && code<=VKEY_F24)
+				{
+					return L"F"+itow(code-VKEY_F1+1);
+				}
+				if(VKEY_NUMPAD0<=code && code<=VKEY_NUMPAD9)
+				{
+					return L"Num "+itow(code-VKEY_NUMPAD0);
+				}
+				switch(code)
+				{
+				case VKEY_BACK:			return L"Backspace";
+				case VKEY_TAB:			return L"Tab";
+				case VKEY_RETURN:		return L"Enter";
+				case VKEY_SHIFT:		return L"Shift";
+				case VKEY_CONTROL:		return L"Ctrl";
+				case VKEY_MENU:			return L"Alt";
+				case VKEY_PAUSE:		return L"Pause";
+				case VKEY_CAPITAL:		return L"Caps Lock";
+				case VKEY_ESCAPE:		return L"Esc";
+				case VKEY_SPACE:		return L"Space";
+				case VKEY_PRIOR:		return L"Page Up";
+				case VKEY_NEXT:			return L"Page Down";
+				case VKEY_END:			return L"End";
+				case VKEY_HOME:			return L"Home";
+				case VKEY_LEFT:			return L"Left";
+				case VKEY_UP:			return L"Up";
+				case VKEY_RIGHT:		return L"Right";
+				case VKEY_DOWN:			return L"Down";
+				case VKEY_SNAPSHOT:		return L"Sys Req";
+				case VKEY_INSERT:		return L"Insert";
+				case VKEY_DELETE:		return L"Delete";
+				case VKEY_APPS:			return L"Application";
+				case VKEY_MULTIPLY:		return L"Num *";
+				case VKEY_ADD:			return L"Num +";
+				case VKEY_SUBTRACT:		return L"Num -";
+				case VKEY_DECIMAL:		return L"Num Del";
+				case VKEY_DIVIDE:		return L"Num /";
+				case VKEY_NUMLOCK:		return L"Num Lock";
+				case VKEY_SCROLL:		return L"Scroll Lock";
+				case VKEY_OEM_1:		return L";";
+				case VKEY_OEM_PLUS:		return L"=";
+				case VKEY_OEM_COMMA:	return L",";
+				case VKEY_OEM_MINUS:	return L"-";
+				case VKEY_OEM_PERIOD:	return L".";
+				case VKEY_OEM_2:		return L"/";
+				case VKEY_OEM_3:		return L"`";
+				case VKEY_OEM_4:		return L"[";
+				case VKEY_OEM_5:		return L"\\";
+				case VKEY_OEM_6:		return L"]";
+				case VKEY_OEM_7:		return L"'";
+				}
+				return L"?";
+			}
+
+			void HeadlessInputService::InitializeKeyNames()
+			{
+				for (vint i = 0; i < keyNames.Count(); i++)
+				{
+					keyNames[i] = GetKeyNameInternal(i);
+					if (keyNames[i] != L"?")
+					{
+						keys.Set(keyNames[i], i);
+					}
+				}
+			}
+
+			HeadlessInputService::HeadlessInputService()
+				:isHookingMouse(false)
+				,isTimerEnabled(false)
+				,keyNames(KeyCount)
+			{
+				for(vint i=0;i<KeyCount;i++)
+				{
+					pressingKeys[i]=false;
+					toggledKeys[i]=false;
+				}
+				InitializeKeyNames();
+			}
+
+			void HeadlessInputService::SetKeyPressing(vint code, bool pressing)
+			{
+				if(0<=code && code<KeyCount)
+				{
+					if(pressing && !pressingKeys[code])
+					{
+						toggledKeys[code]=!toggledKeys[code];
+					}
+					pressingKeys[code]=pressing;
+				}
+			}
+
+			void HeadlessInputService::StartHookMouse()
+			{
+				isHookingMouse=true;
+			}
+
+			void HeadlessInputService::StopHookMouse()
+			{
+				isHookingMouse=false;
+			}
+
+			bool HeadlessInputService::IsHookingMouse()
+			{
+				return isHookingMouse;
+			}
+
+			void HeadlessInputService::StartTimer()
+			{
+				isTimerEnabled=true;
+			}
+
+			void HeadlessInputService::StopTimer()
+			{
+				isTimerEnabled=false;
+			}
+
+			bool HeadlessInputService::IsTimerEnabled()
+			{
+				return isTimerEnabled;
+			}
+
+			bool HeadlessInputService::IsKeyPressing(vint code)
+			{
+				return 0<=code && code<KeyCount && pressingKeys[code];
+			}
+
+			bool HeadlessInputService::IsKeyToggled(vint code)
+			{
+				return 0<=code && code<KeyCount && toggledKeys[code];
+			}
+
+			WString HeadlessInputService::GetKeyName(vint code)
+			{
+				if (0 <= code && code < keyNames.Count())
+				{
+					return keyNames[code];
+				}
+				else
+				{
+					return L"?";
+				}
+			}
+
+			vint HeadlessInputService::GetKey(const WString& name)
+			{
+				vint index = keys.Keys().IndexOf(name);
+				return index == -1 ? -1 : keys.Values()[index];
+			}
+		}
+	}
+}
@@ -0,0 +1,58 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSINPUTSERVICE
+#define VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSINPUTSERVICE
+
+#include "../../GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			/// <summary>An input service whose key states are only changed by injected input.</summary>
+			class HeadlessInputService : public Object, public INativeInputService
+			{
+			public:
+				static const vint							KeyCount = 256;
+			protected:
+				bool										isHookingMouse;
+				bool										isTimerEnabled;
+				bool										pressingKeys[KeyCount];
+				bool										toggledKeys[KeyCount];
+				collections::Array<WString>					keyNames;
+				collections::Dictionary<WString, vint>		keys;
+
+				WString										GetKeyNameInternal(vint code);
+				void										InitializeKeyNames();
+			public:
+				HeadlessInputService();
+
+				/// <summary>Update the state of a key. Pressing a key flips its toggled state.</summary>
+				/// <param name="code">The key code.</param>
+				/// <param name="pressing">Set to true if the key is pressed.</param>
+				void										SetKeyPressing(vint code, bool pressing);
+
+				void										StartHookMouse()override;
+				void										StopHookMouse()override;
+				bool										IsHookingMouse()override;
+				void										StartTimer()override;
+				void										StopTimer()override;
+				bool										IsTimerEnabled()override;
+				bool										IsKeyPressing(vint code)override;
+				bool										IsKeyToggled(vint code)override;
+				WString										GetKeyName(vint code)override;
+				vint										GetKey(const WString& name)override;
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include "HeadlessResourceService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+
+/***********************************************************************
+HeadlessCursor
+***********************************************************************/
+
+			HeadlessCursor::HeadlessCursor(SystemCursorType type)
+				:systemCursorType(type)
+			{
+			}
+
+			bool HeadlessCursor::IsSystemCursor()
+			{
+				return true;
+			}
+
+			INativeCursor::SystemCursorType HeadlessCursor::GetSystemCursorType()
+			{
+				return systemCursorType;
+			}
+
+/***********************************************************************
+HeadlessResourceService
+***********************************************************************/
+
+			HeadlessResourceService::HeadlessResourceService()
+			{
+				systemCursors.Resize(INativeCursor::SystemCursorCount);
+				for(vint i=0;i<systemCursors.Count();i++)
+				{
+					systemCursors[i]=new HeadlessCursor((INativeCursor::SystemCursorType)i);
+				}
+
+				defaultFont.fontFamily=L"Headless";
+				defaultFont.size=12;
+			}
+
+			INativeCursor* HeadlessResourceService::GetSystemCursor(INativeCursor::SystemCursorType type)
+			{
+				vint index=(vint)type;
+				if(0<=index && index<systemCursors.Count())
+				{
+					return systemCursors[index].Obj();
+				}
+				else
+				{
+					return 0;
+				}
+			}
+
+			INativeCursor* HeadlessResourceService::GetDefaultSystemCursor()
+			{
+				return GetSystemCursor(INativeCursor::Arrow);
+			}
+
+			FontProperties HeadlessResourceService::GetDefaultFont()
+			{
+				return defaultFont;
+			}
+
+			void HeadlessResourceService::SetDefaultFont(const FontProperties& value)
+			{
+				defaultFont=value;
+			}
+		}
+	}
+}
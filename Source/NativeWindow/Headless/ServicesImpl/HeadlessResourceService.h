@@ -0,0 +1,48 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSRESOURCESERVICE
+#define VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSRESOURCESERVICE
+
+#include "../../GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			class HeadlessCursor : public Object, public INativeCursor
+			{
+			protected:
+				SystemCursorType							systemCursorType;
+			public:
+				HeadlessCursor(SystemCursorType type);
+
+				bool										IsSystemCursor()override;
+				SystemCursorType							GetSystemCursorType()override;
+			};
+
+			class HeadlessResourceService : public Object, public INativeResourceService
+			{
+			protected:
+				collections::Array<Ptr<HeadlessCursor>>		systemCursors;
+				FontProperties								defaultFont;
+			public:
+				HeadlessResourceService();
+
+				INativeCursor*								GetSystemCursor(INativeCursor::SystemCursorType type)override;
+				INativeCursor*								GetDefaultSystemCursor()override;
+				FontProperties								GetDefaultFont()override;
+				void										SetDefaultFont(const FontProperties& value)override;
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,69 @@
+#include "HeadlessScreenService.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+
+/***********************************************************************
+HeadlessScreen
+***********************************************************************/
+
+			HeadlessScreen::HeadlessScreen(Rect _bounds)
+				:bounds(_bounds)
+			{
+			}
+
+			Rect HeadlessScreen::GetBounds()
+			{
+				return bounds;
+			}
+
+			Rect HeadlessScreen::GetClientBounds()
+			{
+				return bounds;
+			}
+
+			WString HeadlessScreen::GetName()
+			{
+				return L"Headless";
+			}
+
+			bool HeadlessScreen::IsPrimary()
+			{
+				return true;
+			}
+
+/***********************************************************************
+HeadlessScreenService
+***********************************************************************/
+
+			HeadlessScreenService::HeadlessScreenService()
+			{
+				screen=new HeadlessScreen(Rect(0, 0, 1920, 1080));
+			}
+
+			void HeadlessScreenService::SetScreenSize(Size size)
+			{
+				screen->bounds=Rect(Point(0, 0), size);
+			}
+
+			vint HeadlessScreenService::GetScreenCount()
+			{
+				return 1;
+			}
+
+			INativeScreen* HeadlessScreenService::GetScreen(vint index)
+			{
+				return index==0?screen.Obj():0;
+			}
+
+			INativeScreen* HeadlessScreenService::GetScreen(INativeWindow* window)
+			{
+				return window?screen.Obj():0;
+			}
+		}
+	}
+}
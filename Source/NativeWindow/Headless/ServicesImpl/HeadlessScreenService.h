@@ -0,0 +1,53 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Native Window::Headless Implementation
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSSCREENSERVICE
+#define VCZH_PRESENTATION_HEADLESS_SERVICESIMPL_HEADLESSSCREENSERVICE
+
+#include "../../GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace headless
+		{
+			class HeadlessScreen : public Object, public INativeScreen
+			{
+				friend class HeadlessScreenService;
+			protected:
+				Rect											bounds;
+			public:
+				HeadlessScreen(Rect _bounds);
+
+				Rect											GetBounds()override;
+				Rect											GetClientBounds()override;
+				WString											GetName()override;
+				bool											IsPrimary()override;
+			};
+
+			/// <summary>A screen service that exposes a single virtual screen.</summary>
+			class HeadlessScreenService : public Object, public INativeScreenService
+			{
+			protected:
+				Ptr<HeadlessScreen>								screen;
+			public:
+				HeadlessScreenService();
+
+				/// <summary>Resize the virtual screen.</summary>
+				/// <param name="size">The new size of the virtual screen.</param>
+				void											SetScreenSize(Size size);
+				vint											GetScreenCount()override;
+				INativeScreen*									GetScreen(vint index)override;
+				INativeScreen*									GetScreen(INativeWindow* window)override;
+			};
+		}
+	}
+}
+
+#endif
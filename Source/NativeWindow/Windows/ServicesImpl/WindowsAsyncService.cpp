@@ -51,15 +51,20 @@ WindowsAsyncService::DelayItem
 
 			bool WindowsAsyncService::DelayItem::Delay(vint milliseconds)
 			{
+				bool delayed=false;
 				SPIN_LOCK(service->taskListLock)
 				{
 					if(status==INativeDelay::Pending)
 					{
 						executeTime=DateTime::LocalTime().Forward(milliseconds);
-						return true;
+						delayed=true;
 					}
 				}
-				return false;
+				if(delayed)
+				{
+					service->WakeMainThread();
+				}
+				return delayed;
 			}
 
 			bool WindowsAsyncService::DelayItem::Cancel()
@@ -89,6 +94,59 @@ WindowsAsyncService
 
 			WindowsAsyncService::~WindowsAsyncService()
 			{
+				SetOwnerHandle(NULL);
+			}
+
+			void WindowsAsyncService::SetOwnerHandle(HWND handle)
+			{
+				if(delayTimer)
+				{
+					KillTimer(ownerHandle, DelayTimerId);
+					delayTimer=false;
+				}
+				ownerHandle=handle;
+			}
+
+			void WindowsAsyncService::WakeMainThread()
+			{
+				// the main thread runs ExecuteAsyncTasks after each message, so it only needs to be woken from other threads
+				// a message to the hidden owner window is not lost in modal message loops, which drop thread messages
+				if(!IsInMainThread() && ownerHandle)
+				{
+					PostMessage(ownerHandle, WakeMessage, 0, 0);
+				}
+			}
+
+			void WindowsAsyncService::UpdateDelayTimer()
+			{
+				// a timer of the hidden owner window wakes the message loop when the earliest delayed task is due, so delayed tasks do not rely on the global timer
+				bool pending=false;
+				vuint64_t time=0;
+				SPIN_LOCK(taskListLock)
+				{
+					FOREACH(Ptr<DelayItem>, item, delayItems)
+					{
+						if(!pending || item->executeTime.filetime<time)
+						{
+							pending=true;
+							time=item->executeTime.filetime;
+						}
+					}
+				}
+
+				if(!ownerHandle) return;
+				vuint64_t now=DateTime::LocalTime().filetime;
+				if(delayTimer && (!pending || delayTimerTime!=time || now>=time))
+				{
+					KillTimer(ownerHandle, DelayTimerId);
+					delayTimer=false;
+				}
+				if(pending && !delayTimer)
+				{
+					vuint64_t milliseconds=time>now?(time-now+9999)/10000:0;
+					delayTimer=SetTimer(ownerHandle, DelayTimerId, (UINT)milliseconds, NULL)!=0;
+					delayTimerTime=time;
+				}
 			}
 
 			void WindowsAsyncService::ExecuteAsyncTasks()
@@ -137,6 +195,7 @@ WindowsAsyncService
 						});
 					}
 				}
+				UpdateDelayTimer();
 			}
 
 			bool WindowsAsyncService::IsInMainThread()
@@ -156,6 +215,7 @@ WindowsAsyncService
 					TaskItem item(0, proc);
 					taskItems.Add(item);
 				}
+				WakeMainThread();
 			}
 
 			bool WindowsAsyncService::InvokeInMainThreadAndWait(INativeWindow* window, const Func<void()>& proc, vint milliseconds)
@@ -168,6 +228,7 @@ WindowsAsyncService
 					TaskItem item(&semaphore, proc);
 					taskItems.Add(item);
 				}
+				WakeMainThread();
 
 				if(milliseconds<0)
 				{
@@ -187,6 +248,7 @@ WindowsAsyncService
 					delay=new DelayItem(this, proc, false, milliseconds);
 					delayItems.Add(delay);
 				}
+				WakeMainThread();
 				return delay;
 			}
 
@@ -198,6 +260,7 @@ WindowsAsyncService
 					delay=new DelayItem(this, proc, true, milliseconds);
 					delayItems.Add(delay);
 				}
+				WakeMainThread();
 				return delay;
 			}
 		}
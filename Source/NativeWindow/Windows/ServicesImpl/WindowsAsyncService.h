@@ -10,6 +10,7 @@ Interfaces:
 #define VCZH_PRESENTATION_WINDOWS_SERVICESIMPL_WINDOWSASYNCSERVICE
 
 #include "..\..\GuiNativeWindow.h"
+#include <windows.h>
 
 namespace vl
 {
@@ -46,15 +47,26 @@ namespace vl
 					bool								Delay(vint milliseconds)override;
 					bool								Cancel()override;
 				};
+			public:
+				static const UINT						WakeMessage = WM_USER + 1;
+				static const UINT_PTR					DelayTimerId = 2;
+
 			protected:
 				vint									mainThreadId;
+				HWND									ownerHandle = NULL;
 				SpinLock								taskListLock;
 				collections::List<TaskItem>				taskItems;
 				collections::List<Ptr<DelayItem>>		delayItems;
+				bool									delayTimer = false;
+				vuint64_t								delayTimerTime = 0;
+
+				void									WakeMainThread();
+				void									UpdateDelayTimer();
 			public:
 				WindowsAsyncService();
 				~WindowsAsyncService();
 
+				void									SetOwnerHandle(HWND handle);
 				void									ExecuteAsyncTasks();
 				bool									IsInMainThread()override;
 				void									InvokeAsync(const Func<void()>& proc)override;
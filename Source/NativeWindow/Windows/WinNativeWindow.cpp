@@ -1331,6 +1331,7 @@ WindowsController
 					godWindow=CreateWindowEx(WS_EX_CONTROLPARENT, godClass.GetName().Buffer(), L"GodWindow", WS_OVERLAPPEDWINDOW, 0, 0, 0, 0, NULL, NULL, hInstance, NULL);
 					clipboardService.SetOwnerHandle(godWindow);
 					inputService.SetOwnerHandle(godWindow);
+					asyncService.SetOwnerHandle(godWindow);
 				}
 
 				~WindowsController()
@@ -1338,6 +1339,7 @@ WindowsController
 					inputService.StopTimer();
 					inputService.StopHookMouse();
 					clipboardService.SetOwnerHandle(NULL);
+					asyncService.SetOwnerHandle(NULL);
 					DestroyWindow(godWindow);
 				}
 
@@ -1521,6 +1523,11 @@ WindowsController
 				{
 					callbackService.InvokeClipboardUpdated();
 				}
+
+				void InvokeAsyncTasks()
+				{
+					asyncService.ExecuteAsyncTasks();
+				}
 			};
 
 /***********************************************************************
@@ -1549,7 +1556,17 @@ Windows Procedure
 					switch(uMsg)
 					{
 					case WM_TIMER:
-						controller->InvokeGlobalTimer();
+						if(wParam==WindowsAsyncService::DelayTimerId)
+						{
+							controller->InvokeAsyncTasks();
+						}
+						else
+						{
+							controller->InvokeGlobalTimer();
+						}
+						break;
+					case WindowsAsyncService::WakeMessage:
+						controller->InvokeAsyncTasks();
 						break;
 					case WM_CLIPBOARDUPDATE:
 						controller->InvokeClipboardUpdated();
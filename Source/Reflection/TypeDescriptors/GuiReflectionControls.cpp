@@ -389,6 +389,7 @@ Type Declaration
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(Arranger)
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(Axis)
 				CLASS_MEMBER_PROPERTY_FAST(DisplayItemBackground)
+				CLASS_MEMBER_PROPERTY_FAST(ItemTemplatePoolCapacity)
 
 				CLASS_MEMBER_METHOD(EnsureItemVisible, {L"itemIndex"})
 				CLASS_MEMBER_METHOD(GetAdoptedSize, {L"expectedSize"})
@@ -486,6 +487,11 @@ Type Declaration
 				CLASS_MEMBER_CONSTRUCTOR(Ptr<FixedHeightMultiColumnItemArranger>(), NO_PARAMETER)
 			END_CLASS_MEMBER(FixedHeightMultiColumnItemArranger)
 
+			BEGIN_CLASS_MEMBER(VariableHeightItemArranger)
+				CLASS_MEMBER_BASE(RangedItemArrangerBase)
+				CLASS_MEMBER_CONSTRUCTOR(Ptr<VariableHeightItemArranger>(), NO_PARAMETER)
+			END_CLASS_MEMBER(VariableHeightItemArranger)
+
 			BEGIN_INTERFACE_MEMBER(ITextItemView)
 				INTERFACE_IDENTIFIER(vl::presentation::controls::list::ITextItemView)
 
@@ -703,6 +709,7 @@ Type Declaration
 
 				CLASS_MEMBER_METHOD(CanGetNodeByVisibleIndex, NO_PARAMETER)
 				CLASS_MEMBER_METHOD(GetNodeByVisibleIndex, {L"index"})
+				CLASS_MEMBER_METHOD(GetVisibleIndexByNode, {L"node"})
 				CLASS_MEMBER_METHOD(AttachCallback, {L"value"})
 				CLASS_MEMBER_METHOD(DetachCallback, {L"value"})
 				CLASS_MEMBER_METHOD(GetTextValue, { L"node" })
@@ -945,6 +952,7 @@ Type Declaration
 			BEGIN_CLASS_MEMBER(GuiDocumentCommonInterface)
 				CLASS_MEMBER_PROPERTY_FAST(Document)
 				CLASS_MEMBER_PROPERTY_FAST(EditMode)
+				CLASS_MEMBER_PROPERTY_FAST(UndoMemoryBudget)
 
 				CLASS_MEMBER_GUIEVENT(ActiveHyperlinkChanged)
 				CLASS_MEMBER_GUIEVENT(ActiveHyperlinkExecuted)
@@ -1019,6 +1027,7 @@ Type Declaration
 				CLASS_MEMBER_GUIEVENT(UndoRedoChanged)
 				
 				CLASS_MEMBER_PROPERTY_FAST(Readonly)
+				CLASS_MEMBER_PROPERTY_FAST(UndoMemoryBudget)
 				CLASS_MEMBER_PROPERTY_EVENT_FAST(SelectionText, SelectionChanged)
 				CLASS_MEMBER_PROPERTY_EVENT_READONLY_FAST(CaretBegin, SelectionChanged)
 				CLASS_MEMBER_PROPERTY_EVENT_READONLY_FAST(CaretEnd, SelectionChanged)
@@ -1042,6 +1051,8 @@ Type Declaration
 				CLASS_MEMBER_METHOD(SetSelectionTextAsKeyInput, {L"value"})
 				CLASS_MEMBER_METHOD(GetRowText, {L"row"})
 				CLASS_MEMBER_METHOD(GetFragmentText, {L"start" _ L"end"})
+				CLASS_MEMBER_METHOD_OVERLOAD(Find, {L"pattern" _ L"caseSensitive" _ L"forward"}, bool(GuiTextBoxCommonInterface::*)(const WString& _ bool _ bool))
+				CLASS_MEMBER_METHOD_OVERLOAD(ReplaceAll, {L"pattern" _ L"caseSensitive" _ L"replacement"}, vint(GuiTextBoxCommonInterface::*)(const WString& _ bool _ const WString&))
 				CLASS_MEMBER_METHOD(GetRowWidth, {L"row"})
 				CLASS_MEMBER_METHOD(GetTextPosFromPoint, {L"point"})
 				CLASS_MEMBER_METHOD(GetPointFromTextPos, {L"pos"})
@@ -1329,6 +1340,7 @@ Type Declaration
 				CLASS_MEMBER_PROPERTY_READONLY_FAST(Columns)
 				CLASS_MEMBER_PROPERTY_FAST(ItemSource)
 				CLASS_MEMBER_PROPERTY_FAST(AdditionalFilter)
+				CLASS_MEMBER_PROPERTY_FAST(ParallelProcessing)
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(LargeImageProperty)
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(SmallImageProperty)
 				CLASS_MEMBER_PROPERTY_EVENT_READONLY_FAST(SelectedRowValue, SelectedCellChanged)
@@ -228,6 +228,7 @@ Type Declaration
 				CLASS_MEMBER_PROPERTY_READONLY_FAST(CaretEnd)
 				CLASS_MEMBER_PROPERTY_FAST(CaretVisible)
 				CLASS_MEMBER_PROPERTY_FAST(CaretColor)
+				CLASS_MEMBER_PROPERTY_FAST(ParagraphCacheCapacity)
 
 				CLASS_MEMBER_METHOD(IsCaretEndPreferFrontSide, NO_PARAMETER)
 				CLASS_MEMBER_METHOD(SetCaret, {L"begin" _ L"end" _ L"frontSide"})
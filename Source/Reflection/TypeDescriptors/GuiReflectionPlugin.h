@@ -285,6 +285,7 @@ Type List (Controls)
 			F(presentation::controls::list::FixedHeightItemArranger)\
 			F(presentation::controls::list::FixedSizeMultiColumnItemArranger)\
 			F(presentation::controls::list::FixedHeightMultiColumnItemArranger)\
+			F(presentation::controls::list::VariableHeightItemArranger)\
 			F(presentation::controls::list::ITextItemView)\
 			F(presentation::controls::list::TextItem)\
 			F(presentation::controls::TextListView)\
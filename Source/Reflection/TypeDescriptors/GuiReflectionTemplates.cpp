@@ -112,6 +112,11 @@ Type Declaration
 
 				CLASS_MEMBER_METHOD(AddSubscription, {L"subscription"})
 				CLASS_MEMBER_METHOD(UpdateSubscriptions, NO_PARAMETER)
+				CLASS_MEMBER_METHOD(AddPropertyBinding, {L"subscription" _ L"callback"})
+				CLASS_MEMBER_PROPERTY_FAST(BatchBindings)
+				CLASS_MEMBER_METHOD(BeginBindingBatch, NO_PARAMETER)
+				CLASS_MEMBER_METHOD(EndBindingBatch, NO_PARAMETER)
+				CLASS_MEMBER_METHOD(FlushBindings, NO_PARAMETER)
 				CLASS_MEMBER_METHOD(AddComponent, {L"component"})
 				CLASS_MEMBER_METHOD(AddControlHostComponent, {L"controlHost"})
 				CLASS_MEMBER_METHOD(AddAnimation, { L"animation" })
@@ -72,7 +72,14 @@ int wmain(int argc, wchar_t* argv[])
 int main()
 #endif
 {
-	int result = SetupWindowsDirect2DRenderer();
+#if defined VCZH_MSVC
+	// test cases that require the headless controller only run with "/Headless"
+	int result = argc > 1 && wcscmp(argv[1], L"/Headless") == 0
+		? SetupSoftwareRenderer()
+		: SetupWindowsDirect2DRenderer();
+#elif defined VCZH_GCC
+	int result = SetupSoftwareRenderer();
+#endif
 #if defined VCZH_MSVC && defined VCZH_CHECK_MEMORY_LEAKS
 	_CrtDumpMemoryLeaks();
 #endif
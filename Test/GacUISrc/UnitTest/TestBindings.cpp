@@ -0,0 +1,142 @@
+#include "TestHeadless.h"
+
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace headless_test;
+
+namespace headless_test
+{
+	class TestSubscription : public Object, public virtual IValueSubscription
+	{
+	public:
+		vint					value = 0;
+		vint					openCount = 0;
+
+		void Set(vint _value)
+		{
+			value = _value;
+			ValueChanged(BoxValue<vint>(value));
+		}
+
+		bool Open()override
+		{
+			openCount++;
+			return true;
+		}
+
+		bool Update()override
+		{
+			ValueChanged(BoxValue<vint>(value));
+			return true;
+		}
+
+		bool Close()override
+		{
+			return true;
+		}
+	};
+}
+
+TEST_HEADLESS_CASE(TestBindings_FlushOrder)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	List<WString> written;
+
+	auto dependentSubscription = MakePtr<TestSubscription>();
+	auto sourceSubscription = MakePtr<TestSubscription>();
+	TEST_ASSERT(window->AddPropertyBinding(dependentSubscription, [&](const Value& value)
+	{
+		written.Add(L"dependent:" + itow(UnboxValue<vint>(value)));
+	}));
+	TEST_ASSERT(window->AddPropertyBinding(sourceSubscription, [&](const Value& value)
+	{
+		vint source = UnboxValue<vint>(value);
+		written.Add(L"source:" + itow(source));
+		dependentSubscription->Set(source * 10);
+	}));
+
+	// the initial value of both bindings is written when they are added
+	TEST_ASSERT(written.Count() == 3);
+	TEST_ASSERT(written[0] == L"dependent:0");
+	TEST_ASSERT(written[1] == L"source:0");
+	TEST_ASSERT(written[2] == L"dependent:0");
+	written.Clear();
+
+	// without knowing the dependency, bindings are written in the installation order
+	// and the dependent binding is written again after the binding it depends on
+	window->BeginBindingBatch();
+	dependentSubscription->Set(1);
+	sourceSubscription->Set(2);
+	TEST_ASSERT(written.Count() == 0);
+	window->EndBindingBatch();
+	TEST_ASSERT(written.Count() == 3);
+	TEST_ASSERT(written[0] == L"dependent:1");
+	TEST_ASSERT(written[1] == L"source:2");
+	TEST_ASSERT(written[2] == L"dependent:20");
+	written.Clear();
+
+	// the dependency is remembered, so the dependent binding is written only once after the binding it depends on
+	window->BeginBindingBatch();
+	dependentSubscription->Set(3);
+	sourceSubscription->Set(4);
+	window->EndBindingBatch();
+	TEST_ASSERT(written.Count() == 2);
+	TEST_ASSERT(written[0] == L"source:4");
+	TEST_ASSERT(written[1] == L"dependent:40");
+	written.Clear();
+
+	// batched bindings are flushed by the timer of the window
+	window->SetBatchBindings(true);
+	sourceSubscription->Set(5);
+	TEST_ASSERT(written.Count() == 0);
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(written.Count() == 2);
+	TEST_ASSERT(written[0] == L"source:5");
+	TEST_ASSERT(written[1] == L"dependent:50");
+	window->SetBatchBindings(false);
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestBindings_DuplicateSuppression)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	List<vint> written;
+
+	auto subscription = MakePtr<TestSubscription>();
+	TEST_ASSERT(window->AddPropertyBinding(subscription, [&](const Value& value)
+	{
+		written.Add(UnboxValue<vint>(value));
+	}) == subscription);
+	TEST_ASSERT(subscription->openCount == 1);
+	TEST_ASSERT(written.Count() == 1);
+	written.Clear();
+
+	// a subscription that is already added is rejected without attaching another handler
+	TEST_ASSERT(!window->AddPropertyBinding(subscription, [&](const Value& value)
+	{
+		written.Add(-UnboxValue<vint>(value));
+	}));
+	TEST_ASSERT(!window->AddSubscription(subscription));
+	TEST_ASSERT(subscription->openCount == 1);
+	TEST_ASSERT(written.Count() == 0);
+
+	subscription->Set(1);
+	TEST_ASSERT(written.Count() == 1);
+	TEST_ASSERT(written[0] == 1);
+	written.Clear();
+
+	// multiple changes in a batch are written once with the latest value
+	window->BeginBindingBatch();
+	window->BeginBindingBatch();
+	subscription->Set(2);
+	subscription->Set(3);
+	window->EndBindingBatch();
+	subscription->Set(4);
+	TEST_ASSERT(written.Count() == 0);
+	window->EndBindingBatch();
+	TEST_ASSERT(written.Count() == 1);
+	TEST_ASSERT(written[0] == 4);
+
+	DestroyTestWindow(window);
+}
@@ -0,0 +1,208 @@
+#include "TestHeadless.h"
+
+using namespace vl::collections;
+using namespace headless_test;
+
+namespace headless_test
+{
+	template<typename TComposition>
+	class CountingComposition : public TComposition
+	{
+	public:
+		vint						calculated = 0;
+
+	protected:
+		Rect CalculateBounds()override
+		{
+			calculated++;
+			return TComposition::CalculateBounds();
+		}
+	};
+
+	class TestStackComposition : public GuiStackComposition
+	{
+	public:
+		using GuiStackComposition::GetHitTestIndex;
+	};
+
+	GuiGraphicsComposition* FindCompositionByScan(GuiGraphicsComposition* composition, Point location)
+	{
+		if (!composition->GetVisible()) return nullptr;
+		Rect bounds = composition->GetBounds();
+		if (!Rect(Point(0, 0), bounds.GetSize()).Contains(location)) return nullptr;
+
+		Rect clientArea = composition->GetClientArea();
+		Point clientLocation = location - Size(clientArea.x1 - bounds.x1, clientArea.y1 - bounds.y1);
+		for (vint i = composition->Children().Count() - 1; i >= 0; i--)
+		{
+			auto child = composition->Children()[i];
+			Rect childBounds = child->GetBounds();
+			if (auto result = FindCompositionByScan(child, clientLocation - Size(childBounds.x1, childBounds.y1)))
+			{
+				return result;
+			}
+		}
+		return composition;
+	}
+
+	void AssertFindComposition(GuiGraphicsComposition* composition, Rect area, vint step)
+	{
+		for (vint y = area.y1; y < area.y2; y += step)
+		{
+			for (vint x = area.x1; x < area.x2; x += step)
+			{
+				TEST_ASSERT(composition->FindComposition(Point(x, y), false) == FindCompositionByScan(composition, Point(x, y)));
+			}
+		}
+	}
+}
+
+TEST_HEADLESS_CASE(TestCompositions_UnrelatedSiblingBoundsCached)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto parent = new GuiBoundsComposition;
+	parent->SetBounds(Rect(0, 0, 80, 80));
+	window->GetContainerComposition()->AddChild(parent);
+
+	auto resized = new CountingComposition<GuiBoundsComposition>;
+	resized->SetBounds(Rect(0, 0, 10, 10));
+	parent->AddChild(resized);
+
+	auto sibling = new CountingComposition<GuiBoundsComposition>;
+	sibling->SetBounds(Rect(0, 0, 10, 10));
+	sibling->SetAlignmentToParent(Margin(-1, -1, 0, 0));
+	parent->AddChild(sibling);
+
+	auto child = new CountingComposition<GuiBoundsComposition>;
+	child->SetAlignmentToParent(Margin(1, 1, 1, 1));
+	sibling->AddChild(child);
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(sibling->GetBounds() == Rect(70, 70, 80, 80));
+	TEST_ASSERT(child->GetBounds() == Rect(1, 1, 9, 9));
+
+	// resizing a composition does not move its siblings when the parent keeps its size
+	resized->calculated = 0;
+	sibling->calculated = 0;
+	child->calculated = 0;
+	resized->SetPreferredMinSize(Size(20, 20));
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(resized->GetBounds() == Rect(0, 0, 20, 20));
+	TEST_ASSERT(resized->calculated > 0);
+	TEST_ASSERT(sibling->GetBounds() == Rect(70, 70, 80, 80));
+	TEST_ASSERT(child->GetBounds() == Rect(1, 1, 9, 9));
+	TEST_ASSERT(sibling->calculated == 0);
+	TEST_ASSERT(child->calculated == 0);
+
+	// changing the client area of the parent moves sub compositions that are aligned to it
+	parent->SetInternalMargin(Margin(0, 0, 10, 10));
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(sibling->GetBounds() == Rect(60, 60, 70, 70));
+	TEST_ASSERT(sibling->calculated > 0);
+
+	// sub compositions are not calculated again when their parent moves without being resized
+	child->calculated = 0;
+	parent->SetBounds(Rect(5, 5, 85, 85));
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(child->GetBounds() == Rect(1, 1, 9, 9));
+	TEST_ASSERT(child->GetGlobalBounds().Width() == 8);
+	TEST_ASSERT(child->calculated == 0);
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestCompositions_StackItemsMovedBySibling)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto stack = new GuiStackComposition;
+	stack->SetDirection(GuiStackComposition::Vertical);
+	stack->SetAlignmentToParent(Margin(0, 0, 0, 0));
+	window->GetContainerComposition()->AddChild(stack);
+
+	List<GuiStackItemComposition*> items;
+	for (vint i = 0; i < 3; i++)
+	{
+		auto item = new GuiStackItemComposition;
+		item->SetPreferredMinSize(Size(10, 10));
+		stack->AddChild(item);
+		items.Add(item);
+	}
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(items[2]->GetBounds().Top() == 20);
+
+	// resizing a stack item moves the following stack items even if the stack keeps its size
+	items[0]->SetPreferredMinSize(Size(10, 30));
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(stack->GetBounds() == Rect(0, 0, 100, 100));
+	TEST_ASSERT(items[1]->GetBounds().Top() == 30);
+	TEST_ASSERT(items[2]->GetBounds().Top() == 40);
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestCompositions_FindOverlappingComposition)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto parent = new GuiBoundsComposition;
+	parent->SetBounds(Rect(0, 0, 200, 200));
+	window->GetContainerComposition()->AddChild(parent);
+
+	List<GuiBoundsComposition*> children;
+	vuint seed = 1;
+	auto next = [&](vint max)
+	{
+		seed = seed * 1103515245 + 12345;
+		return (vint)((seed >> 8) % max);
+	};
+	for (vint i = 0; i < 100; i++)
+	{
+		auto child = new GuiBoundsComposition;
+		vint x = next(180);
+		vint y = next(180);
+		child->SetBounds(Rect(Point(x, y), Size(1 + next(60), 1 + next(60))));
+		parent->AddChild(child);
+		children.Add(child);
+	}
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	AssertFindComposition(parent, Rect(0, 0, 200, 200), 3);
+
+	// the index is built again after sub compositions are moved or hidden
+	for (vint i = 0; i < children.Count(); i += 3)
+	{
+		children[i]->SetBounds(Rect(Point(next(180), next(180)), Size(1 + next(60), 1 + next(60))));
+	}
+	for (vint i = 1; i < children.Count(); i += 7)
+	{
+		children[i]->SetVisible(false);
+	}
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	AssertFindComposition(parent, Rect(0, 0, 200, 200), 3);
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestCompositions_FindCompositionInLongStack)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto stack = new TestStackComposition;
+	stack->SetDirection(GuiStackComposition::Vertical);
+	stack->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+	window->GetContainerComposition()->AddChild(stack);
+
+	for (vint i = 0; i < 1000; i++)
+	{
+		auto item = new GuiStackItemComposition;
+		item->SetPreferredMinSize(Size(100, 20));
+		stack->AddChild(item);
+	}
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(stack->GetBounds().Height() == 20000);
+
+	// the grid of a vertical stack has one column and about one item in each row
+	auto index = stack->GetHitTestIndex();
+	TEST_ASSERT(index != nullptr);
+	TEST_ASSERT(index->columns == 1);
+	TEST_ASSERT(index->rows == 1000);
+	AssertFindComposition(stack, Rect(0, 0, 110, 20010), 7);
+
+	DestroyTestWindow(window);
+}
@@ -0,0 +1,209 @@
+#include "TestHeadless.h"
+
+using namespace vl::collections;
+using namespace headless_test;
+
+namespace headless_test
+{
+	class TestDocumentRenderer : public GuiDocumentElement::GuiDocumentElementRenderer
+	{
+	public:
+		using GuiDocumentElementRenderer::ParagraphCache;
+		using GuiDocumentElementRenderer::paragraphDistance;
+		using GuiDocumentElementRenderer::paragraphCaches;
+		using GuiDocumentElementRenderer::paragraphHeights;
+		using GuiDocumentElementRenderer::mostRecentlyUsed;
+		using GuiDocumentElementRenderer::leastRecentlyUsed;
+		using GuiDocumentElementRenderer::usedParagraphCount;
+		using GuiDocumentElementRenderer::EnsureAndGetCache;
+		using GuiDocumentElementRenderer::SetParagraphHeight;
+		using GuiDocumentElementRenderer::GetParagraphTop;
+		using GuiDocumentElementRenderer::GetParagraphIndexFromPoint;
+
+		TestDocumentRenderer(GuiDocumentElement* documentElement, IGuiGraphicsRenderTarget* target)
+		{
+			factory = nullptr;
+			element = nullptr;
+			renderTarget = nullptr;
+			Initialize(documentElement);
+			SetRenderTarget(target);
+			OnElementStateChanged();
+		}
+
+		~TestDocumentRenderer()
+		{
+			Finalize();
+		}
+
+		bool HasLayout(vint index)
+		{
+			auto cache = paragraphCaches[index];
+			return cache && cache->graphicsParagraph;
+		}
+
+		void AssertUsedList()
+		{
+			// the used list links exactly paragraphs with a layout
+			vint count = 0;
+			ParagraphCache* previous = nullptr;
+			for (auto cache = mostRecentlyUsed; cache; cache = cache->nextUsed)
+			{
+				TEST_ASSERT(cache->graphicsParagraph);
+				TEST_ASSERT(cache->previousUsed == previous);
+				previous = cache;
+				count++;
+			}
+			TEST_ASSERT(leastRecentlyUsed == previous);
+			TEST_ASSERT(usedParagraphCount == count);
+
+			vint layoutCount = 0;
+			for (vint i = 0; i < paragraphCaches.Count(); i++)
+			{
+				if (HasLayout(i)) layoutCount++;
+			}
+			TEST_ASSERT(layoutCount == count);
+		}
+	};
+
+	Ptr<DocumentModel> CreateTestDocument(vint paragraphCount)
+	{
+		auto model = MakePtr<DocumentModel>();
+		for (vint i = 0; i < paragraphCount; i++)
+		{
+			auto text = MakePtr<DocumentTextRun>();
+			text->text = L"paragraph " + itow(i);
+			auto paragraph = MakePtr<DocumentParagraphRun>();
+			paragraph->runs.Add(text);
+			model->paragraphs.Add(paragraph);
+		}
+		return model;
+	}
+}
+
+TEST_HEADLESS_CASE(TestDocumentElement_ParagraphIndexFromPoint)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	Ptr<GuiDocumentElement> element = GuiDocumentElement::Create();
+	element->SetDocument(CreateTestDocument(1000));
+	{
+		TestDocumentRenderer renderer(element.Obj(), GetRenderTarget(window));
+		vuint seed = 1;
+		auto next = [&](vint max)
+		{
+			seed = seed * 1103515245 + 12345;
+			return (vint)((seed >> 8) % max);
+		};
+
+		for (vint step = 0; step < 200; step++)
+		{
+			renderer.SetParagraphHeight(next(1000), 1 + next(50));
+
+			// compare the tree with tops summed paragraph by paragraph
+			vint top = 0;
+			for (vint i = 0; i < 1000; i++)
+			{
+				vint bottom = top + renderer.paragraphHeights[i] + renderer.paragraphDistance;
+				if (i % 7 == step % 7)
+				{
+					vint foundTop = -1, foundIndex = -1;
+					TEST_ASSERT(renderer.GetParagraphTop(i) == top);
+					TEST_ASSERT(renderer.GetParagraphIndexFromPoint(Point(0, top), foundTop, foundIndex));
+					TEST_ASSERT(foundIndex == i && foundTop == top);
+					TEST_ASSERT(renderer.GetParagraphIndexFromPoint(Point(0, bottom - 1), foundTop, foundIndex));
+					TEST_ASSERT(foundIndex == i && foundTop == top);
+				}
+				top = bottom;
+			}
+
+			// points below the document belong to the last paragraph
+			vint lastTop = renderer.GetParagraphTop(999);
+			vint foundTop = -1, foundIndex = -1;
+			TEST_ASSERT(renderer.GetParagraphIndexFromPoint(Point(0, renderer.GetParagraphTop(1000) + 100), foundTop, foundIndex));
+			TEST_ASSERT(foundIndex == 999 && foundTop == lastTop);
+			TEST_ASSERT(renderer.GetMinSize().y == renderer.GetParagraphTop(1000) - renderer.paragraphDistance);
+		}
+	}
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestDocumentElement_EstimatedCaretBounds)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	Ptr<GuiDocumentElement> element = GuiDocumentElement::Create();
+	element->SetDocument(CreateTestDocument(1000));
+	{
+		TestDocumentRenderer renderer(element.Obj(), GetRenderTarget(window));
+		vint defaultHeight = renderer.paragraphHeights[0];
+
+		// paragraphs without a layout use the default height
+		renderer.SetParagraphHeight(10, defaultHeight * 3);
+		Rect bounds = renderer.GetCaretBounds(TextPos(900, 0), true);
+		TEST_ASSERT(bounds.y1 == 900 * (defaultHeight + renderer.paragraphDistance) + defaultHeight * 2);
+		TEST_ASSERT(bounds.Height() == defaultHeight);
+		TEST_ASSERT(renderer.usedParagraphCount == 1);
+		TEST_ASSERT(renderer.HasLayout(900));
+		TEST_ASSERT(!renderer.HasLayout(899));
+
+		// the caret is found in the same paragraph without creating layouts for other paragraphs
+		TextPos caret = renderer.CalculateCaretFromPoint(Point(0, bounds.y1 + 1));
+		TEST_ASSERT(caret.row == 900 && caret.column == 0);
+		TEST_ASSERT(renderer.usedParagraphCount == 1);
+		renderer.AssertUsedList();
+	}
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestDocumentElement_ReleaseLeastRecentlyUsedParagraphs)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	Ptr<GuiDocumentElement> element = GuiDocumentElement::Create();
+	element->SetDocument(CreateTestDocument(100));
+	element->SetParagraphCacheCapacity(8);
+	{
+		TestDocumentRenderer renderer(element.Obj(), GetRenderTarget(window));
+		for (vint i = 0; i < 8; i++)
+		{
+			renderer.EnsureAndGetCache(i, true);
+		}
+		TEST_ASSERT(renderer.usedParagraphCount == 8);
+		renderer.AssertUsedList();
+
+		// using a paragraph again keeps it when the capacity is exceeded
+		renderer.EnsureAndGetCache(0, true);
+		renderer.EnsureAndGetCache(1, false);
+		renderer.EnsureAndGetCache(8, true);
+		TEST_ASSERT(renderer.usedParagraphCount == 4);
+		TEST_ASSERT(renderer.HasLayout(0));
+		TEST_ASSERT(renderer.HasLayout(6));
+		TEST_ASSERT(renderer.HasLayout(7));
+		TEST_ASSERT(renderer.HasLayout(8));
+		TEST_ASSERT(!renderer.HasLayout(1));
+		TEST_ASSERT(renderer.mostRecentlyUsed == renderer.paragraphCaches[8].Obj());
+		TEST_ASSERT(renderer.leastRecentlyUsed == renderer.paragraphCaches[6].Obj());
+		renderer.AssertUsedList();
+
+		// walking through the document never keeps more layouts than the capacity
+		for (vint i = 0; i < 100; i++)
+		{
+			renderer.EnsureAndGetCache(i, true);
+			TEST_ASSERT(renderer.usedParagraphCount <= 8);
+			TEST_ASSERT(renderer.HasLayout(i));
+		}
+		renderer.AssertUsedList();
+
+		// replaced paragraphs are removed from the used list
+		element->GetDocument()->paragraphs.RemoveRange(97, 3);
+		renderer.NotifyParagraphUpdated(97, 3, 0, true);
+		renderer.AssertUsedList();
+		for (vint i = 90; i < 97; i++)
+		{
+			renderer.EnsureAndGetCache(i, true);
+		}
+		renderer.AssertUsedList();
+
+		renderer.OnElementStateChanged();
+		TEST_ASSERT(renderer.usedParagraphCount == 0);
+		TEST_ASSERT(renderer.mostRecentlyUsed == nullptr && renderer.leastRecentlyUsed == nullptr);
+	}
+	DestroyTestWindow(window);
+}
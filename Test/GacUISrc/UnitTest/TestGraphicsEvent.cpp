@@ -0,0 +1,137 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::compositions;
+
+TEST_CASE(TestGraphicsEvent_AttachAndDetach)
+{
+	GuiNotifyEvent event;
+	List<vint> executed;
+	TEST_ASSERT(event.HasHandlers() == false);
+
+	List<Ptr<IGuiGraphicsEventHandler>> handlers;
+	for (vint i = 0; i < 100; i++)
+	{
+		handlers.Add(event.AttachLambda([&executed, i](GuiGraphicsComposition*, GuiEventArgs&) { executed.Add(i); }));
+	}
+	TEST_ASSERT(event.HasHandlers() == true);
+
+	// detached handlers are skipped, and the order of the remaining handlers is kept after compacting
+	for (vint i = 0; i < 100; i += 2)
+	{
+		TEST_ASSERT(event.Detach(handlers[i]) == true);
+		TEST_ASSERT(handlers[i]->IsAttached() == false);
+		TEST_ASSERT(event.Detach(handlers[i]) == false);
+	}
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(executed.Count() == 50);
+	for (vint i = 0; i < 50; i++)
+	{
+		TEST_ASSERT(executed[i] == i * 2 + 1);
+	}
+
+	// a handler from another event cannot be detached
+	GuiNotifyEvent anotherEvent;
+	auto anotherHandler = anotherEvent.AttachLambda([](GuiGraphicsComposition*, GuiEventArgs&) {});
+	TEST_ASSERT(event.Detach(anotherHandler) == false);
+	TEST_ASSERT(anotherHandler->IsAttached() == true);
+
+	for (vint i = 1; i < 100; i += 2)
+	{
+		TEST_ASSERT(event.Detach(handlers[i]) == true);
+	}
+	TEST_ASSERT(event.HasHandlers() == false);
+	executed.Clear();
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(executed.Count() == 0);
+}
+
+TEST_CASE(TestGraphicsEvent_AttachAndDetachInExecute)
+{
+	GuiNotifyEvent event;
+	List<WString> executed;
+	Ptr<IGuiGraphicsEventHandler> a, b, c, d;
+
+	a = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		executed.Add(L"a");
+		TEST_ASSERT(event.Detach(b) == true);
+		TEST_ASSERT(event.Detach(a) == true);
+		d = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+		{
+			executed.Add(L"d");
+		});
+	});
+	b = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		executed.Add(L"b");
+	});
+	c = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		executed.Add(L"c");
+	});
+
+	// a handler detached in an execution is skipped, a handler attached in an execution is executed in the same execution
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(executed.Count() == 3);
+	TEST_ASSERT(executed[0] == L"a");
+	TEST_ASSERT(executed[1] == L"c");
+	TEST_ASSERT(executed[2] == L"d");
+	TEST_ASSERT(a->IsAttached() == false);
+	TEST_ASSERT(b->IsAttached() == false);
+
+	executed.Clear();
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(executed.Count() == 2);
+	TEST_ASSERT(executed[0] == L"c");
+	TEST_ASSERT(executed[1] == L"d");
+
+	// detaching all handlers in an execution leaves the event usable
+	Ptr<IGuiGraphicsEventHandler> e;
+	e = event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		TEST_ASSERT(event.Detach(c) == true);
+		TEST_ASSERT(event.Detach(d) == true);
+		TEST_ASSERT(event.Detach(e) == true);
+	});
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(event.HasHandlers() == false);
+
+	executed.Clear();
+	event.AttachLambda([&](GuiGraphicsComposition*, GuiEventArgs&)
+	{
+		executed.Add(L"f");
+	});
+	TEST_ASSERT(event.HasHandlers() == true);
+	event.Execute(GuiEventArgs());
+	TEST_ASSERT(executed.Count() == 1);
+	TEST_ASSERT(executed[0] == L"f");
+}
+
+TEST_CASE(TestGraphicsEvent_DestroyOwnerInExecute)
+{
+	auto composition = new GuiBoundsComposition;
+	auto& event = composition->GetEventReceiver()->leftButtonDown;
+	List<WString> executed;
+
+	auto first = event.AttachLambda([&](GuiGraphicsComposition* sender, GuiMouseEventArgs&)
+	{
+		TEST_ASSERT(sender == composition);
+		executed.Add(L"first");
+		delete composition;
+		composition = nullptr;
+	});
+	auto second = event.AttachLambda([&](GuiGraphicsComposition*, GuiMouseEventArgs&)
+	{
+		executed.Add(L"second");
+	});
+
+	// handlers after the one destroying the owner are not executed
+	GuiMouseEventArgs arguments;
+	event.Execute(arguments);
+	TEST_ASSERT(composition == nullptr);
+	TEST_ASSERT(executed.Count() == 1);
+	TEST_ASSERT(executed[0] == L"first");
+}
@@ -0,0 +1,373 @@
+#include "TestHeadless.h"
+
+using namespace vl::collections;
+using namespace vl::presentation::templates;
+using namespace headless_test;
+
+namespace headless_test
+{
+	template<typename TTemplate>
+	class TestScrollViewTemplate : public TTemplate
+	{
+	public:
+		TestScrollViewTemplate()
+		{
+			auto horizontalScroll = new GuiScroll(theme::ThemeName::HScroll);
+			auto verticalScroll = new GuiScroll(theme::ThemeName::VScroll);
+			this->AddChild(horizontalScroll->GetBoundsComposition());
+			this->AddChild(verticalScroll->GetBoundsComposition());
+			this->SetHorizontalScroll(horizontalScroll);
+			this->SetVerticalScroll(verticalScroll);
+
+			auto container = new GuiBoundsComposition;
+			container->SetAlignmentToParent(Margin(0, 0, 0, 0));
+			this->AddChild(container);
+			this->SetContainerComposition(container);
+		}
+	};
+
+	bool IsHeadless()
+	{
+		return GetHeadlessController(GetCurrentController()) != nullptr;
+	}
+
+	IHeadlessController* GetHeadless()
+	{
+		auto headless = GetHeadlessController(GetCurrentController());
+		TEST_ASSERT(headless != nullptr);
+		return headless;
+	}
+
+	GuiWindow* CreateTestWindow(Size clientSize)
+	{
+		auto theme = MakePtr<theme::ThemeTemplates>();
+		theme->Window = [](const reflection::description::Value&) { return new GuiWindowTemplate; };
+		theme->Tooltip = [](const reflection::description::Value&) { return new GuiWindowTemplate; };
+		theme->Menu = [](const reflection::description::Value&) { return new GuiMenuTemplate; };
+		theme->SinglelineTextBox = [](const reflection::description::Value&) { return new GuiSinglelineTextBoxTemplate; };
+		theme->TextList = [](const reflection::description::Value&) { return new TestScrollViewTemplate<GuiTextListTemplate>; };
+		theme->MultilineTextBox = [](const reflection::description::Value&) { return new TestScrollViewTemplate<GuiMultilineTextBoxTemplate>; };
+		theme->ListItemBackground = [](const reflection::description::Value&)
+		{
+			// item backgrounds are measured by their items
+			auto itemBackground = new GuiSelectableButtonTemplate;
+			itemBackground->SetMinSizeLimitation(GuiGraphicsComposition::LimitToElementAndChildren);
+			return itemBackground;
+		};
+		theme->HScroll = [](const reflection::description::Value&) { return new GuiScrollTemplate; };
+		theme->VScroll = [](const reflection::description::Value&) { return new GuiScrollTemplate; };
+		TEST_ASSERT(theme::RegisterTheme(L"HeadlessTest", theme));
+
+		auto window = new GuiWindow(theme::ThemeName::Window);
+		window->SetClientSize(clientSize);
+		window->Show();
+		GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+		return window;
+	}
+
+	void DestroyTestWindow(GuiWindow* window)
+	{
+		window->Hide();
+		delete window;
+		GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+		theme::UnregisterTheme(L"HeadlessTest");
+	}
+
+	IHeadlessRenderTarget* GetRenderTarget(GuiWindow* window)
+	{
+		auto renderTarget = GetHeadlessResourceManager()->GetHeadlessRenderTarget(window->GetNativeWindow());
+		TEST_ASSERT(renderTarget != nullptr);
+		return renderTarget;
+	}
+
+	GuiBoundsComposition* AddSolidBackground(GuiGraphicsComposition* parent, Rect bounds, Color color)
+	{
+		auto element = GuiSolidBackgroundElement::Create();
+		element->SetColor(color);
+
+		auto composition = new GuiBoundsComposition;
+		composition->SetOwnedElement(element);
+		composition->SetBounds(bounds);
+		parent->AddChild(composition);
+		return composition;
+	}
+}
+
+TEST_HEADLESS_CASE(TestHeadless_RenderWindow)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto renderTarget = GetRenderTarget(window);
+	auto composition = AddSolidBackground(window->GetContainerComposition(), Rect(10, 10, 50, 50), Color(255, 0, 0));
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+
+	auto framebuffer = renderTarget->GetFramebuffer();
+	TEST_ASSERT(framebuffer != nullptr);
+	TEST_ASSERT(framebuffer->GetSize() == Size(100, 100));
+	TEST_ASSERT(framebuffer->GetPixel(10, 10) == Color(255, 0, 0));
+	TEST_ASSERT(framebuffer->GetPixel(49, 49) == Color(255, 0, 0));
+	TEST_ASSERT(framebuffer->GetPixel(50, 50) != Color(255, 0, 0));
+	TEST_ASSERT(framebuffer->GetPixel(9, 9) != Color(255, 0, 0));
+
+	composition->GetOwnedElement().Cast<GuiSolidBackgroundElement>()->SetColor(Color(0, 0, 255));
+	vint frameCount = renderTarget->GetFrameCount();
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(renderTarget->GetFrameCount() == frameCount + 1);
+	TEST_ASSERT(framebuffer->GetPixel(10, 10) == Color(0, 0, 255));
+	TEST_ASSERT(framebuffer->GetPixel(49, 49) == Color(0, 0, 255));
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestHeadless_NoFrameWhenIdle)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto renderTarget = GetRenderTarget(window);
+	AddSolidBackground(window->GetContainerComposition(), Rect(10, 10, 50, 50), Color(255, 0, 0));
+	GetHeadless()->AdvanceTime(100);
+	TEST_ASSERT(GetApplication()->GetFrameScheduler()->IsFrameScheduled() == false);
+
+	vint frameCount = renderTarget->GetFrameCount();
+	GetHeadless()->AdvanceTime(1000);
+	TEST_ASSERT(renderTarget->GetFrameCount() == frameCount);
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestHeadless_DamagedRegionOutsideOfWindow)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto renderTarget = GetRenderTarget(window);
+	auto host = window->GetGraphicsHost();
+	auto inside = AddSolidBackground(window->GetContainerComposition(), Rect(10, 10, 50, 50), Color(255, 0, 0));
+	auto outside = AddSolidBackground(window->GetContainerComposition(), Rect(200, 200, 250, 250), Color(255, 0, 0));
+	GetHeadless()->AdvanceTime(100);
+	TEST_ASSERT(host->GetDrawnElementCount() == 1);
+	TEST_ASSERT(host->GetCulledCompositionCount() == 1);
+
+	// the damaged region of a composition outside of the window is dropped without rendering a frame
+	vint frameCount = renderTarget->GetFrameCount();
+	outside->GetOwnedElement().Cast<GuiSolidBackgroundElement>()->SetColor(Color(0, 255, 0));
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(renderTarget->GetFrameCount() == frameCount);
+
+	// only the composition in the damaged region is rendered, and the clipper of the render target is not broken by the previous frame
+	inside->GetOwnedElement().Cast<GuiSolidBackgroundElement>()->SetColor(Color(0, 0, 255));
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(renderTarget->GetFrameCount() == frameCount + 1);
+	TEST_ASSERT(host->GetDrawnElementCount() == 1);
+	TEST_ASSERT(host->GetCulledCompositionCount() == 1);
+	auto framebuffer = renderTarget->GetFramebuffer();
+	TEST_ASSERT(framebuffer->GetPixel(10, 10) == Color(0, 0, 255));
+	TEST_ASSERT(framebuffer->GetPixel(49, 49) == Color(0, 0, 255));
+	TEST_ASSERT(renderTarget->IsClipperCoverWholeTarget() == false);
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestHeadless_PartialRenderCullsUndamagedCompositions)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto renderTarget = GetRenderTarget(window);
+	auto host = window->GetGraphicsHost();
+	List<GuiBoundsComposition*> compositions;
+	for (vint i = 0; i < 10; i++)
+	{
+		compositions.Add(AddSolidBackground(window->GetContainerComposition(), Rect(Point(i * 10, 0), Size(10, 10)), Color(255, 0, 0)));
+	}
+	GetHeadless()->AdvanceTime(100);
+	TEST_ASSERT(host->GetDrawnElementCount() == 10);
+	TEST_ASSERT(host->GetCulledCompositionCount() == 0);
+
+	// changing the color of an element only renders compositions that overlap its area
+	compositions[5]->GetOwnedElement().Cast<GuiSolidBackgroundElement>()->SetColor(Color(0, 255, 0));
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(host->GetDrawnElementCount() == 1);
+	TEST_ASSERT(host->GetCulledCompositionCount() == 9);
+	auto framebuffer = renderTarget->GetFramebuffer();
+	TEST_ASSERT(framebuffer->GetPixel(55, 5) == Color(0, 255, 0));
+	TEST_ASSERT(framebuffer->GetPixel(45, 5) == Color(255, 0, 0));
+	TEST_ASSERT(framebuffer->GetPixel(65, 5) == Color(255, 0, 0));
+
+	// changing the layout renders everything again
+	compositions[0]->SetBounds(Rect(0, 20, 10, 30));
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(host->GetDrawnElementCount() == 10);
+	TEST_ASSERT(host->GetCulledCompositionCount() == 0);
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestHeadless_PopEmptyClipper)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto renderTarget = GetRenderTarget(window);
+
+	renderTarget->StartRendering();
+	renderTarget->PushClipper(Rect(200, 200, 250, 250));
+	TEST_ASSERT(renderTarget->IsClipperCoverWholeTarget() == true);
+	renderTarget->PopClipper();
+	TEST_ASSERT(renderTarget->IsClipperCoverWholeTarget() == false);
+
+	renderTarget->PushClipper(Rect(10, 10, 50, 50));
+	TEST_ASSERT(renderTarget->GetClipper() == Rect(10, 10, 50, 50));
+	renderTarget->PushClipper(Rect(60, 60, 70, 70));
+	TEST_ASSERT(renderTarget->IsClipperCoverWholeTarget() == true);
+	renderTarget->PopClipper();
+	TEST_ASSERT(renderTarget->GetClipper() == Rect(10, 10, 50, 50));
+	renderTarget->PopClipper();
+	TEST_ASSERT(renderTarget->GetClipper() == Rect(0, 0, 100, 100));
+	renderTarget->StopRendering();
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestHeadless_DelayExecuteInVirtualTime)
+{
+	List<vint> executed;
+	auto start = GetHeadless()->GetVirtualTime();
+	GetApplication()->DelayExecuteInMainThread([&]() { executed.Add(3); }, 30);
+	GetApplication()->DelayExecute([&]() { executed.Add(2); }, 20);
+	GetApplication()->DelayExecuteInMainThread([&]() { executed.Add(1); }, 10);
+
+	GetHeadless()->AdvanceTime(15);
+	TEST_ASSERT(executed.Count() == 1);
+	TEST_ASSERT(GetHeadless()->GetVirtualTime() == start + 15);
+
+	GetHeadless()->AdvanceTime(15);
+	TEST_ASSERT(executed.Count() == 3);
+	TEST_ASSERT(executed[0] == 1);
+	TEST_ASSERT(executed[1] == 2);
+	TEST_ASSERT(executed[2] == 3);
+}
+
+TEST_HEADLESS_CASE(TestHeadless_InvokeInMainThreadAndWait)
+{
+	volatile bool invoked = false;
+	volatile bool finished = false;
+	volatile bool result = false;
+	auto thread = Thread::CreateAndStart([&]()
+	{
+		result = GetApplication()->InvokeInMainThreadAndWait(nullptr, [&]()
+		{
+			invoked = true;
+		});
+		finished = true;
+	}, false);
+
+	for (vint i = 0; i < 1000 && !finished; i++)
+	{
+		GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+		Thread::Sleep(1);
+	}
+	thread->Wait();
+	delete thread;
+
+	TEST_ASSERT(invoked);
+	TEST_ASSERT(finished);
+	TEST_ASSERT(result);
+}
+
+TEST_HEADLESS_CASE(TestHeadless_FrameSchedulerWakesOnRequest)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto scheduler = GetApplication()->GetFrameScheduler();
+	vint clockCalls = 0;
+	scheduler->SetClock([&]()
+	{
+		clockCalls++;
+		return GetHeadless()->GetVirtualTime();
+	});
+
+	// the timer stops when nothing needs the next frame
+	GetHeadless()->AdvanceTime(100);
+	TEST_ASSERT(scheduler->IsFrameScheduled() == false);
+	vint frameCount = scheduler->GetFrameCount();
+	clockCalls = 0;
+	GetHeadless()->AdvanceTime(1000);
+	TEST_ASSERT(scheduler->GetFrameCount() == frameCount);
+	TEST_ASSERT(clockCalls == 0);
+
+	// requesting a rendering wakes the timer for one frame, which reads the replaced clock
+	window->GetGraphicsHost()->RequestRender();
+	TEST_ASSERT(scheduler->IsFrameScheduled() == true);
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+	TEST_ASSERT(scheduler->GetFrameCount() == frameCount + 1);
+	TEST_ASSERT(clockCalls == 1);
+	TEST_ASSERT(scheduler->IsFrameScheduled() == false);
+
+	// a request from another thread is forwarded to the main thread
+	auto thread = Thread::CreateAndStart([=]()
+	{
+		scheduler->RequestFrame();
+	}, false);
+	thread->Wait();
+	delete thread;
+	TEST_ASSERT(scheduler->IsFrameScheduled() == false);
+	GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval * 2);
+	TEST_ASSERT(scheduler->GetFrameCount() == frameCount + 2);
+	TEST_ASSERT(scheduler->IsFrameScheduled() == false);
+
+	scheduler->SetClock({});
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestHeadless_FrameSchedulerBlinksCaretByDeadline)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto textBox = new GuiSinglelineTextBox(theme::ThemeName::SinglelineTextBox);
+	textBox->GetBoundsComposition()->SetAlignmentToParent(Margin(0, 0, 0, 0));
+	window->AddChild(textBox);
+	textBox->SetFocus();
+
+	auto scheduler = GetApplication()->GetFrameScheduler();
+	scheduler->SetClock([]()
+	{
+		return GetHeadless()->GetVirtualTime();
+	});
+
+	// a visible caret does not keep the timer running, it only wakes the scheduler when it blinks
+	GetHeadless()->AdvanceTime(100);
+	TEST_ASSERT(scheduler->IsFrameScheduled() == false);
+	vint frameCount = scheduler->GetFrameCount();
+	GetHeadless()->AdvanceTime(GuiGraphicsHost::CaretInterval * 4);
+	vint frames = scheduler->GetFrameCount() - frameCount;
+	TEST_ASSERT(3 <= frames && frames <= 8);
+	TEST_ASSERT(scheduler->IsFrameScheduled() == false);
+
+	// nothing wakes the scheduler after the caret is gone
+	window->GetBoundsComposition()->GetRelatedGraphicsHost()->SetFocus(window->GetBoundsComposition());
+	GetHeadless()->AdvanceTime(GuiGraphicsHost::CaretInterval);
+	frameCount = scheduler->GetFrameCount();
+	GetHeadless()->AdvanceTime(GuiGraphicsHost::CaretInterval * 4);
+	TEST_ASSERT(scheduler->GetFrameCount() == frameCount);
+
+	scheduler->SetClock({});
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestHeadless_TooltipResizesWithContent)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto tooltip = new GuiTooltip(theme::ThemeName::Tooltip);
+	auto content = new GuiBoundsComposition;
+	content->SetPreferredMinSize(Size(50, 20));
+	content->SetAlignmentToParent(Margin(0, 0, 0, 0));
+	tooltip->GetContainerComposition()->AddChild(content);
+	tooltip->ShowPopup(window, Point(0, 0));
+	GetHeadless()->AdvanceTime(100);
+	TEST_ASSERT(tooltip->GetClientSize().x >= 50);
+	TEST_ASSERT(tooltip->GetClientSize().y >= 20);
+	TEST_ASSERT(GetApplication()->GetFrameScheduler()->IsFrameScheduled() == false);
+
+	// the tooltip is resized when the content grows, without requesting frames while it is opened
+	content->SetPreferredMinSize(Size(120, 40));
+	GetHeadless()->AdvanceTime(100);
+	TEST_ASSERT(tooltip->GetClientSize().x >= 120);
+	TEST_ASSERT(tooltip->GetClientSize().y >= 40);
+	TEST_ASSERT(GetApplication()->GetFrameScheduler()->IsFrameScheduled() == false);
+
+	tooltip->Close();
+	GetHeadless()->AdvanceTime(100);
+	delete tooltip;
+	DestroyTestWindow(window);
+}
@@ -0,0 +1,49 @@
+/***********************************************************************
+Helper functions for test cases that run in the headless controller
+***********************************************************************/
+
+#ifndef GACUI_UNITTEST_TESTHEADLESS
+#define GACUI_UNITTEST_TESTHEADLESS
+
+#include "../../../Source/GacUI.h"
+#include "../../../Source/NativeWindow/Headless/HeadlessNativeWindow.h"
+#include "../../../Source/GraphicsElement/Headless/GuiGraphicsHeadless.h"
+
+namespace headless_test
+{
+	using namespace vl;
+	using namespace vl::presentation;
+	using namespace vl::presentation::controls;
+	using namespace vl::presentation::compositions;
+	using namespace vl::presentation::elements;
+	using namespace vl::presentation::elements_headless;
+	using namespace vl::presentation::headless;
+
+	extern bool							IsHeadless();
+	extern IHeadlessController*			GetHeadless();
+	extern GuiWindow*					CreateTestWindow(Size clientSize);
+	extern void							DestroyTestWindow(GuiWindow* window);
+	extern IHeadlessRenderTarget*		GetRenderTarget(GuiWindow* window);
+	extern GuiBoundsComposition*		AddSolidBackground(GuiGraphicsComposition* parent, Rect bounds, Color color);
+}
+
+/***********************************************************************
+Test cases that run in the headless controller, they are skipped in other renderers
+***********************************************************************/
+
+#define TEST_HEADLESS_CASE(NAME)\
+		extern void HEADLESS_TESTCASE_##NAME();\
+		TEST_CASE(NAME)\
+		{\
+			if (headless_test::IsHeadless())\
+			{\
+				HEADLESS_TESTCASE_##NAME();\
+			}\
+			else\
+			{\
+				TEST_PRINT(L"    skipped: requires the headless controller");\
+			}\
+		}\
+		void HEADLESS_TESTCASE_##NAME()
+
+#endif
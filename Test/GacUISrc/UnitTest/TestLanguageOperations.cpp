@@ -0,0 +1,284 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Controls/TextEditorPackage/LanguageService/GuiLanguageOperations.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::parsing;
+using namespace vl::parsing::definitions;
+using namespace vl::parsing::analyzing;
+using namespace vl::parsing::tabling;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+
+namespace language_operations_test
+{
+	const wchar_t* ExpressionGrammar = LR"GRAMMAR(
+class Expression
+{
+}
+
+class NumberExpression : Expression
+{
+	token value;
+}
+
+class NameExpression : Expression
+{
+	token name;
+}
+
+class BinaryExpression : Expression
+{
+	Expression first;
+	Expression second;
+}
+
+class Statement
+{
+}
+
+class ExpressionStatement : Statement
+{
+	Expression expression;
+}
+
+class BlockStatement : Statement
+{
+	Statement[] statements;
+}
+
+class Unit
+{
+	Statement[] statements;
+}
+
+token NAME = "[a-zA-Z_]+";
+token NUMBER = "[0-9]+";
+token ADD = "/+";
+token MUL = "/*";
+token OPEN = "/(";
+token CLOSE = "/)";
+token BEGIN = "/{";
+token END = "/}";
+token SEMICOLON = ";";
+
+discardtoken SPACE = "/s+";
+
+rule Expression Primary
+	= NUMBER : value as NumberExpression
+	= NAME : name as NameExpression
+	= "(" !Expr ")"
+	;
+
+rule Expression Term
+	= !Primary
+	= Term : first "*" Primary : second as BinaryExpression
+	;
+
+rule Expression Expr
+	= !Term
+	= Expr : first "+" Term : second as BinaryExpression
+	;
+
+rule Statement Stat
+	= Expr : expression ";" as ExpressionStatement
+	= "{" {Stat : statements} "}" as BlockStatement
+	;
+
+rule Unit Program
+	= Stat : statements {Stat : statements} as Unit
+	;
+)GRAMMAR";
+
+	Ptr<ParsingGeneralParser> CreateExpressionParser()
+	{
+		List<Ptr<ParsingError>> errors;
+		auto definitionNode = CreateBootstrapStrictParser()->Parse(ExpressionGrammar, L"ParserDecl", errors);
+		TEST_ASSERT(definitionNode && errors.Count() == 0);
+		auto table = GenerateTable(DeserializeDefinition(definitionNode), false, errors);
+		TEST_ASSERT(table && errors.Count() == 0);
+		table->Initialize();
+		return CreateStrictParser(table);
+	}
+
+	class TestParsingExecutor : public RepeatingParsingExecutor
+	{
+	public:
+		RepeatingParsingOutput				output;
+		vint								incrementalCount = 0;
+
+		TestParsingExecutor(Ptr<ParsingGeneralParser> parser)
+			:RepeatingParsingExecutor(parser, L"Program")
+		{
+		}
+
+		void Parse(const WString& code)
+		{
+			RepeatingParsingInput input;
+			input.code = code;
+			output = RepeatingParsingOutput();
+			Execute(input);
+			if (output.incremental)
+			{
+				incrementalCount++;
+			}
+		}
+
+	protected:
+		void OnContextFinishedAsync(RepeatingParsingOutput& context)override
+		{
+			output = context;
+		}
+	};
+
+	void AssertSameTree(ParsingTreeNode* actual, ParsingTreeNode* expected)
+	{
+		TEST_ASSERT(actual->GetCodeRange() == expected->GetCodeRange());
+		if (auto expectedToken = dynamic_cast<ParsingTreeToken*>(expected))
+		{
+			auto actualToken = dynamic_cast<ParsingTreeToken*>(actual);
+			TEST_ASSERT(actualToken);
+			TEST_ASSERT(actualToken->GetValue() == expectedToken->GetValue());
+			TEST_ASSERT(actualToken->GetTokenIndex() == expectedToken->GetTokenIndex());
+		}
+		else if (auto expectedObject = dynamic_cast<ParsingTreeObject*>(expected))
+		{
+			auto actualObject = dynamic_cast<ParsingTreeObject*>(actual);
+			TEST_ASSERT(actualObject);
+			TEST_ASSERT(actualObject->GetType() == expectedObject->GetType());
+			TEST_ASSERT(CompareEnumerable(actualObject->GetCreatorRules(), expectedObject->GetCreatorRules()) == 0);
+			TEST_ASSERT(CompareEnumerable(actualObject->GetMembers().Keys(), expectedObject->GetMembers().Keys()) == 0);
+			for (vint i = 0; i < expectedObject->GetMembers().Count(); i++)
+			{
+				auto actualMember = actualObject->GetMembers().Values()[i];
+				TEST_ASSERT(actualMember->GetParent() == actualObject);
+				AssertSameTree(actualMember.Obj(), expectedObject->GetMembers().Values()[i].Obj());
+			}
+		}
+		else if (auto expectedArray = dynamic_cast<ParsingTreeArray*>(expected))
+		{
+			auto actualArray = dynamic_cast<ParsingTreeArray*>(actual);
+			TEST_ASSERT(actualArray);
+			TEST_ASSERT(actualArray->Count() == expectedArray->Count());
+			for (vint i = 0; i < expectedArray->Count(); i++)
+			{
+				AssertSameTree(actualArray->GetItem(i).Obj(), expectedArray->GetItem(i).Obj());
+			}
+		}
+	}
+
+	bool IsLetter(wchar_t c)
+	{
+		return (L'a' <= c && c <= L'z') || (L'A' <= c && c <= L'Z') || c == L'_';
+	}
+
+	bool IsDigit(wchar_t c)
+	{
+		return L'0' <= c && c <= L'9';
+	}
+}
+using namespace language_operations_test;
+
+TEST_CASE(TestLanguageOperations_IncrementalParsingRandomEdits)
+{
+	auto parser = CreateExpressionParser();
+	TestParsingExecutor executor(parser);
+	executor.SetIncrementalParsing(true);
+
+	WString code =
+		L"a + 1;\n"
+		L"{\n"
+		L"  b * (c + 22) * 3;\n"
+		L"  { x + y + z; 4 * 5; }\n"
+		L"}\n"
+		L"(a + b) * (c + d);\n"
+		L"{ }\n"
+		L"last + 100;\n";
+	executor.Parse(code);
+	TEST_ASSERT(executor.output.node && !executor.output.incremental);
+
+	vuint seed = 1;
+	auto next = [&](vint max)
+	{
+		seed = seed * 1103515245 + 12345;
+		return (vint)((seed >> 8) % max);
+	};
+
+	for (vint step = 0; step < 300; step++)
+	{
+		// every edit keeps the code valid
+		List<vint> candidates;
+		vint operation = next(6);
+		for (vint i = 0; i < code.Length(); i++)
+		{
+			wchar_t c = code[i];
+			wchar_t previous = i == 0 ? L'\n' : code[i - 1];
+			switch (operation)
+			{
+			case 0:
+			case 1:
+				// insert a digit in a number, or remove a digit from a number with more than one digit
+				if (IsDigit(c) && (operation == 0 || IsDigit(previous) || (i + 1 < code.Length() && IsDigit(code[i + 1]))))
+				{
+					candidates.Add(i);
+				}
+				break;
+			case 2:
+				// insert a letter in a name
+				if (IsLetter(c)) candidates.Add(i);
+				break;
+			case 3:
+				// replace a name by a binary expression in parentheses
+				if (IsLetter(c) && !IsLetter(previous)) candidates.Add(i);
+				break;
+			case 4:
+				// insert white spaces
+				if (c == L' ' || c == L'\n') candidates.Add(i);
+				break;
+			case 5:
+				// insert a statement
+				if (c == L';' || c == L'{' || c == L'}') candidates.Add(i + 1);
+				break;
+			}
+		}
+		if (candidates.Count() == 0) continue;
+
+		vint index = candidates[next(candidates.Count())];
+		switch (operation)
+		{
+		case 0:
+			code = code.Left(index) + itow(next(10)) + code.Right(code.Length() - index);
+			break;
+		case 1:
+			code = code.Left(index) + code.Right(code.Length() - index - 1);
+			break;
+		case 2:
+			code = code.Left(index) + WString(L"abcxyz"[next(6)]) + code.Right(code.Length() - index);
+			break;
+		case 3:
+			{
+				vint end = index;
+				while (end < code.Length() && IsLetter(code[end])) end++;
+				code = code.Left(index) + L"(" + code.Sub(index, end - index) + (next(2) == 0 ? L" + " : L" * ") + itow(next(100)) + L")" + code.Right(code.Length() - end);
+			}
+			break;
+		case 4:
+			code = code.Left(index) + (next(2) == 0 ? L"\n  " : L" ") + code.Right(code.Length() - index);
+			break;
+		case 5:
+			code = code.Left(index) + (next(2) == 0 ? L"\nn * 2;" : L" { m + 1; }") + code.Right(code.Length() - index);
+			break;
+		}
+
+		executor.Parse(code);
+		List<Ptr<ParsingError>> errors;
+		auto expected = parser->Parse(code, L"Program", errors);
+		TEST_ASSERT(expected && errors.Count() == 0);
+		TEST_ASSERT(executor.output.node);
+		TEST_ASSERT(executor.output.code == code);
+		AssertSameTree(executor.output.node.Obj(), expected.Obj());
+	}
+
+	// most edits are inside a statement, which is reparsed alone
+	TEST_ASSERT(executor.incrementalCount > 100);
+}
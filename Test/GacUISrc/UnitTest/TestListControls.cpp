@@ -0,0 +1,495 @@
+#include "TestHeadless.h"
+
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::presentation::templates;
+using namespace headless_test;
+
+TEST_HEADLESS_CASE(TestListControls_ReuseTemplatesBySelector)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto textList = new GuiBindableTextList(theme::ThemeName::TextList);
+	textList->GetBoundsComposition()->SetAlignmentToParent(Margin(0, 0, 0, 0));
+	window->AddChild(textList);
+
+	// numbers and strings use different item templates
+	textList->SetItemTemplate([](const Value& value) -> GuiListItemTemplate*
+	{
+		GuiListItemTemplate* itemTemplate = nullptr;
+		if (value.GetTypeDescriptor() == description::GetTypeDescriptor<vint>())
+		{
+			itemTemplate = new GuiListItemTemplate;
+		}
+		else
+		{
+			itemTemplate = new GuiTextListItemTemplate;
+		}
+		itemTemplate->SetReusable(true);
+		itemTemplate->SetPreferredMinSize(Size(10, 10));
+		return itemTemplate;
+	});
+
+	auto items = IValueObservableList::Create();
+	for (vint i = 0; i < 100; i++)
+	{
+		if (i % 3 == 0)
+		{
+			items->Add(BoxValue<vint>(i));
+		}
+		else
+		{
+			items->Add(BoxValue<WString>(itow(i)));
+		}
+	}
+	textList->SetItemSource(items);
+	GetHeadless()->AdvanceTime(100);
+
+	auto verticalScroll = textList->GetVerticalScroll();
+	for (vint position = 0; position <= verticalScroll->GetTotalSize(); position += 35)
+	{
+		verticalScroll->SetPosition(position);
+		GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+
+		vint visibleCount = 0;
+		for (vint i = 0; i < items->GetCount(); i++)
+		{
+			if (auto style = textList->GetArranger()->GetVisibleStyle(i))
+			{
+				visibleCount++;
+				bool isNumber = i % 3 == 0;
+				bool isTextTemplate = dynamic_cast<GuiTextListItemTemplate*>(style) != nullptr;
+				TEST_ASSERT(isNumber != isTextTemplate);
+				TEST_ASSERT(style->GetIndex() == i);
+			}
+		}
+		TEST_ASSERT(visibleCount > 0);
+	}
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestListControls_ReuseTemplatesBySelectorOnValue)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto textList = new GuiBindableTextList(theme::ThemeName::TextList);
+	textList->GetBoundsComposition()->SetAlignmentToParent(Margin(0, 0, 0, 0));
+	window->AddChild(textList);
+
+	// even and odd numbers use different item templates, so templates cannot be chosen by the type of items
+	textList->SetItemTemplate([](const Value& value) -> GuiListItemTemplate*
+	{
+		GuiListItemTemplate* itemTemplate = nullptr;
+		if (UnboxValue<vint>(value) % 2 == 0)
+		{
+			itemTemplate = new GuiListItemTemplate;
+		}
+		else
+		{
+			itemTemplate = new GuiTextListItemTemplate;
+		}
+		itemTemplate->SetReusable(true);
+		itemTemplate->SetPreferredMinSize(Size(10, 10));
+		return itemTemplate;
+	});
+
+	auto items = IValueObservableList::Create();
+	for (vint i = 0; i < 100; i++)
+	{
+		items->Add(BoxValue<vint>(i));
+	}
+	textList->SetItemSource(items);
+	GetHeadless()->AdvanceTime(100);
+
+	auto verticalScroll = textList->GetVerticalScroll();
+	for (vint position = 0; position <= verticalScroll->GetTotalSize(); position += 35)
+	{
+		verticalScroll->SetPosition(position);
+		GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+
+		for (vint i = 0; i < items->GetCount(); i++)
+		{
+			if (auto style = textList->GetArranger()->GetVisibleStyle(i))
+			{
+				bool isEven = i % 2 == 0;
+				bool isTextTemplate = dynamic_cast<GuiTextListItemTemplate*>(style) != nullptr;
+				TEST_ASSERT(isEven != isTextTemplate);
+			}
+		}
+	}
+
+	DestroyTestWindow(window);
+}
+
+namespace list_controls_test
+{
+	vint GetVariableItemHeight(vint value)
+	{
+		return 10 + value % 4 * 5;
+	}
+
+	void CheckVariableHeightItems(GuiBindableTextList* textList, Ptr<IValueObservableList> items)
+	{
+		// visit the whole list, every visible item is placed right after the previous one using its own height
+		auto verticalScroll = textList->GetVerticalScroll();
+		vint position = 0;
+		verticalScroll->SetPosition(0);
+		GetHeadless()->AdvanceTime(100);
+		while (true)
+		{
+			vint visibleCount = 0;
+			vint previousBottom = -1;
+			for (vint i = 0; i < items->GetCount(); i++)
+			{
+				if (auto style = textList->GetArranger()->GetVisibleStyle(i))
+				{
+					visibleCount++;
+					auto bounds = style->GetGlobalBounds();
+					TEST_ASSERT(style->GetIndex() == i);
+					TEST_ASSERT(bounds.Height() == GetVariableItemHeight(UnboxValue<vint>(items->Get(i))));
+					TEST_ASSERT(previousBottom == -1 || previousBottom == bounds.Top());
+					previousBottom = bounds.Bottom();
+				}
+			}
+			TEST_ASSERT(visibleCount > 0);
+
+			if (position >= verticalScroll->GetMaxPosition()) break;
+			position += 37;
+			verticalScroll->SetPosition(position);
+			GetHeadless()->AdvanceTime(100);
+		}
+
+		// all items are measured now, the total size is the sum of all heights
+		vint totalHeight = 0;
+		for (vint i = 0; i < items->GetCount(); i++)
+		{
+			totalHeight += GetVariableItemHeight(UnboxValue<vint>(items->Get(i)));
+		}
+		TEST_ASSERT(verticalScroll->GetTotalSize() == totalHeight);
+	}
+}
+using namespace list_controls_test;
+
+TEST_HEADLESS_CASE(TestListControls_VariableHeightArranger)
+{
+	auto window = CreateTestWindow(Size(100, 100));
+	auto textList = new GuiBindableTextList(theme::ThemeName::TextList);
+	textList->GetBoundsComposition()->SetAlignmentToParent(Margin(0, 0, 0, 0));
+	textList->SetArranger(MakePtr<list::VariableHeightItemArranger>());
+	window->AddChild(textList);
+
+	textList->SetItemTemplate([](const Value& value) -> GuiListItemTemplate*
+	{
+		auto itemTemplate = new GuiTextListItemTemplate;
+		itemTemplate->SetPreferredMinSize(Size(10, GetVariableItemHeight(UnboxValue<vint>(value))));
+		return itemTemplate;
+	});
+
+	auto items = IValueObservableList::Create();
+	for (vint i = 0; i < 200; i++)
+	{
+		items->Add(BoxValue<vint>(i));
+	}
+	textList->SetItemSource(items);
+	CheckVariableHeightItems(textList, items);
+
+	// splice items in and out of the middle of the list
+	for (vint i = 0; i < 20; i++)
+	{
+		items->Insert(50 + i, BoxValue<vint>(1001 + i * 3));
+	}
+	for (vint i = 0; i < 30; i++)
+	{
+		items->RemoveAt(120);
+	}
+	CheckVariableHeightItems(textList, items);
+
+	for (vint i = 0; i < 10; i++)
+	{
+		items->RemoveAt(0);
+	}
+	items->Add(BoxValue<vint>(2002));
+	CheckVariableHeightItems(textList, items);
+
+	DestroyTestWindow(window);
+}
+
+namespace list_controls_test
+{
+	void CheckVisibleNodes(tree::MemoryNodeRootProvider* root)
+	{
+		// the optimized algorithm agrees with the default one that visits all previous sibling nodes
+		vint total = root->CalculateTotalVisibleNodes();
+		for (vint i = 0; i < total; i++)
+		{
+			auto node = root->GetNodeByVisibleIndex(i);
+			TEST_ASSERT(node != nullptr);
+			TEST_ASSERT(root->GetVisibleIndexByNode(node) == i);
+			TEST_ASSERT(root->tree::INodeRootProvider::GetVisibleIndexByNode(node) == i);
+		}
+		TEST_ASSERT(root->GetNodeByVisibleIndex(total) == nullptr);
+	}
+
+	Ptr<tree::MemoryNodeProvider> CreateMemoryNode(vint childCount, bool expanding)
+	{
+		auto node = MakePtr<tree::MemoryNodeProvider>();
+		for (vint i = 0; i < childCount; i++)
+		{
+			node->Children().Add(MakePtr<tree::MemoryNodeProvider>());
+		}
+		node->SetExpanding(expanding);
+		return node;
+	}
+}
+
+TEST_CASE(TestListControls_MemoryNodeVisibleIndex)
+{
+	auto root = MakePtr<tree::TreeViewItemRootProvider>();
+	for (vint i = 0; i < 50; i++)
+	{
+		root->Children().Add(CreateMemoryNode(i % 5, i % 2 == 0));
+	}
+	CheckVisibleNodes(root.Obj());
+
+	// nodes under a collapsed node are not visible
+	auto collapsed = root->Children()[3];
+	TEST_ASSERT(collapsed->Children().Count() == 3);
+	TEST_ASSERT(root->GetVisibleIndexByNode(collapsed->Children()[0].Obj()) == -1);
+
+	// insert and remove sub nodes in the middle
+	root->Children().Insert(20, CreateMemoryNode(7, true));
+	root->Children().Insert(0, CreateMemoryNode(2, true));
+	root->Children().RemoveAt(31);
+	root->Children().RemoveRange(10, 5);
+	CheckVisibleNodes(root.Obj());
+
+	// modify nodes deeper in the tree
+	auto child = root->Children()[20];
+	child->Children().Insert(3, CreateMemoryNode(4, true));
+	child->Children()[0]->Children().Add(MakePtr<tree::MemoryNodeProvider>());
+	child->Children()[0]->SetExpanding(true);
+	child->Children().RemoveAt(1);
+	CheckVisibleNodes(root.Obj());
+
+	child->SetExpanding(false);
+	CheckVisibleNodes(root.Obj());
+	child->SetExpanding(true);
+	collapsed->SetExpanding(true);
+	CheckVisibleNodes(root.Obj());
+
+	root->Children().Clear();
+	TEST_ASSERT(root->CalculateTotalVisibleNodes() == 1);
+	CheckVisibleNodes(root.Obj());
+}
+
+namespace list_controls_test
+{
+	class ThresholdFilter : public list::DataFilterBase
+	{
+	public:
+		vint							threshold = 0;
+
+		void SetThreshold(vint value)
+		{
+			threshold = value;
+			InvokeOnProcessorChanged();
+		}
+
+		bool Filter(const Value& row)override
+		{
+			return UnboxValue<vint>(row) < threshold;
+		}
+	};
+
+	class IntegerSorter : public list::DataSorterBase
+	{
+	public:
+		vint Compare(const Value& row1, const Value& row2)override
+		{
+			return UnboxValue<vint>(row1) - UnboxValue<vint>(row2);
+		}
+	};
+
+	class IntegerKeySorter : public IntegerSorter
+	{
+	public:
+		bool GetSortKey(const Value& row, double& key)override
+		{
+			key = (double)UnboxValue<vint>(row);
+			return true;
+		}
+	};
+
+	class ItemModifiedRecorder : public Object, public virtual GuiListControl::IItemProviderCallback
+	{
+	public:
+		List<Rect>						modifications;
+
+		void OnAttached(GuiListControl::IItemProvider* provider)override
+		{
+		}
+
+		void OnItemModified(vint start, vint count, vint newCount)override
+		{
+			modifications.Add(Rect(start, count, newCount, 0));
+		}
+	};
+
+	void CheckDataRows(list::DataProvider& provider, vint threshold, bool ascending)
+	{
+		TEST_ASSERT(provider.Count() == threshold);
+		for (vint i = 0; i < threshold; i++)
+		{
+			vint value = UnboxValue<vint>(provider.GetBindingValue(i));
+			TEST_ASSERT(value == (ascending ? i : threshold - i - 1));
+		}
+	}
+}
+
+TEST_HEADLESS_CASE(TestListControls_DataProviderRefilter)
+{
+	auto items = IValueObservableList::Create();
+	for (vint i = 0; i < 1000; i++)
+	{
+		items->Add(BoxValue<vint>(i * 37 % 1000));
+	}
+
+	list::DataProvider provider;
+	ItemModifiedRecorder recorder;
+	auto filter = MakePtr<ThresholdFilter>();
+	auto column = MakePtr<list::DataColumn>();
+	provider.GetColumns().Add(column);
+	column->SetFilter(filter);
+	column->SetSorter(MakePtr<IntegerSorter>());
+	provider.SetItemSource(items);
+	provider.SortByColumn(0, true);
+	filter->SetThreshold(500);
+	GuiListControl::IItemProvider* itemProvider = &provider;
+	itemProvider->AttachCallback(&recorder);
+	recorder.modifications.Clear();
+	CheckDataRows(provider, 500, true);
+
+	// changing the filter only reports rows that appear or disappear
+	filter->SetThreshold(510);
+	CheckDataRows(provider, 510, true);
+	TEST_ASSERT(recorder.modifications.Count() == 1);
+	TEST_ASSERT(recorder.modifications[0] == Rect(500, 0, 10, 0));
+
+	filter->SetThreshold(490);
+	CheckDataRows(provider, 490, true);
+	TEST_ASSERT(recorder.modifications.Count() == 2);
+	TEST_ASSERT(recorder.modifications[1] == Rect(490, 20, 0, 0));
+
+	filter->SetThreshold(490);
+	TEST_ASSERT(recorder.modifications.Count() == 2);
+
+	// changing the sorter reorders all rows, and the following filter change is incremental again
+	provider.SortByColumn(0, false);
+	CheckDataRows(provider, 490, false);
+	TEST_ASSERT(recorder.modifications.Count() == 3);
+	TEST_ASSERT(recorder.modifications[2] == Rect(0, 490, 490, 0));
+
+	filter->SetThreshold(495);
+	CheckDataRows(provider, 495, false);
+	TEST_ASSERT(recorder.modifications.Count() == 4);
+	TEST_ASSERT(recorder.modifications[3] == Rect(0, 0, 5, 0));
+
+	itemProvider->DetachCallback(&recorder);
+	provider.SetItemSource(nullptr);
+}
+
+namespace list_controls_test
+{
+	void WaitForModifications(ItemModifiedRecorder& recorder, vint count)
+	{
+		for (vint i = 0; i < 5000 && recorder.modifications.Count() < count; i++)
+		{
+			GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+			Thread::Sleep(1);
+		}
+		TEST_ASSERT(recorder.modifications.Count() == count);
+	}
+}
+
+TEST_HEADLESS_CASE(TestListControls_DataProviderParallelReorder)
+{
+	const vint RowCount = 100000;
+	auto items = IValueObservableList::Create();
+	for (vint i = 0; i < RowCount; i++)
+	{
+		items->Add(BoxValue<vint>(i * 7919 % RowCount));
+	}
+
+	list::DataProvider provider;
+	ItemModifiedRecorder recorder;
+	auto column = MakePtr<list::DataColumn>();
+	provider.GetColumns().Add(column);
+	column->SetSorter(MakePtr<IntegerKeySorter>());
+	provider.SetParallelProcessing(true);
+	provider.SetItemSource(items);
+	GuiListControl::IItemProvider* itemProvider = &provider;
+	itemProvider->AttachCallback(&recorder);
+	recorder.modifications.Clear();
+
+	// rows keep their order until the result is swapped in
+	provider.SortByColumn(0, true);
+	TEST_ASSERT(recorder.modifications.Count() == 0);
+	TEST_ASSERT(UnboxValue<vint>(provider.GetBindingValue(1)) == 7919);
+	WaitForModifications(recorder, 1);
+	TEST_ASSERT(recorder.modifications[0] == Rect(0, RowCount, RowCount, 0));
+	CheckDataRows(provider, RowCount, true);
+
+	// a replaced reordering never swaps in its result
+	provider.SortByColumn(0, false);
+	provider.SortByColumn(0, true);
+	WaitForModifications(recorder, 2);
+	for (vint i = 0; i < 100; i++)
+	{
+		GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+		Thread::Sleep(1);
+	}
+	TEST_ASSERT(recorder.modifications.Count() == 2);
+	CheckDataRows(provider, RowCount, true);
+
+	// rows modified during a reordering are placed when the result arrives
+	provider.SortByColumn(0, false);
+	items->Add(BoxValue<vint>(RowCount));
+	WaitForModifications(recorder, 3);
+	CheckDataRows(provider, RowCount + 1, false);
+
+	// a steady stream of modifications does not keep the result from arriving
+	provider.SortByColumn(0, true);
+	vint added = 0;
+	for (vint i = 0; i < 5000 && recorder.modifications.Count() < 4; i++)
+	{
+		items->Add(BoxValue<vint>(RowCount + 1 + added++));
+		GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+		Thread::Sleep(1);
+	}
+	TEST_ASSERT(recorder.modifications.Count() == 4);
+	CheckDataRows(provider, RowCount + 1 + added, true);
+
+	// deleting the data provider stops the background thread and drops the result
+	{
+		auto deletedItems = IValueList::Create();
+		for (vint i = 0; i < RowCount; i++)
+		{
+			deletedItems->Add(BoxValue<vint>(i));
+		}
+
+		list::DataProvider deletedProvider;
+		auto deletedColumn = MakePtr<list::DataColumn>();
+		deletedProvider.GetColumns().Add(deletedColumn);
+		deletedColumn->SetSorter(MakePtr<IntegerSorter>());
+		deletedProvider.SetParallelProcessing(true);
+		deletedProvider.SetItemSource(deletedItems);
+		deletedProvider.SortByColumn(0, false);
+	}
+	for (vint i = 0; i < 100; i++)
+	{
+		GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+		Thread::Sleep(1);
+	}
+
+	itemProvider->DetachCallback(&recorder);
+	provider.SetItemSource(nullptr);
+}
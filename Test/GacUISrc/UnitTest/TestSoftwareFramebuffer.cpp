@@ -0,0 +1,114 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/GraphicsElement/Headless/GuiGraphicsSoftware.h"
+
+using namespace vl;
+using namespace vl::presentation;
+using namespace vl::presentation::elements_headless;
+
+namespace software_framebuffer_test
+{
+	unsigned char BlendChannel(vuint32_t source, vuint32_t alpha, vuint32_t destination)
+	{
+		vuint32_t x = source * alpha + destination * (255 - alpha);
+		return (unsigned char)((x + 0x80 + (x >> 8)) >> 8);
+	}
+
+	Color BlendPixel(Color source, Color destination)
+	{
+		return Color(
+			BlendChannel(source.r, source.a, destination.r),
+			BlendChannel(source.g, source.a, destination.g),
+			BlendChannel(source.b, source.a, destination.b),
+			BlendChannel(255, source.a, destination.a)
+			);
+	}
+
+	Color GetBackground(vint x, vint y)
+	{
+		return Color((unsigned char)(x * 17), (unsigned char)(y * 31), (unsigned char)(x * y), (unsigned char)(255 - x));
+	}
+
+	void FillBackground(SoftwareFramebuffer& framebuffer)
+	{
+		auto size = framebuffer.GetSize();
+		for (vint y = 0; y < size.y; y++)
+		{
+			for (vint x = 0; x < size.x; x++)
+			{
+				framebuffer.GetScanLine(y)[x] = GetBackground(x, y).value;
+			}
+		}
+	}
+}
+using namespace software_framebuffer_test;
+
+TEST_CASE(TestSoftwareFramebuffer_Clear)
+{
+	for (vint width = 0; width < 10; width++)
+	{
+		SoftwareFramebuffer framebuffer(Size(width, 3), Color(1, 2, 3, 4));
+		for (vint y = 0; y < 3; y++)
+		{
+			for (vint x = 0; x < width; x++)
+			{
+				TEST_ASSERT(framebuffer.GetPixel(x, y) == Color(1, 2, 3, 4));
+			}
+		}
+		framebuffer.Clear(Color(5, 6, 7, 0));
+		for (vint y = 0; y < 3; y++)
+		{
+			for (vint x = 0; x < width; x++)
+			{
+				TEST_ASSERT(framebuffer.GetPixel(x, y) == Color(5, 6, 7, 0));
+			}
+		}
+	}
+}
+
+TEST_CASE(TestSoftwareFramebuffer_FillSpan)
+{
+	// spans of all lengths and offsets cover both the vectorized part and the remaining pixels
+	Color colors[] = { Color(10, 20, 30, 255), Color(200, 100, 50, 128), Color(255, 255, 255, 1), Color(0, 0, 0, 254), Color(90, 180, 45, 0) };
+	SoftwareFramebuffer framebuffer(Size(24, 1));
+	for (auto color : colors)
+	{
+		for (vint x1 = 0; x1 < 4; x1++)
+		{
+			for (vint x2 = x1; x2 <= 20; x2++)
+			{
+				FillBackground(framebuffer);
+				framebuffer.FillSpan(0, x1, x2, color);
+				for (vint x = 0; x < 24; x++)
+				{
+					Color expected = GetBackground(x, 0);
+					if (x1 <= x && x < x2)
+					{
+						if (color.a == 255)
+						{
+							expected = color;
+						}
+						else if (color.a > 0)
+						{
+							expected = BlendPixel(color, expected);
+						}
+					}
+					TEST_ASSERT(framebuffer.GetPixel(x, 0) == expected);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE(TestSoftwareFramebuffer_FillSpanClipped)
+{
+	SoftwareFramebuffer framebuffer(Size(24, 2), Color(0, 0, 0));
+	framebuffer.SetClipper(Rect(3, 0, 13, 1));
+	framebuffer.FillSpan(0, 0, 24, Color(255, 0, 0, 128));
+	framebuffer.FillSpan(1, 0, 24, Color(255, 0, 0, 128));
+	for (vint x = 0; x < 24; x++)
+	{
+		Color expected = 3 <= x && x < 13 ? BlendPixel(Color(255, 0, 0, 128), Color(0, 0, 0)) : Color(0, 0, 0);
+		TEST_ASSERT(framebuffer.GetPixel(x, 0) == expected);
+		TEST_ASSERT(framebuffer.GetPixel(x, 1) == Color(0, 0, 0));
+	}
+}
@@ -0,0 +1,127 @@
+#include "TestHeadless.h"
+
+using namespace vl::collections;
+using namespace headless_test;
+
+namespace headless_test
+{
+	class TestAutoComplete : public GuiTextBoxAutoCompleteBase
+	{
+	public:
+		using GuiTextBoxAutoCompleteBase::MatchedCandidates;
+		using GuiTextBoxAutoCompleteBase::matchedHistory;
+		using GuiTextBoxAutoCompleteBase::autoCompleteControlProvider;
+
+		void SetCandidates(const wchar_t** texts, vint count)
+		{
+			List<AutoCompleteItem> items;
+			for (vint i = 0; i < count; i++)
+			{
+				AutoCompleteItem item;
+				item.text = texts[i];
+				items.Add(item);
+			}
+			SetListContent(items);
+		}
+
+		WString GetListedItems()
+		{
+			WString result;
+			for (vint i = 0; i < autoCompleteControlProvider->GetItemCount(); i++)
+			{
+				if (i > 0) result += L",";
+				result += autoCompleteControlProvider->GetItemText(i);
+			}
+			return result;
+		}
+
+		Ptr<MatchedCandidates> GetLastMatched()
+		{
+			return matchedHistory[matchedHistory.Count() - 1];
+		}
+	};
+
+	TestAutoComplete* CreateTestAutoComplete(GuiWindow* window)
+	{
+		auto textBox = new GuiMultilineTextBox(theme::ThemeName::MultilineTextBox);
+		textBox->GetBoundsComposition()->SetAlignmentToParent(Margin(0, 0, 0, 0));
+		window->AddChild(textBox);
+
+		// the text box owns the auto complete, so that its popup is deleted with the window
+		auto autoComplete = new TestAutoComplete;
+		textBox->SetAutoComplete(autoComplete);
+		GetHeadless()->AdvanceTime(IHeadlessController::TimerInterval);
+		autoComplete->OpenList(TextPos(0, 0));
+		TEST_ASSERT(autoComplete->IsListOpening());
+		return autoComplete;
+	}
+}
+
+TEST_HEADLESS_CASE(TestTextAutoComplete_RankNarrowAndBackspace)
+{
+	auto window = CreateTestWindow(Size(300, 300));
+	auto autoComplete = CreateTestAutoComplete(window);
+	const wchar_t* texts[] = { L"value", L"Gravity", L"getValue", L"navigate", L"gv", L"setValue", L"GetVariable" };
+	autoComplete->SetCandidates(texts, sizeof(texts) / sizeof(*texts));
+	TEST_ASSERT(autoComplete->GetListedItems() == L"getValue,GetVariable,Gravity,gv,navigate,setValue,value");
+
+	// an exact match goes first, then word start matches, ties keep the sorted order
+	autoComplete->HighlightList(L"g");
+	TEST_ASSERT(autoComplete->matchedHistory.Count() == 2);
+	TEST_ASSERT(autoComplete->GetLastMatched()->candidates.Count() == 5);
+	autoComplete->HighlightList(L"gV");
+	TEST_ASSERT(autoComplete->GetListedItems() == L"gv,getValue,GetVariable,Gravity");
+	TEST_ASSERT(autoComplete->GetSelectedListItem() == L"gv");
+
+	// a longer pattern only checks candidates matched by the previous pattern
+	TEST_ASSERT(autoComplete->matchedHistory.Count() == 3);
+	auto matchedG = autoComplete->matchedHistory[1];
+	auto matchedGV = autoComplete->matchedHistory[2];
+	FOREACH(vint, candidate, matchedGV->candidates)
+	{
+		TEST_ASSERT(matchedG->candidates.Contains(candidate));
+	}
+	autoComplete->HighlightList(L"gva");
+	TEST_ASSERT(autoComplete->GetListedItems() == L"getValue,GetVariable");
+	TEST_ASSERT(autoComplete->matchedHistory.Count() == 4);
+
+	// deleting characters returns to previous results without matching again
+	autoComplete->HighlightList(L"gv");
+	TEST_ASSERT(autoComplete->matchedHistory.Count() == 3);
+	TEST_ASSERT(autoComplete->GetLastMatched() == matchedGV);
+	TEST_ASSERT(autoComplete->GetListedItems() == L"gv,getValue,GetVariable,Gravity");
+	autoComplete->HighlightList(L"");
+	TEST_ASSERT(autoComplete->matchedHistory.Count() == 1);
+	TEST_ASSERT(autoComplete->GetListedItems() == L"getValue,GetVariable,Gravity,gv,navigate,setValue,value");
+
+	// replacing the pattern matches from all candidates again
+	autoComplete->HighlightList(L"gv");
+	autoComplete->HighlightList(L"sv");
+	TEST_ASSERT(autoComplete->matchedHistory.Count() == 2);
+	TEST_ASSERT(autoComplete->GetListedItems() == L"setValue");
+
+	DestroyTestWindow(window);
+}
+
+TEST_HEADLESS_CASE(TestTextAutoComplete_ListOnlyBestMatches)
+{
+	auto window = CreateTestWindow(Size(300, 300));
+	auto autoComplete = CreateTestAutoComplete(window);
+	List<WString> texts;
+	List<const wchar_t*> buffers;
+	for (vint i = 0; i < 150; i++)
+	{
+		texts.Add(L"item" + itow(i));
+	}
+	FOREACH(WString, text, texts)
+	{
+		buffers.Add(text.Buffer());
+	}
+	autoComplete->SetCandidates(&buffers[0], buffers.Count());
+	TEST_ASSERT(autoComplete->autoCompleteControlProvider->GetItemCount() == GuiTextBoxAutoCompleteBase::MaxListItemCount);
+
+	autoComplete->HighlightList(L"item14");
+	TEST_ASSERT(autoComplete->GetListedItems() == L"item14,item140,item141,item142,item143,item144,item145,item146,item147,item148,item149,item104,item114,item124,item134");
+
+	DestroyTestWindow(window);
+}
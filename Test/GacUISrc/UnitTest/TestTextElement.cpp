@@ -0,0 +1,647 @@
+#include "TestHeadless.h"
+
+using namespace vl::collections;
+using namespace vl::presentation::elements::text;
+using namespace headless_test;
+
+namespace text_element_test
+{
+	class TestTextLineList : public TextLineList
+	{
+	public:
+		vint GetBlockCount()
+		{
+			return blockTree.Count();
+		}
+
+		vint GetBlockSize(vint block)
+		{
+			return blockTree.Get(blockTree.GetHandle(block)).lineCount;
+		}
+
+		vint GetMaterializedBlockCount()
+		{
+			vint materialized = 0;
+			for (vint i = 0; i < blocks.Count(); i++)
+			{
+				if (blocks[i] && blocks[i]->lines.Count() > 0)
+				{
+					materialized++;
+				}
+			}
+			return materialized;
+		}
+	};
+
+	TextLine CreateLine(vint id)
+	{
+		// lexerFinalState identifies lines without allocating buffers
+		TextLine line;
+		line.lexerFinalState = id;
+		return line;
+	}
+
+	void CheckLines(TestTextLineList& lines, List<vint>& expected)
+	{
+		TEST_ASSERT(lines.Count() == expected.Count());
+		for (vint i = 0; i < expected.Count(); i++)
+		{
+			TEST_ASSERT(lines[i].lexerFinalState == expected[i]);
+		}
+
+		// reading backward does not depend on the cached block of the forward scan
+		for (vint i = expected.Count() - 1; i >= 0; i--)
+		{
+			TEST_ASSERT(lines[i].lexerFinalState == expected[i]);
+		}
+
+		vint total = 0;
+		vint blockCount = lines.GetBlockCount();
+		for (vint i = 0; i < blockCount; i++)
+		{
+			vint size = lines.GetBlockSize(i);
+			TEST_ASSERT(size <= TextLineList::MaxBlockSize);
+			// only the last block could be small, because appending lines starts a new block
+			if (i < blockCount - 1)
+			{
+				TEST_ASSERT(size >= TextLineList::MaxBlockSize / 2);
+			}
+			total += size;
+		}
+		TEST_ASSERT(total == expected.Count());
+	}
+
+	void AddLines(TestTextLineList& lines, List<vint>& expected, vint count)
+	{
+		for (vint i = 0; i < count; i++)
+		{
+			vint id = expected.Count();
+			lines.Add(CreateLine(id));
+			expected.Add(id);
+		}
+	}
+
+	void RemoveLines(TestTextLineList& lines, List<vint>& expected, vint index, vint count)
+	{
+		lines.RemoveRange(index, count);
+		expected.RemoveRange(index, count);
+		CheckLines(lines, expected);
+	}
+
+	// 40 characters cover two full 16 bytes chunks and the remaining characters for both 2 and 4 bytes wchar_t
+	const vint ScanningLength = 40;
+
+	void CheckScanning(const wchar_t* (*scan)(const wchar_t*, const wchar_t*), const List<wchar_t>& targets, const List<wchar_t>& others)
+	{
+		wchar_t buffer[ScanningLength + 1];
+		for (vint length = 0; length <= ScanningLength; length++)
+		{
+			for (vint i = 0; i <= ScanningLength; i++) buffer[i] = L'a';
+
+			// nothing is found, and the character after the range is not read
+			for (vint targetIndex = 0; targetIndex < targets.Count(); targetIndex++)
+			{
+				wchar_t target = targets[targetIndex];
+				buffer[length] = target;
+				TEST_ASSERT(scan(buffer, buffer + length) == buffer + length);
+			}
+			buffer[length] = L'a';
+
+			for (vint position = 0; position < length; position++)
+			{
+				// characters that are not targets are skipped, including those which are only partially equal to a target
+				for (vint otherIndex = 0; otherIndex < others.Count(); otherIndex++)
+				{
+					wchar_t other = others[otherIndex];
+					buffer[position] = other;
+					TEST_ASSERT(scan(buffer, buffer + length) == buffer + length);
+				}
+
+				for (vint targetIndex = 0; targetIndex < targets.Count(); targetIndex++)
+				{
+					wchar_t target = targets[targetIndex];
+					buffer[position] = target;
+					TEST_ASSERT(scan(buffer, buffer + length) == buffer + position);
+					if (position + 1 < length)
+					{
+						buffer[position + 1] = target;
+						TEST_ASSERT(scan(buffer, buffer + length) == buffer + position);
+						TEST_ASSERT(scan(buffer + position + 1, buffer + length) == buffer + position + 1);
+						buffer[position + 1] = L'a';
+					}
+				}
+				buffer[position] = L'a';
+			}
+		}
+	}
+
+	bool CheckFind(TextLines& lines, const WString& pattern, bool caseSensitive, bool forward, TextPos position, TextMatch expected)
+	{
+		TextMatch match;
+		return lines.Find(pattern, caseSensitive, forward, position, match) && match == expected;
+	}
+
+	bool CheckFind(TextLines& lines, const regex::Regex& pattern, bool forward, TextPos position, TextMatch expected)
+	{
+		TextMatch match;
+		return lines.Find(pattern, forward, position, match) && match == expected;
+	}
+
+	bool CheckNotFound(TextLines& lines, const WString& pattern, bool caseSensitive)
+	{
+		TextMatch match;
+		List<TextMatch> matches;
+		return !lines.Find(pattern, caseSensitive, true, TextPos(0, 0), match) && lines.FindAll(pattern, caseSensitive, matches) == 0;
+	}
+
+	void CheckLineBreaks(const wchar_t* input, vint inputCount, const WString* expectedLines, vint expectedCount)
+	{
+		TextLines lines(nullptr);
+		lines.Modify(TextPos(0, 0), TextPos(0, 0), input, inputCount);
+		TEST_ASSERT(lines.GetCount() == expectedCount);
+		for (vint i = 0; i < expectedCount; i++)
+		{
+			TEST_ASSERT(lines.GetText(TextPos(i, 0), TextPos(i, lines.GetLine(i).dataLength)) == expectedLines[i]);
+		}
+	}
+}
+using namespace text_element_test;
+
+TEST_CASE(TestTextElement_TextLineListInsert)
+{
+	const vint BlockSize = TextLineList::MaxBlockSize;
+	TestTextLineList lines;
+	List<vint> expected;
+	AddLines(lines, expected, BlockSize * 3);
+	CheckLines(lines, expected);
+
+	// inserting at block boundaries and into a full block
+	vint inserting[] = { 0, BlockSize - 1, BlockSize, BlockSize + 1, BlockSize * 2, expected.Count() };
+	vint id = -1;
+	for (auto index : inserting)
+	{
+		for (vint i = 0; i < BlockSize / 2; i++)
+		{
+			lines.Insert(index, CreateLine(id));
+			expected.Insert(index, id);
+			id--;
+		}
+		CheckLines(lines, expected);
+	}
+}
+
+TEST_CASE(TestTextElement_TextLineListRemoveAt)
+{
+	const vint BlockSize = TextLineList::MaxBlockSize;
+	TestTextLineList lines;
+	List<vint> expected;
+	AddLines(lines, expected, BlockSize * 4);
+
+	// shrinking a block under half capacity merges it with or borrows from a neighbour
+	for (vint i = 0; i < BlockSize; i++)
+	{
+		vint index = BlockSize + BlockSize / 2;
+		lines.RemoveAt(index);
+		expected.RemoveAt(index);
+	}
+	CheckLines(lines, expected);
+
+	// removing from both ends
+	while (expected.Count() > BlockSize / 2)
+	{
+		lines.RemoveAt(0);
+		expected.RemoveAt(0);
+		lines.RemoveAt(expected.Count() - 1);
+		expected.RemoveAt(expected.Count() - 1);
+	}
+	CheckLines(lines, expected);
+	TEST_ASSERT(lines.GetBlockCount() == 1);
+}
+
+TEST_CASE(TestTextElement_TextLineListRemoveRange)
+{
+	const vint BlockSize = TextLineList::MaxBlockSize;
+	{
+		// within one block
+		TestTextLineList lines;
+		List<vint> expected;
+		AddLines(lines, expected, BlockSize * 3);
+		RemoveLines(lines, expected, BlockSize + 1, BlockSize - 2);
+		RemoveLines(lines, expected, 0, BlockSize / 2);
+	}
+	{
+		// across a block boundary, leaving two small neighbours
+		TestTextLineList lines;
+		List<vint> expected;
+		AddLines(lines, expected, BlockSize * 4);
+		RemoveLines(lines, expected, BlockSize + 10, BlockSize - 20);
+		RemoveLines(lines, expected, 10, expected.Count() - 20);
+	}
+	{
+		// across several blocks, removing whole blocks in the middle
+		TestTextLineList lines;
+		List<vint> expected;
+		AddLines(lines, expected, BlockSize * 6);
+		RemoveLines(lines, expected, BlockSize / 2, BlockSize * 3);
+		RemoveLines(lines, expected, BlockSize, expected.Count() - BlockSize);
+		RemoveLines(lines, expected, 0, expected.Count());
+		AddLines(lines, expected, BlockSize * 2);
+		CheckLines(lines, expected);
+	}
+	{
+		// every start and length around block boundaries
+		for (vint index = BlockSize - 2; index <= BlockSize + 2; index++)
+		{
+			for (vint count = 1; count <= BlockSize * 2; count += BlockSize / 4 - 1)
+			{
+				TestTextLineList lines;
+				List<vint> expected;
+				AddLines(lines, expected, BlockSize * 4);
+				RemoveLines(lines, expected, index, count);
+			}
+		}
+	}
+}
+
+TEST_CASE(TestTextElement_TextLineListMaxWidth)
+{
+	const vint BlockSize = TextLineList::MaxBlockSize;
+	TestTextLineList lines;
+	List<vint> expected;
+	AddLines(lines, expected, BlockSize * 3);
+
+	// the width of a line is its id
+	vint measured = 0;
+	auto measureLine = [&](TextLine& line)
+	{
+		measured++;
+		return line.lexerFinalState;
+	};
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == BlockSize * 3 - 1);
+	TEST_ASSERT(measured == BlockSize * 3);
+
+	// nothing is measured again when nothing changed
+	measured = 0;
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == BlockSize * 3 - 1);
+	TEST_ASSERT(measured == 0);
+
+	// editing the widest line makes the maximum drop, and only its block is measured again
+	lines[BlockSize * 3 - 1].lexerFinalState = 10;
+	lines.InvalidateWidth(BlockSize * 3 - 1);
+	measured = 0;
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == BlockSize * 3 - 2);
+	TEST_ASSERT(measured == BlockSize);
+
+	// deleting the widest line makes the maximum drop
+	lines.RemoveAt(BlockSize * 3 - 2);
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == BlockSize * 3 - 3);
+
+	// deleting the whole block that contains the widest lines
+	lines.RemoveRange(BlockSize * 2, lines.Count() - BlockSize * 2);
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == BlockSize * 2 - 1);
+
+	// editing a line in another block makes it the widest one
+	lines[10].lexerFinalState = BlockSize * 5;
+	lines.InvalidateWidth(10);
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == BlockSize * 5);
+	lines[10].lexerFinalState = 0;
+	lines.InvalidateWidth(10);
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == BlockSize * 2 - 1);
+
+	// deleting a range across blocks merges them and keeps the maximum of what remains
+	lines.RemoveRange(BlockSize / 2, BlockSize * 3 / 2 - 1);
+	TEST_ASSERT(lines.Count() == BlockSize / 2 + 1);
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == BlockSize * 2 - 1);
+	lines.RemoveAt(lines.Count() - 1);
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == BlockSize / 2 - 1);
+
+	lines.RemoveRange(0, lines.Count());
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == 0);
+}
+
+TEST_CASE(TestTextElement_TextLineListAppendText)
+{
+	const vint BlockSize = TextLineList::MaxBlockSize;
+	TestTextLineList lines;
+	for (vint i = 0; i < BlockSize * 100; i++)
+	{
+		lines.AppendLine();
+		WString text = itow(i);
+		lines.AppendText(text.Buffer(), text.Length());
+		lines.AppendText(L"!", 1);
+	}
+	TEST_ASSERT(lines.Count() == BlockSize * 100);
+	TEST_ASSERT(lines.GetBlockCount() == 100);
+	TEST_ASSERT(lines.GetMaterializedBlockCount() == 0);
+
+	// measuring does not create text lines
+	auto measureLine = [](TextLine& line)
+	{
+		return line.dataLength;
+	};
+	TEST_ASSERT(lines.GetMaxWidth(measureLine) == itow(BlockSize * 100 - 1).Length() + 1);
+	TEST_ASSERT(lines.GetMaterializedBlockCount() == 0);
+
+	// only the block of an accessed text line creates its text lines
+	vint index = BlockSize * 50 + 7;
+	TextLine& line = lines[index];
+	TEST_ASSERT(WString(line.text, line.dataLength) == itow(index) + L"!");
+	TEST_ASSERT(lines.GetMaterializedBlockCount() == 1);
+
+	// removing whole blocks does not create their text lines
+	lines.RemoveRange(BlockSize * 10, BlockSize * 20);
+	TEST_ASSERT(lines.GetMaterializedBlockCount() == 1);
+	TEST_ASSERT(WString(lines[BlockSize * 10].text, lines[BlockSize * 10].dataLength) == itow(BlockSize * 30) + L"!");
+	TEST_ASSERT(lines.GetMaterializedBlockCount() == 2);
+
+	// appending after created text lines creates the text line
+	lines.RemoveRange(BlockSize * 11, lines.Count() - BlockSize * 11);
+	lines.AppendLine();
+	lines.AppendText(L"last", 4);
+	TEST_ASSERT(WString(lines[lines.Count() - 1].text, (vint)4) == L"last");
+	lines.Clear();
+	TEST_ASSERT(lines.Count() == 0);
+	TEST_ASSERT(lines.GetBlockCount() == 0);
+}
+
+TEST_CASE(TestTextElement_LoadText)
+{
+	const vint ChunkSize = TextLines::LoadBufferSize;
+	for (vint shift = 0; shift < 3; shift++)
+	{
+		// a huge line covers several chunks, and the CRLF after it crosses two chunks when shift is 0
+		List<WString> expected;
+		expected.Add(L"first" + WString(L"xx").Left(shift));
+		{
+			Array<wchar_t> buffer(ChunkSize * 3 - 8 + 1);
+			for (vint i = 0; i < buffer.Count() - 1; i++)
+			{
+				buffer[i] = (wchar_t)(L'a' + i % 26);
+			}
+			buffer[buffer.Count() - 1] = 0;
+			expected.Add(&buffer[0]);
+		}
+		expected.Add(L"");
+		for (vint i = 0; i < TextLineList::MaxBlockSize * 3; i++)
+		{
+			expected.Add(itow(i));
+		}
+
+		stream::MemoryStream memoryStream;
+		{
+			stream::BomEncoder encoder(stream::BomEncoder::Utf16);
+			stream::EncoderStream encoderStream(memoryStream, encoder);
+			stream::StreamWriter writer(encoderStream);
+			for (vint i = 0; i < expected.Count(); i++)
+			{
+				if (i > 0) writer.WriteString(i % 3 == 0 ? L"\n" : L"\r\n");
+				writer.WriteString(expected[i]);
+			}
+		}
+		memoryStream.SeekFromBegin(0);
+
+		TextLines lines(nullptr);
+		lines.LoadText(memoryStream);
+		TEST_ASSERT(lines.GetCount() == expected.Count());
+		for (vint i = 0; i < expected.Count(); i++)
+		{
+			TextLine& line = lines.GetLine(i);
+			TEST_ASSERT(WString(line.text, line.dataLength) == expected[i]);
+		}
+	}
+}
+
+TEST_CASE(TestTextElement_FindLineBreak)
+{
+	List<wchar_t> targets, others;
+	targets.Add(L'\r');
+	targets.Add(L'\n');
+	others.Add(L'\t');
+	others.Add((wchar_t)0x0A0D);
+	others.Add((wchar_t)0x0D00);
+	if (sizeof(wchar_t) == 4)
+	{
+		// the lower or upper 16 bits are equal to a line break
+		others.Add((wchar_t)0x0001000A);
+		others.Add((wchar_t)0x000D0000);
+	}
+	CheckScanning(&FindLineBreak, targets, others);
+}
+
+TEST_CASE(TestTextElement_FindSpecialCharacter)
+{
+	List<wchar_t> targets, others;
+	targets.Add(L'\t');
+	targets.Add((wchar_t)0xD800);
+	targets.Add((wchar_t)0xDBFF);
+	targets.Add((wchar_t)0xDC00);
+	targets.Add((wchar_t)0xDFFF);
+	others.Add(L'\r');
+	others.Add(L'\n');
+	others.Add((wchar_t)0x0909);
+	others.Add((wchar_t)0xD7FF);
+	others.Add((wchar_t)0xE000);
+	if (sizeof(wchar_t) == 4)
+	{
+		// code points above the BMP are not surrogates, even when their lower 16 bits are
+		others.Add((wchar_t)0x0001D800);
+		others.Add((wchar_t)0x0001DFFF);
+		others.Add((wchar_t)0x00090000);
+	}
+	CheckScanning(&FindSpecialCharacter, targets, others);
+}
+
+TEST_CASE(TestTextElement_ModifyLineBreaks)
+{
+	{
+		WString expected[] = { L"a", L"b" };
+		CheckLineBreaks(L"a\r\nb", 4, expected, 2);
+		CheckLineBreaks(L"a\nb", 3, expected, 2);
+		CheckLineBreaks(L"a\rb", 3, expected, 2);
+	}
+	{
+		// only CRLF is one line break
+		WString expected[] = { L"a", L"", L"b" };
+		CheckLineBreaks(L"a\n\nb", 4, expected, 3);
+		CheckLineBreaks(L"a\r\rb", 4, expected, 3);
+		CheckLineBreaks(L"a\n\rb", 4, expected, 3);
+		CheckLineBreaks(L"a\r\n\r\nb", 6, expected, 3);
+	}
+	{
+		// the character after the input is not read
+		WString expected[] = { L"a", L"" };
+		CheckLineBreaks(L"a\r\n", 2, expected, 2);
+		CheckLineBreaks(L"a\n\n", 2, expected, 2);
+	}
+	{
+		// CRLF crosses the boundary of 16 bytes chunks at every position
+		for (vint position = 0; position < ScanningLength - 1; position++)
+		{
+			wchar_t buffer[ScanningLength + 1];
+			for (vint i = 0; i < ScanningLength; i++) buffer[i] = L'x';
+			buffer[position] = L'\r';
+			buffer[position + 1] = L'\n';
+			buffer[ScanningLength] = 0;
+
+			WString expected[] = { WString(buffer, position), WString(buffer + position + 2, ScanningLength - position - 2) };
+			CheckLineBreaks(buffer, ScanningLength, expected, 2);
+		}
+	}
+}
+
+TEST_CASE(TestTextElement_FindLiteral)
+{
+	TextLines lines(nullptr);
+	lines.SetText(L"abc abc\r\nxABCx\r\nab\r\ncd");
+	TextMatch m00_03(TextPos(0, 0), TextPos(0, 3));
+	TextMatch m04_07(TextPos(0, 4), TextPos(0, 7));
+	TextMatch m11_14(TextPos(1, 1), TextPos(1, 4));
+
+	// forward finds the first match starting at or after the position
+	TEST_ASSERT(CheckFind(lines, L"abc", true, true, TextPos(0, 0), m00_03));
+	TEST_ASSERT(CheckFind(lines, L"abc", true, true, TextPos(0, 1), m04_07));
+	TEST_ASSERT(CheckFind(lines, L"abc", false, true, TextPos(0, 5), m11_14));
+	{
+		TextMatch match;
+		TEST_ASSERT(!lines.Find(L"abc", true, true, TextPos(0, 5), match));
+	}
+
+	// backward finds the last match ending at or before the position
+	TEST_ASSERT(CheckFind(lines, L"abc", true, false, TextPos(3, 2), m04_07));
+	TEST_ASSERT(CheckFind(lines, L"abc", false, false, TextPos(3, 2), m11_14));
+	TEST_ASSERT(CheckFind(lines, L"abc", true, false, TextPos(0, 6), m00_03));
+	TEST_ASSERT(CheckFind(lines, L"abc", true, false, TextPos(0, 7), m04_07));
+
+	List<TextMatch> matches;
+	TEST_ASSERT(lines.FindAll(L"abc", true, matches) == 2);
+	TEST_ASSERT(matches[0] == m00_03 && matches[1] == m04_07);
+	TEST_ASSERT(lines.FindAll(L"ABC", false, matches) == 3);
+	TEST_ASSERT(matches[0] == m00_03 && matches[1] == m04_07 && matches[2] == m11_14);
+	TEST_ASSERT(CheckNotFound(lines, L"abcd", false));
+	TEST_ASSERT(CheckNotFound(lines, L"aBC", true));
+
+	// matches do not overlap
+	lines.SetText(L"aaaaa");
+	TEST_ASSERT(lines.FindAll(L"aa", true, matches) == 2);
+	TEST_ASSERT(matches[0] == TextMatch(TextPos(0, 0), TextPos(0, 2)));
+	TEST_ASSERT(matches[1] == TextMatch(TextPos(0, 2), TextPos(0, 4)));
+}
+
+TEST_CASE(TestTextElement_FindAcrossLines)
+{
+	// the first line of a pattern should end a text line, and the rest is compared with the following lines
+	TextLines lines(nullptr);
+	lines.SetText(L"abc abc\r\nxABCx\r\nab\r\ncd");
+	TEST_ASSERT(CheckFind(lines, L"ab\r\ncd", true, true, TextPos(0, 0), TextMatch(TextPos(2, 0), TextPos(3, 2))));
+	TEST_ASSERT(CheckFind(lines, L"C\r\nXa", false, true, TextPos(0, 0), TextMatch(TextPos(0, 6), TextPos(1, 2))));
+	TEST_ASSERT(CheckFind(lines, L"b\r\nc", true, true, TextPos(0, 0), TextMatch(TextPos(2, 1), TextPos(3, 1))));
+	TEST_ASSERT(CheckFind(lines, L"\r\ncd", true, true, TextPos(0, 0), TextMatch(TextPos(2, 2), TextPos(3, 2))));
+	TEST_ASSERT(CheckFind(lines, L"ab\r\n", true, true, TextPos(0, 0), TextMatch(TextPos(2, 0), TextPos(3, 0))));
+	TEST_ASSERT(CheckFind(lines, L"x\r\nab\r\nc", true, true, TextPos(0, 0), TextMatch(TextPos(1, 4), TextPos(3, 1))));
+	TEST_ASSERT(CheckFind(lines, L"ab\r\ncd", true, false, TextPos(3, 2), TextMatch(TextPos(2, 0), TextPos(3, 2))));
+	TEST_ASSERT(CheckNotFound(lines, L"ab\r\ncde", true));
+	TEST_ASSERT(CheckNotFound(lines, L"ab\r\nc\r\n", true));
+
+	List<TextMatch> matches;
+	TEST_ASSERT(lines.FindAll(L"\r\n", true, matches) == 3);
+	TEST_ASSERT(matches[0] == TextMatch(TextPos(0, 7), TextPos(1, 0)));
+	TEST_ASSERT(matches[2] == TextMatch(TextPos(2, 2), TextPos(3, 0)));
+
+	// modified lines are searched again
+	TEST_ASSERT(CheckNotFound(lines, L"zy", true));
+	lines.Modify(TextPos(3, 0), TextPos(3, 2), L"wzyw");
+	TEST_ASSERT(CheckFind(lines, L"zy", true, true, TextPos(0, 0), TextMatch(TextPos(3, 1), TextPos(3, 3))));
+	TEST_ASSERT(CheckFind(lines, L"ab\r\nwz", true, true, TextPos(0, 0), TextMatch(TextPos(2, 0), TextPos(3, 2))));
+}
+
+TEST_CASE(TestTextElement_FindCaseFolding)
+{
+	TextLines lines(nullptr);
+	lines.SetText(L"\x00C4\x00D6\x00DC \x03A3\x0391\x03A3 \x0141");
+
+	// characters are folded as INVLOC does
+	TextMatch match;
+	bool folded = INVLOC.ToLower(L"\x00C4\x00D6\x00DC") == L"\x00E4\x00F6\x00FC" && INVLOC.ToUpper(L"\x00E4\x00F6\x00FC") == L"\x00C4\x00D6\x00DC";
+	TEST_ASSERT(lines.Find(L"\x00E4\x00F6\x00FC", false, true, TextPos(0, 0), match) == folded);
+	TEST_ASSERT(lines.Find(L"\x00E4\x00F6\x00FC", true, true, TextPos(0, 0), match) == false);
+	TEST_ASSERT(CheckFind(lines, L"\x00C4\x00D6\x00DC", false, true, TextPos(0, 0), TextMatch(TextPos(0, 0), TextPos(0, 3))));
+
+	folded = INVLOC.ToLower(L"\x03A3\x0391\x03A3") == L"\x03C3\x03B1\x03C3" && INVLOC.ToUpper(L"\x03C3\x03B1\x03C3") == L"\x03A3\x0391\x03A3";
+	TEST_ASSERT(lines.Find(L"\x03C3\x03B1\x03C3", false, true, TextPos(0, 0), match) == folded);
+
+	// characters that do not fold to each other never match
+	TEST_ASSERT(CheckNotFound(lines, L"A", false));
+	TEST_ASSERT(CheckNotFound(lines, L"a", false));
+	TEST_ASSERT(CheckNotFound(lines, L"\x00E4\x00F6\x00FD", false));
+	TEST_ASSERT(CheckFind(lines, L"\x0141", false, true, TextPos(0, 0), TextMatch(TextPos(0, 8), TextPos(0, 9))));
+}
+
+TEST_CASE(TestTextElement_FindRegex)
+{
+	TextLines lines(nullptr);
+	lines.SetText(L"a1 b22\r\n\r\nc333");
+	regex::Regex digits(L"/d+");
+	TEST_ASSERT(CheckFind(lines, digits, true, TextPos(0, 0), TextMatch(TextPos(0, 1), TextPos(0, 2))));
+	TEST_ASSERT(CheckFind(lines, digits, true, TextPos(0, 2), TextMatch(TextPos(0, 4), TextPos(0, 6))));
+	TEST_ASSERT(CheckFind(lines, digits, true, TextPos(0, 6), TextMatch(TextPos(2, 1), TextPos(2, 4))));
+	TEST_ASSERT(CheckFind(lines, digits, false, TextPos(2, 3), TextMatch(TextPos(0, 4), TextPos(0, 6))));
+	TEST_ASSERT(CheckFind(lines, digits, false, TextPos(2, 4), TextMatch(TextPos(2, 1), TextPos(2, 4))));
+
+	List<TextMatch> matches;
+	TEST_ASSERT(lines.FindAll(digits, matches) == 3);
+
+	// empty matches are ignored
+	regex::Regex optionalDigits(L"/d*");
+	TEST_ASSERT(lines.FindAll(optionalDigits, matches) == 3);
+	TEST_ASSERT(matches[0] == TextMatch(TextPos(0, 1), TextPos(0, 2)));
+	TEST_ASSERT(matches[1] == TextMatch(TextPos(0, 4), TextPos(0, 6)));
+	TEST_ASSERT(matches[2] == TextMatch(TextPos(2, 1), TextPos(2, 4)));
+}
+
+TEST_HEADLESS_CASE(TestTextElement_ReplaceAll)
+{
+	auto window = CreateTestWindow(Size(200, 200));
+	auto textBox = new GuiMultilineTextBox(theme::ThemeName::MultilineTextBox);
+	textBox->GetBoundsComposition()->SetAlignmentToParent(Margin(0, 0, 0, 0));
+	window->AddChild(textBox);
+
+	WString text = L"abc ABC\r\nxabcx\r\nab\r\ncd";
+	textBox->SetText(text);
+	textBox->ClearUndoRedo();
+
+	TEST_ASSERT(textBox->ReplaceAll(L"abc", true, L"[]") == 2);
+	TEST_ASSERT(textBox->GetText() == L"[] ABC\r\nx[]x\r\nab\r\ncd");
+	TEST_ASSERT(textBox->ReplaceAll(L"abc", false, L"") == 1);
+	TEST_ASSERT(textBox->GetText() == L"[] \r\nx[]x\r\nab\r\ncd");
+	TEST_ASSERT(textBox->ReplaceAll(L"]x\r\nAB", false, L"-") == 1);
+	TEST_ASSERT(textBox->GetText() == L"[] \r\nx[-\r\ncd");
+	TEST_ASSERT(textBox->ReplaceAll(L"nothing", false, L"-") == 0);
+	TEST_ASSERT(textBox->ReplaceAll(regex::Regex(L"[/[/]/-]"), L"\r\n") == 4);
+	TEST_ASSERT(textBox->GetText() == L"\r\n\r\n \r\nx\r\n\r\n\r\ncd");
+
+	// every replacement is undone in one step
+	for (vint i = 0; i < 4; i++)
+	{
+		TEST_ASSERT(textBox->Undo());
+	}
+	TEST_ASSERT(textBox->GetText() == text);
+	TEST_ASSERT(!textBox->CanUndo());
+
+	TEST_ASSERT(textBox->Redo());
+	TEST_ASSERT(textBox->GetText() == L"[] ABC\r\nx[]x\r\nab\r\ncd");
+	TEST_ASSERT(textBox->Redo());
+	TEST_ASSERT(textBox->Redo());
+	TEST_ASSERT(textBox->Redo());
+	TEST_ASSERT(textBox->GetText() == L"\r\n\r\n \r\nx\r\n\r\n\r\ncd");
+	TEST_ASSERT(!textBox->CanRedo());
+
+	// a step of replacements is not merged with typing
+	textBox->Select(TextPos(0, 0), TextPos(0, 0));
+	textBox->SetSelectionText(L"x");
+	TEST_ASSERT(textBox->ReplaceAll(L"x", true, L"yy") == 2);
+	TEST_ASSERT(textBox->GetText() == L"yy\r\n\r\n \r\nyy\r\n\r\n\r\ncd");
+	TEST_ASSERT(textBox->Undo());
+	TEST_ASSERT(textBox->GetText() == L"x\r\n\r\n \r\nx\r\n\r\n\r\ncd");
+
+	DestroyTestWindow(window);
+}
@@ -0,0 +1,73 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements;
+using namespace vl::presentation::controls;
+
+namespace text_undo_redo_test
+{
+	class TestDocumentUndoRedoProcessor : public GuiDocumentUndoRedoProcessor
+	{
+	public:
+		vint GetStepCount()
+		{
+			return steps.Count();
+		}
+	};
+
+	void InsertText(Ptr<DocumentModel> model, TestDocumentUndoRedoProcessor& processor, TextPos position, const WString& text, bool keyInput)
+	{
+		Array<WString> lines(1);
+		lines[0] = text;
+		auto originalModel = model->CopyDocument(position, position, true);
+		model->EditText(position, position, true, lines);
+		TextPos end(position.row, position.column + text.Length());
+
+		GuiDocumentUndoRedoProcessor::ReplaceModelStruct arguments;
+		arguments.originalStart = position;
+		arguments.originalEnd = position;
+		arguments.originalModel = originalModel;
+		arguments.inputStart = position;
+		arguments.inputEnd = end;
+		arguments.inputModel = model->CopyDocument(position, end, true);
+		arguments.keyInput = keyInput;
+		processor.OnReplaceModel(arguments);
+	}
+}
+using namespace text_undo_redo_test;
+
+TEST_CASE(TestTextUndoRedo_MergeOnlyKeyInput)
+{
+	auto model = MakePtr<DocumentModel>();
+	model->paragraphs.Add(new DocumentParagraphRun);
+	auto element = GuiDocumentElement::Create();
+	element->SetDocument(model);
+
+	TestDocumentUndoRedoProcessor processor;
+	processor.Setup(element, nullptr);
+
+	// typing is merged into one step
+	InsertText(model, processor, TextPos(0, 0), L"a", true);
+	InsertText(model, processor, TextPos(0, 1), L"b", true);
+	InsertText(model, processor, TextPos(0, 2), L"c", true);
+	TEST_ASSERT(processor.GetStepCount() == 1);
+
+	// pasting after typing is not merged
+	InsertText(model, processor, TextPos(0, 3), L"pasted", false);
+	TEST_ASSERT(processor.GetStepCount() == 2);
+
+	// typing after pasting is not merged into the pasted step
+	InsertText(model, processor, TextPos(0, 9), L"d", true);
+	TEST_ASSERT(processor.GetStepCount() == 3);
+	InsertText(model, processor, TextPos(0, 10), L"e", true);
+	TEST_ASSERT(processor.GetStepCount() == 3);
+
+	// pasting twice is not merged
+	InsertText(model, processor, TextPos(0, 11), L"x", false);
+	InsertText(model, processor, TextPos(0, 12), L"y", false);
+	TEST_ASSERT(processor.GetStepCount() == 5);
+	TEST_ASSERT(model->GetText(true) == L"abcpasteddexy");
+	delete element;
+}
@@ -0,0 +1,136 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+
+namespace bindings_benchmark
+{
+	const vint BindingCount = 10000;
+	const vint Repeat = 20;
+
+	class BenchmarkSubscription : public Object, public virtual IValueSubscription
+	{
+	public:
+		vint					value = 0;
+
+		void Set(vint _value)
+		{
+			value = _value;
+			ValueChanged(BoxValue<vint>(value));
+		}
+
+		bool Open()override { return true; }
+		bool Update()override { return true; }
+		bool Close()override { return true; }
+	};
+
+	class BenchmarkRootObject : public GuiInstanceRootObject
+	{
+	public:
+		using GuiInstanceRootObject::PropertyBinding;
+		using GuiInstanceRootObject::BindingList;
+		using GuiInstanceRootObject::SortBindings;
+
+		List<Ptr<BenchmarkSubscription>>	bindingSubscriptions;
+		vint								written = 0;
+
+		BenchmarkRootObject()
+		{
+			for (vint i = 0; i < BindingCount; i++)
+			{
+				auto subscription = MakePtr<BenchmarkSubscription>();
+				bindingSubscriptions.Add(subscription);
+				AddPropertyBinding(subscription, [=](const Value&) { written++; });
+			}
+		}
+
+		~BenchmarkRootObject()
+		{
+			FinalizeInstance();
+		}
+
+		GuiControlHost* GetControlHostForInstance()override
+		{
+			return nullptr;
+		}
+	};
+
+	void Report(const WString& name, vint64_t operations, vuint64_t milliseconds)
+	{
+		if (milliseconds == 0) milliseconds = 1;
+		TEST_PRINT(L"    " + name + L": " + u64tow(milliseconds) + L" ms, " + i64tow(operations / (vint64_t)milliseconds) + L" K bindings/s");
+	}
+
+	void BenchmarkBatch(const WString& name, vint changes, bool reversed)
+	{
+		BenchmarkRootObject rootObject;
+		auto start = DateTime::LocalTime().totalMilliseconds;
+		for (vint i = 0; i < Repeat; i++)
+		{
+			rootObject.written = 0;
+			rootObject.BeginBindingBatch();
+			for (vint j = 0; j < changes; j++)
+			{
+				for (vint k = 0; k < BindingCount; k++)
+				{
+					rootObject.bindingSubscriptions[reversed ? BindingCount - k - 1 : k]->Set(j);
+				}
+			}
+			rootObject.EndBindingBatch();
+			TEST_ASSERT(rootObject.written == BindingCount);
+		}
+		Report(name, (vint64_t)BindingCount * changes * Repeat, DateTime::LocalTime().totalMilliseconds - start);
+	}
+
+	void CreateAlmostSortedBindings(BenchmarkRootObject::BindingList& bindings)
+	{
+		for (vint i = 0; i < BindingCount; i++)
+		{
+			auto binding = MakePtr<BenchmarkRootObject::PropertyBinding>();
+			binding->order = i;
+			binding->rank = i % 100 == 99 ? 1 : 0;
+			bindings.Add(binding);
+		}
+	}
+}
+using namespace bindings_benchmark;
+
+TEST_CASE(BenchmarkBindings_Batch)
+{
+	BenchmarkBatch(L"one change per binding", 1, false);
+	BenchmarkBatch(L"one change per binding in reversed order", 1, true);
+	BenchmarkBatch(L"ten changes per binding", 10, false);
+}
+
+TEST_CASE(BenchmarkBindings_Sort)
+{
+	{
+		auto start = DateTime::LocalTime().totalMilliseconds;
+		for (vint i = 0; i < Repeat; i++)
+		{
+			BenchmarkRootObject::BindingList bindings;
+			CreateAlmostSortedBindings(bindings);
+			BenchmarkRootObject::SortBindings(bindings);
+			TEST_ASSERT(bindings[BindingCount - 1]->rank == 1);
+		}
+		Report(L"SortBindings", (vint64_t)BindingCount * Repeat, DateTime::LocalTime().totalMilliseconds - start);
+	}
+	{
+		auto start = DateTime::LocalTime().totalMilliseconds;
+		for (vint i = 0; i < Repeat; i++)
+		{
+			BenchmarkRootObject::BindingList bindings;
+			CreateAlmostSortedBindings(bindings);
+			SortLambda(&bindings[0], bindings.Count(), [](const Ptr<BenchmarkRootObject::PropertyBinding>& a, const Ptr<BenchmarkRootObject::PropertyBinding>& b)
+			{
+				vint result = a->rank - b->rank;
+				return result != 0 ? result : a->order - b->order;
+			});
+			TEST_ASSERT(bindings[BindingCount - 1]->rank == 1);
+		}
+		Report(L"SortLambda", (vint64_t)BindingCount * Repeat, DateTime::LocalTime().totalMilliseconds - start);
+	}
+}
@@ -0,0 +1,90 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+
+namespace data_grid_benchmark
+{
+	const vint RowCount = 1000000;
+	const vint TaskCount = 16;
+
+	class IntegerSorter : public list::DataSorterBase
+	{
+	public:
+		vint Compare(const Value& row1, const Value& row2)override
+		{
+			return UnboxValue<vint>(row1) - UnboxValue<vint>(row2);
+		}
+	};
+
+	class IntegerKeySorter : public IntegerSorter
+	{
+	public:
+		bool GetSortKey(const Value& row, double& key)override
+		{
+			key = (double)UnboxValue<vint>(row);
+			return true;
+		}
+	};
+
+	class BenchmarkDataProvider : public list::DataProvider
+	{
+	public:
+		using list::DataProvider::PrepareSortKeys;
+		using list::DataProvider::FilterAndSortRows;
+		using list::DataProvider::FilterAndSortRowsInParallel;
+	};
+
+	void Report(const WString& name, vuint64_t milliseconds)
+	{
+		if (milliseconds == 0) milliseconds = 1;
+		TEST_PRINT(L"    " + name + L": " + u64tow(milliseconds) + L" ms, " + i64tow(RowCount / (vint64_t)milliseconds) + L" K rows/s");
+	}
+
+	void CheckSorted(const Array<Value>& rows, const List<vint>& result)
+	{
+		TEST_ASSERT(result.Count() == RowCount);
+		for (vint i = 1; i < RowCount; i++)
+		{
+			TEST_ASSERT(UnboxValue<vint>(rows[result[i - 1]]) <= UnboxValue<vint>(rows[result[i]]));
+		}
+	}
+
+	void BenchmarkSort(const WString& name, const Array<Value>& rows, list::IDataSorter* sorter, bool parallel)
+	{
+		List<vint> result;
+		auto start = DateTime::LocalTime().totalMilliseconds;
+		if (parallel)
+		{
+			BenchmarkDataProvider::FilterAndSortRowsInParallel(nullptr, sorter, rows, TaskCount, result);
+		}
+		else
+		{
+			Array<double> keys;
+			bool useKeys = BenchmarkDataProvider::PrepareSortKeys(sorter, rows, keys);
+			BenchmarkDataProvider::FilterAndSortRows(nullptr, sorter, rows, (useKeys ? &keys : nullptr), 0, rows.Count(), result);
+		}
+		Report(name, DateTime::LocalTime().totalMilliseconds - start);
+		CheckSorted(rows, result);
+	}
+}
+using namespace data_grid_benchmark;
+
+TEST_CASE(BenchmarkDataGrid_SortRows)
+{
+	Array<Value> rows(RowCount);
+	for (vint i = 0; i < RowCount; i++)
+	{
+		rows[i] = BoxValue<vint>((i * 7919) % RowCount);
+	}
+
+	IntegerSorter sorter;
+	IntegerKeySorter keySorter;
+	BenchmarkSort(L"Compare", rows, &sorter, false);
+	BenchmarkSort(L"GetSortKey", rows, &keySorter, false);
+	BenchmarkSort(L"Compare in parallel", rows, &sorter, true);
+	BenchmarkSort(L"GetSortKey in parallel", rows, &keySorter, true);
+}
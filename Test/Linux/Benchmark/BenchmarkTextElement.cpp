@@ -0,0 +1,122 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::elements::text;
+
+namespace text_element_benchmark
+{
+	const vint LineLength = 80;
+	const vint LineCount = 100000;
+	const vint Repeat = 20;
+
+	WString CreateText(wchar_t fill)
+	{
+		Array<wchar_t> buffer(LineLength * LineCount + 1);
+		for (vint i = 0; i < LineCount; i++)
+		{
+			for (vint j = 0; j < LineLength - 2; j++)
+			{
+				buffer[i * LineLength + j] = fill;
+			}
+			buffer[i * LineLength + LineLength - 2] = L'\r';
+			buffer[i * LineLength + LineLength - 1] = L'\n';
+		}
+		buffer[LineLength * LineCount] = 0;
+		return &buffer[0];
+	}
+
+	const wchar_t* FindLineBreakScalar(const wchar_t* reading, const wchar_t* end)
+	{
+		while (reading < end && *reading != L'\r' && *reading != L'\n') reading++;
+		return reading;
+	}
+
+	const wchar_t* FindSpecialCharacterScalar(const wchar_t* reading, const wchar_t* end)
+	{
+		while (reading < end && *reading != L'\t' && (*reading & ~0x7FF) != 0xD800) reading++;
+		return reading;
+	}
+
+	vint CountStops(const WString& text, const wchar_t* (*scan)(const wchar_t*, const wchar_t*))
+	{
+		vint count = 0;
+		const wchar_t* reading = text.Buffer();
+		const wchar_t* end = reading + text.Length();
+		while (true)
+		{
+			reading = scan(reading, end);
+			if (reading == end) break;
+			count++;
+			reading++;
+		}
+		return count;
+	}
+
+	void Report(const WString& name, vint64_t characters, vuint64_t milliseconds)
+	{
+		if (milliseconds == 0) milliseconds = 1;
+		TEST_PRINT(L"    " + name + L": " + u64tow(milliseconds) + L" ms, " + i64tow(characters / (vint64_t)milliseconds / 1000) + L" M characters/s");
+	}
+
+	void BenchmarkScanning(const WString& name, const WString& text, const wchar_t* (*scan)(const wchar_t*, const wchar_t*), vint expectedStops)
+	{
+		auto start = DateTime::LocalTime().totalMilliseconds;
+		for (vint i = 0; i < Repeat; i++)
+		{
+			TEST_ASSERT(CountStops(text, scan) == expectedStops);
+		}
+		Report(name, (vint64_t)text.Length() * Repeat, DateTime::LocalTime().totalMilliseconds - start);
+	}
+}
+using namespace text_element_benchmark;
+
+TEST_CASE(BenchmarkTextElement_FindLineBreak)
+{
+	auto text = CreateText(L'x');
+	BenchmarkScanning(L"scalar", text, &FindLineBreakScalar, LineCount * 2);
+	BenchmarkScanning(L"FindLineBreak", text, &FindLineBreak, LineCount * 2);
+}
+
+TEST_CASE(BenchmarkTextElement_FindSpecialCharacter)
+{
+	auto text = CreateText(L'x');
+	BenchmarkScanning(L"scalar", text, &FindSpecialCharacterScalar, 0);
+	BenchmarkScanning(L"FindSpecialCharacter", text, &FindSpecialCharacter, 0);
+}
+
+TEST_CASE(BenchmarkTextElement_SetText)
+{
+	auto text = CreateText(L'x');
+	TextLines lines(nullptr);
+	auto start = DateTime::LocalTime().totalMilliseconds;
+	for (vint i = 0; i < Repeat; i++)
+	{
+		lines.SetText(text);
+		TEST_ASSERT(lines.GetCount() == LineCount + 1);
+	}
+	Report(L"TextLines::SetText", (vint64_t)text.Length() * Repeat, DateTime::LocalTime().totalMilliseconds - start);
+}
+
+TEST_CASE(BenchmarkTextElement_LoadText)
+{
+	auto text = CreateText(L'x');
+	stream::MemoryStream memoryStream;
+	{
+		stream::BomEncoder encoder(stream::BomEncoder::Utf16);
+		stream::EncoderStream encoderStream(memoryStream, encoder);
+		stream::StreamWriter writer(encoderStream);
+		writer.WriteString(text);
+	}
+
+	TextLines lines(nullptr);
+	auto start = DateTime::LocalTime().totalMilliseconds;
+	for (vint i = 0; i < Repeat; i++)
+	{
+		memoryStream.SeekFromBegin(0);
+		lines.LoadText(memoryStream);
+		TEST_ASSERT(lines.GetCount() == LineCount + 1);
+	}
+	Report(L"TextLines::LoadText", (vint64_t)text.Length() * Repeat, DateTime::LocalTime().totalMilliseconds - start);
+}
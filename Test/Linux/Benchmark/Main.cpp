@@ -0,0 +1,13 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+
+int main()
+{
+	return SetupSoftwareRenderer();
+}
+
+void GuiMain()
+{
+	unittest::UnitTest::RunAndDisposeTests();
+}
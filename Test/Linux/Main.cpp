@@ -4,9 +4,10 @@ using namespace vl;
 
 int main()
 {
-	return 0;
+	return SetupSoftwareRenderer();
 }
 
 void GuiMain()
 {
+	unittest::UnitTest::RunAndDisposeTests();
 }